@@ -0,0 +1,440 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+
+namespace Optizelle {
+    // Step size for a one-sided finite difference at x in the direction dx.
+    // We scale the relative step, by default the square root of machine
+    // precision, by the size of x relative to dx.  When dx is zero, we
+    // return zero.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    Real fd_step(
+        typename XX <Real>::Vector const & x,
+        typename XX <Real>::Vector const & dx,
+        Real const & rel = std::sqrt(std::numeric_limits <Real>::epsilon())
+    ) {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+
+        auto norm_dx = std::sqrt(X::innr(dx,dx));
+        if(norm_dx == Real(0.))
+            return Real(0.);
+        return rel * (Real(1.)+std::sqrt(X::innr(x,x))) / norm_dx;
+    }
+
+    // An objective whose Hessian-vector product we approximate with a
+    // one-sided finite difference of the gradient
+    //
+    // hess f(x) dx ~= (grad f(x + h dx) - grad f(x)) / h
+    //
+    // Derive from this rather than ScalarValuedFunction in order to provide
+    // only eval and grad.  We remember the gradient at the last x that we
+    // saw, so each Hessian-vector product at that point costs one gradient.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct FiniteDifferenceHessian : public ScalarValuedFunction <Real,XX> {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+    private:
+        // Point and gradient at that point that we've cached
+        mutable std::unique_ptr <CacheStamp <Real,XX> > x_base;
+        mutable std::unique_ptr <X_Vector> grad_base;
+
+    public:
+        // H_dx = hess f(x) dx
+        void hessvec(
+            X_Vector const & x,
+            X_Vector const & dx,
+            X_Vector & H_dx
+        ) const {
+            // Find the step size
+            auto h = fd_step <Real,XX> (x,dx);
+            if(h == Real(0.)) {
+                X::zero(H_dx);
+                return;
+            }
+
+            // Refresh grad f(x) when we move
+            if(!x_base) {
+                x_base.reset(new CacheStamp <Real,XX> (x));
+                grad_base.reset(new X_Vector(X::init(x)));
+            }
+            if(x_base->stale(x)) {
+                this->grad(x,*grad_base);
+                x_base->update(x);
+            }
+
+            // H_dx <- grad f(x + h dx)
+            X_Vector x_p_hdx(X::init(x));
+            X::copy(x,x_p_hdx);
+            X::axpy(h,dx,x_p_hdx);
+            this->grad(x_p_hdx,H_dx);
+
+            // H_dx <- (grad f(x + h dx) - grad f(x)) / h
+            X::axpy(Real(-1.),*grad_base,H_dx);
+            X::scal(Real(1.)/h,H_dx);
+        }
+    };
+
+    // A vector valued function whose derivative and second derivative
+    // adjoint we approximate with one-sided finite differences
+    //
+    // f'(x)dx ~= (f(x + h dx) - f(x)) / h
+    // (f''(x)dx)*dy ~= (f'(x + h dx)*dy - f'(x)*dy) / h
+    //
+    // Derive from this rather than VectorValuedFunction in order to provide
+    // only eval and ps.  We remember f(x) at the last x and f'(x)*dy at the
+    // last x and dy that we saw.
+    template <
+        typename Real,
+        template <typename> class XX,
+        template <typename> class YY
+    >
+    struct FiniteDifferenceDerivative :
+        public VectorValuedFunction <Real,XX,YY>
+    {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef YY <Real> Y;
+        typedef typename Y::Vector Y_Vector;
+
+    private:
+        // Point and function value at that point that we've cached
+        mutable std::unique_ptr <CacheStamp <Real,XX> > x_eval;
+        mutable std::unique_ptr <Y_Vector> f_x;
+
+        // Point, direction, and adjoint derivative that we've cached
+        mutable std::unique_ptr <CacheStamp <Real,XX> > x_ps;
+        mutable std::unique_ptr <CacheStamp <Real,YY> > dy_ps;
+        mutable std::unique_ptr <X_Vector> fps_x_dy;
+
+    public:
+        // y=f'(x)dx
+        void p(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector & y
+        ) const {
+            // Find the step size
+            auto h = fd_step <Real,XX> (x,dx);
+            if(h == Real(0.)) {
+                Y::zero(y);
+                return;
+            }
+
+            // Refresh f(x) when we move
+            if(!x_eval) {
+                x_eval.reset(new CacheStamp <Real,XX> (x));
+                f_x.reset(new Y_Vector(Y::init(y)));
+            }
+            if(x_eval->stale(x)) {
+                this->eval(x,*f_x);
+                x_eval->update(x);
+            }
+
+            // y <- f(x + h dx)
+            X_Vector x_p_hdx(X::init(x));
+            X::copy(x,x_p_hdx);
+            X::axpy(h,dx,x_p_hdx);
+            this->eval(x_p_hdx,y);
+
+            // y <- (f(x + h dx) - f(x)) / h
+            Y::axpy(Real(-1.),*f_x,y);
+            Y::scal(Real(1.)/h,y);
+        }
+
+        // z=(f''(x)dx)*dy
+        void pps(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            // Find the step size
+            auto h = fd_step <Real,XX> (x,dx);
+            if(h == Real(0.)) {
+                X::zero(z);
+                return;
+            }
+
+            // Refresh f'(x)*dy when either x or dy changes
+            if(!x_ps) {
+                x_ps.reset(new CacheStamp <Real,XX> (x));
+                dy_ps.reset(new CacheStamp <Real,YY> (dy));
+                fps_x_dy.reset(new X_Vector(X::init(x)));
+            }
+            if(x_ps->stale(x) || dy_ps->stale(dy)) {
+                this->ps(x,dy,*fps_x_dy);
+                x_ps->update(x);
+                dy_ps->update(dy);
+            }
+
+            // z <- f'(x + h dx)*dy
+            X_Vector x_p_hdx(X::init(x));
+            X::copy(x,x_p_hdx);
+            X::axpy(h,dx,x_p_hdx);
+            this->ps(x_p_hdx,dy,z);
+
+            // z <- (f'(x + h dx)*dy - f'(x)*dy) / h
+            X::axpy(Real(-1.),*fps_x_dy,z);
+            X::scal(Real(1.)/h,z);
+        }
+    };
+
+    // Approximates the matrix of derivatives of a function, F : Rn -> Rm, on a
+    // colored sparsity pattern with one evaluation of F per color.  We take
+    // F(x) in F_x and return the values of the entries in vals.  The step in
+    // each coordinate is rel max(1,|x_j|).
+    template <typename Real>
+    void fd_compressed(
+        std::function <void(std::vector <Real> const &,std::vector <Real> &)>
+            const & F,
+        ColoredPattern const & pattern,
+        std::vector <Real> const & x,
+        std::vector <Real> const & F_x,
+        Real const & rel,
+        std::vector <Real> & vals
+    ) {
+        vals.assign(pattern.rows.size(),Real(0.));
+        std::vector <Real> x_p_hd(x);
+        std::vector <Real> F_x_p_hd(F_x.size());
+        for(Natural c=0;c<pattern.ncolors();c++) {
+            // Perturb every coordinate of this color at once
+            for(Natural j=0;j<x.size();j++)
+                x_p_hd[j] = pattern.colors[j]==c ?
+                    x[j]+rel*std::max(Real(1.),std::fabs(x[j])) :
+                    x[j];
+            F(x_p_hd,F_x_p_hd);
+
+            // Since no two columns of this color share a row, each row of the
+            // difference belongs to exactly one column
+            for(auto const & k : pattern.entries[c]) {
+                auto const & i = pattern.rows[k];
+                auto const & j = pattern.cols[k];
+                vals[k] = (F_x_p_hd[i]-F_x[i])/(x_p_hd[j]-x[j]);
+            }
+        }
+    }
+
+    // An objective on Rm whose Hessian we approximate with finite differences
+    // of the gradient on a known sparsity pattern.  We color the columns of
+    // the pattern, so a whole Hessian costs one gradient per color plus the
+    // gradient at x.  We keep the Hessian at the last x that we saw and apply
+    // its symmetric part in hessvec.  Derive from this rather than
+    // ScalarValuedFunction in order to provide only eval and grad.
+    template <typename Real>
+    struct SparseFiniteDifferenceHessian :
+        public ScalarValuedFunction <Real,Rm>
+    {
+        // Create some type shortcuts
+        typedef Rm <Real> X;
+        typedef typename X::Vector X_Vector;
+
+    private:
+        // Sparsity pattern of the Hessian
+        ColoredPattern pattern;
+
+        // Point and Hessian at that point that we've cached
+        mutable std::unique_ptr <CacheStamp <Real,Rm> > x_hess;
+        mutable std::vector <Real> vals;
+
+        // Computes the Hessian at x if we haven't already
+        void refresh(X_Vector const & x) const {
+            if(!x_hess)
+                x_hess.reset(new CacheStamp <Real,Rm> (x));
+            if(!x_hess->stale(x))
+                return;
+            X_Vector grad_x(X::init(x));
+            this->grad(x,grad_x);
+            fd_compressed <Real> (
+                [this](X_Vector const & xx,X_Vector & grad_xx) {
+                    this->grad(xx,grad_xx);
+                },
+                pattern,x,grad_x,
+                std::sqrt(std::numeric_limits <Real>::epsilon()),vals);
+            x_hess->update(x);
+        }
+
+    public:
+        // Sets up the coloring for an n x n Hessian with nonzeros at
+        // (is[k],js[k]).  Indices start from 0 and we only require one of
+        // each pair of symmetric entries.
+        SparseFiniteDifferenceHessian(
+            Natural const & n_,
+            std::vector <Natural> const & is,
+            std::vector <Natural> const & js
+        ) : pattern(n_,n_,is,js,true), x_hess(), vals() {}
+
+        // Number of gradients, beyond the one at x, in each Hessian
+        Natural ncolors() const {
+            return pattern.ncolors();
+        }
+
+        // H_dx = hess f(x) dx
+        void hessvec(
+            X_Vector const & x,
+            X_Vector const & dx,
+            X_Vector & H_dx
+        ) const {
+            // Find the Hessian
+            refresh(x);
+
+            // H_dx <- 1/2 (H + H') dx
+            X::zero(H_dx);
+            for(Natural k=0;k<vals.size();k++) {
+                auto const & i = pattern.rows[k];
+                auto const & j = pattern.cols[k];
+                H_dx[i] += Real(0.5)*vals[k]*dx[j];
+                H_dx[j] += Real(0.5)*vals[k]*dx[i];
+            }
+        }
+    };
+
+    // A vector valued function on Rm whose Jacobian we approximate with
+    // finite differences of the function on a known sparsity pattern.  We
+    // color the columns of the pattern, so a whole Jacobian costs one
+    // evaluation per color plus the evaluation at x.  We keep the Jacobian at
+    // the last x that we saw, which gives us both p and ps, and we also hand
+    // it to the direct augmented system solver through jacobian.  For pps,
+    // we difference the Jacobian between x and x + h dx.  Derive from this
+    // rather than VectorValuedFunction in order to provide only eval.
+    template <typename Real>
+    struct SparseFiniteDifferenceJacobian :
+        public VectorValuedFunction <Real,Rm,Rm>
+    {
+        // Create some type shortcuts
+        typedef Rm <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef Rm <Real> Y;
+        typedef typename Y::Vector Y_Vector;
+
+    private:
+        // Sparsity pattern of the Jacobian
+        ColoredPattern pattern;
+
+        // Point and Jacobian at that point that we've cached
+        mutable std::unique_ptr <CacheStamp <Real,Rm> > x_jac;
+        mutable std::vector <Real> vals;
+
+        // Computes the values of the Jacobian at x using the relative step
+        // rel
+        void compute(
+            X_Vector const & x,
+            Real const & rel,
+            std::vector <Real> & vals_
+        ) const {
+            Y_Vector f_x(pattern.m);
+            this->eval(x,f_x);
+            fd_compressed <Real> (
+                [this](X_Vector const & xx,Y_Vector & f_xx) {
+                    this->eval(xx,f_xx);
+                },
+                pattern,x,f_x,rel,vals_);
+        }
+
+        // Computes the Jacobian at x if we haven't already
+        void refresh(X_Vector const & x) const {
+            if(!x_jac)
+                x_jac.reset(new CacheStamp <Real,Rm> (x));
+            if(!x_jac->stale(x))
+                return;
+            compute(x,std::sqrt(std::numeric_limits <Real>::epsilon()),vals);
+            x_jac->update(x);
+        }
+
+    public:
+        // Sets up the coloring for an m x n Jacobian with nonzeros at
+        // (is[k],js[k]).  Indices start from 0.
+        SparseFiniteDifferenceJacobian(
+            Natural const & m_,
+            Natural const & n_,
+            std::vector <Natural> const & is,
+            std::vector <Natural> const & js
+        ) : pattern(m_,n_,is,js,false), x_jac(), vals() {}
+
+        // Number of evaluations, beyond the one at x, in each Jacobian
+        Natural ncolors() const {
+            return pattern.ncolors();
+        }
+
+        // y=f'(x)dx
+        void p(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector & y
+        ) const {
+            refresh(x);
+            Y::zero(y);
+            for(Natural k=0;k<vals.size();k++)
+                y[pattern.rows[k]] += vals[k]*dx[pattern.cols[k]];
+        }
+
+        // z=f'(x)*dy
+        void ps(
+            X_Vector const & x,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            refresh(x);
+            X::zero(z);
+            for(Natural k=0;k<vals.size();k++)
+                z[pattern.cols[k]] += vals[k]*dy[pattern.rows[k]];
+        }
+
+        // z=(f''(x)dx)*dy
+        void pps(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            // This is a second difference of f, so the roundoff error grows
+            // like eps / h^2.  Hence, we balance it against the truncation
+            // error with steps on the order of the cube root of machine
+            // precision rather than reuse the Jacobian at x.
+            X::zero(z);
+            auto rel = std::cbrt(std::numeric_limits <Real>::epsilon());
+            auto h = fd_step <Real,Rm> (x,dx,rel);
+            if(h == Real(0.))
+                return;
+
+            // Find the Jacobian at x and x + h dx
+            std::vector <Real> vals_x;
+            compute(x,rel,vals_x);
+            X_Vector x_p_hdx(X::init(x));
+            X::copy(x,x_p_hdx);
+            X::axpy(h,dx,x_p_hdx);
+            std::vector <Real> vals_p_hdx;
+            compute(x_p_hdx,rel,vals_p_hdx);
+
+            // z <- (f'(x + h dx) - f'(x))*dy / h
+            for(Natural k=0;k<vals_x.size();k++)
+                z[pattern.cols[k]] +=
+                    (vals_p_hdx[k]-vals_x[k])*dy[pattern.rows[k]]/h;
+        }
+
+        // Fills J with the finite difference Jacobian at x
+        bool jacobian(
+            X_Vector const & x,
+            SparseMatrix <Real> & J
+        ) const {
+            refresh(x);
+            J.reset(pattern.m,pattern.n);
+            for(Natural k=0;k<vals.size();k++)
+                J.add(pattern.rows[k],pattern.cols[k],vals[k]);
+            return true;
+        }
+    };
+}
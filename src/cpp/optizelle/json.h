@@ -397,6 +397,11 @@ namespace Optizelle {
                 state.eta2=read::real <Real> (
                     root["Optizelle"].get("eta2",state.eta2),
                     "eta2");
+                state.trial_radii=read::natural(
+                    root["Optizelle"].get(
+                        "trial_radii",
+                        Json::Value::UInt64(state.trial_radii)),
+                    "trial_radii");
                 state.alpha0=read::real <Real> (
                     root["Optizelle"].get("alpha0",state.alpha0),
                     "alpha0");
@@ -408,6 +413,11 @@ namespace Optizelle {
                         "ls_iter_max",
                         Json::Value::UInt64(state.ls_iter_max)),
                     "ls_iter_max");
+                state.ls_points=read::natural(
+                    root["Optizelle"].get(
+                        "ls_points",
+                        Json::Value::UInt64(state.ls_points)),
+                    "ls_points");
                 state.eps_ls=read::real <Real> (
                     root["Optizelle"].get("eps_ls",state.eps_ls),
                     "eps_ls");
@@ -447,6 +457,16 @@ namespace Optizelle {
                     DiagnosticScheme::is_valid,
                     DiagnosticScheme::from_string,
                     "dscheme");
+                state.diag_threads=read::natural(
+                    root["Optizelle"].get(
+                        "diag_threads",
+                        Json::Value::UInt64(state.diag_threads)),
+                    "diag_threads");
+                state.eval_cache_size=read::natural(
+                    root["Optizelle"].get(
+                        "eval_cache_size",
+                        Json::Value::UInt64(state.eval_cache_size)),
+                    "eval_cache_size");
                 state.eps_kind=read::param
                     <ToleranceKind::t> (
                     root["Optizelle"].get("eps_kind",
@@ -455,6 +475,12 @@ namespace Optizelle {
                     ToleranceKind::is_valid,
                     ToleranceKind::from_string,
                     "eps_kind");
+                state.trunc_solver=read::param <TruncatedSolver::t> (
+                    root["Optizelle"].get("trunc_solver",
+                        TruncatedSolver::to_string(state.trunc_solver)),
+                    TruncatedSolver::is_valid,
+                    TruncatedSolver::from_string,
+                    "trunc_solver");
             }
             static void read(
                 std::string const & fname,
@@ -498,10 +524,14 @@ namespace Optizelle {
                 root["Optizelle"]["delta"]=write::real(state.delta);
                 root["Optizelle"]["eta1"]=write::real(state.eta1);
                 root["Optizelle"]["eta2"]=write::real(state.eta2);
+                root["Optizelle"]["trial_radii"]=write::natural(
+                    state.trial_radii);
                 root["Optizelle"]["alpha0"]=write::real(state.alpha0);
                 root["Optizelle"]["c1"]=write::real(state.c1);
                 root["Optizelle"]["ls_iter_max"]=write::natural(
                     state.ls_iter_max);
+                root["Optizelle"]["ls_points"]=write::natural(
+                    state.ls_points);
                 root["Optizelle"]["eps_ls"]=write::real(state.eps_ls);
                 root["Optizelle"]["dir"]=write_param(
                     LineSearchDirection::to_string,state.dir);
@@ -515,8 +545,14 @@ namespace Optizelle {
                     VectorSpaceDiagnostics::to_string,state.x_diag);
                 root["Optizelle"]["dscheme"]=write_param(
                     DiagnosticScheme::to_string,state.dscheme);
+                root["Optizelle"]["diag_threads"]=write::natural(
+                    state.diag_threads);
+                root["Optizelle"]["eval_cache_size"]=write::natural(
+                    state.eval_cache_size);
                 root["Optizelle"]["eps_kind"]=write_param(
                     ToleranceKind::to_string,state.eps_kind);
+                root["Optizelle"]["trunc_solver"]=write_param(
+                    TruncatedSolver::to_string,state.trunc_solver);
 
                 // Create a string with the above output
                 Json::StyledWriter writer;
@@ -670,6 +706,11 @@ namespace Optizelle {
                         "augsys_rst_freq",
                         Json::Value::UInt64(state.augsys_rst_freq)),
                     "augsys_rst_freq");
+                state.augsys_recycle_max=read::natural(
+                    root["Optizelle"].get(
+                        "augsys_recycle_max",
+                        Json::Value::UInt64(state.augsys_recycle_max)),
+                    "augsys_recycle_max");
                 state.PSchur_left_type=read::param <Operators::t> (
                     root["Optizelle"].get("PSchur_left_type",
                         Operators::to_string(state.PSchur_left_type)),
@@ -694,6 +735,12 @@ namespace Optizelle {
                     VectorSpaceDiagnostics::is_valid,
                     VectorSpaceDiagnostics::from_string,
                     "y_diag");
+                state.augsys_solver=read::param <AugmentedSystemSolver::t> (
+                    root["Optizelle"].get("augsys_solver",
+                        AugmentedSystemSolver::to_string(state.augsys_solver)),
+                    AugmentedSystemSolver::is_valid,
+                    AugmentedSystemSolver::from_string,
+                    "augsys_solver");
             }
             static void read(
                 std::string const & fname,
@@ -733,6 +780,8 @@ namespace Optizelle {
                     state.augsys_iter_max);
                 root["Optizelle"]["augsys_rst_freq"]=write::natural(
                     state.augsys_rst_freq);
+                root["Optizelle"]["augsys_recycle_max"]=write::natural(
+                    state.augsys_recycle_max);
                 root["Optizelle"]["PSchur_left_type"]=write_param(
                     Operators::to_string,state.PSchur_left_type);
                 root["Optizelle"]["PSchur_right_type"]=write_param(
@@ -741,6 +790,8 @@ namespace Optizelle {
                     FunctionDiagnostics::to_string,state.g_diag);
                 root["Optizelle"]["y_diag"]=write_param(
                     VectorSpaceDiagnostics::to_string,state.y_diag);
+                root["Optizelle"]["augsys_solver"]=write_param(
+                    AugmentedSystemSolver::to_string,state.augsys_solver);
 
                 return writer.write(root);
             }
@@ -1,3 +1,4 @@
+#include <atomic>
 #include "optizelle/linalg.h"
 #include "optizelle/exception.h"
 #include "FortranCInterface.h"
@@ -797,14 +798,100 @@ namespace Optizelle {
         // Determine k where m = 2k when m is even or m = 2k+1 when m is odd
         const Natural k = m/2; 
 
+        // Determine the leading dimension of the RPF array.  This is m when
+        // m is odd and m+1 when m is even.
+        const Natural lda = m%2 ? m : m+1;
+
         // Return the index
-        return i<=k && j<=k ? j-1 + k+1 + (2*k+1)*(i-1) : i-1 + (j-1-k)*m;
+        return j<=k ? j-1 + k+1 + lda*(i-1) : i-1 + (j-1-k)*lda;
     }
 
     // Indexing for vectors.  Assumes the first index is 1.
     Natural itok(Natural const & i) {
         return i-Natural(1);
     }
+
+    // Returns a new version stamp.  Since we share the counter between all
+    // vectors and threads, no two calls return the same stamp.
+    Natural next_version() {
+        static std::atomic <Natural> version(1);
+        return version++;
+    }
+
+    // Colors the columns of a sparsity pattern so that no two columns of the
+    // same color share a nonzero row
+    Natural color_columns(
+        Natural const & m,
+        Natural const & n,
+        std::vector <Natural> const & rows,
+        std::vector <Natural> const & cols,
+        std::vector <Natural> & colors
+    ) {
+        // Find the nonzero rows of each column and the nonzero columns of
+        // each row
+        std::vector <std::vector <Natural> > col_rows(n);
+        std::vector <std::vector <Natural> > row_cols(m);
+        for(Natural k=0;k<rows.size();k++) {
+            col_rows[cols[k]].emplace_back(rows[k]);
+            row_cols[rows[k]].emplace_back(cols[k]);
+        }
+
+        // Give each column the smallest color not already taken by a column
+        // that shares one of its rows.  We mark taken colors with the index
+        // of the column that we're coloring, so we never have to clear them.
+        Natural const none = std::numeric_limits <Natural>::max();
+        colors.assign(n,none);
+        std::vector <Natural> taken;
+        Natural ncolors = 0;
+        for(Natural j=0;j<n;j++) {
+            for(auto const & i : col_rows[j])
+                for(auto const & jj : row_cols[i])
+                    if(colors[jj]!=none)
+                        taken[colors[jj]]=j;
+            Natural color=0;
+            while(color<ncolors && taken[color]==j)
+                color++;
+            if(color==ncolors) {
+                taken.emplace_back(none);
+                ncolors++;
+            }
+            colors[j]=color;
+        }
+        return ncolors;
+    }
+
+    // Colors the pattern with nonzeros at (is[k],js[k])
+    ColoredPattern::ColoredPattern(
+        Natural const & m_,
+        Natural const & n_,
+        std::vector <Natural> const & is,
+        std::vector <Natural> const & js,
+        bool const & symmetric
+    ) : m(m_), n(n_), rows(), cols(), colors(), entries() {
+        // Sort the entries by column and remove the repeats
+        std::vector <std::pair <Natural,Natural> > jis;
+        for(Natural k=0;k<is.size();k++) {
+            jis.emplace_back(js[k],is[k]);
+            if(symmetric)
+                jis.emplace_back(is[k],js[k]);
+        }
+        std::sort(jis.begin(),jis.end());
+        jis.erase(std::unique(jis.begin(),jis.end()),jis.end());
+        for(auto const & ji : jis) {
+            cols.emplace_back(ji.first);
+            rows.emplace_back(ji.second);
+        }
+
+        // Color the columns and then group the entries by color
+        entries.resize(color_columns(m,n,rows,cols,colors));
+        for(Natural k=0;k<cols.size();k++)
+            entries[colors[cols[k]]].emplace_back(k);
+    }
+
+    // Number of colors
+    Natural ColoredPattern::ncolors() const {
+        return entries.size();
+    }
     
     namespace TruncatedStop{
         // Converts the truncated CG stopping condition to a string 
@@ -840,6 +927,8 @@ namespace Optizelle {
                 return "TooManyFailedSafeguard";
             case ObjectiveIncrease:
                 return "ObjectiveIncrease";
+            case ConvergedOnBoundary:
+                return "ConvergedOnBoundary";
             default:
                 throw Exception::t(__LOC__ +", invalid TruncatedStop::t");
             }
@@ -877,6 +966,8 @@ namespace Optizelle {
                 return TooManyFailedSafeguard;
             else if(trunc_stop=="ObjectiveIncrease")
                 return ObjectiveIncrease;
+            else if(trunc_stop=="ConvergedOnBoundary")
+                return ConvergedOnBoundary;
             else
                 throw Exception::t(__LOC__
                     + ", string can't be convert into a TruncatedStop::t"); 
@@ -898,7 +989,8 @@ namespace Optizelle {
                 name=="OffsetViolatesTrustRegion" ||
                 name=="OffsetViolatesSafeguard" ||
                 name=="TooManyFailedSafeguard" ||
-                name=="ObjectiveIncrease"
+                name=="ObjectiveIncrease" ||
+                name=="ConvergedOnBoundary"
             )
                 return true;
             else
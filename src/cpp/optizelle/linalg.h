@@ -12,6 +12,9 @@
 #include <cstdlib>
 #include <random>
 #include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <exception>
 
 // Putting this into a class prevents its construction.  Essentially, we use
 // this trick in order to create modules like in ML.  It also allows us to
@@ -577,6 +580,42 @@ namespace Optizelle {
     // Indexing for vectors 
     Natural itok(Natural const & i);
 
+    // Returns a version stamp that's never been returned before
+    Natural next_version();
+
+    // Calls eval(0), eval(1), ..., eval(n-1) with up to threads of these
+    // calls running at once.  Exceptions can't leave a parallel region, so
+    // we hold onto the first one and rethrow it once all of the calls finish.
+    // Anything beyond a single thread requires that eval be safe to call
+    // from several threads at once.
+    template <typename Eval>
+    void parallel_eval(
+        Natural const & n,
+        Natural const & threads,
+        Eval const & eval
+    ) {
+        std::exception_ptr error;
+        #ifdef _OPENMP
+        auto const nthreads = std::max(std::min(threads,n),Natural(1));
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic) \
+            if(nthreads>1)
+        #else
+        static_cast <void> (threads);
+        #endif
+        for(Integer j=0;j<Integer(n);j++) {
+            try {
+                eval(Natural(j));
+            } catch(...) {
+                #ifdef _OPENMP
+                #pragma omp critical
+                #endif
+                if(!error) error=std::current_exception();
+            }
+        }
+        if(error)
+            std::rethrow_exception(error);
+    }
+
     //---Operator0---
     // A linear operator specification, A : X->Y
     template <
@@ -592,11 +631,378 @@ namespace Optizelle {
         // y = A(x)
         virtual void eval(X_Vector const & x,Y_Vector &y) const = 0;
 
+        // ys[j] = A(xs[j]) for each j.  By default, we apply the operator to
+        // each vector in turn.  Operators that can share work between the
+        // vectors, such as a factorization, may override this.
+        virtual void eval_many(
+            std::vector <X_Vector const *> const & xs,
+            std::vector <Y_Vector *> const & ys
+        ) const {
+            for(Natural j=0;j<xs.size();j++)
+                eval(*(xs[j]),*(ys[j]));
+        }
+
         // Allow a derived class to deallocate memory 
         virtual ~Operator() {}
     };
     //---Operator1---
     
+    // Used to detect optional pieces of the vector space concept.  Basically,
+    // make_void <T>::type is void whenever T is a valid type.
+    template <typename... T>
+    struct make_void {
+        typedef void type;
+    };
+
+    // Optional multivector extension to a vector space.  A vector space may
+    // store several vectors shaped like x together by providing
+    //
+    //    MultiVector : Default constructible storage for the vectors 
+    //    resize_many(x,n,xs) : Resize xs to hold n vectors shaped like x 
+    //        while keeping the existing vectors
+    //    copy_many(x,j,xs) : xs_j <- x
+    //    innr_many(k,xs,y,z) : z_j <- <xs_j,y> for j < k
+    //    axpy_many(k,alpha,xs,y) : y <- sum_{j<k} alpha_j xs_j + y
+    //
+    // where all indices start from 0.  This lets the Krylov methods turn a
+    // sequence of inner products and axpys into a single matrix-vector
+    // product.  When the vector space doesn't provide these, we fall back to
+    // a container of individual vectors.
+    template <
+        typename Real,
+        template <typename> class XX,
+        typename = void
+    >
+    struct MultiVectors {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // Store the vectors individually
+        typedef std::deque <X_Vector> t;
+
+        // Resize the storage while keeping the existing vectors
+        static void resize(X_Vector const & x,Natural const & n,t & xs) {
+            while(xs.size() > n)
+                xs.pop_back();
+            while(xs.size() < n)
+                xs.emplace_back(X::init(x));
+        }
+
+        // xs_j <- x
+        static void copy(X_Vector const & x,Natural const & j,t & xs) {
+            X::copy(x,xs[j]);
+        }
+
+        // z_j <- <xs_j,y> for j < k
+        static void innr(
+            Natural const & k,
+            t const & xs,
+            X_Vector const & y,
+            Real * z
+        ) {
+            for(Natural j=0;j<k;j++)
+                z[j] = X::innr(xs[j],y);
+        }
+
+        // y <- sum_{j<k} alpha_j xs_j + y
+        static void axpy(
+            Natural const & k,
+            Real const * const alpha,
+            t const & xs,
+            X_Vector & y
+        ) {
+            for(Natural j=0;j<k;j++)
+                X::axpy(alpha[j],xs[j],y);
+        }
+    };
+
+    // Use the vector space's own multivector when it has one
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct MultiVectors <
+        Real,
+        XX,
+        typename make_void <typename XX <Real>::MultiVector>::type
+    > {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // Use the vector space's storage
+        typedef typename X::MultiVector t;
+
+        // Resize the storage while keeping the existing vectors
+        static void resize(X_Vector const & x,Natural const & n,t & xs) {
+            X::resize_many(x,n,xs);
+        }
+
+        // xs_j <- x
+        static void copy(X_Vector const & x,Natural const & j,t & xs) {
+            X::copy_many(x,j,xs);
+        }
+
+        // z_j <- <xs_j,y> for j < k
+        static void innr(
+            Natural const & k,
+            t const & xs,
+            X_Vector const & y,
+            Real * z
+        ) {
+            X::innr_many(k,xs,y,z);
+        }
+
+        // y <- sum_{j<k} alpha_j xs_j + y
+        static void axpy(
+            Natural const & k,
+            Real const * const alpha,
+            t const & xs,
+            X_Vector & y
+        ) {
+            X::axpy_many(k,alpha,xs,y);
+        }
+    };
+    
+    // Detects whether a vector space provides the fused operations below
+    template <typename X,typename = void>
+    struct has_axpby : std::false_type {};
+    template <typename X>
+    struct has_axpby <
+        X,
+        typename make_void <decltype(&X::axpby)>::type
+    > : std::true_type {};
+
+    template <typename X,typename = void>
+    struct has_axpy_innr : std::false_type {};
+    template <typename X>
+    struct has_axpy_innr <
+        X,
+        typename make_void <decltype(&X::axpy_innr)>::type
+    > : std::true_type {};
+
+    template <typename X,typename = void>
+    struct has_copy_scal : std::false_type {};
+    template <typename X>
+    struct has_copy_scal <
+        X,
+        typename make_void <decltype(&X::copy_scal)>::type
+    > : std::true_type {};
+
+    // Optional fused operations on a vector space.  A vector space may provide
+    //
+    //    axpby(alpha,x,beta,y) : y <- alpha x + beta y
+    //    axpy_innr(alpha,x,y,z) : y <- alpha x + y and return <y,z>
+    //    copy_scal(alpha,x,y) : y <- alpha x
+    //
+    // which saves passes over memory in the Krylov methods.  Note, z may be
+    // the same vector as x or y in axpy_innr.  When the vector space doesn't
+    // provide these, we fall back to copy, scal, axpy, and innr.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct FusedOps {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // y <- alpha x + beta y
+        static void axpby(
+            Real const & alpha,
+            X_Vector const & x,
+            Real const & beta,
+            X_Vector & y
+        ) {
+            axpby(has_axpby <X> (),alpha,x,beta,y);
+        }
+
+        // y <- alpha x + y and then axpy_innr <- <y,z>
+        static Real axpy_innr(
+            Real const & alpha,
+            X_Vector const & x,
+            X_Vector & y,
+            X_Vector const & z
+        ) {
+            return axpy_innr(has_axpy_innr <X> (),alpha,x,y,z);
+        }
+
+        // y <- alpha x
+        static void copy_scal(
+            Real const & alpha,
+            X_Vector const & x,
+            X_Vector & y
+        ) {
+            copy_scal(has_copy_scal <X> (),alpha,x,y);
+        }
+
+    private:
+        static void axpby(
+            std::true_type,
+            Real const & alpha,
+            X_Vector const & x,
+            Real const & beta,
+            X_Vector & y
+        ) {
+            X::axpby(alpha,x,beta,y);
+        }
+        static void axpby(
+            std::false_type,
+            Real const & alpha,
+            X_Vector const & x,
+            Real const & beta,
+            X_Vector & y
+        ) {
+            X::scal(beta,y);
+            X::axpy(alpha,x,y);
+        }
+
+        static Real axpy_innr(
+            std::true_type,
+            Real const & alpha,
+            X_Vector const & x,
+            X_Vector & y,
+            X_Vector const & z
+        ) {
+            return X::axpy_innr(alpha,x,y,z);
+        }
+        static Real axpy_innr(
+            std::false_type,
+            Real const & alpha,
+            X_Vector const & x,
+            X_Vector & y,
+            X_Vector const & z
+        ) {
+            X::axpy(alpha,x,y);
+            return X::innr(y,z);
+        }
+
+        static void copy_scal(
+            std::true_type,
+            Real const & alpha,
+            X_Vector const & x,
+            X_Vector & y
+        ) {
+            X::copy_scal(alpha,x,y);
+        }
+        static void copy_scal(
+            std::false_type,
+            Real const & alpha,
+            X_Vector const & x,
+            X_Vector & y
+        ) {
+            X::copy(x,y);
+            X::scal(alpha,y);
+        }
+    };
+    
+    // A pool of work vectors that the algorithms borrow from rather than
+    // allocating their temporaries on every call.  Once the pool has grown
+    // large enough, which generally happens during the first iteration, we
+    // no longer allocate any vectors.  All of the vectors in a pool must be
+    // shaped alike.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct Workspace {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef typename MultiVectors <Real,XX>::t X_MultiVector;
+
+        // Disallow copying 
+        NO_COPY_ASSIGNMENT(Workspace)
+
+        // Start with an empty pool
+        Workspace() : xs(), xss(), nallocs(0) {}
+
+        // Number of vectors the pool has allocated
+        Natural allocations() const {
+            return nallocs;
+        }
+
+        // Give the vector at x_i in xs to the workspace.  This removes it
+        // from xs.
+        void recycle(
+            std::list <X_Vector> & xs_,
+            typename std::list <X_Vector>::iterator const & x_i
+        ) {
+            xs.splice(xs.end(),xs_,x_i);
+        }
+
+        // Vectors borrowed from the workspace.  Everything borrowed goes back
+        // to the workspace when the loan goes out of scope.
+        struct Loan {
+            // Disallow copying 
+            NO_COPY_ASSIGNMENT(Loan)
+
+            // Borrow from the workspace work
+            explicit Loan(Workspace & work_) : work(work_), xs(), xss() {}
+
+            // Return everything to the workspace
+            ~Loan() {
+                work.xs.splice(work.xs.end(),xs);
+                work.xss.splice(work.xss.end(),xss);
+            }
+
+            // Borrow a vector shaped like x.  Similar to X::init, the contents
+            // of this vector are unspecified.
+            X_Vector & vector(X_Vector const & x) {
+                return vector_from([&x]() { return X::init(x); });
+            }
+
+            // Borrow a vector and, when the workspace has none to lend,
+            // create one with make().  This helps when we have no vector
+            // shaped like the ones we want on hand.
+            template <typename Make>
+            X_Vector & vector_from(Make const & make) {
+                if(work.xs.empty()) {
+                    work.xs.emplace_back(make());
+                    work.nallocs++;
+                }
+                xs.splice(xs.end(),work.xs,work.xs.begin());
+                return xs.back();
+            }
+
+            // Keep a borrowed vector by moving it to the front of xs instead
+            // of returning it to the workspace.  This doesn't copy anything.
+            void keep(X_Vector & x,std::list <X_Vector> & xs_) {
+                for(auto x_i = xs.begin(); x_i != xs.end(); x_i++)
+                    if(&(*x_i) == &x) {
+                        xs_.splice(xs_.begin(),xs,x_i);
+                        return;
+                    }
+            }
+
+            // Borrow a multivector.  It may already hold vectors from a
+            // prior loan, so it should be resized before use.
+            X_MultiVector & multivector() {
+                if(work.xss.empty())
+                    work.xss.emplace_back();
+                xss.splice(xss.end(),work.xss,work.xss.begin());
+                return xss.back();
+            }
+
+        private:
+            // Workspace that we borrowed from
+            Workspace & work;
+
+            // Vectors currently on loan
+            std::list <X_Vector> xs;
+            std::list <X_MultiVector> xss;
+        };
+
+    private:
+        // Vectors available to borrow
+        std::list <X_Vector> xs;
+        std::list <X_MultiVector> xss;
+
+        // Number of vectors the pool has allocated
+        Natural nallocs;
+    };
+    
     // A safeguard search used primarily for inequality constraints
     template <typename Real,template <typename> class XX>
     using SafeguardSimplified = std::function <
@@ -976,6 +1382,31 @@ namespace Optizelle {
         return std::pair <Real,Real> (Hp[ijtokp(1,1)],norm_v);
     }
 
+    // Solve the generalized, symmetric eigenvalue problem A x = lambda B x for
+    // the leftmost eigenvalue using the implicitely restarted Arnoldi method.
+    // Here, A is in rectangular packed format (RPF) and we already have the
+    // Choleski factorization B = U'U where U is in packed format.
+    template <typename Real>
+    std::pair <Real,Real> gsyiram_factored(
+        Natural const & m,
+        Real const * const Arf,
+        Real const * const Up,
+        Natural const & iter_innr_max,
+        Natural const & iter_outr_max,
+        Real const & tol
+    ) {
+        // Find the packed version of Arf
+        Integer info;
+        std::vector <Real> Ap(m*(m+1)/2);
+        tfttp <Real> ('N','U',m,Arf,&(Ap[0]),info);
+
+        // Ap <- inv(U') A inv(U) 
+        spgst(1,'U',m,&(Ap[0]),Up,info);
+
+        // Now, find the smallest eigenvalue of Ap = inv(U') A inv(U) 
+        return syiram <Real> (m,&(Ap[0]),iter_innr_max,iter_outr_max,tol);
+    }
+
     // Solve the generalized, symmetric eigenvalue problem A x = lambda x for
     // the leftmost eigenvalue using the implicitely restarted Arnoldi method.
     // Here, A and B is in rectangular packed format (RPF) and we assume that
@@ -998,33 +1429,31 @@ namespace Optizelle {
         Integer info;
         pftrf('N','U',m,&(Brf0[0]),info);
 
-        // Next, find the packed version of Arf and Brf0
-        std::vector <Real> Ap(m*(m+1)/2);
-        tfttp <Real> ('N','U',m,Arf,&(Ap[0]),info);
+        // Next, find the packed version of Brf0
         std::vector <Real> Bp(m*(m+1)/2);
         tfttp <Real> ('N','U',m,&(Brf0[0]),&(Bp[0]),info);
 
-        // Ap <- inv(U') A inv(U) where U comes from the above Choleski
-        // fractorization of Brf.
-        spgst(1,'U',m,&(Ap[0]),&(Bp[0]),info);
-
-        // Now, find the smallest eigenvalue of Ap = inv(U') A inv(U) 
-        return syiram <Real> (m,&(Ap[0]),iter_innr_max,iter_outr_max,tol);
+        // Now, find the smallest eigenvalue 
+        return gsyiram_factored <Real> (m,Arf,&(Bp[0]),iter_innr_max,
+            iter_outr_max,tol);
     }
 
     // Solves a quadratic equation
     //
     // a x^2 + b x + c = 0
     //
-    // Here, we assume that a, b, and c are not all zero.
+    // without allocating memory.  Here, we assume that a, b, and c are not all
+    // zero.
     //
     // (input) a, b, c : Coefficients of the quadratic
-    // (output) Roots, if they exist 
+    // (output) roots : Roots, if they exist.  This must have room for two.
+    // (return) Number of roots
     template <typename Real>
-    std::vector <Real> quad_equation(
+    Natural quad_equation(
         Real const & a,
         Real const & b,
-        Real const & c
+        Real const & c,
+        Real * roots
     ) {
 
         // It's sort of hard to tell if we have a quadratic or a linear since
@@ -1034,19 +1463,19 @@ namespace Optizelle {
         // we assume that we have a quadratic and we use the most stable
         // equation that we can for the root.
         if( a != Real(0.) ) { 
-            auto r1 = b < Real(0.) ?
+            roots[0] = b < Real(0.) ?
                 (-b + std::sqrt(b*b-Real(4.)*a*c)) / (Real(2.)*a) :
                 (Real(2.)*c) / (-b - std::sqrt(b*b-Real(4.)*a*c));
-            auto r2 = b < Real(0.) ?
+            roots[1] = b < Real(0.) ?
                 (Real(2.)*c) / (-b + std::sqrt(b*b-Real(4.)*a*c)) :
                 (-b - std::sqrt(b*b-Real(4.)*a*c)) / (Real(2.)*a);
-            return std::vector <Real> {r1,r2};
+            return 2;
 
         // Now, in the case that a is zero, but b is not, we have a linear
         // function and we can solve for the root.
         } else if( b != Real(0.)) {
-            Real r1 = -c/b;
-            return std::vector <Real> {r1};
+            roots[0] = -c/b;
+            return 1;
 
         // Here, we have a constant function.  Now, we could have no roots
         // if c is zero.  Alternatively, we could have an infinity number of
@@ -1054,7 +1483,26 @@ namespace Optizelle {
         // of these cases, so we just assume that c is not zero and return
         // zero roots.
         } else 
-            return std::vector <Real> ();
+            return 0;
+    }
+
+    // Solves a quadratic equation
+    //
+    // a x^2 + b x + c = 0
+    //
+    // Here, we assume that a, b, and c are not all zero.
+    //
+    // (input) a, b, c : Coefficients of the quadratic
+    // (output) Roots, if they exist 
+    template <typename Real>
+    std::vector <Real> quad_equation(
+        Real const & a,
+        Real const & b,
+        Real const & c
+    ) {
+        Real roots[2];
+        auto n = quad_equation(a,b,c,roots);
+        return std::vector <Real> (roots,roots+n);
     }
 
     // Reasons we stop truncated CG 
@@ -1082,9 +1530,11 @@ namespace Optizelle {
                                        // delta is the trust-region radius
             OffsetViolatesSafeguard,   // Offset violates the safeguard
             TooManyFailedSafeguard,    // Too many safeguarded steps have failed
-            ObjectiveIncrease          // CG objective, 0.5 <ABx,Bx> - <b,Bx>
+            ObjectiveIncrease,         // CG objective, 0.5 <ABx,Bx> - <b,Bx>
                                        // increased between iterations, which
                                        // shouldn't happen.
+            ConvergedOnBoundary        // Relative error is small for a
+                                       // solution on the trust-region boundary
             //---TruncatedStop1---
         };
 
@@ -1105,7 +1555,8 @@ namespace Optizelle {
         xs.pop_front();
     }
 
-    // Store a normalized vector as well as its norm
+    // Store a normalized vector as well as its norm.  The storage for the
+    // vectors is borrowed from loan.
     template <
         typename Real,
         template <typename> class XX
@@ -1114,13 +1565,14 @@ namespace Optizelle {
         Natural const & maxsize,
         Real const & normalization,
         typename XX <Real>::Vector const & x,
-        std::deque <typename XX <Real>::Vector> & xs,
+        typename Workspace <Real,XX>::Loan & loan,
+        std::deque <std::reference_wrapper <typename XX <Real>::Vector> > & xs,
         std::deque <Real> & norm_xs
     ) -> std::function<void()> {
         // Create some type shortcuts
         typedef XX <Real> X;
 
-        return [maxsize,&normalization,&xs,&norm_xs,&x]() {
+        return [maxsize,&normalization,&xs,&norm_xs,&x,&loan]() {
             // If we're not storing anything, exit
             if(maxsize <= 0) return;
 
@@ -1131,7 +1583,7 @@ namespace Optizelle {
 
             // Otherwise, allocate more memory
             } else {
-                xs.emplace_back(X::init(x));
+                xs.emplace_back(loan.vector(x));
                 norm_xs.emplace_back(Real(0.));
             }
             
@@ -1142,31 +1594,40 @@ namespace Optizelle {
         };
     };
 
-    // A orthogonalizes a vector x to a list of other xs.  
+    // A orthogonalizes a vector x to the first k vectors in vs.  Here, the
+    // vs are A normalized and Avs holds A applied to vs.  Each pass requires
+    // a single batched inner product and two batched axpys.
     template <
         typename Real,
         template <typename> class XX
     >
     void Aorthogonalize(
-        std::deque <typename XX <Real>::Vector> const & vs,
-        std::deque <typename XX <Real>::Vector> const & Avs,
+        Natural const & k,
+        typename MultiVectors <Real,XX>::t const & vs,
+        typename MultiVectors <Real,XX>::t const & Avs,
         Natural const & iter_max,
         typename XX <Real>::Vector & x,
         typename XX <Real>::Vector & Ax
     ) {
         // Create some type shortcuts
-        typedef XX <Real> X;
-        typedef typename X::Vector X_Vector;
+        typedef MultiVectors <Real,XX> Vs;
+
+        // Exit early if there's nothing to orthogonalize against
+        if(k==0) return;
+
+        // Allocate memory for the Gram-Schmidt coefficients
+        std::vector <Real> beta(k);
 
         // Orthogonalize the vectors
         for(auto iter = Natural(1);iter <= iter_max;iter++) {
-            auto Av = Avs.cbegin();
-            for(auto const & v : vs) {
-                auto beta=X::innr(*Av,x);
-                X::axpy(Real(-1.)*beta,v,x);
-                X::axpy(Real(-1.)*beta,*Av,Ax);
-                Av++;
-            }
+            // beta <- -(A vs)' x
+            Vs::innr(k,Avs,x,beta.data());
+            for(Natural j=0;j<k;j++)
+                beta[j] = Real(-1.)*beta[j];
+
+            // x <- x + vs beta, Ax <- Ax + A vs beta
+            Vs::axpy(k,beta.data(),vs,x);
+            Vs::axpy(k,beta.data(),Avs,Ax);
         }
     }
 
@@ -1299,6 +1760,7 @@ namespace Optizelle {
     // (output) stop : The reason why the method was terminated
     // (output) safeguard_failed : Number of failed safeguard steps upon exiting
     // (output) alpha_safeguard : Amount we truncated the last iteration
+    // (input/output) work : Workspace for the temporaries
     template <
         typename Real,
         template <typename> class XX
@@ -1325,13 +1787,17 @@ namespace Optizelle {
         Natural & iter,
         TruncatedStop::t & stop,
         Natural & safeguard_failed,
-        Real & alpha_safeguard
+        Real & alpha_safeguard,
+        Workspace <Real,XX> & work
     ){
 
         // Create some type shortcuts
         typedef XX <Real> X;
         typedef typename X::Vector X_Vector;
 
+        // Borrow our temporaries from the workspace
+        typename Workspace <Real,XX>::Loan loan(work);
+
         // Initialize x to zero
         X::zero(x);
 
@@ -1362,54 +1828,84 @@ namespace Optizelle {
         auto const one = Real(1.);
         
         // Residual for the sytem 
-        auto r = X::init(x); 
+        auto & r = loan.vector(x); 
         auto norm_r = Real(0.);
-        auto rs = std::deque <X_Vector> ();
+        auto rs = std::deque <std::reference_wrapper <X_Vector> > ();
         auto norm_rs = std::deque <Real> ();
 
         // Preconditioned residual for the sytem
-        auto Br = X::init(x);
+        auto & Br = loan.vector(x);
         // norm_Br returned from function
-        auto Brs = std::deque <X_Vector> ();
+        auto Brs = std::deque <std::reference_wrapper <X_Vector> > ();
         auto norm_Brs = std::deque <Real> ();
        
         // Preconditioned directions
-        auto Bdx = X::init(x);
+        auto & Bdx = loan.vector(x);
         auto norm_Bdx = Real(0.);
-        auto Bdxs = std::deque <X_Vector> ();
-        auto norm_Bdxs = std::deque <Real> ();
         
         // Operator applied to the preconditioned directions
-        auto ABdx = X::init(x);
+        auto & ABdx = loan.vector(x);
         auto norm_ABdx = Real(0.);
-        auto ABdxs = std::deque <X_Vector> ();
-        auto norm_ABdxs = std::deque <Real> ();
+
+        // Prior preconditioned directions and the operator applied to them.
+        // We store these together, so that we can orthogonalize with batched
+        // inner products.  Once we've stored orthog_storage_max directions, we
+        // overwrite the oldest.  We normalize both by || Bdx ||_A and, along
+        // with each direction, keep the norms of the normalized vectors.
+        typedef MultiVectors <Real,XX> Vs;
+        typedef FusedOps <Real,XX> XF;
+        auto & Bdxs = loan.multivector();
+        auto & ABdxs = loan.multivector();
+        auto & Bdx_normalized = loan.vector(x);
+        auto norm_Bdxs = std::vector <Real> ();
+        auto norm_ABdxs = std::vector <Real> ();
+        auto nBdxs = Natural(0);      // Number of stored directions
+        auto Bdxs_last = Natural(0);  // Location of the newest direction
 
         // Setup a bunch of functions to store elements
         auto archive_r = archive <Real,XX> (
             check_B_projector || check_B_properties ? orthog_storage_max : 0,
             one,
             r,
+            loan,
             rs,
             norm_rs);
         auto archive_Br = archive <Real,XX> (
             check_B_projector || check_B_properties ? orthog_storage_max : 0,
             one,
             Br,
+            loan,
             Brs,
             norm_Brs);
-        auto archive_Bdx = archive <Real,XX> (
-            orthog_storage_max,
-            Anorm_Bdx, 
-            Bdx,
-            Bdxs,
-            norm_Bdxs);
-        auto archive_ABdx = archive <Real,XX> (
-            orthog_storage_max,
-            Anorm_Bdx, 
-            ABdx,
-            ABdxs,
-            norm_ABdxs);
+        auto archive_Bdx = [&]() {
+            // If we're not storing anything, exit
+            if(orthog_storage_max <= 0) return;
+
+            // Allocate more memory until we hit the maximum.  After that,
+            // overwrite the oldest direction.
+            if(nBdxs < orthog_storage_max) {
+                nBdxs++;
+                Vs::resize(x,nBdxs,Bdxs);
+                Vs::resize(x,nBdxs,ABdxs);
+                norm_Bdxs.emplace_back(Real(0.));
+                norm_ABdxs.emplace_back(Real(0.));
+                Bdxs_last = nBdxs-1;
+            } else
+                Bdxs_last = (Bdxs_last+1) % orthog_storage_max;
+
+            // Normalize the direction and copy it into place.  We only need
+            // the norms for our diagnostic checks.
+            XF::copy_scal(Real(1.)/Anorm_Bdx,Bdx,Bdx_normalized);
+            Vs::copy(Bdx_normalized,Bdxs_last,Bdxs);
+            if(check_A_properties)
+                norm_Bdxs[Bdxs_last] = std::sqrt(
+                    X::innr(Bdx_normalized,Bdx_normalized));
+            XF::copy_scal(Real(1.)/Anorm_Bdx,ABdx,Bdx_normalized);
+            Vs::copy(Bdx_normalized,Bdxs_last,ABdxs);
+            if(check_A_properties)
+                norm_ABdxs[Bdxs_last] = std::sqrt(
+                    X::innr(Bdx_normalized,Bdx_normalized));
+        };
                 
         // Allocate memory for a vector where
         //
@@ -1435,9 +1931,9 @@ namespace Optizelle {
             if(!check_B_projector) return;
             
             // Update the elements
-            auto const & Bri = Brs.back();
+            X_Vector const & Bri = Brs.back();
             auto const norm_Bri = norm_Brs.back();
-            auto const & ri = rs.back();
+            X_Vector const & ri = rs.back();
             B_projector.back() = X::innr(Bri,ri) / sq(norm_Bri) - Real(1.);
         };
         auto is_B_projector = [&]() {
@@ -1518,27 +2014,46 @@ namespace Optizelle {
         //    we accumulate error here overtime.  We can mitigate this somewhat
         //    by increasing orthog_iter_max. 
         //
-        // For reference, we store X in row-major format.
+        // For reference, we store X in row-major format.  Unlike the other
+        // checks, we index X by where each direction sits in storage rather
+        // than by age.  Both checks are invariant to permuting the rows and
+        // columns together, so this doesn't change the result.
         auto A_properties = std::deque <std::deque <Real>> ();
-        auto allocate_A_properties = grow_matrix <Real> (
-            check_A_properties ? orthog_storage_max : 0,
-            A_properties);
+        auto innr_Bdxs_ABdx = std::vector <Real> ();
+        auto innr_ABdxs_Bdx = std::vector <Real> ();
         auto update_A_properties = [&]() {
-            // Allocate additional memory when required
-            allocate_A_properties();
-
             // Exit if we're not doing the check 
-            if(!check_A_properties) return;
+            if(!check_A_properties || nBdxs==0) return;
+
+            // Allocate additional memory when required
+            while(A_properties.size() < nBdxs) {
+                for(auto & row : A_properties)
+                    row.emplace_back(Real(0.));
+                A_properties.emplace_back(
+                    std::deque <Real> (A_properties.size()+1,Real(0.)));
+            }
             
+            // Find the inner products between the newest direction and all
+            // of the stored directions.  The stored directions are
+            // normalized, so we normalize the newest one to match.
+            innr_Bdxs_ABdx.resize(nBdxs);
+            innr_ABdxs_Bdx.resize(nBdxs);
+            Vs::innr(nBdxs,Bdxs,ABdx,innr_Bdxs_ABdx.data());
+            Vs::innr(nBdxs,ABdxs,Bdx,innr_ABdxs_Bdx.data());
+            for(auto j = Natural(0);j<nBdxs;j++) {
+                innr_Bdxs_ABdx[j] /= Anorm_Bdx;
+                innr_ABdxs_Bdx[j] /= Anorm_Bdx;
+            }
+
             // Update the elements
-            auto i = Bdxs.size()-1;
+            auto const i = Bdxs_last;
             A_properties[i][i] = Real(0.);
-            auto ele = [&](auto const & i,auto const & j) {
-                return X::innr(ABdxs[i],Bdxs[j])/(norm_ABdxs[i]*norm_Bdxs[j]);
-            };
-            for(auto j = Natural(0);j<i;j++) {
-                A_properties[i][j]=ele(i,j);
-                A_properties[j][i]=ele(j,i);
+            for(auto j = Natural(0);j<nBdxs;j++) {
+                if(j==i) continue;
+                A_properties[i][j] = innr_Bdxs_ABdx[j]
+                    / (norm_ABdxs[i]*norm_Bdxs[j]);
+                A_properties[j][i] = innr_ABdxs_Bdx[j]
+                    / (norm_ABdxs[j]*norm_Bdxs[i]);
             }
         };
         auto is_A_symmetric = [&]() {
@@ -1551,7 +2066,7 @@ namespace Optizelle {
         // Allocate memory for the shifted iterate, x + x_offset.  Generally,
         // we care if this quantity violates the safeguard or the trust-region,
         // not whether x does directly
-        auto shifted_iterate = X::init(x);
+        auto & shifted_iterate = loan.vector(x);
         X::copy(x_offset,shifted_iterate);
         auto norm_shifted_iterate =
             std::sqrt(X::innr(shifted_iterate,shifted_iterate));
@@ -1567,7 +2082,7 @@ namespace Optizelle {
         // Verify that x_offset obeys the safeguard.  This insures that our
         // initial iterate obeys the safeguard, which we need in order to exit
         // with a safe step later.  If it does not, we exit.
-        auto zero = X::init(x);
+        auto & zero = loan.vector(x);
         X::zero(zero);
         if(safeguard(zero,x_offset)<Real(1.)) {
             stop = TruncatedStop::OffsetViolatesSafeguard;
@@ -1575,8 +2090,7 @@ namespace Optizelle {
         }
 
         // Find the initial residual, r = A*x-b = -b, and projected residual, Br
-        X::copy(b,r);
-        X::scal(Real(-1.),r);
+        XF::copy_scal(Real(-1.),b,r);
         B.eval(r,Br);
         norm_r = std::sqrt(X::innr(r,r));
         norm_Br0 = std::sqrt(X::innr(Br,Br));
@@ -1590,15 +2104,14 @@ namespace Optizelle {
         }
 
         // Find the projected search direction 
-        X::copy(Br,Bdx);
-        X::scal(Real(-1.),Bdx);
+        XF::copy_scal(Real(-1.),Br,Bdx);
        
         // Allocate memory for the shifted trial step
         //
         // || (x + x_offset) + alpha Bdx ||
         //
         // and its norm
-        auto shifted_trial = X::init(x);
+        auto & shifted_trial = loan.vector(x);
         auto norm_shifted_trial = std::numeric_limits <Real>::quiet_NaN();
         
         // Track the number of iterations in a row where we violated the
@@ -1614,11 +2127,11 @@ namespace Optizelle {
         //
         // 2. Acutally be able to calculate a point between this safe point
         //    and whereever the algorithm currently is
-        auto x_safe = X::init(x);                    // Last safe iterate
-        auto r_safe = X::init(x);                    // Last safe residual
-        auto shifted_iterate_safe = X::init(x); // For finding a new safe step 
-        auto Bdx_safe = X::init(x);    // For new iterate, x = x + alpha Bdx
-        auto ABdx_safe = X::init(x);   // For new residual, r = r + alpha ABdx
+        auto & x_safe = loan.vector(x);               // Last safe iterate
+        auto & r_safe = loan.vector(x);               // Last safe residual
+        auto & shifted_iterate_safe = loan.vector(x); // For a new safe step 
+        auto & Bdx_safe = loan.vector(x);  // For new iterate, x = x + alpha Bdx
+        auto & ABdx_safe = loan.vector(x); // New residual, r = r + alpha ABdx
 
         // Archives a set of safe iterate information 
         auto archive_iterate = [&]() {
@@ -1637,10 +2150,8 @@ namespace Optizelle {
         auto archive_direction = [&](auto const & alpha) {
             // If the direction looks good, keep it
             if(stop == TruncatedStop::NotConverged) {
-                X::copy(Bdx,Bdx_safe);
-                X::scal(alpha,Bdx_safe);
-                X::copy(ABdx,ABdx_safe);
-                X::scal(alpha,ABdx_safe);
+                XF::copy_scal(alpha,Bdx,Bdx_safe);
+                XF::copy_scal(alpha,ABdx,ABdx_safe);
 
             // If not, dump it
             } else {
@@ -1683,7 +2194,7 @@ namespace Optizelle {
         // for optimization since as long as the CG objective goes down, we
         // know we'll get a positive predicted reduction or a descent
         // direction.
-        auto x_p_ao2Bdx = X::init(x);
+        auto & x_p_ao2Bdx = loan.vector(x);
         auto obj_red = [&](auto const & alpha, bool const & cp=false) {
             // In general, we want this term 
             if(!cp)
@@ -1695,8 +2206,7 @@ namespace Optizelle {
                 X::zero(x_p_ao2Bdx);
 
             // Finish the calculation
-            X::axpy(Real(0.5)*alpha,Bdx,x_p_ao2Bdx);
-            auto red1 = X::innr(ABdx,x_p_ao2Bdx);
+            auto red1 = XF::axpy_innr(Real(0.5)*alpha,Bdx,x_p_ao2Bdx,ABdx);
             auto red2 = X::innr(b,Bdx);
             auto red3 = alpha*(red1-red2);
             return red3;
@@ -1707,16 +2217,18 @@ namespace Optizelle {
         auto step_if_obj_red = [&](auto const & alpha) {
             if(obj_red(alpha) <= Real(0.)) {
                 X::axpy(alpha,Bdx,x);
-                X::axpy(alpha,Bdx,shifted_iterate);
-                X::axpy(alpha,ABdx,r);
+                norm_shifted_iterate = std::sqrt(XF::axpy_innr(
+                    alpha,Bdx,shifted_iterate,shifted_iterate));
+                norm_r=std::sqrt(XF::axpy_innr(alpha,ABdx,r,r));
                 B.eval(r,Br);
-                norm_r=std::sqrt(X::innr(r,r));
                 norm_Br=std::sqrt(X::innr(Br,Br));
-                norm_shifted_iterate =
-                    std::sqrt(X::innr(shifted_iterate,shifted_iterate));
             }
         };
 
+        // Temporaries for checking the safeguard
+        auto & trial = loan.vector(x);
+        auto & sigma_Bdx = loan.vector(x);
+
         // Loop until we converge (or don't)
         iter = 1;
         while(stop == TruncatedStop::NotConverged) {
@@ -1725,7 +2237,8 @@ namespace Optizelle {
             A.eval(Bdx,ABdx);
 
             // Orthogonalize this direction to the previous directions
-            Aorthogonalize <Real,XX> (Bdxs,ABdxs,orthog_iter_max,Bdx,ABdx); 
+            Aorthogonalize <Real,XX> (
+                nBdxs,Bdxs,ABdxs,orthog_iter_max,Bdx,ABdx); 
 
             // Check if this direction is a descent direction.  If it is not,
             // flip it so that it is.  In truth, this really shouldn't ever
@@ -1760,7 +2273,6 @@ namespace Optizelle {
 
                 // Store our history
                 archive_Bdx();
-                archive_ABdx();
                 archive_r();
                 archive_Br();
                 
@@ -1802,9 +2314,8 @@ namespace Optizelle {
                 // We use this to determine if we've stepped outside the
                 // trust-region radius.
                 X::copy(shifted_iterate,shifted_trial);
-                X::axpy(alpha,Bdx,shifted_trial);
-                norm_shifted_trial = std::sqrt(
-                    X::innr(shifted_trial,shifted_trial));
+                norm_shifted_trial = std::sqrt(XF::axpy_innr(
+                    alpha,Bdx,shifted_trial,shifted_trial));
 
                 // Check if we've met or exceeded the trust-region radius
                 if(norm_shifted_trial >= delta)
@@ -1883,7 +2394,6 @@ namespace Optizelle {
                     // which we assume to be a safe starting place.  In any
                     // case, if the new iterate is safe, set safeguard_failed
                     // to zero and let the code take the step down below.
-                    auto trial = X::init(x);
                     X::copy(x,trial);
                     X::axpy(sigma,Bdx,trial);
                     alpha_safeguard =
@@ -1896,9 +2406,7 @@ namespace Optizelle {
                     // amount truncates us more than sigma, then we reduce the
                     // size of sigma.
                     } else if(safeguard_failed==0) { 
-                        auto sigma_Bdx = X::init(x);
-                        X::copy(Bdx,sigma_Bdx);
-                        X::scal(sigma,sigma_Bdx);
+                        XF::copy_scal(sigma,Bdx,sigma_Bdx);
                         alpha_safeguard = std::min(
                             safeguard(shifted_iterate,sigma_Bdx),Real(1.0));
 
@@ -1945,13 +2453,11 @@ namespace Optizelle {
             // If this is the first iteration and the Cauchy-point reduces the
             // CG objective, save it.
             if(iter==1 && obj_red(alpha*alpha_safeguard,true)) {
-                X::copy(x,x_cp);
-                X::scal(alpha_safeguard,x_cp);
+                XF::copy_scal(alpha_safeguard,x,x_cp);
             }
 
             // Find the projected steepest descent direction
-            X::copy(Br,Bdx);
-            X::scal(Real(-1.),Bdx);	
+            XF::copy_scal(Real(-1.),Br,Bdx);
 
             // If we have a NaN in the preconditioner, exit 
             if(norm_Br!=norm_Br)
@@ -1997,43 +2503,750 @@ namespace Optizelle {
         }
     }
 
-    // Solve a 2x2 linear system in packed storage.  This is done through
-    // Gaussian elimination with complete pivoting.  In addition, this assumes
-    // that the system is nonsingular.
+    // Computes truncated CG as above, but with its own workspace
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    void truncated_cg(
+        Operator <Real,XX,XX> const & A,
+        typename XX <Real>::Vector const & b,
+        Operator <Real,XX,XX> const & B,
+        Real const & eps,
+        Natural const & iter_max,
+        Natural const & orthog_storage_max,
+        Natural const & orthog_iter_max,
+        Real const & delta,
+        typename XX <Real>::Vector const & x_offset,
+        Natural const & safeguard_failed_max,
+        SafeguardSimplified <Real,XX> const & safeguard,
+	bool const & check_B_projector,
+	bool const & check_B_properties,
+	bool const & check_A_properties,
+        typename XX <Real>::Vector & x,
+        typename XX <Real>::Vector & x_cp,
+        Real & norm_Br0,
+        Real & norm_Br,
+        Natural & iter,
+        TruncatedStop::t & stop,
+        Natural & safeguard_failed,
+        Real & alpha_safeguard
+    ){
+        Workspace <Real,XX> work;
+        truncated_cg <Real,XX> (A,b,B,eps,iter_max,orthog_storage_max,
+            orthog_iter_max,delta,x_offset,safeguard_failed_max,safeguard,
+            check_B_projector,check_B_properties,check_A_properties,x,x_cp,
+            norm_Br0,norm_Br,iter,stop,safeguard_failed,alpha_safeguard,work);
+    }
+
+    // Factors T + lambda I = L diag(d) L' where T is a symmetric tridiagonal
+    // matrix and L is unit lower bidiagonal.  This takes O(k) operations.
     //
-    // (input) A : 2x2 matrix in packed storage.  That's a length 3 vector.
-    //    Note, we pass this in by value, which initiates a copy.  This is
-    //    because we modify the matrix, so we were going to need a copy
-    //    anyway.
-    // (input) b : Vector of length 2.
-    // (output) x : Solution to the linear system.
+    // (input) k : Size of T
+    // (input) D : Diagonal of T, length k
+    // (input) E : Subdiagonal of T, length k-1
+    // (input) lambda : Shift
+    // (output) d : Diagonal of the factorization, length k
+    // (output) l : Subdiagonal of L, length k-1
+    // (return) Whether T + lambda I is positive definite.  When it's not, we
+    //     stop as soon as we find a nonpositive pivot.
     template <typename Real>
-    void solve2x2(
-        std::vector <Real> A,
-        std::vector <Real> b,
-        std::vector <Real> & x
+    bool tridiagonal_ldlt(
+        Natural const & k,
+        std::vector <Real> const & D,
+        std::vector <Real> const & E,
+        Real const & lambda,
+        std::vector <Real> & d,
+        std::vector <Real> & l
     ) {
-        // Find the largest element of A in absolute value.  Store in i.
-        Natural i=0;  Real val=fabs(A[0]);
-        for(Natural j=1;j<=2;j++) {
-            if(fabs(A[j]) < val) {
-                i=j;
-                val=fabs(A[j]);
-            }
+        d.resize(k);
+        l.resize(k > 0 ? k-1 : 0);
+        for(Natural i=0;i<k;i++) {
+            d[i] = D[i] + lambda - (i > 0 ? l[i-1]*E[i-1] : Real(0.));
+
+            // This also catches NaNs
+            if(!(d[i] > Real(0.)))
+                return false;
+            if(i+1 < k)
+                l[i] = E[i]/d[i];
         }
+        return true;
+    }
 
-        // Determine the row and column pivots
-        std::vector <Natural> p(3);
-        std::vector <Natural> q(3);
-        if(i==0) {
-            p[1]=1; p[2]=2;
-            q[1]=1; q[2]=2;
-        } else if(i==1) {
-            p[1]=2; p[2]=1;
-            q[1]=1; q[2]=2;
-        } else {
-            p[1]=2; p[2]=1;
-            q[1]=2; q[2]=1;
+    // Solves (T + lambda I) h = -gamma0 e_1 using the factorization from
+    // tridiagonal_ldlt.
+    //
+    // (input) k : Size of T
+    // (input) d : Diagonal of the factorization, length k
+    // (input) l : Subdiagonal of L, length k-1
+    // (input) gamma0 : Scaling for the right hand side
+    // (output) h : Solution, length k
+    // (output) dnorm_h : <h,inv(T + lambda I) h>, which gives the derivative
+    //     of || h(lambda) ||^2 with respect to lambda as -2 dnorm_h
+    // (return) || h ||
+    template <typename Real>
+    Real tridiagonal_solve(
+        Natural const & k,
+        std::vector <Real> const & d,
+        std::vector <Real> const & l,
+        Real const & gamma0,
+        std::vector <Real> & h,
+        Real & dnorm_h
+    ) {
+        // Solve L y = -gamma0 e_1 and then L' h = inv(diag(d)) y
+        h.resize(k);
+        auto y = -gamma0;
+        for(Natural i=0;i<k;i++) {
+            h[i] = y/d[i];
+            if(i+1 < k)
+                y = -l[i]*y;
+        }
+        for(Natural i=k-1;i>0;i--)
+            h[i-1] -= l[i-1]*h[i];
+
+        // Find || h || and <h,inv(T + lambda I) h> = || inv(sqrt(diag(d)))
+        // inv(L) h ||^2
+        auto norm_h_2 = Real(0.);
+        dnorm_h = Real(0.);
+        auto z = Real(0.);
+        for(Natural i=0;i<k;i++) {
+            norm_h_2 += h[i]*h[i];
+            z = h[i] - (i > 0 ? l[i-1]*z : Real(0.));
+            dnorm_h += z*z/d[i];
+        }
+        return std::sqrt(norm_h_2);
+    }
+
+    // Solves the trust-region subproblem
+    //
+    // min 0.5 <T h,h> + gamma0 h_1  st  || h || <= delta
+    //
+    // where T is a symmetric tridiagonal matrix.  We diagonalize T and then
+    // use Newton's method on the secular equation 1/|| h(lambda) || = 1/delta
+    // where (T + lambda I) h(lambda) = -gamma0 e_1.  When the trust-region is
+    // infinite, we require T to be positive definite.  Diagonalizing T costs
+    // O(k^2) operations, so we only do this for the hard case and otherwise
+    // use trust_region_tridiagonal below.
+    //
+    // (input) k : Size of T
+    // (input) D : Diagonal of T, length k
+    // (input) E : Subdiagonal of T, length k-1
+    // (input) gamma0 : Scaling for the linear term
+    // (input) delta : Trust-region radius
+    // (output) h : Solution, length k
+    // (output) lambda : Lagrange multiplier for the trust-region constraint
+    // (return) Whether we diagonalized T.  When we didn't, we leave h and
+    //     lambda alone.
+    template <typename Real>
+    bool trust_region_tridiagonal_eig(
+        Natural const & k,
+        std::vector <Real> const & D,
+        std::vector <Real> const & E,
+        Real const & gamma0,
+        Real const & delta,
+        std::vector <Real> & h,
+        Real & lambda
+    ) {
+        // Diagonalize T = Z W Z'.  Note, stevr overwrites D and E and requires
+        // E to have length k.
+        auto D_tmp = std::vector <Real> (D.begin(),D.begin()+k);
+        auto E_tmp = std::vector <Real> (k,Real(0.));
+        if(k>1)
+            copy <Real> (k-1,&(E[0]),1,&(E_tmp[0]),1);
+        auto W = std::vector <Real> (k);
+        auto Z = std::vector <Real> (k*k);
+        auto isuppz = std::vector <Integer> (2*k);
+        auto lwork = Integer(20*k);
+        auto work = std::vector <Real> (lwork);
+        auto liwork = Integer(10*k);
+        auto iwork = std::vector <Integer> (liwork);
+        auto nevals = Integer(0);
+        auto info = Integer(0);
+        Optizelle::stevr <Real> ('V','A',k,&(D_tmp[0]),&(E_tmp[0]),Real(0.),
+            Real(0.),0,0,Optizelle::lamch <Real> ('S'),nevals,&(W[0]),
+            &(Z[0]),k,&(isuppz[0]),&(work[0]),lwork,&(iwork[0]),liwork,info);
+        if(info!=0 || nevals!=Integer(k))
+            return false;
+
+        // Find the coefficients of the linear term in the eigenbasis, c = Z'
+        // (gamma0 e_1)
+        auto c = std::vector <Real> (k);
+        for(Natural i=0;i<k;i++)
+            c[i] = gamma0*Z[ijtok(1,i+1,k)];
+
+        // Find || h(lambda) ||^2 and its derivative, which we write in terms
+        // of w_i = -c_i / (W_i + lambda)
+        auto w = std::vector <Real> (k);
+        auto norm_h = [&](auto const & lambda) {
+            auto norm_h_2 = Real(0.);
+            for(Natural i=0;i<k;i++) {
+                w[i] = -c[i]/(W[i]+lambda);
+                norm_h_2 += w[i]*w[i];
+            }
+            return std::sqrt(norm_h_2);
+        };
+
+        // Find the smallest multiplier that makes T + lambda I positive
+        // semidefinite.  When T is positive definite, we try the
+        // unconstrained minimizer first.
+        auto indefinite = W[0] <= Real(0.);
+        lambda = Real(0.);
+        if(indefinite) {
+            lambda = -W[0]
+                + std::sqrt(std::numeric_limits <Real>::epsilon())
+                    * (Real(1.)+std::fabs(W[0]));
+        }
+        auto norm_h_lambda = norm_h(lambda);
+
+        // If we're in the interior or we have no trust region, we're done
+        if( (!indefinite && norm_h_lambda <= delta) ||
+            delta == std::numeric_limits <Real>::infinity()
+        ) {
+            h.resize(k);
+            gemv <Real> ('N',k,k,Real(1.),&(Z[0]),k,&(w[0]),1,Real(0.),
+                &(h[0]),1);
+            return true;
+        }
+
+        // If the solution for the smallest multiplier lies inside the
+        // trust-region, we have the hard case.  Here, we move along the
+        // eigenvector for the smallest eigenvalue until we hit the boundary.
+        if(norm_h_lambda < delta) {
+            auto norm_rest_2 = norm_h_lambda*norm_h_lambda - w[0]*w[0];
+            w[0] = std::sqrt(delta*delta - norm_rest_2);
+            h.resize(k);
+            gemv <Real> ('N',k,k,Real(1.),&(Z[0]),k,&(w[0]),1,Real(0.),
+                &(h[0]),1);
+            return true;
+        }
+
+        // Otherwise, use Newton's method on 1/|| h(lambda) || - 1/delta.
+        // Since this function is concave and increasing, the iterates
+        // increase monotonically toward the root when we start to its left.
+        auto const tol = Real(100.)*std::numeric_limits <Real>::epsilon();
+        for(Natural iter=0;iter<100;iter++) {
+            if(std::fabs(norm_h_lambda-delta) <= tol*delta)
+                break;
+            auto dnorm_h = Real(0.);
+            for(Natural i=0;i<k;i++)
+                dnorm_h += w[i]*w[i]/(W[i]+lambda);
+            lambda += (norm_h_lambda-delta)/delta * norm_h_lambda*norm_h_lambda
+                / dnorm_h;
+            norm_h_lambda = norm_h(lambda);
+        }
+
+        // Transform the solution back, h = Z w
+        h.resize(k);
+        gemv <Real> ('N',k,k,Real(1.),&(Z[0]),k,&(w[0]),1,Real(0.),&(h[0]),1);
+        return true;
+    }
+
+    // Solves the trust-region subproblem
+    //
+    // min 0.5 <T h,h> + gamma0 h_1  st  || h || <= delta
+    //
+    // where T is a symmetric tridiagonal matrix.  We use the safeguarded
+    // Newton method of More and Sorensen on the secular equation
+    // 1/|| h(lambda) || = 1/delta where (T + lambda I) h(lambda) = -gamma0 e_1.
+    // Each step factors T + lambda I, which costs O(k) operations, so GLTR can
+    // resolve this problem every iteration.  Only when we can't find a root,
+    // which is the hard case, do we diagonalize T.  When the trust-region is
+    // infinite, we require T to be positive definite.
+    //
+    // (input) k : Size of T
+    // (input) D : Diagonal of T, length k
+    // (input) E : Subdiagonal of T, length k-1
+    // (input) gamma0 : Scaling for the linear term
+    // (input) delta : Trust-region radius
+    // (output) h : Solution, length k.  When T is indefinite and the
+    //     trust-region is infinite, there's no solution and we leave h alone.
+    // (input/output) lambda : Lagrange multiplier for the trust-region
+    //     constraint.  On input, this is our initial guess, such as the
+    //     multiplier from the previous, smaller Krylov space in GLTR.
+    // (return) Whether T has a nonpositive eigenvalue
+    template <typename Real>
+    bool trust_region_tridiagonal(
+        Natural const & k,
+        std::vector <Real> const & D,
+        std::vector <Real> const & E,
+        Real const & gamma0,
+        Real const & delta,
+        std::vector <Real> & h,
+        Real & lambda
+    ) {
+        // Factorization of T + lambda I and the derivative of the norm
+        auto d = std::vector <Real> ();
+        auto l = std::vector <Real> ();
+        auto dnorm_h = Real(0.);
+
+        // When T is positive definite, try the unconstrained minimizer first
+        auto indefinite = !tridiagonal_ldlt <Real> (k,D,E,Real(0.),d,l);
+        if(!indefinite) {
+            auto norm_h = tridiagonal_solve <Real> (k,d,l,gamma0,h,dnorm_h);
+            if(norm_h <= delta) {
+                lambda = Real(0.);
+                return indefinite;
+            }
+        }
+
+        // Without a trust-region, we can't handle negative curvature
+        if(delta == std::numeric_limits <Real>::infinity()) {
+            lambda = Real(0.);
+            return indefinite;
+        }
+
+        // Bracket the multiplier.  Since the smallest eigenvalue of T is no
+        // larger than any diagonal element, T + lambda_lo I is not positive
+        // definite for smaller lambda.  By Gershgorin, T + lambda_hi I has
+        // eigenvalues at least |gamma0|/delta, so || h(lambda_hi) || <= delta.
+        auto lambda_lo = Real(0.);
+        auto gersh = Real(0.);
+        for(Natural i=0;i<k;i++) {
+            lambda_lo = std::max(lambda_lo,-D[i]);
+            gersh = std::max(gersh,-D[i]
+                + (i > 0 ? std::fabs(E[i-1]) : Real(0.))
+                + (i+1 < k ? std::fabs(E[i]) : Real(0.)));
+        }
+        auto lambda_hi = gersh + std::fabs(gamma0)/delta;
+
+        // Start from our guess when it lies in the bracket.  When we cut
+        // the bracket, we move at least a fraction into it.
+        auto inside = [&]() {
+            return std::max(std::sqrt(lambda_lo*lambda_hi),
+                lambda_lo + Real(0.01)*(lambda_hi-lambda_lo));
+        };
+        lambda = lambda > lambda_lo && lambda < lambda_hi ? lambda : inside();
+
+        // Newton's method on 1/|| h(lambda) || - 1/delta.  We shrink the
+        // bracket as we go, which keeps us out of the region where
+        // T + lambda I is indefinite.
+        auto const tol = Real(100.)*std::numeric_limits <Real>::epsilon();
+        for(Natural iter=0;iter<100;iter++) {
+            // When T + lambda I is indefinite, lambda is too small
+            if(!tridiagonal_ldlt <Real> (k,D,E,lambda,d,l)) {
+                lambda_lo = lambda;
+                lambda = inside();
+                continue;
+            }
+
+            // Check for convergence
+            auto norm_h = tridiagonal_solve <Real> (k,d,l,gamma0,h,dnorm_h);
+            if(std::fabs(norm_h-delta) <= tol*delta)
+                return indefinite;
+
+            // Otherwise, update the bracket and take a Newton step when it
+            // stays inside
+            if(norm_h < delta)
+                lambda_hi = lambda;
+            else
+                lambda_lo = lambda;
+            lambda += (norm_h-delta)/delta * norm_h*norm_h / dnorm_h;
+            if(!(lambda > lambda_lo && lambda < lambda_hi))
+                lambda = inside();
+
+            // If the bracket collapses, we're in the hard case where the
+            // root lies at or to the left of the smallest eigenvalue
+            if(lambda_hi-lambda_lo <= tol*lambda_hi)
+                break;
+        }
+
+        // In the hard case, diagonalize T.  If that fails, fall back to the
+        // upper bound of the bracket, which still gives a step inside the
+        // trust-region.
+        if(!trust_region_tridiagonal_eig <Real> (k,D,E,gamma0,delta,h,lambda)){
+            lambda = lambda_hi;
+            tridiagonal_ldlt <Real> (k,D,E,lambda,d,l);
+            tridiagonal_solve <Real> (k,d,l,gamma0,h,dnorm_h);
+        }
+        return indefinite;
+    }
+
+    // Forms the solution x = Q h of GLTR from the Lanczos vectors and the
+    // solution of the tridiagonal subproblem.  Then, truncate it to meet the
+    // safeguard.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    void gltr_solution(
+        typename MultiVectors <Real,XX>::t const & qs,
+        std::vector <Real> const & h,
+        SafeguardSimplified <Real,XX> const & safeguard,
+        typename XX <Real>::Vector & x,
+        Natural & safeguard_failed,
+        Real & alpha_safeguard,
+        Workspace <Real,XX> & work
+    ) {
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef MultiVectors <Real,XX> Vs;
+
+        // Borrow our temporaries from the workspace
+        typename Workspace <Real,XX>::Loan loan(work);
+
+        // x = Q h
+        X::zero(x);
+        Vs::axpy(h.size(),h.data(),qs,x);
+
+        // Truncate the solution
+        auto & zero = loan.vector(x);
+        X::zero(zero);
+        safeguard_failed = 0;
+        alpha_safeguard = std::min(safeguard(zero,x),Real(1.));
+        if(alpha_safeguard < Real(1.)) {
+            X::scal(alpha_safeguard,x);
+            safeguard_failed = 1;
+        }
+    }
+
+    // Computes the generalized Lanczos trust-region (GLTR) method in order
+    // to solve
+    //
+    // min 0.5 <Ax,x> - <b,x> st || x ||_inv(B) <= delta
+    //
+    // Unlike truncated CG, we don't stop when we hit the trust-region boundary
+    // or detect negative curvature.  Rather, we continue to build the Krylov
+    // space and solve the trust-region subproblem restricted to this space
+    // using its tridiagonal representation.  This gives a better step on
+    // nonconvex problems at the cost of storing all of the Lanczos vectors.
+    // Note, the trust-region is measured in the norm induced by the inverse
+    // of the preconditioner, which is the usual norm when B is the identity.
+    // The parameters are as follows.
+    //
+    // (input) A : Operator in the system A x = b
+    // (input) b : Right hand side in the system A x = b
+    // (input) B : Symmetric, positive definite preconditioner
+    // (input) eps : Stopping tolerance
+    // (input) iter_max :  Maximum number of iterations
+    // (input) delta : Trust region radius.  If this number is infinity, we
+    //     stop when we detect negative curvature.
+    // (input) safeguard : Our safeguard function.  We truncate the final
+    //     solution and the Cauchy point to satisfy it.
+    // (output) x : Final solution x
+    // (output) x_cp : The Cauchy-Point, which is defined as the solution x
+    //     after a single iteration
+    // (output) norm_Br0 : The norm || r ||_B of the initial residual
+    // (output) norm_Br : An estimate of the norm || r ||_B of the final
+    //     residual for the trust-region subproblem
+    // (output) iter : The number of iterations required to converge.
+    // (output) stop : The reason why the method was terminated
+    // (output) safeguard_failed : Whether we truncated the solution due to
+    //     the safeguard
+    // (output) alpha_safeguard : Amount we truncated the solution
+    // (output) qs : The Lanczos vectors that span the Krylov space
+    // (output) D : Diagonal of the Lanczos tridiagonal matrix
+    // (output) E : Subdiagonal of the Lanczos tridiagonal matrix
+    // (input/output) work : Workspace for the temporaries
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    void gltr(
+        Operator <Real,XX,XX> const & A,
+        typename XX <Real>::Vector const & b,
+        Operator <Real,XX,XX> const & B,
+        Real const & eps,
+        Natural const & iter_max,
+        Real const & delta,
+        SafeguardSimplified <Real,XX> const & safeguard,
+        typename XX <Real>::Vector & x,
+        typename XX <Real>::Vector & x_cp,
+        Real & norm_Br0,
+        Real & norm_Br,
+        Natural & iter,
+        TruncatedStop::t & stop,
+        Natural & safeguard_failed,
+        Real & alpha_safeguard,
+        typename MultiVectors <Real,XX>::t & qs,
+        std::vector <Real> & D,
+        std::vector <Real> & E,
+        Workspace <Real,XX> & work
+    ){
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef MultiVectors <Real,XX> Vs;
+        typedef FusedOps <Real,XX> XF;
+
+        // Borrow our temporaries from the workspace
+        typename Workspace <Real,XX>::Loan loan(work);
+
+        // Initialize the solution and Cauchy point to zero
+        X::zero(x);
+        X::zero(x_cp);
+        iter = 0;
+        stop = TruncatedStop::NotConverged;
+        safeguard_failed = 0;
+        alpha_safeguard = Real(1.);
+        Vs::resize(x,0,qs);
+        D.clear();
+        E.clear();
+
+        // Residuals from the last two iterations, g_old and g, where g_0 = -b.
+        // These are the Lanczos vectors scaled by gamma and live in the dual
+        // space.
+        auto & g_old = loan.vector(x);
+        auto & g = loan.vector(x);
+        X::zero(g_old);
+        XF::copy_scal(Real(-1.),b,g);
+
+        // Preconditioned residual, Bg, and the Lanczos vectors q = Bg / gamma
+        // where gamma = sqrt(<g,Bg>).  These are B^{-1}-orthonormal.
+        auto & Bg = loan.vector(x);
+        B.eval(g,Bg);
+        auto gamma = std::sqrt(X::innr(g,Bg));
+        auto gamma_old = Real(1.);
+        norm_Br0 = gamma;
+        norm_Br = gamma;
+        if(gamma!=gamma) {
+            stop = TruncatedStop::NanPreconditioner;
+            return;
+        }
+        if(gamma == Real(0.)) {
+            stop = TruncatedStop::RelativeErrorSmall;
+            return;
+        }
+        auto & q = loan.vector(x);
+        auto & Aq = loan.vector(x);
+
+        // Solution of the tridiagonal trust-region subproblem.  Each solve
+        // starts from the multiplier of the last one, which is usually close.
+        auto h = std::vector <Real> ();
+        auto h_old = std::vector <Real> ();
+        auto lambda = Real(0.);
+
+        // Loop until we converge (or don't)
+        while(stop == TruncatedStop::NotConverged) {
+            iter++;
+
+            // Store the next Lanczos vector
+            XF::copy_scal(Real(1.)/gamma,Bg,q);
+            Vs::resize(x,iter,qs);
+            Vs::copy(q,iter-1,qs);
+
+            // Find the next residual,
+            //
+            // g_new = A q - (delta/gamma) g - (gamma/gamma_old) g_old,
+            //
+            // where delta = <q,Aq>.  We orthogonalize against g_old first as
+            // in modified Gram-Schmidt and store the result in g_old.
+            A.eval(q,Aq);
+            XF::axpby(Real(1.),Aq,-gamma/gamma_old,g_old);
+            D.emplace_back(X::innr(q,g_old));
+            if(D.back()!=D.back()) {
+                stop = TruncatedStop::NanOperator;
+                iter--;
+                break;
+            }
+            X::axpy(-D.back()/gamma,g,g_old);
+            std::swap(g,g_old);
+
+            // Find the norm of the new residual
+            B.eval(g,Bg);
+            gamma_old = gamma;
+            auto gamma_2 = X::innr(g,Bg);
+            if(gamma_2!=gamma_2) {
+                stop = TruncatedStop::NanPreconditioner;
+                iter--;
+                break;
+            }
+            gamma = gamma_2 > Real(0.) ? std::sqrt(gamma_2) : Real(0.);
+
+            // Solve the trust-region subproblem on the Krylov space
+            std::swap(h,h_old);
+            auto indefinite = trust_region_tridiagonal <Real> (
+                iter,D,E,norm_Br0,delta,h,lambda);
+
+            // Without a trust-region, we can't handle negative curvature.
+            // Keep the last solution or, on the first iteration, take a unit
+            // step in the preconditioned steepest-descent direction.
+            if(indefinite && delta == std::numeric_limits <Real>::infinity()){
+                stop = TruncatedStop::NegativeCurvature;
+                std::swap(h,h_old);
+                if(iter==1) {
+                    h.assign(1,-norm_Br0);
+                    XF::copy_scal(h[0],q,x_cp);
+                }
+                break;
+            }
+
+            // On the first iteration, save the Cauchy-point
+            if(iter==1)
+                XF::copy_scal(h[0],q,x_cp);
+
+            // Estimate the norm of the residual for the trust-region
+            // subproblem, which is gamma | h_k |.  A zero gamma means that
+            // we've found an invariant subspace.
+            norm_Br = gamma*std::fabs(h.back());
+            if(norm_Br <= eps*norm_Br0 || gamma == Real(0.))
+                stop = lambda > Real(0.) ?
+                    TruncatedStop::ConvergedOnBoundary :
+                    TruncatedStop::RelativeErrorSmall;
+            else if(iter>=iter_max)
+                stop = TruncatedStop::MaxItersExceeded;
+            else
+                E.emplace_back(gamma);
+        }
+
+        // Trim the Krylov space to the one that defines our solution.  This
+        // drops any pieces that we computed after a NaN or negative
+        // curvature.
+        Vs::resize(x,h.size(),qs);
+        D.resize(h.size());
+        E.resize(h.size() > 0 ? h.size()-1 : 0);
+
+        // Form the solution and truncate it to meet the safeguard
+        gltr_solution <Real,XX> (qs,h,safeguard,x,safeguard_failed,
+            alpha_safeguard,work);
+        auto & zero = loan.vector(x);
+        X::zero(zero);
+        X::scal(std::min(safeguard(zero,x_cp),Real(1.)),x_cp);
+    }
+
+    // Computes GLTR as above, but discards the Krylov space
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    void gltr(
+        Operator <Real,XX,XX> const & A,
+        typename XX <Real>::Vector const & b,
+        Operator <Real,XX,XX> const & B,
+        Real const & eps,
+        Natural const & iter_max,
+        Real const & delta,
+        SafeguardSimplified <Real,XX> const & safeguard,
+        typename XX <Real>::Vector & x,
+        typename XX <Real>::Vector & x_cp,
+        Real & norm_Br0,
+        Real & norm_Br,
+        Natural & iter,
+        TruncatedStop::t & stop,
+        Natural & safeguard_failed,
+        Real & alpha_safeguard,
+        Workspace <Real,XX> & work
+    ){
+        typename Workspace <Real,XX>::Loan loan(work);
+        auto D = std::vector <Real> ();
+        auto E = std::vector <Real> ();
+        gltr <Real,XX> (A,b,B,eps,iter_max,delta,safeguard,x,x_cp,norm_Br0,
+            norm_Br,iter,stop,safeguard_failed,alpha_safeguard,
+            loan.multivector(),D,E,work);
+    }
+
+    // Computes GLTR as above, but with its own workspace
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    void gltr(
+        Operator <Real,XX,XX> const & A,
+        typename XX <Real>::Vector const & b,
+        Operator <Real,XX,XX> const & B,
+        Real const & eps,
+        Natural const & iter_max,
+        Real const & delta,
+        SafeguardSimplified <Real,XX> const & safeguard,
+        typename XX <Real>::Vector & x,
+        typename XX <Real>::Vector & x_cp,
+        Real & norm_Br0,
+        Real & norm_Br,
+        Natural & iter,
+        TruncatedStop::t & stop,
+        Natural & safeguard_failed,
+        Real & alpha_safeguard
+    ){
+        Workspace <Real,XX> work;
+        gltr <Real,XX> (A,b,B,eps,iter_max,delta,safeguard,x,x_cp,norm_Br0,
+            norm_Br,iter,stop,safeguard_failed,alpha_safeguard,work);
+    }
+
+    // Resolves the GLTR trust-region subproblem for a new trust-region radius
+    // using the Krylov space from a prior call to GLTR.  This does not apply
+    // the operator or the preconditioner, so it's cheap when we shrink the
+    // trust-region after a rejected step.  The new solution is as good as the
+    // Krylov space allows, but we don't extend it.
+    //
+    // (input) qs : Lanczos vectors from GLTR
+    // (input) D : Diagonal of the Lanczos tridiagonal matrix from GLTR
+    // (input) E : Subdiagonal of the Lanczos tridiagonal matrix from GLTR
+    // (input) norm_Br0 : The norm || b ||_B from GLTR
+    // (input) delta : New trust-region radius
+    // (input) safeguard : Our safeguard function
+    // (output) x : New solution
+    // (input/output) stop : Reason why GLTR was terminated.  We change this
+    //     to ConvergedOnBoundary when the new solution lies on the boundary.
+    // (output) safeguard_failed : Whether we truncated the solution due to
+    //     the safeguard
+    // (output) alpha_safeguard : Amount we truncated the solution
+    // (input/output) work : Workspace for the temporaries
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    void gltr_resolve(
+        typename MultiVectors <Real,XX>::t const & qs,
+        std::vector <Real> const & D,
+        std::vector <Real> const & E,
+        Real const & norm_Br0,
+        Real const & delta,
+        SafeguardSimplified <Real,XX> const & safeguard,
+        typename XX <Real>::Vector & x,
+        TruncatedStop::t & stop,
+        Natural & safeguard_failed,
+        Real & alpha_safeguard,
+        Workspace <Real,XX> & work
+    ) {
+        // Solve the tridiagonal subproblem for the new radius
+        auto h = std::vector <Real> ();
+        auto lambda = Real(0.);
+        if(D.size() > 0)
+            trust_region_tridiagonal <Real> (D.size(),D,E,norm_Br0,delta,h,
+                lambda);
+        if(lambda > Real(0.))
+            stop = TruncatedStop::ConvergedOnBoundary;
+
+        // Form the solution
+        gltr_solution <Real,XX> (qs,h,safeguard,x,safeguard_failed,
+            alpha_safeguard,work);
+    }
+
+    // Solve a 2x2 linear system in packed storage.  This is done through
+    // Gaussian elimination with complete pivoting.  In addition, this assumes
+    // that the system is nonsingular.
+    //
+    // (input) A : 2x2 matrix in packed storage.  That's a length 3 vector.
+    //    Note, we pass this in by value, which initiates a copy.  This is
+    //    because we modify the matrix, so we were going to need a copy
+    //    anyway.
+    // (input) b : Vector of length 2.
+    // (output) x : Solution to the linear system.
+    template <typename Real>
+    void solve2x2(
+        std::vector <Real> A,
+        std::vector <Real> b,
+        std::vector <Real> & x
+    ) {
+        // Find the largest element of A in absolute value.  Store in i.
+        Natural i=0;  Real val=fabs(A[0]);
+        for(Natural j=1;j<=2;j++) {
+            if(fabs(A[j]) < val) {
+                i=j;
+                val=fabs(A[j]);
+            }
+        }
+
+        // Determine the row and column pivots
+        std::vector <Natural> p(3);
+        std::vector <Natural> q(3);
+        if(i==0) {
+            p[1]=1; p[2]=2;
+            q[1]=1; q[2]=2;
+        } else if(i==1) {
+            p[1]=2; p[2]=1;
+            q[1]=1; q[2]=2;
+        } else {
+            p[1]=2; p[2]=1;
+            q[1]=2; q[2]=1;
         }
 
         // Do a step of Gaussian elimination
@@ -2160,34 +3373,49 @@ namespace Optizelle {
         }
     }
 
-    // Orthogonalizes a vector x to a list of other xs.  
+    // Orthogonalizes a vector x to the first k vectors in vs.  We use
+    // classical Gram-Schmidt, so that each pass requires a single batched
+    // inner product and axpy, with a second pass to correct for the loss of
+    // orthogonality.  The coefficients are returned in R.
     template <
         typename Real,
         template <typename> class XX
     >
     void orthogonalize(
-        std::list <typename XX <Real>::Vector> const & vs,
+        Natural const & k,
+        typename MultiVectors <Real,XX>::t const & vs,
         typename XX <Real>::Vector & x,
         Real * R
     ) {
         // Create some type shortcuts
-        typedef XX <Real> X;
-        typedef typename X::Vector X_Vector;
+        typedef MultiVectors <Real,XX> Vs;
+
+        // Exit early if there's nothing to orthogonalize against
+        if(k==0) return;
+
+        // Allocate memory for the Gram-Schmidt coefficients
+        std::vector <Real> beta(k);
 
         // Orthogonalize the vectors
-        Natural i=0;
-        for(typename std::list <X_Vector>::const_iterator v=vs.begin();
-            v!=vs.end();
-            v++
-        ) {
-            Real beta=X::innr(*v,x);
-            X::axpy(Real(-1.)*beta,*v,x);
-            R[i] = beta;
-            i++;
+        for(Natural j=0;j<k;j++)
+            R[j] = Real(0.);
+        for(Natural iter=1;iter<=2;iter++) {
+            // beta <- V' x
+            Vs::innr(k,vs,x,beta.data());
+
+            // x <- x - V beta
+            for(Natural j=0;j<k;j++) {
+                R[j] += beta[j];
+                beta[j] = -beta[j];
+            }
+            Vs::axpy(k,beta.data(),vs,x);
         }
     }
 
-    // Solves for the linear solve iterate update dx in the current Krylov space
+    // Solves for the linear solve iterate update dx in the current Krylov space.
+    // When we recycle a subspace, we also remove the recycled directions us
+    // using the k x m matrix of coefficients Bc from orthogonalizing the
+    // Krylov vectors against their images.
     template <
         typename Real,
         template <typename> class XX
@@ -2196,20 +3424,24 @@ namespace Optizelle {
         Natural const & m,
         Real const * const R,
         Real const * const Qt_e1,
-        std::list <typename XX <Real>::Vector> const & vs,
+        typename MultiVectors <Real,XX>::t const & vs,
         Operator <Real,XX,XX> const & B_right,
+        Natural const & k,
+        Real const * const Bc,
+        typename MultiVectors <Real,XX>::t const & us,
         typename XX <Real>::Vector const & x,
-        typename XX <Real>::Vector & dx
+        typename XX <Real>::Vector & dx,
+        Workspace <Real,XX> & work
     ) {
         // Create some type shortcuts
         typedef XX <Real> X;
-        typedef typename X::Vector X_Vector;
         
         // Allocate memory for the solution of the triangular solve 
         std::vector <Real> y(m);
 
-        // Create one temporary element required to solve for the iterate
-        X_Vector V_y(X::init(x));
+        // Borrow one temporary element required to solve for the iterate
+        typename Workspace <Real,XX>::Loan loan(work);
+        auto & V_y = loan.vector(x);
 
         // Solve the system for y
         copy <Real> (m,&(Qt_e1[0]),1,&(y[0]),1);
@@ -2229,21 +3461,25 @@ namespace Optizelle {
 
         // Compute tmp = V y
         X::zero(V_y);
-        typename std::list <X_Vector>::const_iterator vv=vs.begin();
-        for(Natural j=0;j<m;j++) {
-            X::axpy(Real(y[j]),*vv,V_y);
-            vv++;
-        }
+        MultiVectors <Real,XX>::axpy(m,y.data(),vs,V_y);
 
         // Right recondition the above linear combination
         B_right.eval(V_y,dx);
+
+        // Remove the recycled directions, dx <- dx - U Bc y
+        if(k > 0) {
+            std::vector <Real> Bc_y(k);
+            gemv <Real> ('N',k,m,Real(-1.),&(Bc[0]),k,&(y[0]),1,Real(0.),
+                &(Bc_y[0]),1);
+            MultiVectors <Real,XX>::axpy(k,Bc_y.data(),us,dx);
+        }
     }
 
     // Resets the GMRES method.  This does a number of things
     // 1.  Calculates the preconditioned residual.
     // 2.  Finds the norm of the preconditioned residual.
     // 3.  Finds the initial Krylov vector.
-    // 4.  Initializes the list of Krylov vectors.
+    // 4.  Initializes the set of Krylov vectors.
     // 5.  Finds the initial RHS for the least squares system, Q' norm(w1) e1.
     // 6.  Clears out all of the old Givens rotations
     // These steps are required during initialization as well as during a
@@ -2257,7 +3493,8 @@ namespace Optizelle {
         Operator <Real,XX,XX> const & B_left,
         Natural const & rst_freq,
         typename XX <Real>::Vector & v,
-        std::list <typename XX <Real>::Vector> & vs,
+        typename MultiVectors <Real,XX>::t & vs,
+        Natural & nvs,
         typename XX <Real>::Vector & r,
         Real & norm_r,
         std::vector <Real> & Qt_e1,
@@ -2265,6 +3502,7 @@ namespace Optizelle {
     ){
         // Create some type shortcuts
         typedef XX <Real> X;
+        typedef FusedOps <Real,XX> XF;
 
         // Apply the left preconditioner to the true residual.  This
         // completes #1
@@ -2274,14 +3512,12 @@ namespace Optizelle {
         norm_r = std::sqrt(X::innr(r,r));
 
         // Find the initial Krylov vector.  This completes #3.
-        X::copy(r,v);
-        X::scal(Real(1.)/norm_r,v);
+        XF::copy_scal(Real(1.)/norm_r,r,v);
 
-        // Clear memory for the list of Krylov vectors and insert the first
-        // vector.  This completes #4.
-        vs.clear();
-        vs.emplace_back(std::move(X::init(rtrue)));
-        X::copy(v,vs.back());
+        // Reset the Krylov vectors and insert the first vector.  We keep the
+        // memory from before.  This completes #4.
+        nvs = 1;
+        MultiVectors <Real,XX>::copy(v,0,vs);
 
         // Find the initial right hand side for the vector Q' norm(w1) e1.  This
         // completes #5.
@@ -2338,6 +3574,145 @@ namespace Optizelle {
         ) const { } 
     };
 
+    // A subspace that GMRES recycles between solves.  We keep directions U
+    // along with their images C = B_left A U, which we keep orthonormal.
+    // Before a solve, we remove the components of the residual in the range
+    // of C and, during the solve, we keep the Krylov space orthogonal to C.
+    // After each cycle of GMRES, we add its correction to the subspace and,
+    // once full, replace the oldest direction.  This is the truncated GCRO
+    // method of de Sturler.  When the operator changes, mark the subspace
+    // stale, so that we recompute C before the next solve.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct GMRESRecycle {
+        // Disallow constructors
+        NO_COPY_ASSIGNMENT(GMRESRecycle)
+
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef MultiVectors <Real,XX> Vs;
+        typedef typename Vs::t X_MultiVector;
+
+        // Recycled directions, U, and their images, C
+        X_MultiVector us;
+        X_MultiVector cs;
+
+        // Number of directions currently in use
+        Natural size;
+
+        // Position of the oldest direction
+        Natural oldest;
+
+        // Whether C no longer matches the operator
+        bool stale;
+
+        // Number of operator applications used to recompute C
+        Natural refreshes;
+
+        // Start with an empty subspace
+        GMRESRecycle() : us(), cs(), size(0), oldest(0), stale(false),
+            refreshes(0) {}
+
+        // Notes that the operator changed
+        void touch() {
+            stale = size > 0;
+        }
+
+        // Forgets all of the directions
+        void clear() {
+            size = 0;
+            oldest = 0;
+            stale = false;
+        }
+
+        // Adds the direction u along with its image c = B_left A u.  We
+        // overwrite both in the process.  We drop directions whose images
+        // lie in the range of C.
+        void add(Natural const & size_max,X_Vector & u,X_Vector & c) {
+            // If we can't store anything, don't bother
+            if(size_max == 0 || size > size_max)
+                clear();
+            if(size_max == 0)
+                return;
+
+            // Orthogonalize c against C and update u to match
+            auto norm_c0 = std::sqrt(X::innr(c,c));
+            auto coeffs = std::vector <Real> (size);
+            orthogonalize <Real,XX> (size,cs,c,coeffs.data());
+            for(auto & coeff : coeffs)
+                coeff = -coeff;
+            Vs::axpy(size,coeffs.data(),us,u);
+
+            // Normalize the image
+            auto norm_c = std::sqrt(X::innr(c,c));
+            if(!(norm_c > std::sqrt(std::numeric_limits <Real>::epsilon())
+                * norm_c0)
+            )
+                return;
+            X::scal(Real(1.)/norm_c,c);
+            X::scal(Real(1.)/norm_c,u);
+
+            // Store the direction.  Since c is orthogonal to all of C, we can
+            // replace any of the directions and retain orthogonality.
+            auto j = Natural(0);
+            if(size < size_max) {
+                j = size;
+                size++;
+                Vs::resize(u,size,us);
+                Vs::resize(c,size,cs);
+            } else {
+                j = oldest;
+                oldest = (oldest+1) % size_max;
+            }
+            Vs::copy(u,j,us);
+            Vs::copy(c,j,cs);
+        }
+
+        // Recomputes C for the current operator when stale
+        void refresh(
+            Natural const & size_max,
+            Operator <Real,XX,XX> const & A,
+            Operator <Real,XX,XX> const & B_left,
+            X_Vector const & x,
+            Workspace <Real,XX> & work
+        ) {
+            // Borrow our temporaries from the workspace
+            typename Workspace <Real,XX>::Loan loan(work);
+
+            // Rebuild the subspace from the old directions
+            auto n = std::min(size,size_max);
+            if(!stale || n == 0) {
+                stale = false;
+                return;
+            }
+            auto us_old = X_MultiVector();
+            std::swap(us,us_old);
+            clear();
+            auto & u = loan.vector(x);
+            auto & Au = loan.vector(x);
+            auto & c = loan.vector(x);
+            auto e_j = std::vector <Real> (n,Real(0.));
+            for(Natural j=0;j<n;j++) {
+                // u <- U e_j
+                e_j[j] = Real(1.);
+                X::zero(u);
+                Vs::axpy(j+1,e_j.data(),us_old,u);
+                e_j[j] = Real(0.);
+
+                // c <- B_left A u
+                A.eval(u,Au);
+                B_left.eval(Au,c);
+                refreshes++;
+
+                // Add it back in
+                add(size_max,u,c);
+            }
+        }
+    };
+
     // Computes the GMRES algorithm in order to solve A(x)=b.
     // (input) A : Operator that computes A(x)
     // (input) b : Right hand side
@@ -2351,6 +3726,10 @@ namespace Optizelle {
     // (input) B_right : Operator that computes the right preconditioner
     // (input/output) x : Initial guess of the solution.  Returns the final
     //    solution.
+    // (input) recycle_max : Maximum number of directions that we recycle.
+    //    If we don't want recycling, set this to zero.
+    // (input/output) recycle : Recycled subspace from prior solves
+    // (input/output) work : Workspace for the temporaries
     // (return) (norm_rtrue,iter) : Final norm of the true residual and
     //    the number of iterations computed.  They are returned in a STL pair.
     template <
@@ -2366,12 +3745,17 @@ namespace Optizelle {
         Operator <Real,XX,XX> const & B_left,
         Operator <Real,XX,XX> const & B_right,
         GMRESManipulator <Real,XX> const & gmanip,
-        typename XX <Real>::Vector & x
+        typename XX <Real>::Vector & x,
+        Natural const & recycle_max,
+        GMRESRecycle <Real,XX> & recycle,
+        Workspace <Real,XX> & work
     ){
 
         // Create some type shortcuts
         typedef XX <Real> X;
-        typedef typename X::Vector X_Vector;
+
+        // Borrow our temporaries from the workspace
+        typename Workspace <Real,XX>::Loan loan(work);
 
         // Adjust the restart frequency if it is too big
         rst_freq = rst_freq > iter_max ? iter_max : rst_freq;
@@ -2380,16 +3764,16 @@ namespace Optizelle {
         rst_freq = rst_freq == 0 ? iter_max : rst_freq;
 
         // Allocate memory for the residual
-        X_Vector r(X::init(x));
+        auto & r = loan.vector(x);
         
         // Allocate memory for the iterate update 
-        X_Vector dx(X::init(x));
+        auto & dx = loan.vector(x);
         
         // Allocate memory for x + dx 
-        X_Vector x_p_dx(X::init(x));
+        auto & x_p_dx = loan.vector(x);
         
         // Allocate memory for the true residual
-        X_Vector rtrue(X::init(x));
+        auto & rtrue = loan.vector(x);
         
         // Allocate memory for the norm of the true, preconditioned, and
         // original true norm of the residual
@@ -2403,13 +3787,20 @@ namespace Optizelle {
         std::vector <Real> R(rst_freq*(rst_freq+1)/2);
 
         // Allocate memory for the normalized Krylov vector
-        X_Vector v(X::init(x));
+        auto & v = loan.vector(x);
 
         // Allocate memory for w, the orthogonalized, but not normalized vector
-        X_Vector w(X::init(x));
-
-        // Allocate memory for the list of Krylov vectors
-        std::list <X_Vector> vs;
+        auto & w = loan.vector(x);
+
+        // Allocate memory for the Krylov vectors.  We grow this as needed,
+        // but it never holds more than rst_freq+1 vectors.  In addition,
+        // track the number of vectors currently in use and allocated.
+        typedef MultiVectors <Real,XX> Vs;
+        typedef FusedOps <Real,XX> XF;
+        auto & vs = loan.multivector();
+        Natural nvs(0);
+        Natural nvs_alloc(1);
+        Vs::resize(x,nvs_alloc,vs);
 
         // Allocate memory for right hand side of the linear system, the vector
         // Q' norm(w1) e1.  Since we have a problem overdetermined by a single
@@ -2421,20 +3812,69 @@ namespace Optizelle {
         std::list <std::pair<Real,Real> > Qts;
 
         // Allocate a temporary work element
-        X_Vector A_Mrinv_v(X::init(x));
+        auto & A_Mrinv_v = loan.vector(x);
 
         // Allocate memory for the subiteration number of GMRES taking into
         // account restarting
         Natural i(0);
 
+        // Allocate memory for the image of the last correction, which we
+        // add to the recycled subspace
+        auto & c = loan.vector(x);
+
         // Find the true residual and its norm
         A.eval(x,rtrue);
-        X::scal(Real(-1.),rtrue);
-        X::axpy(Real(1.),b,rtrue);
+        XF::axpby(Real(1.),b,Real(-1.),rtrue);
         norm_rtrue = std::sqrt(X::innr(rtrue,rtrue));
 
+        // Remove the part of the preconditioned residual that lies in the
+        // range of the recycled subspace, x <- x + U C' B_left r.  Afterwards,
+        // the new preconditioned residual should be orthogonal to C.  If it's
+        // not, the operator or preconditioner changed without our knowing,
+        // so we recompute C and try again.  If that still fails, we give up
+        // on the subspace.
+        if(recycle_max == 0)
+            recycle.clear();
+        for(Natural pass=1;pass<=2;pass++) {
+            recycle.refresh(recycle_max,A,B_left,x,work);
+            auto const k = recycle.size;
+            if(k == 0)
+                break;
+
+            // Project
+            B_left.eval(rtrue,r);
+            auto norm_r0 = std::sqrt(X::innr(r,r));
+            auto alpha = std::vector <Real> (k);
+            Vs::innr(k,recycle.cs,r,alpha.data());
+            Vs::axpy(k,alpha.data(),recycle.us,x);
+            A.eval(x,rtrue);
+            XF::axpby(Real(1.),b,Real(-1.),rtrue);
+            norm_rtrue = std::sqrt(X::innr(rtrue,rtrue));
+
+            // Check the orthogonality of the new residual.  We measure against
+            // the residual prior to the projection since the new residual may
+            // be down to rounding error.
+            B_left.eval(rtrue,r);
+            Vs::innr(k,recycle.cs,r,alpha.data());
+            auto norm_Ctr = std::sqrt(dot <Real> (k,&(alpha[0]),1,
+                &(alpha[0]),1));
+            auto norm_r1 = std::sqrt(X::innr(r,r));
+            if(norm_Ctr <= std::sqrt(std::numeric_limits <Real>::epsilon())
+                * std::max(norm_r1,norm_r0)
+            )
+                break;
+            recycle.touch();
+            if(pass==2)
+                recycle.clear();
+        }
+        auto k = recycle.size;
+
+        // Allocate memory for the coefficients from orthogonalizing the
+        // Krylov vectors against C
+        std::vector <Real> Bc(recycle_max*rst_freq);
+
         // Initialize the GMRES algorithm
-        resetGMRES<Real,XX> (rtrue,B_left,rst_freq,v,vs,r,norm_r,
+        resetGMRES<Real,XX> (rtrue,B_left,rst_freq,v,vs,nvs,r,norm_r,
             Qt_e1,Qts);
 
         // If for some bizarre reason, we're already optimal, don't do any work 
@@ -2459,18 +3899,30 @@ namespace Optizelle {
             A.eval(w,A_Mrinv_v);
             B_left.eval(A_Mrinv_v,w);
 
-            // Orthogonalize this Krylov vector with respect to the rest
-            orthogonalize <Real,XX> (vs,w,&(R[(i-1)*i/2]));
+            // Orthogonalize this Krylov vector with respect to the recycled
+            // subspace and then the rest
+            Real norm_w0 = k > 0 ? std::sqrt(X::innr(w,w)) : Real(0.);
+            orthogonalize <Real,XX> (k,recycle.cs,w,Bc.data()+(i-1)*k);
+            orthogonalize <Real,XX> (nvs,vs,w,&(R[(i-1)*i/2]));
 
             // Find the norm of the remaining, orthogonalized vector
             Real norm_w = std::sqrt(X::innr(w,w));
 
+            // When recycling, the recycled subspace and the Krylov vectors
+            // may exhaust the space.  In this case, the remaining vector is
+            // rounding error and the current solve is as good as we'll get.
+            bool exhausted = k > 0 && norm_w <= Real(100.)
+                * std::numeric_limits <Real>::epsilon() * norm_w0;
+
             // Normalize the orthogonalized Krylov vector and insert it into the
-            // list of Krylov vectros
-            X::copy(w,v);
-            X::scal(Real(1.)/norm_w,v);
-            vs.emplace_back(std::move(X::init(x)));
-            X::copy(v,vs.back());
+            // set of Krylov vectors
+            XF::copy_scal(Real(1.)/norm_w,w,v);
+            nvs++;
+            if(nvs > nvs_alloc) {
+                nvs_alloc = nvs;
+                Vs::resize(x,nvs_alloc,vs);
+            }
+            Vs::copy(v,nvs-1,vs);
 
             // Apply the existing Givens rotations to the new column of R
             Natural j=1;
@@ -2504,14 +3956,14 @@ namespace Optizelle {
             bool nan_detected = false;
             for(Natural ii = 0;ii <= 1;ii++) { 
                 // Solve for the new iterate update
-                solveInKrylov <Real,XX> (i,&(R[0]),&(Qt_e1[0]),vs,B_right,x,dx);
+                solveInKrylov <Real,XX> (i,&(R[0]),&(Qt_e1[0]),vs,B_right,
+                    k,Bc.data(),recycle.us,x,dx,work);
 
                 // Find the current iterate, its residual, the residual's norm
                 X::copy(x,x_p_dx);
                 X::axpy(Real(1.),dx,x_p_dx);
                 A.eval(x_p_dx,rtrue);
-                X::scal(Real(-1.),rtrue);
-                X::axpy(Real(1.),b,rtrue);
+                XF::axpby(Real(1.),b,Real(-1.),rtrue);
                 norm_rtrue = std::sqrt(X::innr(rtrue,rtrue));
 
                 // If our residual is real, quit
@@ -2522,7 +3974,7 @@ namespace Optizelle {
                 // during the last iteration, so eliminate the last vector and
                 // quit
                 else {
-                    vs.pop_back();
+                    nvs--;
                     if ( iter > 0 ) { iter--; }
                     if ( i    > 0 ) { i--; }
                     nan_detected=true;
@@ -2540,6 +3992,9 @@ namespace Optizelle {
             // is small
             if(norm_rtrue <= eps) break;	
 
+            // Exit if we can't make any further progress
+            if(exhausted) break;
+
             // If we've hit the restart frequency, reset the Krylov spaces and
             // factorizations
             if(i%rst_freq==0) {
@@ -2547,9 +4002,17 @@ namespace Optizelle {
                 // Move to the new iterate
                 X::copy(x_p_dx,x);
 
-                // Reset the GMRES algorithm
-                resetGMRES<Real,XX> (rtrue,B_left,rst_freq,v,vs,r,norm_r,
-                    Qt_e1,Qts);
+                // Reset the GMRES algorithm.  The correction from this cycle
+                // has image B_left A dx, which is the difference between the
+                // old and new preconditioned residuals.  Recycle it.
+                X::copy(r,c);
+                resetGMRES<Real,XX> (rtrue,B_left,rst_freq,v,vs,nvs,r,
+                    norm_r,Qt_e1,Qts);
+                if(recycle_max > 0) {
+                    X::axpy(Real(-1.),r,c);
+                    recycle.add(recycle_max,dx,c);
+                    k = recycle.size;
+                }
        
                 // Make sure to correctly indicate that we're now working on
                 // iteration 0 of the next round of GMRES.  If we exit
@@ -2565,28 +4028,344 @@ namespace Optizelle {
         // As long as we didn't just solve for our new iterate, go ahead and
         // solve for it now.
         if(i > 0){ 
-            solveInKrylov <Real,XX> (i,&(R[0]),&(Qt_e1[0]),vs,B_right,x,dx);
+            solveInKrylov <Real,XX> (i,&(R[0]),&(Qt_e1[0]),vs,B_right,
+                k,Bc.data(),recycle.us,x,dx,work);
             X::axpy(Real(1.),dx,x);
+
+            // Recycle the correction from the final cycle as long as its
+            // residual is well defined
+            if(recycle_max > 0 && norm_rtrue==norm_rtrue) {
+                B_left.eval(rtrue,c);
+                XF::axpby(Real(1.),r,Real(-1.),c);
+                recycle.add(recycle_max,dx,c);
+            }
         }
 
         // Return the norm and the residual
         return std::pair <Real,Natural> (norm_rtrue,iter);
     }
+
+    // Computes GMRES as above, but without recycling
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    std::pair <Real,Natural> gmres(
+        Operator <Real,XX,XX> const & A,
+        typename XX <Real>::Vector const & b,
+        Real eps,
+        Natural iter_max,
+        Natural rst_freq,
+        Operator <Real,XX,XX> const & B_left,
+        Operator <Real,XX,XX> const & B_right,
+        GMRESManipulator <Real,XX> const & gmanip,
+        typename XX <Real>::Vector & x,
+        Workspace <Real,XX> & work
+    ){
+        GMRESRecycle <Real,XX> recycle;
+        return gmres <Real,XX> (A,b,eps,iter_max,rst_freq,B_left,B_right,
+            gmanip,x,0,recycle,work);
+    }
     
+    // Computes GMRES as above, but with its own workspace
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    std::pair <Real,Natural> gmres(
+        Operator <Real,XX,XX> const & A,
+        typename XX <Real>::Vector const & b,
+        Real eps,
+        Natural iter_max,
+        Natural rst_freq,
+        Operator <Real,XX,XX> const & B_left,
+        Operator <Real,XX,XX> const & B_right,
+        GMRESManipulator <Real,XX> const & gmanip,
+        typename XX <Real>::Vector & x
+    ){
+        Workspace <Real,XX> work;
+        return gmres <Real,XX> (A,b,eps,iter_max,rst_freq,B_left,B_right,
+            gmanip,x,work);
+    }
+
+    // Computes GMRES on several systems, A(x_j)=b_j, that share the operator
+    // A.  Each system runs its own restarted GMRES iteration with its own
+    // stopping tolerance, but we advance the systems together so that every
+    // application of A goes to all of the active systems at once through
+    // A.eval_many.  The arguments match gmres above except
+    // (input) bs : Right hand sides
+    // (input) gmanips : Manipulators for the stopping tolerance of each system
+    // (input/output) xs : Initial guesses of the solutions.  Returns the
+    //    final solutions.
+    // (return) (norm_rtrue,iter) : Final norm of the true residual and the
+    //    number of iterations computed for each system
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    std::vector <std::pair <Real,Natural> > gmres_many(
+        Operator <Real,XX,XX> const & A,
+        std::vector <typename XX <Real>::Vector const *> const & bs,
+        Real const & eps,
+        Natural iter_max,
+        Natural rst_freq,
+        Operator <Real,XX,XX> const & B_left,
+        Operator <Real,XX,XX> const & B_right,
+        std::vector <GMRESManipulator <Real,XX> const *> const & gmanips,
+        std::vector <typename XX <Real>::Vector *> const & xs,
+        Workspace <Real,XX> & work
+    ){
+
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef MultiVectors <Real,XX> Vs;
+        typedef typename Vs::t X_MultiVector;
+        typedef FusedOps <Real,XX> XF;
+
+        // Borrow our temporaries from the workspace
+        typename Workspace <Real,XX>::Loan loan(work);
+
+        // Adjust the restart frequency if it is too big
+        rst_freq = rst_freq > iter_max ? iter_max : rst_freq;
+
+        // Adjust the restart frequency if none is desired.
+        rst_freq = rst_freq == 0 ? iter_max : rst_freq;
+
+        // Everything that GMRES tracks for a single system.  The quantities
+        // match those in gmres above.
+        struct System {
+            X_Vector * r;
+            X_Vector * dx;
+            X_Vector * x_p_dx;
+            X_Vector * rtrue;
+            X_Vector * v;
+            X_Vector * w;
+            X_Vector * A_Mrinv_v;
+            X_MultiVector * vs;
+            Natural nvs;
+            Natural nvs_alloc;
+            std::vector <Real> R;
+            std::vector <Real> Qt_e1;
+            std::list <std::pair<Real,Real> > Qts;
+            Real eps;
+            Real norm_rtrue;
+            Real norm_r;
+            Natural i;
+            Natural iter;
+            bool active;
+        };
+
+        // Setup each of the systems
+        auto const n = bs.size();
+        auto systems = std::vector <System> (n);
+        for(Natural j=0;j<n;j++) {
+            auto & s = systems[j];
+            auto const & x = *(xs[j]);
+            s.r = &(loan.vector(x));
+            s.dx = &(loan.vector(x));
+            s.x_p_dx = &(loan.vector(x));
+            s.rtrue = &(loan.vector(x));
+            s.v = &(loan.vector(x));
+            s.w = &(loan.vector(x));
+            s.A_Mrinv_v = &(loan.vector(x));
+            s.vs = &(loan.multivector());
+            s.nvs = 0;
+            s.nvs_alloc = 1;
+            Vs::resize(x,s.nvs_alloc,*(s.vs));
+            s.R.resize(rst_freq*(rst_freq+1)/2);
+            s.Qt_e1.resize(rst_freq+1);
+            s.eps = eps;
+            s.i = 0;
+            s.iter = 0;
+            s.active = true;
+        }
+
+        // Applies A to the vectors picked out by from for each active system
+        // and stores the result in the vectors picked out by to
+        auto eval_active = [&](
+            std::function <X_Vector const & (Natural const &)> const & from,
+            std::function <X_Vector & (Natural const &)> const & to
+        ) {
+            auto xs_ = std::vector <X_Vector const *> ();
+            auto ys_ = std::vector <X_Vector *> ();
+            for(Natural j=0;j<n;j++)
+                if(systems[j].active) {
+                    xs_.emplace_back(&(from(j)));
+                    ys_.emplace_back(&(to(j)));
+                }
+            if(xs_.size() > 0)
+                A.eval_many(xs_,ys_);
+        };
+
+        // Find the true residuals and their norms
+        eval_active(
+            [&](Natural const & j) -> X_Vector const & {
+                return *(xs[j]); },
+            [&](Natural const & j) -> X_Vector & {
+                return *(systems[j].rtrue); });
+        for(Natural j=0;j<n;j++) {
+            auto & s = systems[j];
+            XF::axpby(Real(1.),*(bs[j]),Real(-1.),*(s.rtrue));
+            s.norm_rtrue = std::sqrt(X::innr(*(s.rtrue),*(s.rtrue)));
+
+            // Initialize the GMRES algorithm
+            resetGMRES<Real,XX> (*(s.rtrue),B_left,rst_freq,*(s.v),*(s.vs),
+                s.nvs,*(s.r),s.norm_r,s.Qt_e1,s.Qts);
+
+            // If for some bizarre reason, we're already optimal, don't do
+            // any work
+            gmanips[j]->eval(0,*(xs[j]),*(bs[j]),s.eps);
+            if(s.norm_rtrue <= s.eps) s.active = false;
+        }
+
+        // Iterate until the maximum iteration
+        for(Natural iter = 1; iter <= iter_max;iter++) {
+
+            // Find the current iterate taking into account restarting
+            auto i = iter % rst_freq;
+            if(i == 0) i = rst_freq;
+
+            // Find the next Krylov vectors
+            for(auto & s : systems)
+                if(s.active)
+                    B_right.eval(*(s.v),*(s.w));
+            eval_active(
+                [&](Natural const & j) -> X_Vector const & {
+                    return *(systems[j].w); },
+                [&](Natural const & j) -> X_Vector & {
+                    return *(systems[j].A_Mrinv_v); });
+            for(Natural j=0;j<n;j++) {
+                auto & s = systems[j];
+                if(!s.active)
+                    continue;
+                s.iter = iter;
+                s.i = i;
+                B_left.eval(*(s.A_Mrinv_v),*(s.w));
+
+                // Orthogonalize this Krylov vector with respect to the rest
+                orthogonalize <Real,XX> (s.nvs,*(s.vs),*(s.w),
+                    &(s.R[(i-1)*i/2]));
+
+                // Find the norm of the remaining, orthogonalized vector
+                Real norm_w = std::sqrt(X::innr(*(s.w),*(s.w)));
+
+                // Normalize the orthogonalized Krylov vector and insert it
+                // into the set of Krylov vectors
+                XF::copy_scal(Real(1.)/norm_w,*(s.w),*(s.v));
+                s.nvs++;
+                if(s.nvs > s.nvs_alloc) {
+                    s.nvs_alloc = s.nvs;
+                    Vs::resize(*(s.v),s.nvs_alloc,*(s.vs));
+                }
+                Vs::copy(*(s.v),s.nvs-1,*(s.vs));
+
+                // Apply the existing Givens rotations to the new column of R
+                Natural jj=1;
+                for(auto const & Qt : s.Qts) {
+                    rot <Real> (1,&(s.R[(jj-1)+(i-1)*i/2]),1,
+                        &(s.R[jj+(i-1)*i/2]),1,Qt.first,Qt.second);
+                    jj++;
+                }
+
+                // Form and apply the new Givens rotation
+                s.Qts.emplace_back(std::pair <Real,Real> ());
+                rotg <Real> (s.R[(i-1)+i*(i-1)/2],norm_w,
+                    s.Qts.back().first,s.Qts.back().second);
+                rot <Real> (1,&(s.R[(i-1)+i*(i-1)/2]),1,
+                    &(norm_w),1,s.Qts.back().first,s.Qts.back().second);
+                rot <Real> (1,&(s.Qt_e1[i-1]),1,&(s.Qt_e1[i]),
+                    1,s.Qts.back().first,s.Qts.back().second);
+                s.norm_r = fabs(s.Qt_e1[i]);
+
+                // Solve for the new iterate update
+                solveInKrylov <Real,XX> (i,&(s.R[0]),&(s.Qt_e1[0]),*(s.vs),
+                    B_right,0,nullptr,*(s.vs),*(xs[j]),*(s.dx),work);
+                X::copy(*(xs[j]),*(s.x_p_dx));
+                X::axpy(Real(1.),*(s.dx),*(s.x_p_dx));
+            }
+
+            // Find the residuals of the new iterates
+            eval_active(
+                [&](Natural const & j) -> X_Vector const & {
+                    return *(systems[j].x_p_dx); },
+                [&](Natural const & j) -> X_Vector & {
+                    return *(systems[j].rtrue); });
+            for(Natural j=0;j<n;j++) {
+                auto & s = systems[j];
+                if(!s.active)
+                    continue;
+                XF::axpby(Real(1.),*(bs[j]),Real(-1.),*(s.rtrue));
+                s.norm_rtrue = std::sqrt(X::innr(*(s.rtrue),*(s.rtrue)));
+
+                // If we detect a NaN, then something has gone terribly wrong
+                // during the last iteration, so eliminate the last vector,
+                // solve once more, and quit.  We do this system on its own.
+                if(s.norm_rtrue!=s.norm_rtrue) {
+                    s.nvs--;
+                    s.iter--;
+                    s.i--;
+                    solveInKrylov <Real,XX> (s.i,&(s.R[0]),&(s.Qt_e1[0]),
+                        *(s.vs),B_right,0,nullptr,*(s.vs),*(xs[j]),*(s.dx),
+                        work);
+                    X::copy(*(xs[j]),*(s.x_p_dx));
+                    X::axpy(Real(1.),*(s.dx),*(s.x_p_dx));
+                    A.eval(*(s.x_p_dx),*(s.rtrue));
+                    XF::axpby(Real(1.),*(bs[j]),Real(-1.),*(s.rtrue));
+                    s.norm_rtrue = std::sqrt(X::innr(*(s.rtrue),*(s.rtrue)));
+                    s.active = false;
+                    continue;
+                }
+
+                // Adjust the stopping tolerance
+                gmanips[j]->eval(i,*(s.x_p_dx),*(bs[j]),s.eps);
+
+                // Determine if we should exit since the norm of the true
+                // residual is small
+                if(s.norm_rtrue <= s.eps) {
+                    s.active = false;
+                    continue;
+                }
+
+                // If we've hit the restart frequency, reset the Krylov spaces
+                // and factorizations
+                if(i%rst_freq==0) {
+                    X::copy(*(s.x_p_dx),*(xs[j]));
+                    resetGMRES<Real,XX> (*(s.rtrue),B_left,rst_freq,*(s.v),
+                        *(s.vs),s.nvs,*(s.r),s.norm_r,s.Qt_e1,s.Qts);
+                    s.i = 0;
+                }
+            }
+        }
+
+        // As long as we didn't just solve for our new iterate, go ahead and
+        // solve for it now.
+        auto result = std::vector <std::pair <Real,Natural> > ();
+        for(Natural j=0;j<n;j++) {
+            auto & s = systems[j];
+            if(s.i > 0) {
+                solveInKrylov <Real,XX> (s.i,&(s.R[0]),&(s.Qt_e1[0]),*(s.vs),
+                    B_right,0,nullptr,*(s.vs),*(xs[j]),*(s.dx),work);
+                X::axpy(Real(1.),*(s.dx),*(xs[j]));
+            }
+            result.emplace_back(s.norm_rtrue,s.iter);
+        }
+        return result;
+    }
+
     // Determines the relative error between two vectors where the second vector
     // may or may not have been initialized.  This is typically used for
     // determining the relative error between a vector and some cached value.
+    // We use x_tmp1 as scratch space, so it must be shaped like x.
     template <typename Real,template <typename> class XX>
     Real rel_err_cached(
         typename XX <Real>::Vector const & x,
-        std::pair <bool,typename XX <Real>::Vector> const & x_cached
+        std::pair <bool,typename XX <Real>::Vector> const & x_cached,
+        typename XX <Real>::Vector & x_tmp1
     ) {
         // Create a type shortcut
         typedef XX <Real> X;
 
-        // Create some workspace
-        typename X::Vector x_tmp1(X::init(x));
-
         // If we've not been cached yet, return infinity
         if(!x_cached.first)
             return std::numeric_limits <Real>::infinity();
@@ -2605,6 +4384,426 @@ namespace Optizelle {
             return rel_err;
         }
     } 
+
+    // Same as above, but we allocate our own scratch space
+    template <typename Real,template <typename> class XX>
+    Real rel_err_cached(
+        typename XX <Real>::Vector const & x,
+        std::pair <bool,typename XX <Real>::Vector> const & x_cached
+    ) {
+        // Create some workspace
+        typename XX <Real>::Vector x_tmp1(XX <Real>::init(x));
+
+        // Find the relative error
+        return rel_err_cached <Real,XX> (x,x_cached,x_tmp1);
+    }
+
+    // Determines whether a vector space stamps its vectors with versions.
+    // Vector spaces opt in by providing the functions
+    //
+    // static Natural version(Vector const & x)
+    // static void touch(Vector & x)
+    //
+    // where version must return a new value each time the vector space
+    // operations change x and touch gives x a new version after anything
+    // else changes it.  In addition, two vectors may only share a version
+    // when they hold the same data, which is easiest to insure by drawing
+    // the versions from next_version.
+    template <typename X,typename = void>
+    struct has_version : std::false_type {};
+    template <typename X>
+    struct has_version <
+        X,
+        typename make_void <decltype(&X::version)>::type
+    > : std::true_type {};
+
+    // Remembers a vector in order to determine later whether it changed.
+    // Mostly, we use this to decide whether a cached computation is stale.
+    // When the vector space stamps its vectors with versions, this check
+    // costs O(1).  Otherwise, we keep a copy of the vector and check the
+    // relative error with rel_err_cached.
+    template <
+        typename Real,
+        template <typename> class XX,
+        bool = has_version <XX <Real> >::value
+    >
+    struct CacheStamp {
+    private:
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // Copy of the vector.  The boolean value denotes whether or not
+        // we've started caching yet.
+        std::pair <bool,X_Vector> x_cached;
+
+    public:
+        // Allocate memory for the copy
+        explicit CacheStamp(X_Vector const & x) :
+            x_cached(false,X::init(x))
+        {}
+
+        // Determines whether x differs from the vector we remembered
+        bool stale(X_Vector const & x) const {
+            return rel_err_cached <Real,XX> (x,x_cached)
+                >= std::numeric_limits <Real>::epsilon()*1e1;
+        }
+
+        // Same as above, but we borrow our scratch space from work
+        bool stale(X_Vector const & x,Workspace <Real,XX> & work) const {
+            typename Workspace <Real,XX>::Loan loan(work);
+            return rel_err_cached <Real,XX> (x,x_cached,loan.vector(x))
+                >= std::numeric_limits <Real>::epsilon()*1e1;
+        }
+
+        // Remembers x
+        void update(X_Vector const & x) {
+            x_cached.first=true;
+            X::copy(x,x_cached.second);
+        }
+    };
+
+    template <typename Real,template <typename> class XX>
+    struct CacheStamp <Real,XX,true> {
+    private:
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // Version of the vector.  Since versions start at 1, 0 denotes
+        // that we've not started caching yet.
+        Natural version;
+
+    public:
+        // We only need the version, so we don't keep a copy
+        explicit CacheStamp(X_Vector const & x) : version(0) {}
+
+        // Determines whether x differs from the vector we remembered
+        bool stale(X_Vector const & x) const {
+            return version==0 || version!=X::version(x);
+        }
+
+        // Same as above.  We don't need any scratch space.
+        bool stale(X_Vector const & x,Workspace <Real,XX> & work) const {
+            return stale(x);
+        }
+
+        // Remembers x
+        void update(X_Vector const & x) {
+            version=X::version(x);
+        }
+    };
+
+    // Gives x a new version after code outside of the vector space
+    // operations, such as a user's function, wrote to it.  When the vector
+    // space doesn't stamp its vectors with versions, there's nothing to do.
+    template <
+        typename Real,
+        template <typename> class XX,
+        bool = has_version <XX <Real> >::value
+    >
+    struct Touch {
+        static void eval(typename XX <Real>::Vector & x) {}
+    };
+
+    template <typename Real,template <typename> class XX>
+    struct Touch <Real,XX,true> {
+        static void eval(typename XX <Real>::Vector & x) {
+            XX <Real>::touch(x);
+        }
+    };
+
+    // Gives access to the coordinates of a vector.  We only know how to do
+    // this when the vector space stores the coordinates in a std::vector.
+    // Otherwise, data returns nullptr.
+    template <typename Real,typename Vector>
+    struct Coordinates {
+        static Real * data(Vector & x) {
+            return nullptr;
+        }
+        static Natural size(Vector const & x) {
+            return 0;
+        }
+    };
+    template <typename Real>
+    struct Coordinates <Real,std::vector <Real> > {
+        static Real * data(std::vector <Real> & x) {
+            return x.data();
+        }
+        static Natural size(std::vector <Real> const & x) {
+            return x.size();
+        }
+    };
+
+    // A sparse m x n matrix in coordinate form.  Entry k holds the value
+    // vals[k] at row rows[k] and column cols[k] where indices start from 0.
+    // We sum repeated entries.
+    template <typename Real>
+    struct SparseMatrix {
+        // Size of the matrix
+        Natural m;
+        Natural n;
+
+        // Location and value of the entries
+        std::vector <Natural> rows;
+        std::vector <Natural> cols;
+        std::vector <Real> vals;
+
+        // Start with an empty matrix
+        SparseMatrix() : m(0), n(0), rows(), cols(), vals() {}
+
+        // Removes all of the entries and sets the size
+        void reset(Natural const & m_,Natural const & n_) {
+            m = m_;
+            n = n_;
+            rows.clear();
+            cols.clear();
+            vals.clear();
+        }
+
+        // Adds the value val at row i and column j
+        void add(Natural const & i,Natural const & j,Real const & val) {
+            rows.emplace_back(i);
+            cols.emplace_back(j);
+            vals.emplace_back(val);
+        }
+    };
+
+    // A sparse LDL' factorization of a symmetric matrix using the up-looking
+    // algorithm from Davis' LDL package.  We don't reorder the matrix, so
+    // this works best on matrices whose factors don't fill in much.
+    template <typename Real>
+    struct SparseLDLT {
+        // Size of the matrix
+        Natural n;
+
+        // Strictly lower triangular factor stored by compressed columns
+        std::vector <Natural> Lp;
+        std::vector <Natural> Li;
+        std::vector <Real> Lx;
+
+        // Diagonal factor
+        std::vector <Real> D;
+
+        // Start with an empty factorization
+        SparseLDLT() : n(0), Lp(), Li(), Lx(), D() {}
+
+        // Factors the n x n symmetric matrix whose upper triangle we store by
+        // compressed columns in Ap, Ai, and Ax.  Returns false if we find a
+        // pivot that is zero relative to the diagonal of the matrix.
+        bool factor(
+            Natural const & n_,
+            std::vector <Natural> const & Ap,
+            std::vector <Natural> const & Ai,
+            std::vector <Real> const & Ax
+        ) {
+            // Since indices are unsigned, we mark the lack of a parent with n
+            n = n_;
+            auto const none = n;
+
+            // Find the elimination tree and the number of entries in each
+            // column of L
+            auto parent = std::vector <Natural> (n);
+            auto flag = std::vector <Natural> (n);
+            auto lnz = std::vector <Natural> (n);
+            for(Natural k=0;k<n;k++) {
+                parent[k] = none;
+                flag[k] = k;
+                lnz[k] = 0;
+                for(Natural p=Ap[k];p<Ap[k+1];p++)
+                    for(auto i=Ai[p]; i<k && flag[i]!=k; i=parent[i]) {
+                        if(parent[i]==none)
+                            parent[i] = k;
+                        lnz[i]++;
+                        flag[i] = k;
+                    }
+            }
+            Lp.assign(n+1,0);
+            for(Natural k=0;k<n;k++)
+                Lp[k+1] = Lp[k] + lnz[k];
+            Li.resize(Lp[n]);
+            Lx.resize(Lp[n]);
+            D.resize(n);
+
+            // Compute the factorization one row at a time
+            auto y = std::vector <Real> (n,Real(0.));
+            auto pattern = std::vector <Natural> (n);
+            for(Natural k=0;k<n;k++) {
+                // Scatter the column k of A into y and find the pattern of
+                // row k of L
+                auto top = n;
+                flag[k] = k;
+                lnz[k] = 0;
+                auto A_kk = Real(0.);
+                for(Natural p=Ap[k];p<Ap[k+1];p++) {
+                    auto i = Ai[p];
+                    if(i > k)
+                        continue;
+                    y[i] += Ax[p];
+                    if(i == k)
+                        A_kk += Ax[p];
+                    Natural len = 0;
+                    for(; flag[i]!=k; i=parent[i]) {
+                        pattern[len++] = i;
+                        flag[i] = k;
+                    }
+                    while(len > 0)
+                        pattern[--top] = pattern[--len];
+                }
+
+                // Solve for row k of L and the pivot
+                D[k] = y[k];
+                y[k] = Real(0.);
+                for(; top<n; top++) {
+                    auto i = pattern[top];
+                    auto y_i = y[i];
+                    y[i] = Real(0.);
+                    auto p_end = Lp[i] + lnz[i];
+                    for(auto p=Lp[i];p<p_end;p++)
+                        y[Li[p]] -= Lx[p]*y_i;
+                    auto L_ki = y_i / D[i];
+                    D[k] -= L_ki*y_i;
+                    Li[p_end] = k;
+                    Lx[p_end] = L_ki;
+                    lnz[i]++;
+                }
+
+                // Check the pivot
+                if(std::fabs(D[k]) <= Real(n)
+                    * std::numeric_limits <Real>::epsilon() * std::fabs(A_kk)
+                )
+                    return false;
+            }
+            return true;
+        }
+
+        // Factors A A' for the sparse m x n matrix A.  Returns false if we
+        // find a zero pivot, which generally means that A doesn't have full
+        // row rank.
+        bool factor_aat(SparseMatrix <Real> const & A) {
+            // Store A by rows and by columns
+            auto const m = A.m;
+            auto const nnz = A.vals.size();
+            auto rp = std::vector <Natural> (m+1,0);
+            auto cp = std::vector <Natural> (A.n+1,0);
+            for(Natural p=0;p<nnz;p++) {
+                rp[A.rows[p]+1]++;
+                cp[A.cols[p]+1]++;
+            }
+            for(Natural i=0;i<m;i++)
+                rp[i+1] += rp[i];
+            for(Natural j=0;j<A.n;j++)
+                cp[j+1] += cp[j];
+            auto rj = std::vector <Natural> (nnz);
+            auto rx = std::vector <Real> (nnz);
+            auto ci = std::vector <Natural> (nnz);
+            auto cx = std::vector <Real> (nnz);
+            {
+                auto rnext = rp;
+                auto cnext = cp;
+                for(Natural p=0;p<nnz;p++) {
+                    auto q = rnext[A.rows[p]]++;
+                    rj[q] = A.cols[p];
+                    rx[q] = A.vals[p];
+                    q = cnext[A.cols[p]]++;
+                    ci[q] = A.rows[p];
+                    cx[q] = A.vals[p];
+                }
+            }
+
+            // Form the upper triangle of A A' one column at a time.  Column
+            // k holds the inner products of row k with rows i <= k.
+            auto Bp = std::vector <Natural> (m+1,0);
+            auto Bi = std::vector <Natural> ();
+            auto Bx = std::vector <Real> ();
+            auto w = std::vector <Real> (m,Real(0.));
+            auto mark = std::vector <Natural> (m,m);
+            auto pattern = std::vector <Natural> ();
+            for(Natural k=0;k<m;k++) {
+                pattern.clear();
+                for(Natural p=rp[k];p<rp[k+1];p++) {
+                    auto j = rj[p];
+                    for(Natural q=cp[j];q<cp[j+1];q++) {
+                        auto i = ci[q];
+                        if(i > k)
+                            continue;
+                        if(mark[i] != k) {
+                            mark[i] = k;
+                            w[i] = Real(0.);
+                            pattern.emplace_back(i);
+                        }
+                        w[i] += cx[q]*rx[p];
+                    }
+                }
+                std::sort(pattern.begin(),pattern.end());
+                for(auto const & i : pattern) {
+                    Bi.emplace_back(i);
+                    Bx.emplace_back(w[i]);
+                }
+                Bp[k+1] = Bi.size();
+            }
+
+            // Factor the result
+            return factor(m,Bp,Bi,Bx);
+        }
+
+        // Solves L D L' x = b where x holds b on entry and the solution on
+        // exit
+        void solve(Real * x) const {
+            for(Natural j=0;j<n;j++)
+                for(auto p=Lp[j];p<Lp[j+1];p++)
+                    x[Li[p]] -= Lx[p]*x[j];
+            for(Natural j=0;j<n;j++)
+                x[j] /= D[j];
+            for(Natural j=n;j-- > 0;)
+                for(auto p=Lp[j];p<Lp[j+1];p++)
+                    x[j] -= Lx[p]*x[Li[p]];
+        }
+    };
+
+    // Colors the columns of an m x n sparsity pattern, whose nonzeros lie at
+    // (rows[k],cols[k]), so that no two columns of the same color share a
+    // nonzero row.  Then, a single directional derivative in the sum of the
+    // coordinate directions of a color recovers every column of that color.
+    // We color greedily in the natural order and return the number of
+    // colors.  Indices start from 0.
+    Natural color_columns(
+        Natural const & m,
+        Natural const & n,
+        std::vector <Natural> const & rows,
+        std::vector <Natural> const & cols,
+        std::vector <Natural> & colors);
+
+    // A sparsity pattern of an m x n matrix along with a coloring of its
+    // columns from color_columns.  We remove repeated entries and sort the
+    // entries by column.  Indices start from 0.
+    struct ColoredPattern {
+        // Size of the matrix
+        Natural m;
+        Natural n;
+
+        // Location of the entries
+        std::vector <Natural> rows;
+        std::vector <Natural> cols;
+
+        // Color of each column
+        std::vector <Natural> colors;
+
+        // Entries that belong to each color
+        std::vector <std::vector <Natural> > entries;
+
+        // Colors the pattern with nonzeros at (is[k],js[k]).  When symmetric
+        // is true, we also add the transpose of each entry.
+        ColoredPattern(
+            Natural const & m_,
+            Natural const & n_,
+            std::vector <Natural> const & is,
+            std::vector <Natural> const & js,
+            bool const & symmetric);
+
+        // Number of colors
+        Natural ncolors() const;
+    };
 //---Optizelle2---
 }
 //---Optizelle3---
@@ -133,6 +133,8 @@ namespace Optizelle{
                 return "InvSR1";
             case UserDefined:
                 return "UserDefined";
+            case CompactBFGS:
+                return "CompactBFGS";
             default:
                 throw Exception::t(__LOC__ + ", invalid Operators::t"); 
             }
@@ -156,6 +158,8 @@ namespace Optizelle{
                 return InvSR1; 
             else if(op=="UserDefined")
                 return UserDefined; 
+            else if(op=="CompactBFGS")
+                return CompactBFGS; 
             else
                 throw Exception::t(__LOC__
                     + ", string can't be convert into an Operators::t"); 
@@ -170,7 +174,8 @@ namespace Optizelle{
                 name=="InvBFGS" ||
                 name=="SR1" ||
                 name=="InvSR1" ||
-                name=="UserDefined" 
+                name=="UserDefined" ||
+                name=="CompactBFGS"
             )
                 return true;
             else
@@ -250,6 +255,8 @@ namespace Optizelle{
                 return "TwoPointA";
             case TwoPointB:
                 return "TwoPointB";
+            case ParallelBackTracking:
+                return "ParallelBackTracking";
             default:
                 throw Exception::t(__LOC__
                     + ", invalid LineSearchKind::t"); 
@@ -266,6 +273,8 @@ namespace Optizelle{
                 return TwoPointA; 
             else if(kind=="TwoPointB")
                 return TwoPointB; 
+            else if(kind=="ParallelBackTracking")
+                return ParallelBackTracking; 
             else
                 throw Exception::t(__LOC__
                     + ", string can't be convert into a LineSearchKind::t"); 
@@ -276,7 +285,8 @@ namespace Optizelle{
             if( name=="GoldenSection" ||
                 name=="BackTracking" ||
                 name=="TwoPointA" ||
-                name=="TwoPointB" 
+                name=="TwoPointB" ||
+                name=="ParallelBackTracking"
             )
                 return true;
             else
@@ -289,6 +299,7 @@ namespace Optizelle{
             switch(kind){
             case GoldenSection:
             case BackTracking:
+            case ParallelBackTracking:
                 return true;
             case TwoPointA:
             case TwoPointB:
@@ -638,6 +649,82 @@ namespace Optizelle{
         }
     }
     
+    // Different methods for solving the trust-region subproblem
+    namespace TruncatedSolver{
+
+        // Converts the trust-region subproblem solver to a string
+        std::string to_string(t const & trunc_solver) {
+            switch(trunc_solver){
+            case ConjugateGradient: 
+                return "ConjugateGradient";
+            case Lanczos: 
+                return "Lanczos";
+            default:
+                throw Exception::t(__LOC__+", invalid TruncatedSolver::t"); 
+            }
+        }
+        
+        // Converts a string to the trust-region subproblem solver
+        t from_string(std::string const & trunc_solver) {
+            if(trunc_solver=="ConjugateGradient")
+                return ConjugateGradient; 
+            else if(trunc_solver=="Lanczos")
+                return Lanczos;
+            else
+                throw Exception::t(__LOC__
+                    + ", string can't be convert into a TruncatedSolver::t"); 
+        }
+
+        // Checks whether or not a string is valid
+        bool is_valid(std::string const & name) {
+            if( name=="ConjugateGradient" ||
+                name=="Lanczos"
+            )
+                return true;
+            else
+                return false;
+        }
+    }
+    
+    // Different methods for solving the augmented systems
+    namespace AugmentedSystemSolver{
+
+        // Converts the augmented system solver to a string
+        std::string to_string(t const & augsys_solver) {
+            switch(augsys_solver){
+            case GMRES: 
+                return "GMRES";
+            case Direct: 
+                return "Direct";
+            default:
+                throw Exception::t(__LOC__
+                    + ", invalid AugmentedSystemSolver::t"); 
+            }
+        }
+        
+        // Converts a string to the augmented system solver
+        t from_string(std::string const & augsys_solver) {
+            if(augsys_solver=="GMRES")
+                return GMRES; 
+            else if(augsys_solver=="Direct")
+                return Direct;
+            else
+                throw Exception::t(__LOC__
+                    + ", string can't be convert into a "
+                    + "AugmentedSystemSolver::t"); 
+        }
+
+        // Checks whether or not a string is valid
+        bool is_valid(std::string const & name) {
+            if( name=="GMRES" ||
+                name=="Direct"
+            )
+                return true;
+            else
+                return false;
+        }
+    }
+    
     // Reasons why the quasinormal problem exited
     namespace QuasinormalStop{
 
@@ -783,6 +870,8 @@ namespace Optizelle{
             return atos("Safeguard");
         case TruncatedStop::ObjectiveIncrease:
             return atos("ObjIncr");
+        case TruncatedStop::ConvergedOnBoundary:
+            return atos("ConvBnd");
         default:
             throw Exception::t(__LOC__ + ", invalid TruncatedStop::t");
         }
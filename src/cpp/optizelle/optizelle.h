@@ -8,6 +8,9 @@
 #include<iostream>
 #include<iomanip>
 #include<memory>
+#include<mutex>
+#include<future>
+#include<exception>
 #include<functional>
 #include<algorithm>
 #include<numeric>
@@ -47,6 +50,44 @@ namespace Optizelle{
         virtual void hessvec(Vector const & x,Vector const & dx,Vector & H_dx)
             const = 0;
 
+        // H_dxs[j] = hess f(x) dxs[j] for each j.  By default, we apply
+        // hessvec to each direction in turn.  Functions that can share work
+        // between directions, or that are expensive to call, may override
+        // this.
+        virtual void hessvec_many(
+            Vector const & x,
+            std::vector <Vector const *> const & dxs,
+            std::vector <Vector *> const & H_dxs
+        ) const {
+            for(Natural j=0;j<dxs.size();j++)
+                hessvec(x,*(dxs[j]),*(H_dxs[j]));
+        }
+
+        // Starts computing f(x) and returns a future for its value.  By
+        // default, we defer the call to eval until someone waits on the
+        // future, so nothing runs concurrently.  Functions that can run
+        // their evaluations in the background may override this to return
+        // a future that's already working, which lets the algorithms
+        // overlap them with other independent work, such as a Hessian-vector
+        // product or a constraint evaluation.  Such functions must allow
+        // their other members to run in the meantime.  In either case, x
+        // must remain alive and unchanged until we wait on the future.
+        virtual std::future <Real> eval_async(Vector const & x) const {
+            return std::async(std::launch::deferred,
+                [this,&x]() { return eval(x); });
+        }
+
+        // Starts computing grad = grad f(x) and returns a future that's
+        // ready once grad holds the result.  As with eval_async, we defer
+        // the call to grad by default, and both x and grad must remain
+        // alive and untouched until we wait on the future.
+        virtual std::future <void> grad_async(Vector const & x,Vector & grad)
+            const
+        {
+            return std::async(std::launch::deferred,
+                [this,&x,&grad]() { this->grad(x,grad); });
+        }
+
         // Allow a derived class to deallocate memory
         virtual ~ScalarValuedFunction() {}
     };
@@ -75,6 +116,11 @@ namespace Optizelle{
             return f_x;
         }
 
+        // Computes whatever the merit function needs at x aside from the
+        // objective.  We call this while the objective at x may still be in
+        // progress, so that the two evaluations can overlap.
+        virtual void prepare_merit(Vector const & x) const {}
+
         // Stopping condition modification of the gradient
         virtual void grad_stop(
             Vector const & x,
@@ -170,12 +216,626 @@ namespace Optizelle{
              Y_Vector const & dy,
              X_Vector & z
          ) const = 0;
+
+         // ys[j]=f'(x)dxs[j] for each j.  By default, we apply p to each
+         // direction in turn.  Functions that can share work between
+         // directions, such as a factorization or an adjoint setup, may
+         // override this.
+         virtual void p_many(
+             X_Vector const & x,
+             std::vector <X_Vector const *> const & dxs,
+             std::vector <Y_Vector *> const & ys
+         ) const {
+             for(Natural j=0;j<dxs.size();j++)
+                 p(x,*(dxs[j]),*(ys[j]));
+         }
+
+         // zs[j]=f'(x)*dys[j] for each j.  By default, we apply ps to each
+         // direction in turn.
+         virtual void ps_many(
+             X_Vector const & x,
+             std::vector <Y_Vector const *> const & dys,
+             std::vector <X_Vector *> const & zs
+         ) const {
+             for(Natural j=0;j<dys.size();j++)
+                 ps(x,*(dys[j]),*(zs[j]));
+         }
+
+         // Fills J with the sparse Jacobian f'(x) and returns true.  Rows
+         // index the coordinates of y and columns index the coordinates of
+         // x.  By default, we don't have a sparse Jacobian and return false.
+         // The direct augmented system solver requires this.
+         virtual bool jacobian(
+             X_Vector const & x,
+             SparseMatrix <Real> & J
+         ) const {
+             return false;
+         }
+
+         // Starts computing y=f(x) and returns a future that's ready once y
+         // holds the result.  By default, we defer the call to eval until
+         // someone waits on the future.  Functions that can run their
+         // evaluations in the background may override this.  Both x and y
+         // must remain alive and untouched until we wait on the future.
+         virtual std::future <void> eval_async(X_Vector const & x,Y_Vector & y)
+             const
+         {
+             return std::async(std::launch::deferred,
+                 [this,&x,&y]() { eval(x,y); });
+         }
          
          // Allow a derived class to deallocate memory
          virtual ~VectorValuedFunction() {}
     };
     //---VectorValuedFunction1---
 
+    // Memoizes the value and gradient of a scalar valued function at the last
+    // few points where we evaluated it.  We recognize a point with a
+    // CacheStamp, which costs O(1) when the vector space versions its
+    // vectors, and count each evaluation that we avoid.  The cache may be
+    // shared by several threads, but we don't hold the lock while we evaluate
+    // the underlying function.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct CachedScalarValuedFunction : public ScalarValuedFunction <Real,XX> {
+    private:
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // A point along with what we know about the function there
+        struct Entry {
+            CacheStamp <Real,XX> x;
+            bool has_value;
+            Real value;
+            bool has_grad;
+            X_Vector grad;
+
+            explicit Entry(X_Vector const & x_) :
+                x(x_), has_value(false), value(0.), has_grad(false),
+                grad(X::init(x_))
+            {
+                x.update(x_);
+            }
+        };
+
+        // Underlying function
+        std::unique_ptr <ScalarValuedFunction <Real,XX> > f;
+
+        // Maximum number of points that we remember
+        Natural size;
+
+        // Number of evaluations that we've avoided
+        Natural & hits;
+
+        // Remembered points, most recently used first
+        mutable std::list <Entry> entries;
+
+        // Scratch space for comparing x against the remembered points, so
+        // that a lookup doesn't allocate
+        mutable Workspace <Real,XX> work;
+
+        // Guards the remembered points, the scratch space, and the count
+        mutable std::mutex lock;
+
+        // Finds the entry for x and moves it to the front.  If we don't
+        // remember x, we return the end of the list.
+        typename std::list <Entry>::iterator find(X_Vector const & x) const {
+            for(auto entry=entries.begin();entry!=entries.end();entry++)
+                if(!entry->x.stale(x,work)) {
+                    entries.splice(entries.begin(),entries,entry);
+                    return entries.begin();
+                }
+            return entries.end();
+        }
+
+        // Finds or creates the entry for x.  When the cache is full, we
+        // reuse the least recently used entry.
+        Entry & insert(X_Vector const & x) const {
+            if(find(x)!=entries.end())
+                return entries.front();
+            if(entries.size() < size)
+                entries.emplace_front(x);
+            else {
+                entries.splice(entries.begin(),entries,--entries.end());
+                auto & entry = entries.front();
+                entry.x.update(x);
+                entry.has_value = false;
+                entry.has_grad = false;
+            }
+            return entries.front();
+        }
+
+        // Copies f(x) into value when we remember it
+        bool recall(X_Vector const & x,Real & value) const {
+            std::lock_guard <std::mutex> guard(lock);
+            auto entry = find(x);
+            if(entry==entries.end() || !entry->has_value)
+                return false;
+            hits++;
+            value = entry->value;
+            return true;
+        }
+
+        // Remembers that value is f(x)
+        void remember(X_Vector const & x,Real const & value) const {
+            std::lock_guard <std::mutex> guard(lock);
+            auto & entry = insert(x);
+            entry.value = value;
+            entry.has_value = true;
+        }
+
+        // Copies grad f(x) into grad when we remember it
+        bool recall_grad(X_Vector const & x,X_Vector & grad) const {
+            std::lock_guard <std::mutex> guard(lock);
+            auto entry = find(x);
+            if(entry==entries.end() || !entry->has_grad)
+                return false;
+            hits++;
+            X::copy(entry->grad,grad);
+            return true;
+        }
+
+        // Remembers that grad is grad f(x)
+        void remember_grad(X_Vector const & x,X_Vector const & grad) const {
+            std::lock_guard <std::mutex> guard(lock);
+            auto & entry = insert(x);
+            X::copy(grad,entry.grad);
+            entry.has_grad = true;
+        }
+
+    public:
+        // Prevent constructors
+        NO_DEFAULT_COPY_ASSIGNMENT(CachedScalarValuedFunction)
+
+        // Remember up to size_ points and add the avoided evaluations to hits_
+        CachedScalarValuedFunction(
+            std::unique_ptr <ScalarValuedFunction <Real,XX> > && f_,
+            Natural const & size_,
+            Natural & hits_
+        ) : f(std::move(f_)), size(size_), hits(hits_), entries(), work(),
+            lock()
+        {}
+
+        // <- f(x)
+        Real eval(X_Vector const & x) const {
+            auto value = Real(0.);
+            if(recall(x,value))
+                return value;
+            value = f->eval(x);
+            remember(x,value);
+            return value;
+        }
+
+        // grad = grad f(x)
+        void grad(X_Vector const & x,X_Vector & grad) const {
+            if(recall_grad(x,grad))
+                return;
+            f->grad(x,grad);
+            remember_grad(x,grad);
+        }
+
+        // Starts computing f(x).  When we remember the value, the future is
+        // already ready.  Otherwise, we remember the value once someone
+        // waits on the future of the underlying function.
+        std::future <Real> eval_async(X_Vector const & x) const {
+            auto value = Real(0.);
+            if(recall(x,value)) {
+                std::promise <Real> ready;
+                ready.set_value(value);
+                return ready.get_future();
+            }
+            return std::async(std::launch::deferred,
+                [this,&x,pending=f->eval_async(x)]() mutable {
+                    auto value = pending.get();
+                    remember(x,value);
+                    return value;
+                });
+        }
+
+        // Starts computing grad = grad f(x) in the same way as eval_async
+        std::future <void> grad_async(X_Vector const & x,X_Vector & grad)
+            const
+        {
+            if(recall_grad(x,grad)) {
+                std::promise <void> ready;
+                ready.set_value();
+                return ready.get_future();
+            }
+            return std::async(std::launch::deferred,
+                [this,&x,&grad,pending=f->grad_async(x,grad)]() mutable {
+                    pending.get();
+                    remember_grad(x,grad);
+                });
+        }
+
+        // H_dx = hess f(x) dx
+        void hessvec(
+            X_Vector const & x,
+            X_Vector const & dx,
+            X_Vector & H_dx
+        ) const {
+            f->hessvec(x,dx,H_dx);
+        }
+
+        // H_dxs[j] = hess f(x) dxs[j] for each j
+        void hessvec_many(
+            X_Vector const & x,
+            std::vector <X_Vector const *> const & dxs,
+            std::vector <X_Vector *> const & H_dxs
+        ) const {
+            f->hessvec_many(x,dxs,H_dxs);
+        }
+    };
+
+    // Memoizes the value of a vector valued function at the last few points
+    // where we evaluated it.  This works like CachedScalarValuedFunction, but
+    // we only remember values since the derivatives depend on a direction.
+    template <
+        typename Real,
+        template <typename> class XX,
+        template <typename> class YY
+    >
+    struct CachedVectorValuedFunction
+        : public VectorValuedFunction <Real,XX,YY>
+    {
+    private:
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef YY <Real> Y;
+        typedef typename Y::Vector Y_Vector;
+
+        // A point along with the function value there
+        struct Entry {
+            CacheStamp <Real,XX> x;
+            Y_Vector y;
+
+            Entry(X_Vector const & x_,Y_Vector const & y_) :
+                x(x_), y(Y::init(y_))
+            {
+                x.update(x_);
+                Y::copy(y_,y);
+            }
+        };
+
+        // Underlying function
+        std::unique_ptr <VectorValuedFunction <Real,XX,YY> > f;
+
+        // Maximum number of points that we remember
+        Natural size;
+
+        // Number of evaluations that we've avoided
+        Natural & hits;
+
+        // Remembered points, most recently used first
+        mutable std::list <Entry> entries;
+
+        // Scratch space for comparing x against the remembered points, so
+        // that a lookup doesn't allocate
+        mutable Workspace <Real,XX> work;
+
+        // Guards the remembered points, the scratch space, and the count
+        mutable std::mutex lock;
+
+        // Finds the entry for x and moves it to the front.  If we don't
+        // remember x, we return the end of the list.
+        typename std::list <Entry>::iterator find(X_Vector const & x) const {
+            for(auto entry=entries.begin();entry!=entries.end();entry++)
+                if(!entry->x.stale(x,work)) {
+                    entries.splice(entries.begin(),entries,entry);
+                    return entries.begin();
+                }
+            return entries.end();
+        }
+
+        // Copies f(x) into y when we remember it
+        bool recall(X_Vector const & x,Y_Vector & y) const {
+            std::lock_guard <std::mutex> guard(lock);
+            auto entry = find(x);
+            if(entry==entries.end())
+                return false;
+            hits++;
+            Y::copy(entry->y,y);
+            return true;
+        }
+
+        // Remembers that y is f(x).  When the cache is full, we reuse the
+        // least recently used entry.
+        void remember(X_Vector const & x,Y_Vector const & y) const {
+            std::lock_guard <std::mutex> guard(lock);
+            auto entry = find(x);
+            if(entry!=entries.end())
+                return;
+            if(entries.size() < size)
+                entries.emplace_front(x,y);
+            else {
+                entries.splice(entries.begin(),entries,--entries.end());
+                entries.front().x.update(x);
+                Y::copy(y,entries.front().y);
+            }
+        }
+
+    public:
+        // Prevent constructors
+        NO_DEFAULT_COPY_ASSIGNMENT(CachedVectorValuedFunction)
+
+        // Remember up to size_ points and add the avoided evaluations to hits_
+        CachedVectorValuedFunction(
+            std::unique_ptr <VectorValuedFunction <Real,XX,YY> > && f_,
+            Natural const & size_,
+            Natural & hits_
+        ) : f(std::move(f_)), size(size_), hits(hits_), entries(), work(),
+            lock()
+        {}
+
+        // y=f(x)
+        void eval(X_Vector const & x,Y_Vector & y) const {
+            if(recall(x,y))
+                return;
+            f->eval(x,y);
+            remember(x,y);
+        }
+
+        // Starts computing y=f(x).  When we remember the value, the future
+        // is already ready.  Otherwise, we remember the value once someone
+        // waits on the future of the underlying function.
+        std::future <void> eval_async(X_Vector const & x,Y_Vector & y) const {
+            if(recall(x,y)) {
+                std::promise <void> ready;
+                ready.set_value();
+                return ready.get_future();
+            }
+            return std::async(std::launch::deferred,
+                [this,&x,&y,pending=f->eval_async(x,y)]() mutable {
+                    pending.get();
+                    remember(x,y);
+                });
+        }
+
+        // y=f'(x)dx
+        void p(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector & y
+        ) const {
+            f->p(x,dx,y);
+        }
+
+        // z=f'(x)*dy
+        void ps(
+            X_Vector const & x,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            f->ps(x,dy,z);
+        }
+
+        // z=(f''(x)dx)*dy
+        void pps(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            f->pps(x,dx,dy,z);
+        }
+
+        // ys[j]=f'(x)dxs[j] for each j
+        void p_many(
+            X_Vector const & x,
+            std::vector <X_Vector const *> const & dxs,
+            std::vector <Y_Vector *> const & ys
+        ) const {
+            f->p_many(x,dxs,ys);
+        }
+
+        // zs[j]=f'(x)*dys[j] for each j
+        void ps_many(
+            X_Vector const & x,
+            std::vector <Y_Vector const *> const & dys,
+            std::vector <X_Vector *> const & zs
+        ) const {
+            f->ps_many(x,dys,zs);
+        }
+
+        // Sparse Jacobian f'(x), when the underlying function has one
+        bool jacobian(
+            X_Vector const & x,
+            SparseMatrix <Real> & J
+        ) const {
+            return f->jacobian(x,J);
+        }
+    };
+
+    // Gives the outputs of a scalar valued function new versions once the
+    // underlying function fills them.  Users typically write to their
+    // outputs through the element accessors, which don't touch the vector,
+    // so we touch each output once after the call instead.
+    template <
+        typename Real,
+        template <typename> class XX
+    >
+    struct TouchedScalarValuedFunction
+        : public ScalarValuedFunction <Real,XX>
+    {
+    private:
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+
+        // Underlying function
+        std::unique_ptr <ScalarValuedFunction <Real,XX> > f;
+
+    public:
+        // Prevent constructors
+        NO_DEFAULT_COPY_ASSIGNMENT(TouchedScalarValuedFunction)
+
+        // Take ownership of the underlying function
+        explicit TouchedScalarValuedFunction(
+            std::unique_ptr <ScalarValuedFunction <Real,XX> > && f_
+        ) : f(std::move(f_)) {}
+
+        // <- f(x)
+        Real eval(X_Vector const & x) const {
+            return f->eval(x);
+        }
+
+        // grad = grad f(x)
+        void grad(X_Vector const & x,X_Vector & grad) const {
+            f->grad(x,grad);
+            Touch <Real,XX>::eval(grad);
+        }
+
+        // H_dx = hess f(x) dx
+        void hessvec(
+            X_Vector const & x,
+            X_Vector const & dx,
+            X_Vector & H_dx
+        ) const {
+            f->hessvec(x,dx,H_dx);
+            Touch <Real,XX>::eval(H_dx);
+        }
+
+        // H_dxs[j] = hess f(x) dxs[j] for each j
+        void hessvec_many(
+            X_Vector const & x,
+            std::vector <X_Vector const *> const & dxs,
+            std::vector <X_Vector *> const & H_dxs
+        ) const {
+            f->hessvec_many(x,dxs,H_dxs);
+            for(auto const & H_dx : H_dxs)
+                Touch <Real,XX>::eval(*H_dx);
+        }
+
+        // Starts computing f(x)
+        std::future <Real> eval_async(X_Vector const & x) const {
+            return f->eval_async(x);
+        }
+
+        // Starts computing grad = grad f(x).  We touch grad once someone
+        // waits on the future.
+        std::future <void> grad_async(X_Vector const & x,X_Vector & grad)
+            const
+        {
+            return std::async(std::launch::deferred,
+                [&grad,pending=f->grad_async(x,grad)]() mutable {
+                    pending.get();
+                    Touch <Real,XX>::eval(grad);
+                });
+        }
+    };
+
+    // Gives the outputs of a vector valued function new versions once the
+    // underlying function fills them.  This works like
+    // TouchedScalarValuedFunction.
+    template <
+        typename Real,
+        template <typename> class XX,
+        template <typename> class YY
+    >
+    struct TouchedVectorValuedFunction
+        : public VectorValuedFunction <Real,XX,YY>
+    {
+    private:
+        // Create some type shortcuts
+        typedef XX <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef YY <Real> Y;
+        typedef typename Y::Vector Y_Vector;
+
+        // Underlying function
+        std::unique_ptr <VectorValuedFunction <Real,XX,YY> > f;
+
+    public:
+        // Prevent constructors
+        NO_DEFAULT_COPY_ASSIGNMENT(TouchedVectorValuedFunction)
+
+        // Take ownership of the underlying function
+        explicit TouchedVectorValuedFunction(
+            std::unique_ptr <VectorValuedFunction <Real,XX,YY> > && f_
+        ) : f(std::move(f_)) {}
+
+        // y=f(x)
+        void eval(X_Vector const & x,Y_Vector & y) const {
+            f->eval(x,y);
+            Touch <Real,YY>::eval(y);
+        }
+
+        // y=f'(x)dx
+        void p(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector & y
+        ) const {
+            f->p(x,dx,y);
+            Touch <Real,YY>::eval(y);
+        }
+
+        // z=f'(x)*dy
+        void ps(
+            X_Vector const & x,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            f->ps(x,dy,z);
+            Touch <Real,XX>::eval(z);
+        }
+
+        // z=(f''(x)dx)*dy
+        void pps(
+            X_Vector const & x,
+            X_Vector const & dx,
+            Y_Vector const & dy,
+            X_Vector & z
+        ) const {
+            f->pps(x,dx,dy,z);
+            Touch <Real,XX>::eval(z);
+        }
+
+        // ys[j]=f'(x)dxs[j] for each j
+        void p_many(
+            X_Vector const & x,
+            std::vector <X_Vector const *> const & dxs,
+            std::vector <Y_Vector *> const & ys
+        ) const {
+            f->p_many(x,dxs,ys);
+            for(auto const & y : ys)
+                Touch <Real,YY>::eval(*y);
+        }
+
+        // zs[j]=f'(x)*dys[j] for each j
+        void ps_many(
+            X_Vector const & x,
+            std::vector <Y_Vector const *> const & dys,
+            std::vector <X_Vector *> const & zs
+        ) const {
+            f->ps_many(x,dys,zs);
+            for(auto const & z : zs)
+                Touch <Real,XX>::eval(*z);
+        }
+
+        // Sparse Jacobian f'(x), when the underlying function has one
+        bool jacobian(
+            X_Vector const & x,
+            SparseMatrix <Real> & J
+        ) const {
+            return f->jacobian(x,J);
+        }
+
+        // Starts computing y=f(x).  We touch y once someone waits on the
+        // future.
+        std::future <void> eval_async(X_Vector const & x,Y_Vector & y) const {
+            return std::async(std::launch::deferred,
+                [&y,pending=f->eval_async(x,y)]() mutable {
+                    pending.get();
+                    Touch <Real,YY>::eval(y);
+                });
+        }
+    };
+
     //---Messaging0---
     // Defines how we output messages to the user
     namespace Messaging {
@@ -280,8 +940,11 @@ namespace Optizelle{
             InvBFGS,           // Inverse BFGS approximation
             SR1,               // SR1 approximation
             InvSR1,            // Inverse SR1 approximation
-            UserDefined        // User defined operator (such as the true
+            UserDefined,       // User defined operator (such as the true
                                // Hessian for Newton's method)
+            CompactBFGS        // BFGS approximation using the compact
+                               // representation of Byrd, Nocedal, and
+                               // Schnabel
             //---Operators1---
         };
         
@@ -331,7 +994,9 @@ namespace Optizelle{
             GoldenSection,    // Golden-section search 
             BackTracking,     // BackTracking search 
             TwoPointA,        // Barzilai and Borwein's method A
-            TwoPointB         // Barzilai and Borwein's method B
+            TwoPointB,        // Barzilai and Borwein's method B
+            ParallelBackTracking // BackTracking search that evaluates
+                              // several step lengths at once
             //---LineSearchKind1---
         };
             
@@ -385,7 +1050,9 @@ namespace Optizelle{
             // Occurs after we take the optimization step x+dx, but before
             // we calculate the gradient based on this new step.  In addition,
             // after this point we set the objective value, f_x, to be
-            // f_xpdx.
+            // f_xpdx.  When the objective computes its gradient
+            // asynchronously, the gradient may be in progress here, so we
+            // must not modify x or read grad.
             AfterStepBeforeGradient,
 
             // Occurs just after the gradient computation with the new
@@ -538,6 +1205,45 @@ namespace Optizelle{
         bool is_valid(std::string const & eps_rel);
     }
 
+    // Different methods for solving the trust-region subproblem
+    namespace TruncatedSolver {
+        enum t : Natural{
+            //---TruncatedSolver0---
+            ConjugateGradient,  // Truncated CG, which stops at the boundary
+            Lanczos,            // Generalized Lanczos (GLTR), which continues
+                                // along the boundary
+            //---TruncatedSolver1---
+        };
+        
+        // Converts the trust-region subproblem solver to a string
+        std::string to_string(t const & trunc_solver);
+        
+        // Converts a string to the trust-region subproblem solver
+        t from_string(std::string const & trunc_solver);
+
+        // Checks whether or not a string is valid
+        bool is_valid(std::string const & name);
+    }
+
+    // Different methods for solving the augmented systems
+    namespace AugmentedSystemSolver {
+        enum t : Natural{
+            //---AugmentedSystemSolver0---
+            GMRES,              // Preconditioned GMRES
+            Direct,             // Sparse LDL' factorization of g'(x)g'(x)*
+            //---AugmentedSystemSolver1---
+        };
+        
+        // Converts the augmented system solver to a string
+        std::string to_string(t const & augsys_solver);
+        
+        // Converts a string to the augmented system solver
+        t from_string(std::string const & augsys_solver);
+
+        // Checks whether or not a string is valid
+        bool is_valid(std::string const & name);
+    }
+
     // Reasons why the quasinormal problem exited
     namespace QuasinormalStop{
         enum t{
@@ -579,6 +1285,159 @@ namespace Optizelle{
             return (x < y) || (y != y) ? x : y;
         }
 
+        // Results of a finite difference test.  For each step size, we store
+        // the relative error between a derivative and its finite difference
+        // approximation.
+        template <typename Real>
+        struct FiniteDifferenceTable {
+            // Description of the test
+            std::string title;
+
+            // Step sizes are given by epsilon = 10^(-exponent)
+            std::vector <Integer> exponents;
+
+            // Step sizes
+            std::vector <Real> epsilons;
+
+            // Relative error for each step size
+            std::vector <Real> rel_errs;
+
+            // Smallest relative error seen so far
+            Real min_rel_err;
+
+            // Sets up the sweep of step sizes from 1e+2 down to 1e-5
+            explicit FiniteDifferenceTable(std::string const & title_) :
+                title(title_),
+                exponents(),
+                epsilons(),
+                rel_errs(),
+                min_rel_err(std::numeric_limits<Real>::quiet_NaN())
+            {
+                for(Integer i=-2;i<=5;i++){
+                    exponents.emplace_back(i);
+                    epsilons.emplace_back(pow(Real(.1),int(i)));
+                }
+            }
+
+            // Records the relative error for the next step size
+            void add(Real const & rel_err) {
+                rel_errs.emplace_back(rel_err);
+                min_rel_err=get_smallest <> (rel_err,min_rel_err);
+            }
+
+            // Prints out the table of relative errors
+            void print(Messaging::t const & msg) const {
+                msg(title);
+                for(Natural j=0;j<rel_errs.size();j++) {
+                    Integer const & i=exponents[j];
+                    std::stringstream ss;
+                    if(i<0) ss << "The relative difference (1e+" << -i <<  "): ";
+                    else ss << "The relative difference (1e-" << i << "): ";
+                    ss << std::scientific << std::setprecision(16)
+                        << rel_errs[j];
+                    msg(ss.str());
+                }
+            }
+        };
+
+        // Evaluates the 4-point finite difference stencil of a function in the
+        // direction dx for each step size epsilon and returns the resulting
+        // directional derivatives.  The points x + c eps dx are independent of
+        // each other, so we evaluate up to threads of them concurrently.
+        template <
+            typename Real,
+            template <typename> class XX,
+            typename Out
+        >
+        std::vector <Out> stencil(
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            std::vector <Real> const & epsilons,
+            Natural const & threads,
+            std::function <Out()> const & zero,
+            std::function <void(typename XX <Real>::Vector const &,Out &)>
+                const & eval,
+            std::function <void(Real const &,Out const &,Out &)> const & axpy
+        ) {
+            // Create some type shortcuts
+            typedef XX <Real> X;
+            typedef typename X::Vector X_Vector;
+
+            // Offsets and weights of the stencil
+            Real const cs[4]={Real(1.),Real(-1.),Real(2.),Real(-2.)};
+            Real const ws[4]={Real(8.),Real(-8.),Real(-1.),Real(1.)};
+
+            // Zero out the directional derivatives
+            std::vector <Out> dds;
+            for(Natural j=0;j<epsilons.size();j++)
+                dds.emplace_back(zero());
+
+            // Create elements for a batch of points x + c eps dx and for the
+            // function evaluated at these points
+            Natural n=4*epsilons.size();
+            Natural batch=std::min(std::max(threads,Natural(1)),n);
+            std::vector <X_Vector> xs;
+            std::vector <Out> fs;
+            for(Natural k=0;k<batch;k++) {
+                xs.emplace_back(X::init(x));
+                fs.emplace_back(zero());
+            }
+
+            // Run through the stencil a batch at a time
+            for(Natural start=0;start<n;start+=batch) {
+                Natural size=std::min(batch,n-start);
+
+                // Form the points
+                for(Natural k=0;k<size;k++) {
+                    Natural l=start+k;
+                    X::copy(x,xs[k]);
+                    X::axpy(cs[l%4]*epsilons[l/4],dx,xs[k]);
+                }
+
+                // Evaluate the function
+                parallel_eval(size,batch,[&](Natural const & k) {
+                    eval(xs[k],fs[k]);
+                });
+
+                // Accumulate the finite difference calculation
+                for(Natural k=0;k<size;k++) {
+                    Natural l=start+k;
+                    axpy(ws[l%4]/(Real(12.)*epsilons[l/4]),fs[k],dds[l/4]);
+                }
+            }
+            return dds;
+        }
+
+        // Performs a 4-point finite difference directional derivative on
+        // a scalar valued function f : X->R for each step size epsilon.  In
+        // other words, dds[j] ~= f'(x)dx.  We accomplish this by doing a
+        // finite difference calculation on f.
+        template <
+            typename Real,
+            template <typename> class XX
+        >
+        void directionalDerivatives(
+            ScalarValuedFunction<Real,XX> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            std::vector <Real> const & epsilons,
+            Natural const & threads,
+            std::vector <Real> & dds
+        ){
+            // Create some type shortcuts
+            typedef XX <Real> X;
+            typedef typename X::Vector X_Vector;
+
+            dds=stencil <Real,XX,Real> (x,dx,epsilons,threads,
+                []() { return Real(0.); },
+                [&f](X_Vector const & x_op_dx,Real & obj) {
+                    obj=f.eval(x_op_dx);
+                },
+                [](Real const & alpha,Real const & obj,Real & dd) {
+                    dd+=alpha*obj;
+                });
+        }
+
         // Performs a 4-point finite difference directional derivative on
         // a scalar valued function f : X->R.  In other words, <- f'(x)dx.  We
         // accomplish this by doing a finite difference calculation on f.
@@ -591,40 +1450,47 @@ namespace Optizelle{
             typename XX <Real>::Vector const & x,
             typename XX <Real>::Vector const & dx,
             Real const & epsilon
+        ){
+            std::vector <Real> dds;
+            directionalDerivatives <Real,XX> (f,x,dx,{epsilon},1,dds);
+            return dds[0];
+        }
+        
+        // Performs a 4-point finite difference directional derivative on
+        // the gradient of a scalar valued function f : X->R for each step
+        // size epsilon.  In other words, dds[j] ~= hess f(x) dx.  We
+        // accomplish this by doing a finite difference calculation on G where
+        // G(x)=grad f(x).
+        template <
+            typename Real,
+            template <typename> class XX
+        >
+        void directionalDerivatives(
+            ScalarValuedFunction<Real,XX> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            std::vector <Real> const & epsilons,
+            Natural const & threads,
+            std::vector <typename XX <Real>::Vector> & dds
         ){
             // Create some type shortcuts
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
 
-            // Create an element for x+eps dx, x-eps dx, etc. 
-            X_Vector x_op_dx(X::init(x));
-
-            // f(x+eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(epsilon,dx,x_op_dx);
-            Real obj_xpes=f.eval(x_op_dx);
-
-            // f(x-eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(-epsilon,dx,x_op_dx);
-            Real obj_xmes=f.eval(x_op_dx);
-
-            // f(x+2 eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(Real(2.*epsilon),dx,x_op_dx);
-            Real obj_xp2es=f.eval(x_op_dx);
-
-            // f(x-2 eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(Real(-2.*epsilon),dx,x_op_dx);
-            Real obj_xm2es=f.eval(x_op_dx);
-
-            // Calculate the directional derivative and return it
-            Real dd=(obj_xm2es-Real(8.)*obj_xmes+Real(8.)*obj_xpes-obj_xp2es)
-                /(Real(12.)*epsilon);
-            return dd;
+            dds=stencil <Real,XX,X_Vector> (x,dx,epsilons,threads,
+                [&x]() {
+                    X_Vector zero(X::init(x));
+                    X::zero(zero);
+                    return zero;
+                },
+                [&f](X_Vector const & x_op_dx,X_Vector & fgrad_x_op_dx) {
+                    f.grad(x_op_dx,fgrad_x_op_dx);
+                },
+                [](Real const & alpha,X_Vector const & fgrad,X_Vector & dd) {
+                    X::axpy(alpha,fgrad,dd);
+                });
         }
-        
+
         // Performs a 4-point finite difference directional derivative on
         // the gradient of a scalar valued function f : X->R.  In other words,
         // dd ~= hess f(x) dx.  We accomplish this by doing a finite difference
@@ -644,101 +1510,112 @@ namespace Optizelle{
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
 
-            // Create an element for x+eps dx, x-eps dx, etc. 
-            X_Vector x_op_dx(X::init(x));
-
-            // Create an element to store the gradient at this point 
-            X_Vector fgrad_x_op_dx(X::init(x));
-
-            // Zero out the directional derivative
-            X::zero(dd);
-
-            // grad f(x+eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(epsilon,dx,x_op_dx);
-            f.grad(x_op_dx,fgrad_x_op_dx);
-            X::axpy(Real(8.),fgrad_x_op_dx,dd);
-
-            // grad f(x-eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(-epsilon,dx,x_op_dx);
-            f.grad(x_op_dx,fgrad_x_op_dx);
-            X::axpy(Real(-8.),fgrad_x_op_dx,dd);
-
-            // grad f(x+2 eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(Real(2.)*epsilon,dx,x_op_dx);
-            f.grad(x_op_dx,fgrad_x_op_dx);
-            X::axpy(Real(-1.),fgrad_x_op_dx,dd);
-
-            // grad f(x-2 eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(Real(-2.)*epsilon,dx,x_op_dx);
-            f.grad(x_op_dx,fgrad_x_op_dx);
-            X::axpy(Real(1.),fgrad_x_op_dx,dd);
-
-            // Finish the finite difference calculation 
-            X::scal(Real(1.)/(Real(12.)*epsilon),dd);
+            std::vector <X_Vector> dds;
+            directionalDerivatives <Real,XX> (f,x,dx,{epsilon},1,dds);
+            X::copy(dds[0],dd);
+        }
+
+        // Performs a 4-point finite difference directional derivative on
+        // a vector valued function f : X->Y for each step size epsilon.  In
+        // other words, dds[j] ~= f'(x)dx.  We accomplish this by doing a
+        // finite difference calculation on f.  The element y is only used
+        // to size the results.
+        template <
+            typename Real,
+            template <typename> class XX,
+            template <typename> class YY 
+        >
+        void directionalDerivatives(
+            VectorValuedFunction<Real,XX,YY> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            std::vector <Real> const & epsilons,
+            Natural const & threads,
+            typename YY <Real>::Vector const & y,
+            std::vector <typename YY <Real>::Vector> & dds
+        ){
+            // Create some type shortcuts
+            typedef XX <Real> X;
+            typedef typename X::Vector X_Vector;
+            typedef YY <Real> Y;
+            typedef typename Y::Vector Y_Vector;
+
+            dds=stencil <Real,XX,Y_Vector> (x,dx,epsilons,threads,
+                [&y]() {
+                    Y_Vector zero(Y::init(y));
+                    Y::zero(zero);
+                    return zero;
+                },
+                [&f](X_Vector const & x_op_dx,Y_Vector & f_x_op_dx) {
+                    f.eval(x_op_dx,f_x_op_dx);
+                },
+                [](Real const & alpha,Y_Vector const & f_x,Y_Vector & dd) {
+                    Y::axpy(alpha,f_x,dd);
+                });
+        }
+
+        // Performs a 4-point finite difference directional derivative on
+        // a vector valued function f : X->Y. In other words, dd ~= f'(x)dx.
+        // We accomplish this by doing a finite difference calculation on f.
+        template <
+            typename Real,
+            template <typename> class XX,
+            template <typename> class YY 
+        >
+        void directionalDerivative(
+            VectorValuedFunction<Real,XX,YY> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            Real const & epsilon,
+            typename YY <Real>::Vector& dd
+        ){
+            // Create some type shortcuts
+            typedef YY <Real> Y;
+            typedef typename Y::Vector Y_Vector;
+
+            std::vector <Y_Vector> dds;
+            directionalDerivatives <Real,XX,YY> (f,x,dx,{epsilon},1,dd,dds);
+            Y::copy(dds[0],dd);
         }
-
+        
         // Performs a 4-point finite difference directional derivative on
-        // a vector valued function f : X->Y. In other words, dd ~= f'(x)dx.
-        // We accomplish this by doing a finite difference calculation on f.
+        // the second derivative-adjoint of a vector valued function for each
+        // step size epsilon.  In other words, dds[j] ~= (f''(x)dx)*dy.  In
+        // order to calculate this, we do a finite difference approximation
+        // using g(x)=f'(x)*dy.  Therefore, the error in the approximation
+        // should be in the dx piece.
         template <
             typename Real,
             template <typename> class XX,
             template <typename> class YY 
         >
-        void directionalDerivative(
+        void directionalDerivatives(
             VectorValuedFunction<Real,XX,YY> const & f,
             typename XX <Real>::Vector const & x,
             typename XX <Real>::Vector const & dx,
-            Real const & epsilon,
-            typename YY <Real>::Vector& dd
+            typename YY <Real>::Vector const & dy,
+            std::vector <Real> const & epsilons,
+            Natural const & threads,
+            std::vector <typename XX <Real>::Vector> & dds
         ){
             // Create some type shortcuts
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
-            typedef YY <Real> Y;
-            typedef typename Y::Vector Y_Vector;
 
-            // Create an element for x+eps dx, x-eps dx, etc. 
-            X_Vector x_op_dx(X::init(x));
-
-            // Create an element for f(x+eps dx), etc.
-            Y_Vector f_x_op_dx(Y::init(dd));
-            
-            // Zero out the directional derivative
-            Y::zero(dd);
-
-            // f(x+eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(epsilon,dx,x_op_dx);
-            f.eval(x_op_dx,f_x_op_dx);
-            Y::axpy(Real(8.),f_x_op_dx,dd);
-
-            // f(x-eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(-epsilon,dx,x_op_dx);
-            f.eval(x_op_dx,f_x_op_dx);
-            Y::axpy(Real(-8.),f_x_op_dx,dd);
-
-            // f(x+2 eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(Real(2.)*epsilon,dx,x_op_dx);
-            f.eval(x_op_dx,f_x_op_dx);
-            Y::axpy(Real(-1.),f_x_op_dx,dd);
-
-            // f(x-2 eps dx)
-            X::copy(x,x_op_dx);
-            X::axpy(Real(-2.)*epsilon,dx,x_op_dx);
-            f.eval(x_op_dx,f_x_op_dx);
-            Y::axpy(Real(1.),f_x_op_dx,dd);
-
-            // Finish the finite difference calculation 
-            Y::scal(Real(1.)/(Real(12.)*epsilon),dd);
+            dds=stencil <Real,XX,X_Vector> (x,dx,epsilons,threads,
+                [&x]() {
+                    X_Vector zero(X::init(x));
+                    X::zero(zero);
+                    return zero;
+                },
+                [&f,&dy](X_Vector const & x_op_dx,X_Vector & fps_xopdx_dy) {
+                    f.ps(x_op_dx,dy,fps_xopdx_dy);
+                },
+                [](Real const & alpha,X_Vector const & fps,X_Vector & dd) {
+                    X::axpy(alpha,fps,dd);
+                });
         }
-        
+
         // Performs a 4-point finite difference directional derivative on
         // the second derivative-adjoint of a vector valued function. In other
         // words, dd ~= (f''(x)dx)*dy.  In order to calculate this, we do a
@@ -761,56 +1638,24 @@ namespace Optizelle{
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
 
-            // Create an element for x+eps dx, x-eps dx, etc. 
-            X_Vector x_op_dx(X::init(x));
-
-            // Create an element for f'(x+eps dx)*dy, etc.
-            X_Vector fps_xopdx_dy(X::init(dd));
-
-            // Zero out the directional derivative
-            X::zero(dd);
-
-            // f'(x+eps dx)*dy
-            X::copy(x,x_op_dx);
-            X::axpy(epsilon,dx,x_op_dx);
-            f.ps(x_op_dx,dy,fps_xopdx_dy);
-            X::axpy(Real(8.),fps_xopdx_dy,dd);
-
-            // f'(x-eps dx)*dy
-            X::copy(x,x_op_dx);
-            X::axpy(-epsilon,dx,x_op_dx);
-            f.ps(x_op_dx,dy,fps_xopdx_dy);
-            X::axpy(Real(-8.),fps_xopdx_dy,dd);
-
-            // f'(x+2 eps dx)*dy
-            X::copy(x,x_op_dx);
-            X::axpy(Real(2.)*epsilon,dx,x_op_dx);
-            f.ps(x_op_dx,dy,fps_xopdx_dy);
-            X::axpy(Real(-1.),fps_xopdx_dy,dd);
-
-            // f'(x-2 eps dx)*dy
-            X::copy(x,x_op_dx);
-            X::axpy(Real(-2.)*epsilon,dx,x_op_dx);
-            f.ps(x_op_dx,dy,fps_xopdx_dy);
-            X::axpy(Real(1.),fps_xopdx_dy,dd);
-
-            // Finish the finite difference calculation 
-            X::scal(Real(1.)/(Real(12.)*epsilon),dd);
+            std::vector <X_Vector> dds;
+            directionalDerivatives <Real,XX,YY> (f,x,dx,dy,{epsilon},1,dds);
+            X::copy(dds[0],dd);
         }
 
         // Performs a finite difference test on the gradient of f where  
         // f : X->R is scalar valued.  In other words, we check grad f using f
-        // and return the smallest relative error. 
+        // and return the relative errors for each step size. 
         template <
             typename Real,
             template <typename> class XX
         >
-        Real gradientCheck(
-            Messaging::t const & msg,
+        FiniteDifferenceTable <Real> gradientCheck(
             ScalarValuedFunction<Real,XX> const & f,
             typename XX <Real>::Vector const & x,
             typename XX <Real>::Vector const & dx,
-            std::string const & name
+            std::string const & name,
+            Natural const & threads = 1
         ) {
             // Create some type shortcuts
             typedef XX <Real> X;
@@ -823,88 +1668,98 @@ namespace Optizelle{
             // Begin by calculating the directional derivative via the gradient
             Real dd_grad=X::innr(f_grad,dx);
 
-            // Compute an ensemble of finite difference tests in a linear manner
-            msg("Finite difference test on the gradient of " + name);
-            Real min_rel_err(std::numeric_limits<Real>::quiet_NaN());
-            for(Integer i=-2;i<=5;i++){
-                Real epsilon=pow(Real(.1),int(i));
-                Real dd=directionalDerivative <> (f,x,dx,epsilon);
-
-                // Calculate the relative error
-                Real rel_err=fabs(dd_grad-dd)
-                    / (std::numeric_limits <Real>::epsilon()+fabs(dd_grad));
-
-                // Calculate the smallest relative error seen so far 
-                min_rel_err=get_smallest <> (rel_err,min_rel_err);
+            // Compute an ensemble of finite difference tests
+            FiniteDifferenceTable <Real> table(
+                "Finite difference test on the gradient of " + name);
+            std::vector <Real> dds;
+            directionalDerivatives <Real,XX> (f,x,dx,table.epsilons,threads,
+                dds);
+
+            // Calculate the relative errors
+            for(auto const & dd : dds)
+                table.add(fabs(dd_grad-dd)
+                    / (std::numeric_limits <Real>::epsilon()+fabs(dd_grad)));
+            return table;
+        }
 
-                // Print out the relative error
-                std::stringstream ss;
-                if(i<0) ss << "The relative difference (1e+" << -i <<  "): ";
-                else ss << "The relative difference (1e-" << i << "): ";
-                ss << std::scientific << std::setprecision(16) << rel_err; 
-                msg(ss.str());
-            }
-            
-            // Return the function's smallest relative error
-            return min_rel_err;
+        // Performs a finite difference test on the gradient of f where  
+        // f : X->R is scalar valued.  In other words, we check grad f using f
+        // and return the smallest relative error. 
+        template <
+            typename Real,
+            template <typename> class XX
+        >
+        Real gradientCheck(
+            Messaging::t const & msg,
+            ScalarValuedFunction<Real,XX> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            std::string const & name,
+            Natural const & threads = 1
+        ) {
+            auto table = gradientCheck <Real,XX> (f,x,dx,name,threads);
+            table.print(msg);
+            return table.min_rel_err;
         }
         
         // Performs a finite difference test on the hessian of f where f : X->R
-        // is scalar valued.  In other words, we check hess f dx using grad f.
+        // is scalar valued.  In other words, we check hess f dx using grad f
+        // and return the relative errors for each step size.
         template <
             typename Real,
             template <typename> class XX
         >
-        Real hessianCheck(
-            Messaging::t const & msg,
+        FiniteDifferenceTable <Real> hessianCheck(
             ScalarValuedFunction<Real,XX> const & f,
             typename XX <Real>::Vector const & x,
             typename XX <Real>::Vector const & dx,
-            std::string const & name
+            std::string const & name,
+            Natural const & threads = 1
         ) {
             // Create some type shortcuts
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
 
-            // Create an element for the residual between the directional 
-            // derivative computed Hessian-vector product and the true 
-            // Hessian-vector product.
-            X_Vector res(X::init(x));
-
             // Calculate hess f in the direction dx.  
             X_Vector hess_f_dx(X::init(x));
             f.hessvec(x,dx,hess_f_dx);
 
-            // Compute an ensemble of finite difference tests in a linear manner
-            msg("Finite difference test on the Hessian of " + name);
-            Real min_rel_err(std::numeric_limits<Real>::quiet_NaN());
-            for(Integer i=-2;i<=5;i++){
-
-                // Calculate the directional derivative
-                Real epsilon=pow(Real(.1),int(i));
-                directionalDerivative <> (f,x,dx,epsilon,res);
+            // Compute an ensemble of finite difference tests
+            FiniteDifferenceTable <Real> table(
+                "Finite difference test on the Hessian of " + name);
+            std::vector <X_Vector> dds;
+            directionalDerivatives <Real,XX> (f,x,dx,table.epsilons,threads,
+                dds);
 
+            for(auto & res : dds) {
                 // Determine the residual.  Store in res.
                 X::axpy(Real(-1.),hess_f_dx,res);
 
                 // Determine the relative error
-                Real rel_err=sqrt(X::innr(res,res))
+                table.add(sqrt(X::innr(res,res))
                     / (std::numeric_limits <Real>::epsilon()
-                    + sqrt(X::innr(hess_f_dx,hess_f_dx)));
-
-                // Calculate the smallest relative error seen so far 
-                min_rel_err=get_smallest <> (rel_err,min_rel_err);
-
-                // Print out the differences
-                std::stringstream ss;
-                if(i<0)ss << "The relative difference (1e+" << -i <<  "): ";
-                else ss << "The relative difference (1e-" << i << "): ";
-                ss << std::scientific << std::setprecision(16) << rel_err; 
-                msg(ss.str());
+                    + sqrt(X::innr(hess_f_dx,hess_f_dx))));
             }
-            
-            // Return the function's smallest relative error
-            return min_rel_err;
+            return table;
+        }
+
+        // Performs a finite difference test on the hessian of f where f : X->R
+        // is scalar valued.  In other words, we check hess f dx using grad f.
+        template <
+            typename Real,
+            template <typename> class XX
+        >
+        Real hessianCheck(
+            Messaging::t const & msg,
+            ScalarValuedFunction<Real,XX> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            std::string const & name,
+            Natural const & threads = 1
+        ) {
+            auto table = hessianCheck <Real,XX> (f,x,dx,name,threads);
+            table.print(msg);
+            return table.min_rel_err;
         }
         
         // This tests the symmetry of the Hessian.  We accomplish this by
@@ -925,13 +1780,10 @@ namespace Optizelle{
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
 
-            // Calculate hess f in the direction dx.  
+            // Calculate hess f in the directions dx and dxx.  
             X_Vector H_x_dx(X::init(x));
-            f.hessvec(x,dx,H_x_dx);
-            
-            // Calculate hess f in the direction dxx.  
             X_Vector H_x_dxx(X::init(x));
-            f.hessvec(x,dxx,H_x_dxx);
+            f.hessvec_many(x,{&dx,&dxx},{&H_x_dx,&H_x_dxx});
             
             // Calculate <H(x)dx,dxx>
             Real innr_Hxdx_dxx = X::innr(H_x_dx,dxx);
@@ -1002,67 +1854,68 @@ namespace Optizelle{
         }
 
         // Performs a finite difference test on the derivative of a
-        // vector-valued function f.  Specifically, we check f'(x)dx using f.
+        // vector-valued function f.  Specifically, we check f'(x)dx using f
+        // and return the relative errors for each step size.
         template <
             typename Real,
             template <typename> class XX,
             template <typename> class YY 
         >
-        Real derivativeCheck(
-            Messaging::t const & msg,
+        FiniteDifferenceTable <Real> derivativeCheck(
             VectorValuedFunction<Real,XX,YY> const & f,
             typename XX <Real>::Vector const & x,
             typename XX <Real>::Vector const & dx,
             typename YY <Real>::Vector const & y,
-            std::string const & name
+            std::string const & name,
+            Natural const & threads = 1
         ) {
             // Create some type shortcuts
             typedef YY <Real> Y;
             typedef typename Y::Vector Y_Vector;
 
-            // Create an element for the residual between the directional 
-            // derivative and the true derivative.
-            Y_Vector res(Y::init(y));
-
             // Calculate f'(x)dx 
             Y_Vector fp_x_dx(Y::init(y));
             f.p(x,dx,fp_x_dx);
 
-            // Compute an ensemble of finite difference tests in a linear manner
-            std::stringstream notice;
-            notice << "Finite difference test on the derivative of " 
-                << name;
-            msg(notice.str());
-            Real min_rel_err(std::numeric_limits<Real>::quiet_NaN());
-            for(Integer i=-2;i<=5;i++){
-
-                // Calculate the directional derivative
-                Real epsilon=pow(Real(.1),int(i));
-                directionalDerivative <> (f,x,dx,epsilon,res);
+            // Compute an ensemble of finite difference tests
+            FiniteDifferenceTable <Real> table(
+                "Finite difference test on the derivative of " + name);
+            std::vector <Y_Vector> dds;
+            directionalDerivatives <Real,XX,YY> (f,x,dx,table.epsilons,
+                threads,y,dds);
 
+            for(auto & res : dds) {
                 // Determine the residual.  Store in res.
                 Y::axpy(Real(-1.),fp_x_dx,res);
 
                 // Determine the relative error
-                Real rel_err=sqrt(Y::innr(res,res))
+                table.add(sqrt(Y::innr(res,res))
                     / (std::numeric_limits <Real>::epsilon()
-                    + sqrt(Y::innr(fp_x_dx,fp_x_dx)));
-                
-                // Calculate the smallest relative error seen so far 
-                min_rel_err=get_smallest <> (rel_err,min_rel_err);
-
-                // Print out the differences
-                std::stringstream ss;
-                if(i<0)ss << "The relative difference (1e+" << -i <<  "): ";
-                else ss << "The relative difference (1e-" << i << "): ";
-                ss << std::scientific << std::setprecision(16) << rel_err; 
-                msg(ss.str());
+                    + sqrt(Y::innr(fp_x_dx,fp_x_dx))));
             }
-            
-            // Return the function's smallest relative error
-            return min_rel_err; 
+            return table;
         }
 
+        // Performs a finite difference test on the derivative of a
+        // vector-valued function f.  Specifically, we check f'(x)dx using f.
+        template <
+            typename Real,
+            template <typename> class XX,
+            template <typename> class YY 
+        >
+        Real derivativeCheck(
+            Messaging::t const & msg,
+            VectorValuedFunction<Real,XX,YY> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            typename YY <Real>::Vector const & y,
+            std::string const & name,
+            Natural const & threads = 1
+        ) {
+            auto table = derivativeCheck <Real,XX,YY> (f,x,dx,y,name,threads);
+            table.print(msg);
+            return table.min_rel_err; 
+        }
         // Performs an adjoint check on the first-order derivative of a vector
         // valued function.  In other words, we check that
         // <f'(x)dx,dy> = <dx,f'(x)*dy>
@@ -1117,63 +1970,70 @@ namespace Optizelle{
 
         // Performs a finite difference test on the second-derivative-adjoint 
         // of a vector-valued function f.  Specifically, we check
-        // (f''(x)dx)*dy using f'(x)*dy.
+        // (f''(x)dx)*dy using f'(x)*dy and return the relative errors for
+        // each step size.
         template <
             typename Real,
             template <typename> class XX,
             template <typename> class YY 
         >
-        Real secondDerivativeCheck(
-            Messaging::t const & msg,
+        FiniteDifferenceTable <Real> secondDerivativeCheck(
             VectorValuedFunction<Real,XX,YY> const & f,
             typename XX <Real>::Vector const & x,
             typename XX <Real>::Vector const & dx,
             typename YY <Real>::Vector const & dy,
-            std::string const & name
+            std::string const & name,
+            Natural const & threads = 1
         ) {
             // Create some type shortcuts
             typedef XX <Real> X;
             typedef typename X::Vector X_Vector;
 
-            // Create an element for the residual between the directional 
-            // derivative and the true derivative.
-            X_Vector res(X::init(x));
-
             // Calculate (f''(x)dx)*dy
             X_Vector fpps_x_dx_dy(X::init(dx));
             f.pps(x,dx,dy,fpps_x_dx_dy);
 
-            // Compute an ensemble of finite difference tests in a linear manner
-            msg("Finite difference test on the 2nd-derivative adjoint "
-                "of " + name);
-            Real min_rel_err(std::numeric_limits<Real>::quiet_NaN());
-            for(Integer i=-2;i<=5;i++){
-
-                // Calculate the directional derivative
-                Real epsilon=pow(Real(.1),int(i));
-                directionalDerivative <> (f,x,dx,dy,epsilon,res);
+            // Compute an ensemble of finite difference tests
+            FiniteDifferenceTable <Real> table(
+                "Finite difference test on the 2nd-derivative adjoint of "
+                + name);
+            std::vector <X_Vector> dds;
+            directionalDerivatives <Real,XX,YY> (f,x,dx,dy,table.epsilons,
+                threads,dds);
 
+            for(auto & res : dds) {
                 // Determine the residual.  Store in res.
                 X::axpy(Real(-1.),fpps_x_dx_dy,res);
 
                 // Determine the relative error
-                Real rel_err=sqrt(X::innr(res,res))
+                table.add(sqrt(X::innr(res,res))
                     / (std::numeric_limits <Real>::epsilon()
-                    + sqrt(X::innr(fpps_x_dx_dy,fpps_x_dx_dy)));
-                
-                // Calculate the smallest relative error seen so far 
-                min_rel_err=get_smallest <> (rel_err,min_rel_err);
-
-                // Print out the differences
-                std::stringstream ss;
-                if(i<0)ss << "The relative difference (1e+" << -i <<  "): ";
-                else ss << "The relative difference (1e-" << i << "): ";
-                ss << std::scientific << std::setprecision(16) << rel_err; 
-                msg(ss.str());
+                    + sqrt(X::innr(fpps_x_dx_dy,fpps_x_dx_dy))));
             }
-            
-            // Return the function's smallest relative error
-            return min_rel_err; 
+            return table;
+        }
+
+        // Performs a finite difference test on the second-derivative-adjoint 
+        // of a vector-valued function f.  Specifically, we check
+        // (f''(x)dx)*dy using f'(x)*dy.
+        template <
+            typename Real,
+            template <typename> class XX,
+            template <typename> class YY 
+        >
+        Real secondDerivativeCheck(
+            Messaging::t const & msg,
+            VectorValuedFunction<Real,XX,YY> const & f,
+            typename XX <Real>::Vector const & x,
+            typename XX <Real>::Vector const & dx,
+            typename YY <Real>::Vector const & dy,
+            std::string const & name,
+            Natural const & threads = 1
+        ) {
+            auto table = secondDerivativeCheck <Real,XX,YY> (
+                f,x,dx,dy,name,threads);
+            table.print(msg);
+            return table.min_rel_err; 
         }
         
         // Checks the zero and innr operations 
@@ -1785,6 +2645,7 @@ namespace Optizelle{
         // Create some type shortcuts
         typedef XX <Real> X;
         typedef typename X::Vector X_Vector;
+        typedef typename Workspace <Real,XX>::Loan X_Loan;
         
         // Disallow constructors
         NO_CONSTRUCTORS(Unconstrained)
@@ -1889,6 +2750,10 @@ namespace Optizelle{
                 // Diagnostic scheme 
                 DiagnosticScheme::t dscheme;
 
+                // Number of function evaluations that the finite difference
+                // diagnostics may run concurrently
+                Natural diag_threads;
+
                 // ---------- Quasi-Newton Methods ----------
 
                 // Number of control objects to store in a quasi-Newton method
@@ -1900,6 +2765,18 @@ namespace Optizelle{
                 // Difference in prior steps
                 std::list <X_Vector> oldS;
 
+                // Inner products between the prior steps, <s_i,s_j>.  Rows
+                // and columns are ordered like oldS.  This is only maintained
+                // for the compact BFGS and SR1 representations and it is
+                // rebuilt from oldS whenever its size doesn't match.  Anything
+                // that replaces oldS or oldY must clear it.
+                std::deque <std::deque <Real>> innr_oldS_oldS;
+
+                // Inner products between the prior steps and the prior
+                // gradient differences, <s_i,y_j>.  Maintained like
+                // innr_oldS_oldS.
+                std::deque <std::deque <Real>> innr_oldS_oldY;
+
                 // ---------- Truncated CG ----------
 
                 // Current number of truncated-CG iterations taken
@@ -1924,6 +2801,12 @@ namespace Optizelle{
                 // previous.  In theory, we need 1.  In practice, 2 may help.
                 Natural trunc_orthog_iter_max;
 
+                // Method we use to solve the trust-region subproblem.  The
+                // Lanczos method stores a vector for every iteration, but
+                // generally takes better steps on nonconvex problems.  The
+                // composite-step SQP method always uses truncated CG.
+                TruncatedSolver::t trunc_solver;
+
                 // Why truncated CG was last stopped
                 TruncatedStop::t trunc_stop;
 
@@ -1973,6 +2856,10 @@ namespace Optizelle{
                 // Predicted reduction
                 Real pred;
 
+                // Number of trust-region radii whose trial steps we evaluate
+                // concurrently
+                Natural trial_radii;
+
                 // ---------- Line Search  ----------
 
                 // Base line-search step length
@@ -2002,6 +2889,27 @@ namespace Optizelle{
                 // Type of line-search 
                 LineSearchKind::t kind;
 
+                // Number of step lengths that the parallel line-search
+                // evaluates concurrently
+                Natural ls_points;
+
+                // ---------- Evaluation cache ----------
+
+                // Number of points where we remember the values of the
+                // objective and constraints as well as the objective gradient.
+                // A size of zero turns off the cache.
+                Natural eval_cache_size;
+
+                // Total number of function evaluations avoided by the cache.
+                // The cache only sees a const state, so this is mutable.
+                mutable Natural eval_cache_hits;
+
+                // ---------- Workspace ----------
+
+                // Pool of work vectors shaped like x.  This only holds
+                // temporaries, so it's not part of the restart information.
+                mutable Workspace <Real,XX> work_x;
+
                 // Initialization constructors
                 explicit t(X_Vector const & x_user) :
                     eps_grad(
@@ -2074,6 +2982,11 @@ namespace Optizelle{
                         1
                         //---trunc_orthog_iter_max1---
                     ),
+                    trunc_solver(
+                        //---trunc_solver0---
+                        TruncatedSolver::ConjugateGradient
+                        //---trunc_solver1---
+                    ),
                     trunc_stop(
                         //---trunc_stop0---
                         TruncatedStop::RelativeErrorSmall
@@ -2140,16 +3053,6 @@ namespace Optizelle{
                         X::init(x_user)
                         //---dx_old1---
                     ),
-                    oldY(
-                        //---oldY0---
-                        // Empty
-                        //---oldY1--- 
-                    ),
-                    oldS(
-                        //---oldS0---
-                        // Empty
-                        //---oldS1--- 
-                    ), 
                     f_x(
                         //---f_x0---
                         std::numeric_limits<Real>::quiet_NaN()
@@ -2165,6 +3068,26 @@ namespace Optizelle{
                         1
                         //---msg_level1---
                     ),
+                    oldY(
+                        //---oldY0---
+                        // Empty
+                        //---oldY1--- 
+                    ),
+                    oldS(
+                        //---oldS0---
+                        // Empty
+                        //---oldS1--- 
+                    ), 
+                    innr_oldS_oldS(
+                        //---innr_oldS_oldS0---
+                        // Empty
+                        //---innr_oldS_oldS1--- 
+                    ), 
+                    innr_oldS_oldY(
+                        //---innr_oldS_oldY0---
+                        // Empty
+                        //---innr_oldS_oldY1--- 
+                    ), 
                     safeguard_failed_max(
                         //---safeguard_failed_max0---
                         5 
@@ -2220,6 +3143,11 @@ namespace Optizelle{
                         std::numeric_limits<Real>::quiet_NaN()
                         //---pred1---
                     ),
+                    trial_radii(
+                        //---trial_radii0---
+                        1
+                        //---trial_radii1---
+                    ),
                     alpha0(
                         //---alpha00---
                         1.
@@ -2284,7 +3212,28 @@ namespace Optizelle{
                         //---dscheme0---
                         DiagnosticScheme::Never
                         //---dscheme1---
-                    )
+                    ),
+                    diag_threads(
+                        //---diag_threads0---
+                        1
+                        //---diag_threads1---
+                    ),
+                    ls_points(
+                        //---ls_points0---
+                        4
+                        //---ls_points1---
+                    ),
+                    eval_cache_size(
+                        //---eval_cache_size0---
+                        0
+                        //---eval_cache_size1---
+                    ),
+                    eval_cache_hits(
+                        //---eval_cache_hits0---
+                        0
+                        //---eval_cache_hits1---
+                    ),
+                    work_x()
                 {
                         //---x0---
                         X::copy(x_user,x);
@@ -2403,6 +3352,10 @@ namespace Optizelle{
                     ss << "The maximum number of orthogonalization iterations "
                         "that truncated-CG computes must be positive: " <<
                         state.trunc_orthog_iter_max;
+
+                    //---trunc_solver_valid0---
+                    // Any 
+                    //---trunc_solver_valid1---
                     
                     //---trunc_stop_valid0---
                     // Any 
@@ -2488,6 +3441,14 @@ namespace Optizelle{
                     //---oldS_valid0---
                     // Any 
                     //---oldS_valid1---
+                    
+                    //---innr_oldS_oldS_valid0---
+                    // Any 
+                    //---innr_oldS_oldS_valid1---
+                    
+                    //---innr_oldS_oldY_valid0---
+                    // Any 
+                    //---innr_oldS_oldY_valid1---
 
                 // Check that the objective value isn't a NaN past
                 // iteration 1
@@ -2584,6 +3545,15 @@ namespace Optizelle{
                     //---pred_valid0---
                     // Any 
                     //---pred_valid1---
+
+                // Check that we try at least one trust-region radius at a time
+                else if(!(
+                    //---trial_radii_valid0---
+                    state.trial_radii > 0
+                    //---trial_radii_valid1---
+                ))
+                    ss << "The number of trial radii must be positive: "
+                        "trial_radii = " << state.trial_radii;
                     
                 // Check that the base line-search step length is nonnegative 
                 else if(!(
@@ -2662,6 +3632,15 @@ namespace Optizelle{
                         "be set to SteepestDescent: dir = "
                         << LineSearchDirection::to_string(state.dir);
                 }
+
+                // Check that we evaluate at least one step length at a time
+                else if(!(
+                    //---ls_points_valid0---
+                    state.ls_points > 0
+                    //---ls_points_valid1---
+                ))
+                    ss << "The number of step lengths evaluated at once must "
+                        "be positive: ls_points = " << state.ls_points;
                     //---f_diag_valid0---
                     // Any 
                     //---f_diag_valid1---
@@ -2678,6 +3657,23 @@ namespace Optizelle{
                     // Any 
                     //---dscheme_valid1---
 
+                // Check that we use at least one thread for the diagnostics
+                else if(!(
+                    //---diag_threads_valid0---
+                    state.diag_threads > 0
+                    //---diag_threads_valid1---
+                ))
+                    ss << "The number of diagnostic threads must be "
+                        "positive: diag_threads = " << state.diag_threads;
+
+                    //---eval_cache_size_valid0---
+                    // Any 
+                    //---eval_cache_size_valid1---
+
+                    //---eval_cache_hits_valid0---
+                    // Any 
+                    //---eval_cache_hits_valid1---
+
                 // If there's an error, print it
                 if(ss.str()!="")
                     throw Exception::t(__LOC__ + ", " + ss.str());
@@ -2736,6 +3732,7 @@ namespace Optizelle{
                     item.first == "iter_max" || 
                     item.first == "glob_iter" || 
                     item.first == "glob_iter_max" ||
+                    item.first == "trial_radii" ||
                     item.first == "glob_iter_total" || 
                     item.first == "trunc_iter" || 
                     item.first == "trunc_iter_max" ||
@@ -2748,7 +3745,11 @@ namespace Optizelle{
                     item.first == "safeguard_failed_total" ||
                     item.first == "ls_iter" || 
                     item.first == "ls_iter_max" ||
-                    item.first == "ls_iter_total" 
+                    item.first == "ls_iter_total" ||
+                    item.first == "ls_points" ||
+                    item.first == "diag_threads" ||
+                    item.first == "eval_cache_size" ||
+                    item.first == "eval_cache_hits"
                 ) 
                     return true;
                 else
@@ -2782,7 +3783,9 @@ namespace Optizelle{
                     (item.first=="dscheme" &&
                         DiagnosticScheme::is_valid(item.second)) ||
                     (item.first=="eps_kind" &&
-                        ToleranceKind::is_valid(item.second))
+                        ToleranceKind::is_valid(item.second)) ||
+                    (item.first=="trunc_solver" &&
+                        TruncatedSolver::is_valid(item.second))
                 )
                     return true;
                 else
@@ -2902,6 +3905,8 @@ namespace Optizelle{
                 nats.emplace_back("glob_iter",std::move(state.glob_iter));
                 nats.emplace_back("glob_iter_max",
                     std::move(state.glob_iter_max));
+                nats.emplace_back("trial_radii",
+                    std::move(state.trial_radii));
                 nats.emplace_back("glob_iter_total",
                     std::move(state.glob_iter_total));
                 nats.emplace_back("trunc_iter",std::move(state.trunc_iter));
@@ -2926,6 +3931,14 @@ namespace Optizelle{
                     std::move(state.ls_iter_max));
                 nats.emplace_back("ls_iter_total",
                     std::move(state.ls_iter_total));
+                nats.emplace_back("ls_points",
+                    std::move(state.ls_points));
+                nats.emplace_back("diag_threads",
+                    std::move(state.diag_threads));
+                nats.emplace_back("eval_cache_size",
+                    std::move(state.eval_cache_size));
+                nats.emplace_back("eval_cache_hits",
+                    std::move(state.eval_cache_hits));
 
                 // Copy in all the parameters
                 params.emplace_back("algorithm_class",
@@ -2953,6 +3966,8 @@ namespace Optizelle{
                 params.emplace_back("eps_kind",
                     ToleranceKind::to_string(
                         state.eps_kind));
+                params.emplace_back("trunc_solver",
+                    TruncatedSolver::to_string(state.trunc_solver));
             }
 
             // Copy in all variables.  This assumes that the quasi-Newton
@@ -2961,9 +3976,11 @@ namespace Optizelle{
                 typename State::t & state,
                 X_Vectors & xs
             ) {
-                // Clear out oldY and oldS
+                // Clear out oldY and oldS along with their inner products
                 state.oldY.clear();
                 state.oldS.clear();
+                state.innr_oldS_oldS.clear();
+                state.innr_oldS_oldY.clear();
 
                 for(typename X_Vectors::iterator item = xs.begin();
                     item!=xs.end();
@@ -3056,6 +4073,8 @@ namespace Optizelle{
                         state.glob_iter=std::move(item->second);
                     else if(item->first=="glob_iter_max")
                         state.glob_iter_max=std::move(item->second);
+                    else if(item->first=="trial_radii")
+                        state.trial_radii=std::move(item->second);
                     else if(item->first=="glob_iter_total")
                         state.glob_iter_total=std::move(item->second);
                     else if(item->first=="trunc_iter")
@@ -3082,6 +4101,14 @@ namespace Optizelle{
                         state.ls_iter_max=std::move(item->second);
                     else if(item->first=="ls_iter_total")
                         state.ls_iter_total=std::move(item->second);
+                    else if(item->first=="ls_points")
+                        state.ls_points=std::move(item->second);
+                    else if(item->first=="diag_threads")
+                        state.diag_threads=std::move(item->second);
+                    else if(item->first=="eval_cache_size")
+                        state.eval_cache_size=std::move(item->second);
+                    else if(item->first=="eval_cache_hits")
+                        state.eval_cache_hits=std::move(item->second);
                 }
                     
                 // Next, copy in any parameters 
@@ -3122,6 +4149,9 @@ namespace Optizelle{
                     else if(item->first=="eps_kind")
                         state.eps_kind
                             = ToleranceKind::from_string(item->second);
+                    else if(item->first=="trunc_solver")
+                        state.trunc_solver
+                            = TruncatedSolver::from_string(item->second);
                 }
             }
             
@@ -3279,10 +4309,14 @@ namespace Optizelle{
                 // Stored quasi-Newton information
                 std::list<X_Vector> const & oldY;
                 std::list<X_Vector> const & oldS;
+
+                // Workspace for the temporaries
+                Workspace <Real,XX> & work_x;
             public:
                 BFGS(
                     typename State::t const & state
-                ) : oldY(state.oldY), oldS(state.oldS) {};
+                ) : oldY(state.oldY), oldS(state.oldS),
+                    work_x(state.work_x) {};
 
                 // Operator interface
                 /* It's not entirely clear to me what the best implementation
@@ -3308,11 +4342,6 @@ namespace Optizelle{
                         "number of stored gradient differences must equal "
                         "the number of stored trial step differences");
 
-                    // Allocate memory for work
-                    std::list <X_Vector> work;
-                    for(Natural i=0;i<oldY.size();i++)
-                        work.emplace_back(std::move(X::init(dx)));
-
                     // If we have no vectors in our history, we return the
                     // direction
                     X::copy(dx,result);
@@ -3332,6 +4361,14 @@ namespace Optizelle{
                                 "possesed a nonpositive inner product");
                     }
 
+                    // Borrow memory for work.  We give it back at the end.
+                    std::list <X_Vector> work;
+                    {
+                        X_Loan loan(work_x);
+                        for(Natural i=0;i<oldY.size();i++)
+                            loan.keep(loan.vector(dx),work);
+                    }
+
                     // Othwerwise, we copy all of the trial step differences
                     // into the work space
                     typename std::list <X_Vector>::iterator Bisj_iter
@@ -3435,144 +4472,322 @@ namespace Optizelle{
                         // Increment i and adjust Bisi
                         Bisi_iter--;
                     }
+
+                    // Return the memory for work
+                    while(!work.empty())
+                        work_x.recycle(work,work.begin());
                 }
             };
 
-            // The SR1 Hessian approximation.  
-            class SR1 : public Operator <Real,XX,XX> {
+            // Computes the inner products <s_i,s_j> and <s_i,y_j> between all
+            // of the stored quasi-Newton pairs
+            static void innr_quasi(
+                std::list <X_Vector> const & oldS,
+                std::list <X_Vector> const & oldY,
+                std::deque <std::deque <Real>> & innr_oldS_oldS,
+                std::deque <std::deque <Real>> & innr_oldS_oldY
+            ) {
+                innr_oldS_oldS.clear();
+                innr_oldS_oldY.clear();
+                for(auto const & s_i : oldS) {
+                    innr_oldS_oldS.emplace_back();
+                    innr_oldS_oldY.emplace_back();
+                    auto y_j = oldY.cbegin();
+                    for(auto const & s_j : oldS) {
+                        innr_oldS_oldS.back().emplace_back(X::innr(s_i,s_j));
+                        innr_oldS_oldY.back().emplace_back(X::innr(s_i,*y_j));
+                        y_j++;
+                    }
+                }
+            }
+
+            // The BFGS Hessian approximation using the compact representation
+            // from "Representations of quasi-Newton matrices and their use in
+            // limited memory methods" by Byrd, Nocedal, and Schnabel.  With
+            // B0 = I, we have
+            //
+            // B = I - [S Y] [ S'S  L ]^{-1} [ S' ]
+            //               [ L'  -D ]      [ Y' ]
+            //
+            // where D = diag(<s_i,y_i>) and L_ij = <s_i,y_j> when the pair i
+            // is newer than the pair j and zero otherwise.  The inner products
+            // between the pairs are cached in the state, so each application
+            // only requires 2m inner products and 2m axpys.  The small system
+            // is solved by eliminating the second block, which leaves the
+            // positive definite matrix T = S'S + L inv(D) L'.
+            class CompactBFGS : public Operator <Real,XX,XX> {
             private:
                 // Stored quasi-Newton information
                 std::list<X_Vector> const & oldY;
                 std::list<X_Vector> const & oldS;
+                std::deque <std::deque <Real>> const & innr_oldS_oldS;
+                std::deque <std::deque <Real>> const & innr_oldS_oldY;
+
+                // Inner products computed locally when the cached ones are
+                // out of sync with the stored pairs
+                mutable std::deque <std::deque <Real>> innr_oldS_oldS_work;
+                mutable std::deque <std::deque <Real>> innr_oldS_oldY_work;
+
+                // Work space for the small, dense system.  These only grow,
+                // so repeated applications don't allocate memory. 
+                mutable std::vector <Real> T;
+                mutable std::vector <Real> p;
             public:
-                SR1(
+                CompactBFGS(
                     typename State::t const & state
-                ) : oldY(state.oldY), oldS(state.oldS) {};
-                
+                ) : oldY(state.oldY), oldS(state.oldS),
+                    innr_oldS_oldS(state.innr_oldS_oldS),
+                    innr_oldS_oldY(state.innr_oldS_oldY),
+                    innr_oldS_oldS_work(),
+                    innr_oldS_oldY_work(),
+                    T(),
+                    p()
+                {};
+
                 // Operator interface
-                void eval(X_Vector const & dx,X_Vector & result) const {
+                void eval(X_Vector const & dx, X_Vector & result) const{
 
                     // Check that the number of stored gradient and trial step
                     // differences is the same.
                     if(oldY.size() != oldS.size())
-                        throw Exception::t(__LOC__
-                            + ", in the SR1 Hessian approximation, the "
+                        throw Exception::t(__LOC__ +
+                            ", in the compact BFGS Hessian approximation, the "
                             "number of stored gradient differences must equal "
                             "the number of stored trial step differences");
 
-                    // Allocate memory for work
-                    std::list <X_Vector> work;
-                    for(Natural i=0;i<oldY.size();i++)
-                        work.emplace_back(std::move(X::init(dx)));
-                    X_Vector yi_m_Bisi(X::init(dx));
-
-                    // If we have no vectors in our history, we return the 
+                    // If we have no vectors in our history, we return the
                     // direction
                     X::copy(dx,result);
-                    if(oldY.size() == 0) return;
-
-                    // Othwerwise, we copy all of the trial step differences 
-                    // into the work space
-                    typename std::list <X_Vector>::iterator Bisj_iter
-                        =work.begin();
-                    typename std::list <X_Vector>::const_iterator sk_iter
-                        =oldS.begin();
-                    while(Bisj_iter!=work.end())
-                        X::copy((*sk_iter++),(*Bisj_iter++));
-
-                    // Keep track of the element Bisi
-                    typename std::list <X_Vector>::const_iterator Bisi_iter
-                        =work.end(); Bisi_iter--;
-
-                    // Keep iterating until Bisi equals the first element in the
-                    // work list. This means we have computed B1s1, B2s2, ...,
-                    // Bksk.
-                    Bisj_iter=work.begin();
-                    typename std::list <X_Vector>::const_iterator si_iter
-                        =oldS.end(); si_iter--;
-                    typename std::list <X_Vector>::const_iterator yi_iter
-                        =oldY.end(); yi_iter--;
-                    typename std::list <X_Vector>::const_iterator sj_iter
-                        =oldS.begin();
-                    while(true){
-
-                        // Create some reference to our iterators that are 
-                        // easier to work with
-                        X_Vector const & si=*si_iter;
-                        X_Vector const & yi=*yi_iter;
-                        X_Vector const & Bisi=*Bisi_iter;
-
-                        // Determine yi-Bisi
-                        X::copy(yi,yi_m_Bisi);
-                        X::axpy(Real(-1.),Bisi,yi_m_Bisi);
-                        
-                        // Determine <yi-Bisi,dx>
-                        Real inner_yimBisi_dx(X::innr(yi_m_Bisi,dx));
+                    Natural const m = oldS.size();
+                    if(m == 0) return;
+
+                    // Grab the inner products between the pairs.  In case
+                    // the cache is out of sync, such as after a restart, we
+                    // compute them directly.
+                    auto const cached =
+                        innr_oldS_oldS.size()==m && innr_oldS_oldY.size()==m;
+                    if(!cached)
+                        innr_quasi(oldS,oldY,
+                            innr_oldS_oldS_work,innr_oldS_oldY_work);
+                    auto const & SS = cached ?
+                        innr_oldS_oldS : innr_oldS_oldS_work;
+                    auto const & SY = cached ?
+                        innr_oldS_oldY : innr_oldS_oldY_work;
 
-                        // Determine <yi-Bisi,si>
-                        Real inner_yimBisi_si(X::innr(yi_m_Bisi,si));
+                    // As a safety check, insure that the inner product
+                    // between all the (s,y) pairs is positive
+                    for(Natural i=0;i<m;i++)
+                        if(SY[i][i] <= Real(0.))
+                            throw Exception::t(__LOC__
+                                + ", detected a (s,y) pair in BFGS that "
+                                "possesed a nonpositive inner product");
 
-                        // Determine <yi-Bisi,dx>/<y_i-Bisi,si>.
-                        // Store in alpha
-                        Real alpha=inner_yimBisi_dx/inner_yimBisi_si;
+                    // Form T = S'S + L inv(D) L'.  Since the newest pairs
+                    // come first, L_ij is nonzero only when i<j.
+                    T.resize(m*m);
+                    for(Natural j=1;j<=m;j++)
+                        for(Natural i=1;i<=j;i++) {
+                            auto Tij = SS[i-1][j-1];
+                            for(Natural k=j+1;k<=m;k++)
+                                Tij += SY[i-1][k-1]*SY[j-1][k-1]/SY[k-1][k-1];
+                            T[ijtok(i,j,m)] = Tij;
+                        }
 
-                        // Determine alpha y_i + Bi dx.  Store in result (which
-                        // accumulate Bi dx).
-                        X::axpy(alpha,yi,result);
+                    // Factor T = U'U
+                    Integer info(0);
+                    potrf <Real> ('U',m,&(T[0]),m,info);
+                    if(info != 0)
+                        throw Exception::t(__LOC__
+                            + ", unable to factor the middle matrix in the "
+                            "compact BFGS Hessian approximation");
+
+                    // Find p = [ S' dx ; Y' dx ]
+                    p.resize(2*m);
+                    auto s_i = oldS.cbegin();
+                    auto y_i = oldY.cbegin();
+                    for(Natural i=0;i<m;i++) {
+                        p[i] = X::innr(*s_i++,dx);
+                        p[m+i] = X::innr(*y_i++,dx);
+                    }
 
-                        // Then, add -alpha*Bisi to this result
-                        X::axpy(-alpha,Bisi,result);
+                    // p1 <- S'dx + L inv(D) Y'dx
+                    for(Natural i=0;i<m;i++)
+                        for(Natural k=i+1;k<m;k++)
+                            p[i] += SY[i][k]*p[m+k]/SY[k][k];
+
+                    // p1 <- inv(T) p1 
+                    trsv <Real> ('U','T','N',m,&(T[0]),m,&(p[0]),1);
+                    trsv <Real> ('U','N','N',m,&(T[0]),m,&(p[0]),1);
+
+                    // p2 <- inv(D) (L' p1 - Y'dx)
+                    for(Natural k=0;k<m;k++) {
+                        auto Lp1 = Real(0.);
+                        for(Natural i=0;i<k;i++)
+                            Lp1 += SY[i][k]*p[i];
+                        p[m+k] = (Lp1-p[m+k])/SY[k][k];
+                    }
 
-                        // Check whether or not we've calculated B_{i+1}p for 
-                        // the last time
-                        if(Bisi_iter==work.begin()) break;
+                    // result <- dx - S p1 - Y p2
+                    s_i = oldS.cbegin();
+                    y_i = oldY.cbegin();
+                    for(Natural i=0;i<m;i++) {
+                        X::axpy(-p[i],*s_i++,result);
+                        X::axpy(-p[m+i],*y_i++,result);
+                    }
+                }
+            };
 
-                        // Begin the calculation of B_{i+1}sj
-                        while(si_iter!=sj_iter){
-                            // Add some additional references to the iterators 
-                            X_Vector const & sj=*sj_iter;
-                            X_Vector & Bisj=*Bisj_iter;
+            // Factors the middle matrix of the compact SR1 representation
+            //
+            // M = D + L + L' - S'S
+            //
+            // using an LDL' factorization without pivoting.  Here, we order
+            // the pairs from oldest to newest, so the pivots are the SR1
+            // curvature measures <s_i,y_i-B_i s_i> where B_i is the SR1
+            // approximation built from the pairs older than i.  We store the
+            // unit lower triangular factor below the diagonal of LD and the
+            // pivots on the diagonal.
+            static void factor_sr1(
+                std::deque <std::deque <Real>> const & innr_oldS_oldS,
+                std::deque <std::deque <Real>> const & innr_oldS_oldY,
+                std::vector <Real> & LD
+            ) {
+                // Create some shortcuts.  Since oldS and oldY store the
+                // newest pair first, the ith oldest pair is at m-i.
+                auto const & SS = innr_oldS_oldS;
+                auto const & SY = innr_oldS_oldY;
+                Natural const m = SS.size();
+                LD.resize(m*m);
+
+                // M_ij where the pair j is at least as new as the pair i
+                auto M = [&](Natural const & i,Natural const & j) {
+                    return SY[m-j][m-i] - SS[m-i][m-j];
+                };
 
-                            // Determine <yi-Bisi,sj>
-                            Real inner_yimBisi_sj(X::innr(yi_m_Bisi,sj));
+                // Factor column by column
+                for(Natural j=1;j<=m;j++) {
+                    auto d = M(j,j);
+                    for(Natural k=1;k<j;k++)
+                        d -= sq(LD[ijtok(j,k,m)])*LD[ijtok(k,k,m)];
+                    LD[ijtok(j,j,m)] = d;
+
+                    for(Natural i=j+1;i<=m;i++) {
+                        auto l = M(j,i);
+                        for(Natural k=1;k<j;k++)
+                            l -= LD[ijtok(i,k,m)]*LD[ijtok(j,k,m)]
+                                *LD[ijtok(k,k,m)];
+                        LD[ijtok(i,j,m)] = l/d;
+                    }
+                }
+            }
 
-                            // Determine <yi-Bisj,sj> / <yi-Bisi,si>.
-                            // Store in beta.
-                            //
-                            // CHECK THIS FORMULA
-                            Real beta = inner_yimBisi_sj / inner_yimBisi_si;
-                        
-                            // Determine beta y_i + Bisj.  Store in Bisj. 
-                            X::axpy(beta,yi,Bisj);
+            // Solves M x = b in place using the factorization from factor_sr1
+            static void solve_sr1(
+                Natural const & m,
+                std::vector <Real> const & LD,
+                Real * x
+            ) {
+                // x <- inv(L) x
+                for(Natural j=1;j<=m;j++)
+                    for(Natural i=j+1;i<=m;i++)
+                        x[i-1] -= LD[ijtok(i,j,m)]*x[j-1];
 
-                            // Add -beta*Bisi to this result
-                            X::axpy(-beta,Bisi,Bisj);
+                // x <- inv(D) x
+                for(Natural i=1;i<=m;i++)
+                    x[i-1] /= LD[ijtok(i,i,m)];
 
-                            // Change j to be j-1 and adjust Bisj and sj 
-                            // accordingly
-                            sj_iter++;
-                            Bisj_iter++;
-                        }
+                // x <- inv(L') x
+                for(Natural j=m;j>=1;j--)
+                    for(Natural i=j+1;i<=m;i++)
+                        x[j-1] -= LD[ijtok(i,j,m)]*x[i-1];
+            }
 
-                        // At this point, we've computed all Bisj entries on the
-                        // current row.  As a result, we increment i and set j 
-                        // to be k.  This requires us to modify si, yi, sj, 
-                        // Bisj, and Bisi accordingly.
-                        
-                        // Increment i and adjust si
-                        si_iter--;
+            // The SR1 Hessian approximation.  We use the compact
+            // representation from Byrd, Nocedal, and Schnabel.  With B0 = I,
+            // we have
+            //
+            // B = I + (Y-S) inv(D + L + L' - S'S) (Y-S)'
+            //
+            // where D and L are defined as in the compact BFGS
+            // representation.  Like there, the inner products between the
+            // pairs are cached in the state, so each application only
+            // requires 2m inner products and 2m axpys.
+            class SR1 : public Operator <Real,XX,XX> {
+            private:
+                // Stored quasi-Newton information
+                std::list<X_Vector> const & oldY;
+                std::list<X_Vector> const & oldS;
+                std::deque <std::deque <Real>> const & innr_oldS_oldS;
+                std::deque <std::deque <Real>> const & innr_oldS_oldY;
 
-                        // Increment i and adjust yi
-                        yi_iter--;
+                // Inner products computed locally when the cached ones are
+                // out of sync with the stored pairs
+                mutable std::deque <std::deque <Real>> innr_oldS_oldS_work;
+                mutable std::deque <std::deque <Real>> innr_oldS_oldY_work;
 
-                        // Set j=k and adjust sj
-                        sj_iter=oldS.begin();
+                // Work space for the small, dense system
+                mutable std::vector <Real> LD;
+                mutable std::vector <Real> p;
+            public:
+                SR1(
+                    typename State::t const & state
+                ) : oldY(state.oldY), oldS(state.oldS),
+                    innr_oldS_oldS(state.innr_oldS_oldS),
+                    innr_oldS_oldY(state.innr_oldS_oldY),
+                    innr_oldS_oldS_work(),
+                    innr_oldS_oldY_work(),
+                    LD(),
+                    p()
+                {};
+                
+                // Operator interface
+                void eval(X_Vector const & dx,X_Vector & result) const {
 
-                        // Set j=k, increment i, and adjust Bisj
-                        Bisj_iter=work.begin();
+                    // Check that the number of stored gradient and trial step
+                    // differences is the same.
+                    if(oldY.size() != oldS.size())
+                        throw Exception::t(__LOC__
+                            + ", in the SR1 Hessian approximation, the "
+                            "number of stored gradient differences must equal "
+                            "the number of stored trial step differences");
 
-                        // Increment i and adjust Bisi
-                        Bisi_iter--;
+                    // If we have no vectors in our history, we return the 
+                    // direction
+                    X::copy(dx,result);
+                    Natural const m = oldS.size();
+                    if(m == 0) return;
+
+                    // Grab the inner products between the pairs.  In case
+                    // the cache is out of sync, such as after a restart, we
+                    // compute them directly.
+                    auto const cached =
+                        innr_oldS_oldS.size()==m && innr_oldS_oldY.size()==m;
+                    if(!cached)
+                        innr_quasi(oldS,oldY,
+                            innr_oldS_oldS_work,innr_oldS_oldY_work);
+
+                    // Factor the middle matrix
+                    factor_sr1(
+                        cached ? innr_oldS_oldS : innr_oldS_oldS_work,
+                        cached ? innr_oldS_oldY : innr_oldS_oldY_work,
+                        LD);
+
+                    // Find p = (Y-S)' dx with the oldest pair first
+                    p.resize(m);
+                    auto s_i = oldS.cbegin();
+                    auto y_i = oldY.cbegin();
+                    for(Natural i=m;i>=1;i--)
+                        p[i-1] = X::innr(*y_i++,dx) - X::innr(*s_i++,dx);
+
+                    // p <- inv(M) p
+                    solve_sr1(m,LD,&(p[0]));
+
+                    // result <- dx + (Y-S) p
+                    s_i = oldS.cbegin();
+                    y_i = oldY.cbegin();
+                    for(Natural i=m;i>=1;i--) {
+                        X::axpy(p[i-1],*y_i++,result);
+                        X::axpy(-p[i-1],*s_i++,result);
                     }
                 }
             };
@@ -3716,6 +4931,9 @@ namespace Optizelle{
                         case Operators::BFGS:
                             H.reset(new BFGS(state));
                             break;
+                        case Operators::CompactBFGS:
+                            H.reset(new CompactBFGS(state));
+                            break;
                         case Operators::SR1:
                             H.reset(new SR1(state));
                             break;
@@ -3738,6 +4956,18 @@ namespace Optizelle{
                         f->grad(x,grad);
                  }
 
+                 // Start computing f(x) and grad f(x) with the underlying
+                 // function
+                 std::future <Real> eval_async(X_Vector const & x) const {
+                    return f->eval_async(x);
+                 }
+                 std::future <void> grad_async(
+                     X_Vector const & x,
+                     X_Vector & grad
+                 ) const {
+                    return f->grad_async(x,grad);
+                 }
+
                  // H_dx = hess f(x) dx 
                  // This actually computes the Hessian-vector product.  In 
                  // essence, we may want to use a Hessian approximation 
@@ -3749,11 +4979,25 @@ namespace Optizelle{
                      X_Vector const & dx,
                      X_Vector & H_dx 
                  ) const {
-                     if(H.get()!=nullptr) 
+                     if(H.get()!=nullptr)
                         H->eval(dx,H_dx);
                      else
                         f->hessvec(x,dx,H_dx);
                  }
+
+                 // H_dxs[j] = hess f(x) dxs[j] for each j.  When we use the
+                 // user's hessvec, pass the whole batch along.
+                 virtual void hessvec_many(
+                     X_Vector const & x,
+                     std::vector <X_Vector const *> const & dxs,
+                     std::vector <X_Vector *> const & H_dxs
+                 ) const {
+                     if(H.get()!=nullptr)
+                        for(Natural j=0;j<dxs.size();j++)
+                            H->eval(*(dxs[j]),*(H_dxs[j]));
+                     else
+                        f->hessvec_many(x,dxs,H_dxs);
+                 }
             };
 
             // Don't do a safeguard search
@@ -3843,6 +5087,19 @@ namespace Optizelle{
                 // objective).
                 check(fns);
 
+                // Give the outputs of the objective new versions when the
+                // vector space tracks them
+                if(has_version <X>::value)
+                    fns.f.reset(new TouchedScalarValuedFunction <Real,XX> (
+                        std::move(fns.f)));
+
+                // Remember the objective at the last few points
+                if(state.eval_cache_size > 0)
+                    fns.f.reset(new CachedScalarValuedFunction <Real,XX> (
+                        std::move(fns.f),
+                        state.eval_cache_size,
+                        state.eval_cache_hits));
+
                 // Modify the objective function if necessary
                 fns.f.reset(new HessianAdjustedFunction(state,fns));
 
@@ -3985,7 +5242,8 @@ namespace Optizelle{
                 // Determine some extra diagnostic information
                 Real merit_x=f_mod.merit(x,f_x);
                 Real norm_dx=sqrt(X::innr(dx,dx));
-                X_Vector grad_diag(X::init(grad));
+                X_Loan loan(state.work_x);
+                auto & grad_diag = loan.vector(grad);
                     f_mod.grad_diag(x,grad,grad_diag);
                 Real norm_grad=sqrt(X::innr(grad_diag,grad_diag));
 
@@ -4097,11 +5355,13 @@ namespace Optizelle{
                 ScalarValuedFunction <Real,XX> const & f=*(fns.f);
                 X_Vector const & x=state.x;
                 FunctionDiagnostics::t const & f_diag=state.f_diag;
+                Natural const & diag_threads=state.diag_threads;
                
-                // Create some random directions for these tests
-                X_Vector dx(X::init(x));
+                // Borrow some random directions for these tests
+                X_Loan loan(state.work_x);
+                auto & dx = loan.vector(x);
                     X::rand(dx); 
-                X_Vector dxx(X::init(x));
+                auto & dxx = loan.vector(x);
                     X::rand(dxx);
 
                 // Run the diagnostics
@@ -4110,13 +5370,16 @@ namespace Optizelle{
                         break;
                     case FunctionDiagnostics::FirstOrder:
                         msg("Diagnostics on the function f");
-                        Optizelle::Diagnostics::gradientCheck(msg,f,x,dx,"f");
+                        Optizelle::Diagnostics::gradientCheck(
+                            msg,f,x,dx,"f",diag_threads);
                         msg("");
                         break;
                     case FunctionDiagnostics::SecondOrder:
                         msg("Diagnostics on the function f");
-                        Optizelle::Diagnostics::gradientCheck(msg,f,x,dx,"f");
-                        Optizelle::Diagnostics::hessianCheck(msg,f,x,dx,"f");
+                        Optizelle::Diagnostics::gradientCheck(
+                            msg,f,x,dx,"f",diag_threads);
+                        Optizelle::Diagnostics::hessianCheck(
+                            msg,f,x,dx,"f",diag_threads);
                         Optizelle::Diagnostics::hessianSymmetryCheck(
                             msg,f,x,dx,dxx,"f");
                         msg("");
@@ -4161,8 +5424,9 @@ namespace Optizelle{
                 VectorSpaceDiagnostics::t const & x_diag=state.x_diag;
                 X_Vector const & x=state.x;
                
-                // Create some random directions for these tests
-                X_Vector dx(X::init(x));
+                // Borrow some random directions for these tests
+                X_Loan loan(state.work_x);
+                auto & dx = loan.vector(x);
                     X::rand(dx); 
 
                 // Run the diagnostics
@@ -4219,8 +5483,11 @@ namespace Optizelle{
                 auto const & glob_iter = state.glob_iter;
                 auto const & glob_iter_max = state.glob_iter_max;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Find both the norm of the gradient and the step
-                X_Vector grad_stop(X::init(grad));
+                auto & grad_stop = loan.vector(grad);
                 f_mod.grad_stop(x,grad,grad_stop);
                 const Real norm_grad=sqrt(X::innr(grad_stop,grad_stop));
                 const Real norm_dx=sqrt(X::innr(dx,dx));
@@ -4261,15 +5528,19 @@ namespace Optizelle{
                 // Store a reference to the base of the Hessian-vector product
                 X_Vector const & x;
 
-                // Allocate memory for temporaries
-                mutable X_Vector H_dx;
+                // Borrow memory for temporaries
+                X_Loan loan;
+                X_Vector & H_dx;
 
             public:
-                // Take in the objective and the base point during construction 
+                // Take in the objective, the base point, and the workspace
+                // during construction 
                 HessianOperator(
                     typename Functions::t const & fns,
-                    X_Vector const & x_)
-                : f(*(fns.f)), f_mod(*(fns.f_mod)), x(x_), H_dx(X::init(x_))
+                    X_Vector const & x_,
+                    Workspace <Real,XX> & work)
+                : f(*(fns.f)), f_mod(*(fns.f_mod)), x(x_), loan(work),
+                    H_dx(loan.vector(x_))
                 {}
 
                 // Basic application
@@ -4284,10 +5555,13 @@ namespace Optizelle{
                 }
             };
         
-            // Checks whether we accept or reject a step
+            // Checks whether we accept or reject a step given a future for
+            // the objective evaluated at x+dx.  We compute the model while
+            // the objective may still be in progress.
             static bool checkStep(
                 typename Functions::t const & fns,
-                typename State::t & state
+                typename State::t & state,
+                std::future <Real> && f_xpdx_
             ){
                 // Create some shortcuts
                 ScalarValuedFunction <Real,XX> const & f=*(fns.f);
@@ -4308,14 +5582,17 @@ namespace Optizelle{
                 // Determine merit(x)
                 Real merit_x = f_mod.merit(x,f_x);
                 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine H(x)dx
-                X_Vector H_dx(X::init(x));
+                auto & H_dx = loan.vector(x);
                     f.hessvec(x,dx,H_dx);
-                X_Vector Hdx_step(X::init(x));
+                auto & Hdx_step = loan.vector(x);
                     f_mod.hessvec_step(x,dx,H_dx,Hdx_step);
 
                 // Determine the gradient
-                X_Vector grad_step(X::init(x));
+                auto & grad_step = loan.vector(x);
                     f_mod.grad_step(x,grad,grad_step);
 
                 // Calculate the model,
@@ -4324,12 +5601,13 @@ namespace Optizelle{
                     + Real(.5)*X::innr(Hdx_step,dx);
 
                 // Determine x+dx
-                X_Vector x_p_dx(X::init(x));
+                auto & x_p_dx = loan.vector(x);
                 X::copy(dx,x_p_dx);
                 X::axpy(Real(1.),x,x_p_dx);
 
                 // Determine the merit function evaluated at x+dx
-                f_xpdx=f.eval(x_p_dx);
+                f_mod.prepare_merit(x_p_dx);
+                f_xpdx=f_xpdx_.get();
                 Real merit_xpdx=f_mod.merit(x_p_dx,f_xpdx);
 
                 // Determine the norm of the step
@@ -4358,7 +5636,8 @@ namespace Optizelle{
                     // Increase the size of the trust-region if truncated CG 
                     // reached the boundary.
                     if( trunc_stop==TruncatedStop::NegativeCurvature ||
-                        trunc_stop==TruncatedStop::TrustRegionViolated
+                        trunc_stop==TruncatedStop::TrustRegionViolated ||
+                        trunc_stop==TruncatedStop::ConvergedOnBoundary
                     ) 
                         delta*=Real(2.);
                     return true;
@@ -4369,6 +5648,33 @@ namespace Optizelle{
                     return false;
                 }
             }
+
+            // Checks whether we accept or reject a step given the objective
+            // evaluated at x+dx
+            static bool checkStep(
+                typename Functions::t const & fns,
+                typename State::t & state,
+                Real const & f_xpdx_
+            ){
+                std::promise <Real> f_xpdx;
+                f_xpdx.set_value(f_xpdx_);
+                return checkStep(fns,state,f_xpdx.get_future());
+            }
+
+            // Checks whether we accept or reject a step
+            static bool checkStep(
+                typename Functions::t const & fns,
+                typename State::t & state
+            ){
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
+                // Start evaluating the objective at x+dx
+                auto & x_p_dx = loan.vector(state.x);
+                X::copy(state.dx,x_p_dx);
+                X::axpy(Real(1.),state.x,x_p_dx);
+                return checkStep(fns,state,fns.f->eval_async(x_p_dx));
+            }
         
             // Finds the trust-region step
             static void getStepTR(
@@ -4391,12 +5697,14 @@ namespace Optizelle{
                     = state.trunc_orthog_storage_max;
                 auto const & trunc_orthog_iter_max
                     = state.trunc_orthog_iter_max;
+                auto const & trunc_solver = state.trunc_solver;
                 Real const & delta=state.delta;
                 X_Vector const & x=state.x;
                 X_Vector const & grad=state.grad;
                 Real const & norm_dxtyp=state.norm_dxtyp;
                 auto const & safeguard_failed_max = state.safeguard_failed_max;
                 auto const & glob_iter_max = state.glob_iter_max;
+                Natural const & trial_radii=state.trial_radii;
                 X_Vector & dx=state.dx;
                 Natural & trunc_iter=state.trunc_iter;
                 Natural & trunc_iter_total=state.trunc_iter_total;
@@ -4412,25 +5720,28 @@ namespace Optizelle{
                 auto & glob_iter = state.glob_iter;
                 auto & glob_iter_total = state.glob_iter_total;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Allocate a little bit of work space
-                X_Vector x_tmp1(X::init(x));
+                auto & x_tmp1 = loan.vector(x);
 
                 // Allocate memory for the Cauchy point and truncated Newton
                 // points
-                auto dx_cp = X::init(x);
-                auto dx_n = X::init(x);
+                auto & dx_cp = loan.vector(x);
+                auto & dx_n = loan.vector(x);
 
                 // Find -grad f(x)
-                X_Vector grad_step(X::init(x));
+                auto & grad_step = loan.vector(x);
                     f_mod.grad_step(x,grad,grad_step);
                 if(gradmod(grad_step,Real(0.),true))
                     f_mod.grad_step(x,grad,grad_step);
-                X_Vector minus_grad(X::init(x));
-                    X::copy(grad_step,minus_grad);
-                    X::scal(Real(-1.),minus_grad);
+                auto & minus_grad = loan.vector(x);
+                    FusedOps <Real,XX>::copy_scal(
+                        Real(-1.),grad_step,minus_grad);
 
                 // Create the Hessian operator
-                HessianOperator H(fns,x);
+                HessianOperator H(fns,x,state.work_x);
 
                 // Manipulate the state if required
                 smanip.eval(fns,state,OptimizationLocation::BeforeGetStep);
@@ -4450,30 +5761,60 @@ namespace Optizelle{
                         std::placeholders::_2,
                         Real(1.)));
 
+                // When we use GLTR, keep the Krylov space, so that we can
+                // resolve the trust-region subproblem without additional
+                // Hessian-vector products if we reject the step
+                auto & qs = loan.multivector();
+                auto D = std::vector <Real> ();
+                auto E = std::vector <Real> ();
+
                 // Find the trial step 
-                truncated_cg(
-                    H,
-                    minus_grad,
-                    PH,
-                    eps_trunc,
-                    trunc_iter_max,
-                    trunc_orthog_storage_max,
-                    trunc_orthog_iter_max,
-                    delta,
-                    x_tmp1,
-                    safeguard_failed_max,
-                    simplified_safeguard,
-                    false,
-                    true,
-                    true,
-                    dx_n,
-                    dx_cp,
-                    residual_err0,
-                    residual_err,
-                    trunc_iter,
-                    trunc_stop,
-                    safeguard_failed,
-                    alpha_x);
+                if(trunc_solver == TruncatedSolver::Lanczos)
+                    gltr(
+                        H,
+                        minus_grad,
+                        PH,
+                        eps_trunc,
+                        trunc_iter_max,
+                        delta,
+                        simplified_safeguard,
+                        dx_n,
+                        dx_cp,
+                        residual_err0,
+                        residual_err,
+                        trunc_iter,
+                        trunc_stop,
+                        safeguard_failed,
+                        alpha_x,
+                        qs,
+                        D,
+                        E,
+                        state.work_x);
+                else
+                    truncated_cg(
+                        H,
+                        minus_grad,
+                        PH,
+                        eps_trunc,
+                        trunc_iter_max,
+                        trunc_orthog_storage_max,
+                        trunc_orthog_iter_max,
+                        delta,
+                        x_tmp1,
+                        safeguard_failed_max,
+                        simplified_safeguard,
+                        false,
+                        true,
+                        true,
+                        dx_n,
+                        dx_cp,
+                        residual_err0,
+                        residual_err,
+                        trunc_iter,
+                        trunc_stop,
+                        safeguard_failed,
+                        alpha_x,
+                        state.work_x);
 
                 // Calculate the truncated CG error
                 trunc_err = residual_err / residual_err0;
@@ -4482,72 +5823,177 @@ namespace Optizelle{
                 // Keep track of the number of failed safeguard steps
                 safeguard_failed_total+=safeguard_failed;
 
-                // Find the Newton shift, dx_dnewton = dx_newton-dx_cp.  We
-                // use this in the dogleg computation if required.
-                auto dx_dnewton = X::init(x);
+                // Find the Newton shift, dx_dnewton = dx_newton-dx_cp, and
+                // its squared norm.  We use this in the dogleg computation if
+                // required.
+                auto & dx_dnewton = loan.vector(x);
                 X::copy(dx_n,dx_dnewton);
-                X::axpy(Real(-1.),dx_cp,dx_dnewton);
+                auto norm_dxdnewton_2 = FusedOps <Real,XX>::axpy_innr(
+                    Real(-1.),dx_cp,dx_dnewton,dx_dnewton);
                 
                 // Find || dx_cp|| and || dx_n ||.  We use this in the dogleg
                 // computation if required.
                 auto norm_dxcp = std::sqrt(X::innr(dx_cp,dx_cp));
                 auto norm_dxn = std::sqrt(X::innr(dx_n,dx_n));
 
-                // Continue to look for a step until one comes back as valid
-                for( glob_iter=1;
-                     glob_iter<=glob_iter_max;
-                     glob_iter++
+                // Computes the trial step for the trust-region radius
+                // radius.  When we use GLTR, we already have the step for
+                // the first radius.  After that, we resolve the trust-region
+                // subproblem on the same Krylov space with the smaller
+                // radius.  Otherwise, we compute the dogleg step.  There are
+                // three cases
+                //
+                // 1.  || dx_cp || >= radius
+                //
+                //     Here, we set
+                //
+                //     dx = (radius / || dx_cp || ) dx_np
+                //
+                // 2.  || dx_n || <= radius
+                //
+                //     Here, we set
+                //
+                //     dx = dx_n
+                //
+                // 3.  || dx_n || > radius > || dx_cp ||
+                //
+                //     Here, we find theta such that 
+                //
+                //     || dx_cp + theta dx_dnewton || = radius
+                //
+                //     and then set
+                //
+                //     dx = dx_cp + theta dx_dnewton
+                //
+                // Note, this only works when both dx_n and dx_cp are both
+                // feasible with respect to the safeguard.
+                auto trial_step = [&](
+                    bool const & first,
+                    Real const & radius,
+                    X_Vector & dx
                 ) {
-                    // Keep track of the number of globalization iterations
-                    glob_iter_total++;
-
-                    // Compute the dogleg step.  There are three cases
-                    //
-                    // 1.  || dx_cp || >= delta
-                    //
-                    //     Here, we set
-                    //
-                    //     dx = (delta / || dx_cp || ) dx_np
-                    //
-                    // 2.  || dx_n || <= delta
-                    //
-                    //     Here, we set
-                    //
-                    //     dx = dx_n
-                    //
-                    // 3.  || dx_n || > delta > || dx_cp ||
-                    //
-                    //     Here, we find theta such that 
-                    //
-                    //     || dx_cp + theta dx_dnewton || = delta
-                    //
-                    //     and then set
-                    //
-                    //     dx = dx_cp + theta dx_dnewton
-                    //
-                    // Note, this only works when both dx_n and dx_cp are both
-                    // feasible with respect to the safeguard.
-                    if(norm_dxcp >= delta) {
-                        X::copy(dx_cp,dx);
-                        X::scal(delta/norm_dxcp,dx);
-                    } else if(norm_dxn <= delta) {
+                    if(trunc_solver == TruncatedSolver::Lanczos) {
+                        if(first)
+                            X::copy(dx_n,dx);
+                        else {
+                            gltr_resolve(qs,D,E,residual_err0,radius,
+                                simplified_safeguard,dx,trunc_stop,
+                                safeguard_failed,alpha_x,state.work_x);
+                        }
+                    } else if(norm_dxcp >= radius) {
+                        FusedOps <Real,XX>::copy_scal(
+                            radius/norm_dxcp,dx_cp,dx);
+                    } else if(norm_dxn <= radius) {
                         X::copy(dx_n,dx);
                     } else {
-                        auto aa = X::innr(dx_dnewton,dx_dnewton);
+                        auto aa = norm_dxdnewton_2;
                         auto bb = Real(2.) * X::innr(dx_dnewton,dx_cp);
-                        auto cc = norm_dxcp*norm_dxcp - delta*delta;
+                        auto cc = norm_dxcp*norm_dxcp - radius*radius;
                         auto roots = quad_equation(aa,bb,cc);
                         auto theta = roots[0] > roots[1] ? roots[0] : roots[1];
                         X::copy(dx_cp,dx);
                         X::axpy(theta,dx_dnewton,dx);
                     }
+                };
+
+                // Determines whether a step is so small that we're not making
+                // progress or whether it has nans in it
+                auto stalled = [&](X_Vector const & dx) {
+                    Real norm_dx = sqrt(X::innr(dx,dx));
+                    return norm_dx<eps_dx*absrel(norm_dxtyp)
+                        || norm_dx!=norm_dx;
+                };
+
+                // When we try several radii at once, we hold the trial steps
+                // along with their radii, what the subproblem solve reported
+                // for each, and the objective at each trial point
+                struct Trial {
+                    X_Vector * dx;
+                    X_Vector * x_p_dx;
+                    Real radius;
+                    TruncatedStop::t trunc_stop;
+                    Natural safeguard_failed;
+                    Real alpha_x;
+                    Real f_xpdx;
+                };
+                auto trials = std::vector <Trial> ();
+                for(Natural j=0;trial_radii > 1 && j<trial_radii;j++)
+                    trials.emplace_back(Trial{
+                        &loan.vector(x),&loan.vector(x),Real(0.),trunc_stop,
+                        safeguard_failed,alpha_x,Real(0.)});
+                auto trial = trials.size();
+                auto ntrials = trials.size();
+
+                // Continue to look for a step until one comes back as valid
+                for( glob_iter=1;
+                     glob_iter<=glob_iter_max;
+                     glob_iter++
+                ) {
+                    // Keep track of the number of globalization iterations
+                    glob_iter_total++;
+
+                    // When we try several radii at once and we've used up
+                    // the last batch, compute the trial steps for the
+                    // current radius and for each radius that we'd fall back
+                    // on if we rejected the step before it.  Then, evaluate
+                    // the objective at all of them concurrently.  We also
+                    // start a new batch when the radius no longer matches
+                    // the next trial, which happens when a state manipulator
+                    // changes delta.
+                    if(trials.size() > 0 &&
+                        (trial==ntrials || trials[trial].radius != delta)
+                    ) {
+                        auto radius = delta;
+                        ntrials = 0;
+                        while(ntrials < trials.size() &&
+                            glob_iter+ntrials <= glob_iter_max
+                        ) {
+                            auto & t = trials[ntrials];
+                            trial_step(glob_iter+ntrials==1,radius,*(t.dx));
+                            t.radius = radius;
+                            t.trunc_stop = trunc_stop;
+                            t.safeguard_failed = safeguard_failed;
+                            t.alpha_x = alpha_x;
+                            X::copy(x,*(t.x_p_dx));
+                            X::axpy(Real(1.),*(t.dx),*(t.x_p_dx));
+                            ntrials++;
+                            if(stalled(*(t.dx)))
+                                break;
+                            radius = sqrt(X::innr(*(t.dx),*(t.dx)))/Real(2.);
+                        }
+                        parallel_eval(ntrials,ntrials,[&](Natural const & j){
+                            trials[j].f_xpdx = f.eval(*(trials[j].x_p_dx));
+                        });
+                        trial = 0;
+                    }
+
+                    // Find the trial step.  When we tried several radii at
+                    // once, the radius already matches the next trial since
+                    // checkStep shrinks it the same way after a rejection.
+                    if(trials.size() > 0) {
+                        auto const & t = trials[trial];
+                        X::copy(*(t.dx),dx);
+                        trunc_stop = t.trunc_stop;
+                        safeguard_failed = t.safeguard_failed;
+                        alpha_x = t.alpha_x;
+                    } else
+                        trial_step(glob_iter==1,delta,dx);
+
+                    // Keep track of the number of failed safeguard steps when
+                    // we resolve the subproblem with GLTR.  We already
+                    // counted these for the first solve.
+                    if(trunc_solver == TruncatedSolver::Lanczos && glob_iter>1)
+                        safeguard_failed_total+=safeguard_failed;
 
                     // Manipulate the state if required
                     smanip.eval(fns,state,
                         OptimizationLocation::BeforeActualVersusPredicted);
 
                     // Check whether the step is good
-                    if(checkStep(fns,state))
+                    if(trials.size() > 0 ?
+                        checkStep(fns,state,trials[trial++].f_xpdx) :
+                        checkStep(fns,state)
+                    )
                         break;
                     
                     // Manipulate the state if required
@@ -4560,8 +6006,7 @@ namespace Optizelle{
                     // stopping conditions to terminate optimization.  We use a
                     // zero length step so that we do not modify the current
                     // iterate.
-                    Real norm_dx = sqrt(X::innr(dx,dx));
-                    if(norm_dx<eps_dx*absrel(norm_dxtyp) || norm_dx!=norm_dx) {
+                    if(stalled(dx)) {
                         X::zero(dx);
                         break;
                     }
@@ -4588,8 +6033,11 @@ namespace Optizelle{
                 X_Vector const & grad=state.grad;
                 X_Vector & dx=state.dx;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
 
                 // We take the steepest descent direction and apply the
@@ -4623,8 +6071,11 @@ namespace Optizelle{
                 // it here and fix it at the end of the routine.
                 X::scal(1./alpha,dx_old);
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
 
                 // If we're on the first iterations, we take the steepest
@@ -4674,16 +6125,19 @@ namespace Optizelle{
                 X_Vector const & grad=state.grad;
                 X_Vector const & grad_old=state.grad_old;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
-                X_Vector grad_old_step(X::init(grad));
+                auto & grad_old_step = loan.vector(grad);
                     f_mod.grad_step(x,grad_old,grad_old_step);
 
                 // Apply the preconditioner to the gradients 
-                X_Vector PH_grad_step(X::init(grad_step));
+                auto & PH_grad_step = loan.vector(grad_step);
                     PH.eval(grad_step,PH_grad_step);
-                X_Vector PH_grad_old_step(X::init(grad_old_step));
+                auto & PH_grad_old_step = loan.vector(grad_old_step);
                     PH.eval(grad_old_step,PH_grad_old_step);
 
                 // Return the momentum parameter
@@ -4704,21 +6158,24 @@ namespace Optizelle{
                 X_Vector const & grad=state.grad;
                 X_Vector const & grad_old=state.grad_old;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
-                X_Vector grad_old_step(X::init(grad));
+                auto & grad_old_step = loan.vector(grad);
                     f_mod.grad_step(x,grad_old,grad_old_step);
 
                 // Find grad-grad_old 
-                X_Vector grad_m_gradold(X::init(grad));
+                auto & grad_m_gradold = loan.vector(grad);
                 X::copy(grad_step,grad_m_gradold);
                 X::axpy(Real(-1.),grad_old_step,grad_m_gradold);
                 
                 // Apply the preconditioner to the gradients 
-                X_Vector PH_grad_step(X::init(grad_step));
+                auto & PH_grad_step = loan.vector(grad_step);
                     PH.eval(grad_step,PH_grad_step);
-                X_Vector PH_grad_old_step(X::init(grad_old_step));
+                auto & PH_grad_old_step = loan.vector(grad_old_step);
                     PH.eval(grad_old_step,PH_grad_old_step);
                     
                 // Return the momentum parameter
@@ -4741,19 +6198,22 @@ namespace Optizelle{
                 X_Vector const & grad_old=state.grad_old;
                 X_Vector const & dx_old=state.dx_old;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
-                X_Vector grad_old_step(X::init(grad));
+                auto & grad_old_step = loan.vector(grad);
                     f_mod.grad_step(x,grad_old,grad_old_step);
 
                 // Find grad-grad_old 
-                X_Vector grad_m_gradold(X::init(grad));
+                auto & grad_m_gradold = loan.vector(grad);
                 X::copy(grad_step,grad_m_gradold);
                 X::axpy(Real(-1.),grad_old_step,grad_m_gradold);
                 
                 // Apply the preconditioner to the gradient
-                X_Vector PH_grad_step(X::init(grad_step));
+                auto & PH_grad_step = loan.vector(grad_step);
                     PH.eval(grad_step,PH_grad_step);
                     
                 // Return the momentum parameter.
@@ -4775,8 +6235,11 @@ namespace Optizelle{
                 X_Vector const & grad=state.grad;
                 X_Vector & dx=state.dx;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
 
                 // Create the inverse BFGS operator
@@ -4789,15 +6252,26 @@ namespace Optizelle{
                 X::scal(Real(-1.),dx);
             }
 
+            // Evaluates the objective at x and returns the merit function
+            // there.  We evaluate the rest of the merit function while the
+            // objective may still be in progress.
+            static Real meritAt(
+                typename Functions::t const & fns,
+                X_Vector const & x,
+                Real & f_x
+            ) {
+                auto f_x_done = fns.f->eval_async(x);
+                fns.f_mod->prepare_merit(x);
+                f_x = f_x_done.get();
+                return fns.f_mod->merit(x,f_x);
+            }
+
             // Compute a Golden-Section search between 0 and alpha0. 
             static typename LineSearchTermination::t goldenSection(
                 typename Functions::t const & fns,
                 typename State::t & state
             ) {
                 // Create some shortcuts
-                ScalarValuedFunction <Real,XX> const & f=*(fns.f);
-                ScalarValuedFunctionModifications <Real,XX> const &
-                    f_mod=*(fns.f_mod);
                 X_Vector const & x=state.x;
                 X_Vector const & dx=state.dx;
                 Natural const & iter_max=state.ls_iter_max;
@@ -4807,8 +6281,11 @@ namespace Optizelle{
                 Real & f_xpdx=state.f_xpdx;
                 Real & alpha=state.alpha;
                 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Create one work element that holds x+mu dx or x+lambda dx 
-                X_Vector x_p_dx(X::init(x));
+                auto & x_p_dx = loan.vector(x);
 
                 // Find 1 over the golden ratio
                 Real beta=Real(2./(1.+sqrt(5.)));
@@ -4827,14 +6304,14 @@ namespace Optizelle{
                 // mu 
                 X::copy(x,x_p_dx);
                 X::axpy(mu,dx,x_p_dx);
-                Real f_mu=f.eval(x_p_dx);
-                Real merit_mu=f_mod.merit(x_p_dx,f_mu);
+                Real f_mu;
+                Real merit_mu=meritAt(fns,x_p_dx,f_mu);
 
                 // lambda
                 X::copy(x,x_p_dx);
                 X::axpy(lambda,dx,x_p_dx);
-                Real f_lambda=f.eval(x_p_dx);
-                Real merit_lambda=f_mod.merit(x_p_dx,f_lambda);
+                Real f_lambda;
+                Real merit_lambda=meritAt(fns,x_p_dx,f_lambda);
 
                 // Search for a fixed number of iterations.  Note, since we
                 // already evaluated the objective twice above, at mu and
@@ -4857,8 +6334,7 @@ namespace Optizelle{
 
                         X::copy(x,x_p_dx);
                         X::axpy(mu,dx,x_p_dx);
-                        f_mu=f.eval(x_p_dx);
-                        merit_mu=f_mod.merit(x_p_dx,f_mu);
+                        merit_mu=meritAt(fns,x_p_dx,f_mu);
 
                     // Otherwise, the objective is greater on the right, so
                     // bracket on the left
@@ -4872,8 +6348,7 @@ namespace Optizelle{
                 
                         X::copy(x,x_p_dx);
                         X::axpy(lambda,dx,x_p_dx);
-                        f_lambda=f.eval(x_p_dx);
-                        merit_lambda=f_mod.merit(x_p_dx,f_lambda);
+                        merit_lambda=meritAt(fns,x_p_dx,f_lambda);
                     }
                 }
 
@@ -4919,8 +6394,11 @@ namespace Optizelle{
                 // Set alpha to the base alpha 
                 alpha=alpha0;
                
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Determine x+alpha dx 
-                X_Vector x_p_adx(X::init(x));
+                auto & x_p_adx = loan.vector(x);
                     X::copy(x,x_p_adx);
                     X::axpy(alpha,dx,x_p_adx);
     
@@ -4932,6 +6410,76 @@ namespace Optizelle{
                 iter_total+=iter;
             }
 
+            // This backtracks in the same way as backTracking, but we
+            // evaluate the objective at the next ls_points step lengths,
+            // alpha0, alpha0/2, alpha0/4, ..., at once.  Then, we hand these
+            // out one at a time in the order that backTracking tries them,
+            // so that the sufficient decrease test in getStepLS accepts the
+            // same step.  We evaluate another batch once we've used up the
+            // last one or when the next step length in the batch no longer
+            // matches alpha0, which happens when a state manipulator changes
+            // alpha0.  The caller must discard the batch, by setting next to
+            // the size of alphas, when x or dx changes.
+            static void parallelBackTracking(
+                typename Functions::t const & fns,
+                typename State::t & state,
+                std::vector <Real> & alphas,
+                std::vector <Real> & f_alphas,
+                Natural & next
+            ) {
+                // Create some shortcuts
+                ScalarValuedFunction <Real,XX> const & f=*(fns.f);
+                X_Vector const & x=state.x;
+                X_Vector const & dx=state.dx;
+                Real const & alpha0=state.alpha0;
+                Natural const & ls_points=state.ls_points;
+                auto const & glob_iter = state.glob_iter;
+                auto const & glob_iter_max = state.glob_iter_max;
+                Natural & iter_total=state.ls_iter_total;
+                Natural & iter=state.ls_iter;
+                Real & f_xpdx=state.f_xpdx;
+                Real & alpha=state.alpha;
+
+                // Set alpha to the base alpha 
+                alpha=alpha0;
+
+                // Evaluate the objective at the next batch of step lengths,
+                // but not past the last globalization iteration
+                iter=0;
+                if(next==alphas.size() || alphas[next]!=alpha) {
+                    // Borrow our temporaries from the workspace
+                    X_Loan loan(state.work_x);
+
+                    // Determine x+alpha dx for each step length.  We halve
+                    // alpha in the same way that getStepLS halves alpha0.
+                    auto npoints=std::min(ls_points,glob_iter_max-glob_iter+1);
+                    auto x_p_adxs = std::vector <X_Vector *> ();
+                    alphas.assign(npoints,alpha);
+                    for(Natural j=0;j<npoints;j++) {
+                        if(j>0)
+                            alphas[j] = alphas[j-1]/Real(2.);
+                        x_p_adxs.emplace_back(&loan.vector(x));
+                        X::copy(x,*(x_p_adxs[j]));
+                        X::axpy(alphas[j],dx,*(x_p_adxs[j]));
+                    }
+
+                    // Evaluate the objective
+                    f_alphas.assign(npoints,Real(0.));
+                    parallel_eval(npoints,npoints,[&](Natural const & j) {
+                        f_alphas[j] = f.eval(*(x_p_adxs[j]));
+                    });
+                    next=0;
+
+                    // Set the number of line-search iterations to the number
+                    // of objective evaluations
+                    iter=npoints;
+                    iter_total+=iter;
+                }
+
+                // Hand out the objective at the current step length
+                f_xpdx=f_alphas[next++];
+            }
+
             // Find the line search parameter based on the 2-point approximation
             // from Barzilai and Borwein
             static void twoPoint(
@@ -4953,20 +6501,23 @@ namespace Optizelle{
                 Natural & iter=state.ls_iter;
                 Real & f_xpdx=state.f_xpdx;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Find delta_x
-                X_Vector delta_x(X::init(x));
+                auto & delta_x = loan.vector(x);
                     X::copy(x,delta_x);
                     X::axpy(Real(-1.),x_old,delta_x);
 
                 // Determine the gradient for the step computation
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
                 
-                X_Vector grad_old_step(X::init(grad));
+                auto & grad_old_step = loan.vector(grad);
                     f_mod.grad_step(x,grad_old,grad_old_step);
 
                 // Find delta_grad
-                X_Vector delta_grad(X::init(x));
+                auto & delta_grad = loan.vector(x);
                     X::copy(grad_step,delta_grad);
                     X::axpy(Real(-1.),grad_old_step,delta_grad);
 
@@ -4978,7 +6529,7 @@ namespace Optizelle{
                     alpha=X::innr(delta_x,delta_x)/X::innr(delta_x,delta_grad);
 
                 // Save the objective value at this step
-                X_Vector x_p_adx(X::init(x));
+                auto & x_p_adx = loan.vector(x);
                     X::copy(x,x_p_adx);
                     X::axpy(alpha,dx,x_p_adx);
                 f_xpdx=f.eval(x_p_adx);
@@ -5037,14 +6588,17 @@ namespace Optizelle{
                 // Manipulate the state if required
                 smanip.eval(fns,state,OptimizationLocation::BeforeGetStep);
                 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Modify the gradient if need be 
-                auto grad_step = X::init(x);
+                auto & grad_step = loan.vector(x);
                 f_mod.grad_step(x,grad,grad_step);
                 if(gradmod(grad_step,Real(0.),true))
                     f_mod.grad_step(x,grad,grad_step);
 
                 // Create the trust-region offset 
-                auto x_offset = X::init(x);
+                auto & x_offset = loan.vector(x);
                 X::zero(x_offset);
 
                 // Find the line-search direction
@@ -5068,15 +6622,15 @@ namespace Optizelle{
                     break;
                 case LineSearchDirection::NewtonCG: {
                     // Allocate memory for the Cauchy point
-                    X_Vector dx_cp(X::init(x));
+                    auto & dx_cp = loan.vector(x);
 
                     // Create the Hessian operator
-                    HessianOperator H(fns,x);
+                    HessianOperator H(fns,x,state.work_x);
 
                     // Find -grad f(x)
-                    X_Vector grad_step(X::init(grad));
+                    auto & grad_step = loan.vector(grad);
                         f_mod.grad_step(x,grad,grad_step);
-                    X_Vector minus_grad(X::init(x));
+                    auto & minus_grad = loan.vector(x);
                         X::copy(grad_step,minus_grad);
                         X::scal(Real(-1.),minus_grad);
 
@@ -5115,7 +6669,8 @@ namespace Optizelle{
                         trunc_iter,
                         trunc_stop,
                         safeguard_failed,
-                        alpha_x);
+                        alpha_x,
+                        state.work_x);
 
                     // Calculate the truncated CG error 
                     trunc_err = residual_err / residual_err0;
@@ -5135,11 +6690,11 @@ namespace Optizelle{
                     Real merit_x = f_mod.merit(x,f_x);
                     
                     // Determine the gradient at x
-                    X_Vector grad_step(X::init(x));
+                    auto & grad_step = loan.vector(x);
                         f_mod.grad_step(x,grad,grad_step);
                 
                     // Allocate memory for x+alpha dx 
-                    X_Vector x_p_adx(X::init(x));
+                    auto & x_p_adx = loan.vector(x);
 
                     // Keep track of whether or not we hit a bound with the
                     // line-search
@@ -5154,9 +6709,9 @@ namespace Optizelle{
                     // can search up to alpha0 out in front of the direction,
                     // so we make sure that x + alpha0 dx is safe.  If not, we
                     // move back alpha.
-                    auto zero = X::init(x);
+                    auto & zero = loan.vector(x);
                     X::zero(zero);
-                    auto alpha_dx = X::init(x);
+                    auto & alpha_dx = loan.vector(x);
                     X::copy(dx,alpha_dx);
                     X::scal(alpha0,alpha_dx);
                     alpha_x = std::min(
@@ -5168,6 +6723,23 @@ namespace Optizelle{
                     // is satisfied.
                     bool sufficient_decrease=false;
 
+                    // Step lengths that the parallel line-search has
+                    // evaluated, but not yet handed out, along with the
+                    // objective at each
+                    auto alphas = std::vector <Real> ();
+                    auto f_alphas = std::vector <Real> ();
+                    auto next = Natural(0);
+
+                    // Remember x and dx across the state manipulator, so that
+                    // we can tell whether it changed the points that the
+                    // parallel line-search evaluated
+                    auto x_stamp = std::unique_ptr <CacheStamp <Real,XX> > ();
+                    auto dx_stamp = std::unique_ptr <CacheStamp <Real,XX> > ();
+                    if(kind==LineSearchKind::ParallelBackTracking) {
+                        x_stamp.reset(new CacheStamp <Real,XX> (x));
+                        dx_stamp.reset(new CacheStamp <Real,XX> (dx));
+                    }
+
                     // Continue to look for a step until one comes back as valid
                     for( glob_iter = 1;
                          glob_iter <= glob_iter_max;
@@ -5184,6 +6756,9 @@ namespace Optizelle{
                             ls_stop=goldenSection(fns,state);
                         else if(kind==LineSearchKind::BackTracking)
                             backTracking(fns,state);
+                        else if(kind==LineSearchKind::ParallelBackTracking)
+                            parallelBackTracking(
+                                fns,state,alphas,f_alphas,next);
 
                         // Determine x+dx 
                         X::copy(x,x_p_adx);
@@ -5226,9 +6801,21 @@ namespace Optizelle{
                             break;
                         }
 
-                        // Manipulate the state if required
+                        // Manipulate the state if required.  If this changes
+                        // x or dx, we discard the step lengths from the
+                        // parallel line-search that we haven't used yet.
+                        auto const batched = next < alphas.size();
+                        if(batched) {
+                            x_stamp->update(x);
+                            dx_stamp->update(dx);
+                        }
                         smanip.eval(fns,state,
                             OptimizationLocation::AfterRejectedLineSearch);
+                        if( batched && (
+                            x_stamp->stale(x,state.work_x) ||
+                            dx_stamp->stale(dx,state.work_x))
+                        )
+                            next = alphas.size();
 
                         // Rescale the search direction in case we're not
                         // quite done searching yet.
@@ -5255,7 +6842,9 @@ namespace Optizelle{
                     // reasonable value.  Since the safe guarding modifies
                     // the base line-search parameter, we need to restore it
                     // here.
-                    if(kind==LineSearchKind::BackTracking)
+                    if(kind==LineSearchKind::BackTracking ||
+                        kind==LineSearchKind::ParallelBackTracking
+                    )
                         alpha0=alpha0_orig;
 
                 // Do the line-searches that are not based on sufficient
@@ -5320,19 +6909,25 @@ namespace Optizelle{
                 LineSearchDirection::t const & dir=state.dir;
                 std::list <X_Vector>& oldY=state.oldY;
                 std::list <X_Vector>& oldS=state.oldS;
+                auto & innr_oldS_oldS=state.innr_oldS_oldS;
+                auto & innr_oldS_oldY=state.innr_oldS_oldY;
                
-                // Allocate some temp storage for y and s
-                X_Vector s(X::init(x));
-                X_Vector y(X::init(x));
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
+                // Borrow some storage for y and s.  If we keep the pair, these
+                // move into the quasi-Newton storage.
+                auto & s = loan.vector(x);
+                auto & y = loan.vector(x);
 
                 // Find s = x-x_old
                 X::copy(x,s);
                 X::axpy(Real(-1.),x_old,s);
                 
                 // Determine the gradient for the quasi-Newton computation 
-                X_Vector grad_quasi(X::init(grad));
+                auto & grad_quasi = loan.vector(grad);
                     f_mod.grad_quasi(x,grad,grad_quasi);
-                X_Vector grad_old_quasi(X::init(grad_old));
+                auto & grad_old_quasi = loan.vector(grad_old);
                     f_mod.grad_quasi(x,grad_old,grad_old_quasi);
 
                 // Find y = grad - grad_old
@@ -5342,6 +6937,7 @@ namespace Optizelle{
                 // If we're using BFGS, check that <y,s> > 0
                 if((PH_type==Operators::InvBFGS ||
                     H_type==Operators::BFGS ||
+                    H_type==Operators::CompactBFGS ||
                     dir==LineSearchDirection::BFGS)
                     && X::innr(y,s) <= Real(0.))
                     return;
@@ -5359,14 +6955,45 @@ namespace Optizelle{
                 if( PH_type==Operators::InvSR1 ||
                     H_type==Operators::SR1
                 ) {
-                    // Bs <- B s
-                    X_Vector Bs(X::init(x));
-                        typename Functions::SR1(state).eval(s,Bs);
+                    // Make sure the inner products between the pairs match
+                    // the stored history
+                    Natural const m = oldS.size();
+                    if( innr_oldS_oldS.size()!=m || innr_oldS_oldY.size()!=m)
+                        Functions::innr_quasi(oldS,oldY,
+                            innr_oldS_oldS,innr_oldS_oldY);
+
+                    // Factor the middle matrix of the compact representation.
+                    // The pivots are the measures of how much interesting
+                    // information we've already added, si'(yi-Bi si).
+                    std::vector <Real> LD;
+                    Functions::factor_sr1(innr_oldS_oldS,innr_oldS_oldY,LD);
+                    Real innr_si_ymBsi(0.);
+                    for(Natural i=1;i<=m;i++) {
+                        Real tmp(fabs(LD[ijtok(i,i,m)]));
+                        innr_si_ymBsi =
+                            tmp > innr_si_ymBsi ? tmp : innr_si_ymBsi;
+                    }
 
-                    // y_m_Bs <- y-Bs
-                    X_Vector y_m_Bs(X::init(x));
+                    // Find c = (Y-S)'s with the oldest pair first and then
+                    // w = inv(M) c.  This gives Bs = s + (Y-S) w.
+                    std::vector <Real> c(m);
+                    auto s_i = oldS.cbegin();
+                    auto y_i = oldY.cbegin();
+                    for(Natural i=m;i>=1;i--)
+                        c[i-1] = X::innr(*y_i++,s) - X::innr(*s_i++,s);
+                    auto w = c;
+                    if(m>0) Functions::solve_sr1(m,LD,&(w[0]));
+
+                    // y_m_Bs <- y-Bs = y - s - (Y-S) w
+                    auto & y_m_Bs = loan.vector(x);
                         X::copy(y,y_m_Bs);
-                        X::axpy(Real(-1.),Bs,y_m_Bs);
+                        X::axpy(Real(-1.),s,y_m_Bs);
+                    s_i = oldS.cbegin();
+                    y_i = oldY.cbegin();
+                    for(Natural i=m;i>=1;i--) {
+                        X::axpy(-w[i-1],*y_i++,y_m_Bs);
+                        X::axpy(w[i-1],*s_i++,y_m_Bs);
+                    }
 
                     // norm_s_2 = || s ||^2
                     Real norm_s_2(X::innr(s,s));
@@ -5375,38 +7002,13 @@ namespace Optizelle{
                     Real norm_ymBs_2(X::innr(y_m_Bs,y_m_Bs));
 
                     // Compute a measure of how much interesting new information
-                    // we'll add to the SR1 operator
-                    Real innr_s_ymBs(fabs(X::innr(s,y_m_Bs)));
-
-                    // Repeat the above step for the existing vectors
-                    std::list <X_Vector> oldSS;
-                    std::list <X_Vector> oldYY;
-                    Real innr_si_ymBsi(0.);
-                    Natural m=oldS.size();
-                    for(int i=0;i<m;i++) {
-                        // Remove the last vector in quasi-Newton information
-                        oldSS.splice(oldSS.end(),oldS,oldS.begin());
-                        oldYY.splice(oldYY.end(),oldY,oldY.begin());
-
-                        // Bs <- B si
-                        typename Functions::SR1(state).eval(
-                            oldSS.back(),Bs);
-
-                        // y_m_Bs
-                        X::copy(oldYY.back(),y_m_Bs);
-                        X::axpy(Real(-1.),Bs,y_m_Bs);
-                    
-                        // Compute a measure of how much interesting new
-                        // information we've already added
-                        Real tmp(fabs(X::innr(oldSS.back(),y_m_Bs)));
-                        innr_si_ymBsi =
-                            tmp > innr_si_ymBsi ? tmp : innr_si_ymBsi;
-                    }
-
-                    // Put all the vectors back.  I'm sure there's a better
-                    // way to cache this information.
-                    oldS.splice(oldS.begin(),oldSS);
-                    oldY.splice(oldY.begin(),oldYY);
+                    // we'll add to the SR1 operator,
+                    //
+                    // s'(y-Bs) = s'y - s's - c'w
+                    Real innr_s_ymBs(X::innr(s,y) - norm_s_2);
+                    for(Natural i=0;i<m;i++)
+                        innr_s_ymBs -= c[i]*w[i];
+                    innr_s_ymBs = fabs(innr_s_ymBs);
 
                     // If the new vector doesn't add much, ignore it
                     if( innr_s_ymBs <=
@@ -5421,14 +7023,66 @@ namespace Optizelle{
                 }
 
                 // Insert these into the quasi-Newton storage
-                oldS.emplace_front(std::move(s));
-                oldY.emplace_front(std::move(y));
+                loan.keep(s,oldS);
+                loan.keep(y,oldY);
+
+                // Update the inner products used by the compact BFGS and SR1
+                // representations.  As long as the cache matches the prior
+                // history, we only need the products against the new pair.
+                auto const compact = H_type==Operators::CompactBFGS ||
+                    H_type==Operators::SR1 ||
+                    PH_type==Operators::InvSR1;
+                auto const incremental = compact &&
+                    innr_oldS_oldS.size()+1==oldS.size() &&
+                    innr_oldS_oldY.size()+1==oldS.size();
+                if(incremental) {
+                    // Add a new first row
+                    X_Vector const & s_new = oldS.front();
+                    X_Vector const & y_new = oldY.front();
+                    innr_oldS_oldS.emplace_front();
+                    innr_oldS_oldY.emplace_front();
+                    auto y_j = oldY.cbegin();
+                    for(auto const & s_j : oldS) {
+                        innr_oldS_oldS.front().emplace_back(
+                            X::innr(s_new,s_j));
+                        innr_oldS_oldY.front().emplace_back(
+                            X::innr(s_new,*y_j++));
+                    }
+
+                    // Add a new first column to the remaining rows
+                    auto s_i = std::next(oldS.cbegin());
+                    for(Natural i=1;i<oldS.size();i++) {
+                        innr_oldS_oldS[i].emplace_front(
+                            innr_oldS_oldS.front()[i]);
+                        innr_oldS_oldY[i].emplace_front(
+                            X::innr(*s_i++,y_new));
+                    }
+
+                // Otherwise, the cache no longer describes the history, so
+                // throw it out
+                } else {
+                    innr_oldS_oldS.clear();
+                    innr_oldS_oldY.clear();
+                }
 
                 // Determine if we need to free some memory
                 if(oldS.size()>state.stored_history){
-                    oldS.pop_back();
-                    oldY.pop_back();
+                    state.work_x.recycle(oldS,std::prev(oldS.end()));
+                    state.work_x.recycle(oldY,std::prev(oldY.end()));
+
+                    // Drop the last row and column of the inner products
+                    if(incremental) {
+                        innr_oldS_oldS.pop_back();
+                        innr_oldS_oldY.pop_back();
+                        for(auto & row : innr_oldS_oldS) row.pop_back();
+                        for(auto & row : innr_oldS_oldY) row.pop_back();
+                    }
                 }
+
+                // If the cache was out of sync, rebuild it from scratch
+                if(compact && !incremental)
+                    Functions::innr_quasi(oldS,oldY,
+                        innr_oldS_oldS,innr_oldS_oldY);
             }
 
             // Solves an optimization problem
@@ -5470,10 +7124,15 @@ namespace Optizelle{
 
                     // Sometimes, we can calculate the gradient and objective
                     // simultaneously.  Hence, it's best to calculate the
-                    // gradient first and then possibly cache the objective
-                    f.grad(x,grad);
-                    f_x=f.eval(x);
-                    X_Vector grad_stop(X::init(grad));
+                    // gradient first and then possibly cache the objective.
+                    // When the function evaluates asynchronously, we also
+                    // let the two run together.
+                    auto grad_done = f.grad_async(x,grad);
+                    auto f_x_done = f.eval_async(x);
+                    grad_done.get();
+                    f_x=f_x_done.get();
+                    X_Loan loan(state.work_x);
+                    auto & grad_stop = loan.vector(grad);
                         f_mod.grad_stop(x,grad,grad_stop);
                     norm_gradtyp=sqrt(X::innr(grad_stop,grad_stop));
 
@@ -5527,13 +7186,19 @@ namespace Optizelle{
                     if(iter==1)
                         norm_dxtyp=std::sqrt(X::innr(dx,dx));
 
+                    // Start finding the new gradient.  The constrained
+                    // algorithms update their cached constraints in the
+                    // manipulator below, so we overlap these evaluations with
+                    // the gradient when the function evaluates asynchronously.
+                    auto grad_done = f.grad_async(x,grad);
+
                     // Manipulate the state if required
                     smanip.eval(fns,state,
                         OptimizationLocation::AfterStepBeforeGradient);
 
                     // Find the new objective value and gradient
                     f_x=f_xpdx;
-                    f.grad(x,grad);
+                    grad_done.get();
                     
                     // Manipulate the state if required
                     smanip.eval(fns,state,OptimizationLocation::AfterGradient);
@@ -5622,6 +7287,8 @@ namespace Optizelle{
         typedef typename X::Vector X_Vector;
         typedef YY <Real> Y;
         typedef typename Y::Vector Y_Vector;
+        typedef typename Workspace <Real,XX>::Loan X_Loan;
+        typedef typename Workspace <Real,YY>::Loan Y_Loan;
 
         // This defines a product space between X and Y
         template <typename Real_>
@@ -5663,9 +7330,94 @@ namespace Optizelle{
             static Real_ innr(Vector const & x,Vector const & y) {
                 return X::innr(x.first,y.first) + Y::innr(x.second,y.second);
             }
+
+            // y <- alpha * x + beta * y
+            static void axpby(
+                Real_ const & alpha,
+                Vector const & x,
+                Real_ const & beta,
+                Vector & y
+            ) {
+                FusedOps <Real,XX>::axpby(alpha,x.first,beta,y.first);
+                FusedOps <Real,YY>::axpby(alpha,x.second,beta,y.second);
+            }
+
+            // y <- alpha * x + y and then axpy_innr <- <y,z>
+            static Real_ axpy_innr(
+                Real_ const & alpha,
+                Vector const & x,
+                Vector & y,
+                Vector const & z
+            ) {
+                return FusedOps <Real,XX>::axpy_innr(
+                        alpha,x.first,y.first,z.first)
+                    + FusedOps <Real,YY>::axpy_innr(
+                        alpha,x.second,y.second,z.second);
+            }
+
+            // y <- alpha * x
+            static void copy_scal(
+                Real_ const & alpha,
+                Vector const & x,
+                Vector & y
+            ) {
+                FusedOps <Real,XX>::copy_scal(alpha,x.first,y.first);
+                FusedOps <Real,YY>::copy_scal(alpha,x.second,y.second);
+            }
+
+            // Store several vectors by storing several of each piece
+            typedef std::pair <
+                typename MultiVectors <Real,XX>::t,
+                typename MultiVectors <Real,YY>::t> MultiVector;
+
+            // Resize xs to hold n vectors shaped like x
+            static void resize_many(
+                Vector const & x,
+                Natural const & n,
+                MultiVector & xs
+            ) {
+                MultiVectors <Real,XX>::resize(x.first,n,xs.first);
+                MultiVectors <Real,YY>::resize(x.second,n,xs.second);
+            }
+
+            // xs_j <- x
+            static void copy_many(
+                Vector const & x,
+                Natural const & j,
+                MultiVector & xs
+            ) {
+                MultiVectors <Real,XX>::copy(x.first,j,xs.first);
+                MultiVectors <Real,YY>::copy(x.second,j,xs.second);
+            }
+
+            // z_j <- <xs_j,y> for j < k
+            static void innr_many(
+                Natural const & k,
+                MultiVector const & xs,
+                Vector const & y,
+                Real_ * z
+            ) {
+                std::vector <Real_> z_y(k);
+                MultiVectors <Real,XX>::innr(k,xs.first,y.first,z);
+                MultiVectors <Real,YY>::innr(k,xs.second,y.second,z_y.data());
+                for(Natural j=0;j<k;j++)
+                    z[j] += z_y[j];
+            }
+
+            // y <- sum_{j<k} alpha_j xs_j + y
+            static void axpy_many(
+                Natural const & k,
+                Real_ const * const alpha,
+                MultiVector const & xs,
+                Vector & y
+            ) {
+                MultiVectors <Real,XX>::axpy(k,alpha,xs.first,y.first);
+                MultiVectors <Real,YY>::axpy(k,alpha,xs.second,y.second);
+            }
         };
         typedef XXxYY <Real> XxY;
         typedef typename XxY::Vector XxY_Vector;
+        typedef typename Workspace <Real,XXxYY>::Loan XxY_Loan;
 
         // Routines that manipulate the internal state of the optimization 
         // algorithm.
@@ -5749,6 +7501,15 @@ namespace Optizelle{
                 // How often we restart the augmented system solve
                 Natural augsys_rst_freq;
 
+                // Maximum number of directions that the augmented system
+                // solves recycle between each other
+                Natural augsys_recycle_max;
+
+                // Method we use to solve the augmented systems.  The direct
+                // solver requires that g provide its sparse Jacobian and
+                // that we can access the coordinates of y.
+                AugmentedSystemSolver::t augsys_solver;
+
                 // Number of iterations taken by the augmented system solve
                 Natural augsys_qn_iter;
                 Natural augsys_pg_iter;
@@ -5850,6 +7611,48 @@ namespace Optizelle{
                 // Reason why the quasinormal problem exited
                 QuasinormalStop::t qn_stop;
 
+                // ---------- Workspace ----------
+
+                // Pool of work vectors shaped like (x,y) for the augmented
+                // system solves.  Like work_x, this isn't part of the restart
+                // information.
+                mutable Workspace <Real,XXxYY> work_xy;
+
+                // Pool of work vectors shaped like y
+                mutable Workspace <Real,YY> work_y;
+
+                // Subspace recycled between the augmented system solves along
+                // with the iterate where we built the augmented system.  This
+                // isn't part of the restart information either.
+                mutable GMRESRecycle <Real,XXxYY> augsys_recycle;
+                mutable CacheStamp <Real,XX> augsys_recycle_x;
+
+                // Sparse Jacobian of g and the factorization of g'(x)g'(x)*
+                // for the direct augmented system solver along with the
+                // iterate where we factored and whether the factorization
+                // succeeded.  This isn't part of the restart information.
+                mutable SparseMatrix <Real> augsys_jacobian;
+                mutable SparseLDLT <Real> augsys_ldlt;
+                mutable CacheStamp <Real,XX> augsys_ldlt_x;
+                mutable bool augsys_ldlt_ok;
+
+                // Solution of the augmented system for the quasinormal
+                // Newton step that we solved ahead of time together with the
+                // equality multiplier.  We keep the iterate and xi_qn of the
+                // solve along with its results, so that the quasinormal step
+                // only uses the solution when it would solve the same system.
+                // The list holds either nothing or the solution followed by
+                // the right hand side, which we borrowed from work_xy.  The
+                // right hand side holds the Cauchy point and linearized
+                // feasibility, so the quasinormal step doesn't recompute
+                // them.  This isn't part of the restart information.
+                std::list <XxY_Vector> augsys_qn_ahead;
+                CacheStamp <Real,XX> augsys_qn_ahead_x;
+                Real augsys_qn_ahead_xi;
+                Real augsys_qn_ahead_err;
+                Real augsys_qn_ahead_err_target;
+                Natural augsys_qn_ahead_iter;
+
                 // Initialization constructors
                 explicit t(X_Vector const & x_user,Y_Vector const & y_user) : 
                     Unconstrained <Real,XX>::State::t(x_user),
@@ -5961,6 +7764,16 @@ namespace Optizelle{
                         0
                         //---augsys_rst_freq1---
                     ),
+                    augsys_recycle_max(
+                        //---augsys_recycle_max0---
+                        0
+                        //---augsys_recycle_max1---
+                    ),
+                    augsys_solver(
+                        //---augsys_solver0---
+                        AugmentedSystemSolver::GMRES
+                        //---augsys_solver1---
+                    ),
                     augsys_qn_iter(
                         //---augsys_qn_iter0---
                         0
@@ -6180,7 +7993,21 @@ namespace Optizelle{
                         //---qn_stop0---
                         QuasinormalStop::Feasible
                         //---qn_stop1---
-                    )
+                    ),
+                    work_xy(),
+                    work_y(),
+                    augsys_recycle(),
+                    augsys_recycle_x(x_user),
+                    augsys_jacobian(),
+                    augsys_ldlt(),
+                    augsys_ldlt_x(x_user),
+                    augsys_ldlt_ok(false),
+                    augsys_qn_ahead(),
+                    augsys_qn_ahead_x(x_user),
+                    augsys_qn_ahead_xi(0.),
+                    augsys_qn_ahead_err(0.),
+                    augsys_qn_ahead_err_target(0.),
+                    augsys_qn_ahead_iter(0)
                 {
                         Y::copy(y_user,y);
                 }
@@ -6386,6 +8213,14 @@ namespace Optizelle{
                     // Any
                     //---augsys_rst_freq_valid1---
                     
+                    //---augsys_recycle_max_valid0---
+                    // Any
+                    //---augsys_recycle_max_valid1---
+                    
+                    //---augsys_solver_valid0---
+                    // Any
+                    //---augsys_solver_valid1---
+                    
                     //---augsys_qn_iter_valid0---
                     // Any
                     //---augsys_qn_iter_valid1---
@@ -6646,6 +8481,7 @@ namespace Optizelle{
                 if( Unconstrained <Real,XX>::Restart::is_nat(item) ||
                     item.first == "augsys_iter_max" ||
                     item.first == "augsys_rst_freq" ||
+                    item.first == "augsys_recycle_max" ||
                     item.first == "augsys_qn_iter" ||
                     item.first == "augsys_pg_iter" ||
                     item.first == "augsys_proj_iter" ||
@@ -6683,7 +8519,9 @@ namespace Optizelle{
                     (item.first=="y_diag" &&
                         VectorSpaceDiagnostics::is_valid(item.second)) ||
                     (item.first=="qn_stop" &&
-                        QuasinormalStop::is_valid(item.second))
+                        QuasinormalStop::is_valid(item.second)) ||
+                    (item.first=="augsys_solver" &&
+                        AugmentedSystemSolver::is_valid(item.second))
                 ) 
                     return true;
                 else
@@ -6822,6 +8660,8 @@ namespace Optizelle{
                     std::move(state.augsys_iter_max));
                 nats.emplace_back("augsys_rst_freq",
                     std::move(state.augsys_rst_freq));
+                nats.emplace_back("augsys_recycle_max",
+                    std::move(state.augsys_recycle_max));
                 nats.emplace_back("augsys_qn_iter",
                     std::move(state.augsys_qn_iter));
                 nats.emplace_back("augsys_pg_iter",
@@ -6868,6 +8708,8 @@ namespace Optizelle{
                     VectorSpaceDiagnostics::to_string(state.y_diag));
                 params.emplace_back("qn_stop",
                     QuasinormalStop::to_string(state.qn_stop));
+                params.emplace_back("augsys_solver",
+                    AugmentedSystemSolver::to_string(state.augsys_solver));
             }
             
             // Copy in all equality multipliers 
@@ -6992,6 +8834,8 @@ namespace Optizelle{
                         state.augsys_iter_max=std::move(item->second);
                     else if(item->first=="augsys_rst_freq")
                         state.augsys_rst_freq=std::move(item->second);
+                    else if(item->first=="augsys_recycle_max")
+                        state.augsys_recycle_max=std::move(item->second);
                     else if(item->first=="augsys_qn_iter")
                         state.augsys_qn_iter=std::move(item->second);
                     else if(item->first=="augsys_pg_iter")
@@ -7048,6 +8892,9 @@ namespace Optizelle{
                     else if(item->first=="qn_stop")
                         state.qn_stop=QuasinormalStop::from_string(
                             item->second);
+                    else if(item->first=="augsys_solver")
+                        state.augsys_solver
+                            = AugmentedSystemSolver::from_string(item->second);
                 }
             }
 
@@ -7157,13 +9004,15 @@ namespace Optizelle{
                 mutable X_Vector grad_tmp;
                 mutable X_Vector x_tmp1;
                 mutable Y_Vector y_tmp1;
+                Workspace <Real,XX> & work_x;
+                Workspace <Real,YY> & work_y;
 
-                // Variables used for caching.  The boolean values denote
-                // whether or not we've started caching yet.
-                mutable std::pair <bool,X_Vector> x_merit;
+                // Variables used for caching.  The stamps determine whether
+                // the cached values are stale.
+                mutable CacheStamp <Real,XX> x_merit;
                 mutable Y_Vector g_x;
-                mutable std::pair <bool,X_Vector> x_grad;
-                mutable std::pair <bool,Y_Vector> y_grad;
+                mutable CacheStamp <Real,XX> x_grad;
+                mutable CacheStamp <Real,YY> y_grad;
                 mutable X_Vector gpxsy; 
 
                 // Adds the Lagrangian pieces to the gradient
@@ -7177,19 +9026,13 @@ namespace Optizelle{
                     
                     // If relative error between the current and cached values
                     // is large, compute anew.
-                    if( rel_err_cached <Real,XX> (x,x_grad)
-                            >= std::numeric_limits <Real>::epsilon()*1e1 ||
-                        rel_err_cached <Real,YY> (y,y_grad)
-                            >= std::numeric_limits <Real>::epsilon()*1e1 
-                    ) {
+                    if(x_grad.stale(x,work_x) || y_grad.stale(y,work_y)) {
                         // gpxsy <- g'(x)* y 
                         g.ps(x,y,gpxsy);
 
                         // Cache the values
-                        x_grad.first=true;
-                        X::copy(x,x_grad.second);
-                        y_grad.first=true;
-                        Y::copy(y,y_grad.second);
+                        x_grad.update(x);
+                        y_grad.update(y);
                     }
 
                     // grad <- grad f(x) + g'(x)*y 
@@ -7210,30 +9053,38 @@ namespace Optizelle{
                     grad_tmp(X::init(state.x)),
                     x_tmp1(X::init(state.x)),
                     y_tmp1(Y::init(state.y)),
-                    x_merit(false,X::init(state.x)),
+                    work_x(state.work_x),
+                    work_y(state.work_y),
+                    x_merit(state.x),
                     g_x(Y::init(state.y)),
-                    x_grad(false,X::init(state.x)),
-                    y_grad(false,Y::init(state.y)),
+                    x_grad(state.x),
+                    y_grad(state.y),
                     gpxsy(X::init(state.x))
                 { }
 
-                // Merit function additions to the objective
-                virtual Real merit(X_Vector const & x,Real const & f_x) const {
-                    // Do the underlying modification of the objective
-                    Real merit_x = f_mod->merit(x,f_x);
-                    
+                // Evaluates the constraint at x unless we've cached it
+                virtual void prepare_merit(X_Vector const & x) const {
+                    // Do the underlying preparation
+                    f_mod->prepare_merit(x);
+
                     // If we've not started caching or the relative error
                     // is large, compute anew.
-                    if( rel_err_cached <Real,XX> (x,x_merit)
-                            >= std::numeric_limits <Real>::epsilon()*1e1
-                    ) {
+                    if(x_merit.stale(x,work_x)) {
                         // g_x <- g(x)
                         g.eval(x,g_x);
                     
                         // Cache the values
-                        x_merit.first=true;
-                        X::copy(x,x_merit.second);
+                        x_merit.update(x);
                     }
+                }
+
+                // Merit function additions to the objective
+                virtual Real merit(X_Vector const & x,Real const & f_x) const {
+                    // Do the underlying modification of the objective
+                    Real merit_x = f_mod->merit(x,f_x);
+
+                    // Make sure that we have g(x)
+                    prepare_merit(x);
 
                     // Return f(x) + < y,g(x) > + rho || g(x) ||^2   
                     return merit_x + Y::innr(y,g_x) + rho * Y::innr(g_x,g_x);
@@ -7384,6 +9235,19 @@ namespace Optizelle{
 
                 // Check that all functions are defined 
                 check(fns);
+
+                // Give the outputs of the equality constraint new versions
+                // when the vector spaces track them
+                if(has_version <X>::value || has_version <Y>::value)
+                    fns.g.reset(new TouchedVectorValuedFunction <Real,XX,YY>(
+                        std::move(fns.g)));
+
+                // Remember the equality constraint at the last few points
+                if(state.eval_cache_size > 0)
+                    fns.g.reset(new CachedVectorValuedFunction <Real,XX,YY> (
+                        std::move(fns.g),
+                        state.eval_cache_size,
+                        state.eval_cache_hits));
                 
                 // Modify the objective 
                 fns.f_mod.reset(new EqualityModifications(
@@ -7686,11 +9550,14 @@ namespace Optizelle{
                 X_Vector const & x=state.x;
                 Y_Vector const & y=state.y;
                 FunctionDiagnostics::t const & g_diag = state.g_diag;
+                Natural const & diag_threads=state.diag_threads;
                 
-                // Create some random directions for these tests
-                X_Vector dx(X::init(x));
+                // Borrow some random directions for these tests
+                X_Loan loan_x(state.work_x);
+                Y_Loan loan_y(state.work_y);
+                auto & dx = loan_x.vector(x);
                     X::rand(dx); 
-                Y_Vector dy(Y::init(y));
+                auto & dy = loan_y.vector(y);
                     Y::rand(dy);
 
                 // Run the diagnostics
@@ -7700,7 +9567,7 @@ namespace Optizelle{
                     case FunctionDiagnostics::FirstOrder:
                         msg("Diagnostics on the function g");
                         Optizelle::Diagnostics::derivativeCheck(
-                            msg,g,x,dx,dy,"g");
+                            msg,g,x,dx,dy,"g",diag_threads);
                         Optizelle::Diagnostics::derivativeAdjointCheck(
                             msg,g,x,dx,dy,"g");
                         msg("");
@@ -7708,11 +9575,11 @@ namespace Optizelle{
                     case FunctionDiagnostics::SecondOrder:
                         msg("Diagnostics on the function g");
                         Optizelle::Diagnostics::derivativeCheck(
-                            msg,g,x,dx,dy,"g");
+                            msg,g,x,dx,dy,"g",diag_threads);
                         Optizelle::Diagnostics::derivativeAdjointCheck(
                             msg,g,x,dx,dy,"g");
                         Optizelle::Diagnostics::secondDerivativeCheck(
-                            msg,g,x,dx,dy,"g");
+                            msg,g,x,dx,dy,"g",diag_threads);
                         msg("");
                         break;
                 }
@@ -7742,6 +9609,10 @@ namespace Optizelle{
                 // Equality modifications 
                 typename Functions::EqualityModifications g_mod;
 
+                // Borrow memory for the zero vector
+                X_Loan loan;
+                X_Vector & zero;
+
             public:
                 // Remove some constructors
                 NO_COPY_ASSIGNMENT(EqualityHessianOperator);
@@ -7759,7 +9630,9 @@ namespace Optizelle{
                         std::unique_ptr <
                             ScalarValuedFunctionModifications <Real,XX>
                         > (new ScalarValuedFunctionModifications <Real,XX> ())
-                    )
+                    ),
+                    loan(state.work_x),
+                    zero(loan.vector(state.x))
                 {}
 
                 // Basic application
@@ -7767,7 +9640,6 @@ namespace Optizelle{
                     const
                 {
                     // Grab the zero vector in the X space
-                    X_Vector zero(X::init(x));
                     X::zero(zero);
 
                     // Add the equality constraint's contribution to the
@@ -7786,10 +9658,11 @@ namespace Optizelle{
                 X_Vector const & x=state.x;
                 FunctionDiagnostics::t const & L_diag=state.L_diag;
                 
-                // Create some random directions for these tests
-                X_Vector dx(X::init(x));
+                // Borrow some random directions for these tests
+                X_Loan loan(state.work_x);
+                auto & dx = loan.vector(x);
                     X::rand(dx); 
-                X_Vector dxx(X::init(x));
+                auto & dxx = loan.vector(x);
                     X::rand(dxx); 
 
                 // Create the equality Hessian operator
@@ -7832,8 +9705,9 @@ namespace Optizelle{
                 VectorSpaceDiagnostics::t const & y_diag=state.y_diag;
                 Y_Vector const & y=state.y;
                
-                // Create some random directions for these tests
-                Y_Vector dy(Y::init(y));
+                // Borrow some random directions for these tests
+                Y_Loan loan(state.work_y);
+                auto & dy = loan.vector(y);
                     Y::rand(dy); 
 
                 // Run the diagnostics
@@ -7872,6 +9746,17 @@ namespace Optizelle{
             // Disallow constructors
             NO_CONSTRUCTORS(Algorithms)
 
+            // Borrows a vector shaped like (x,y) from the workspace of loan
+            static XxY_Vector & borrowXxY(
+                XxY_Loan & loan,
+                X_Vector const & x,
+                Y_Vector const & y
+            ) {
+                return loan.vector_from([&x,&y]() {
+                    return XxY_Vector(X::init(x),Y::init(y));
+                });
+            }
+
             // The operator for the augmented system,
             //
             // [ I      g'(x)* ]
@@ -7906,6 +9791,40 @@ namespace Optizelle{
                     // g'(x_base)* dx
                     g.p(x_base,dx_dy.first,result.second);
                 }
+
+                // Apply the augmented system to several vectors at once.  We
+                // pass all of the directions to the constraint together, so
+                // that it can share work between them.
+                void eval_many(
+                    std::vector <XxY_Vector const *> const & dx_dys,
+                    std::vector <XxY_Vector *> const & results
+                ) const {
+                    // Create some shortcuts
+                    VectorValuedFunction <Real,XX,YY> const & g=*(fns.g);
+
+                    // Split the vectors into their pieces
+                    auto const n = dx_dys.size();
+                    auto dxs = std::vector <X_Vector const *> (n);
+                    auto dys = std::vector <Y_Vector const *> (n);
+                    auto results_x = std::vector <X_Vector *> (n);
+                    auto results_y = std::vector <Y_Vector *> (n);
+                    for(Natural j=0;j<n;j++) {
+                        dxs[j] = &(dx_dys[j]->first);
+                        dys[j] = &(dx_dys[j]->second);
+                        results_x[j] = &(results[j]->first);
+                        results_y[j] = &(results[j]->second);
+                    }
+
+                    // g'(x_base)* dy
+                    g.ps_many(x_base,dys,results_x);
+
+                    // dx + g'(x_base)* dy 
+                    for(Natural j=0;j<n;j++)
+                        X::axpy(Real(1.),*(dxs[j]),*(results_x[j]));
+
+                    // g'(x_base)* dx
+                    g.p_many(x_base,dxs,results_y);
+                }
             };
             
             // The block diagonal preconditioner 
@@ -7937,6 +9856,156 @@ namespace Optizelle{
                 }
             };
 
+            // Grabs the subspace that the augmented system solves at x
+            // recycle.  When x changes, so does the augmented system, so we
+            // have to recompute the images of the recycled directions.
+            static GMRESRecycle <Real,XXxYY> & augsysRecycle(
+                typename State::t const & state,
+                X_Vector const & x
+            ) {
+                if(state.augsys_recycle_x.stale(x,state.work_x)) {
+                    state.augsys_recycle.touch();
+                    state.augsys_recycle_x.update(x);
+                }
+                return state.augsys_recycle;
+            }
+
+            // Solves the augmented system at x directly.  Since the leading
+            // block is the identity,
+            //
+            // [ I     g'(x)* ] = [ I     0 ] [ I  0            ] [ I g'(x)* ]
+            // [ g'(x) 0      ]   [ g'(x) I ] [ 0 -g'(x)g'(x)* ] [ 0 I      ]
+            //
+            // so the solve only requires a factorization of g'(x)g'(x)*,
+            // which we compute once for each x and reuse between the solves.
+            // We form g'(x)g'(x)* as J J' from the sparse Jacobian, which
+            // only holds when both x and y use the Euclidean inner product
+            // on their coordinates, as Rm does.  Returns false when g'(x)
+            // doesn't have full row rank, in which case we don't touch xx.
+            static bool augsysDirect(
+                typename Functions::t const & fns,
+                typename State::t const & state,
+                X_Vector const & x,
+                XxY_Vector const & bb,
+                XxY_Vector & xx
+            ) {
+                // Create some shortcuts
+                auto const & g = *(fns.g);
+                auto & J = state.augsys_jacobian;
+                auto & ldlt = state.augsys_ldlt;
+
+                // Factor g'(x)g'(x)* when x changes.  We also make sure
+                // that we can work with the coordinates of x.
+                typedef Coordinates <Real,X_Vector> XC;
+                if(state.augsys_ldlt_x.stale(x,state.work_x)) {
+                    if(!g.jacobian(x,J))
+                        throw Exception::t(__LOC__
+                            + ", the direct augmented system solver requires "
+                            + "a sparse Jacobian from the equality "
+                            + "constraint");
+                    if(XC::size(x)!=J.n)
+                        throw Exception::t(__LOC__
+                            + ", the direct augmented system solver requires "
+                            + "access to the coordinates of x that match the "
+                            + "columns of the Jacobian");
+                    state.augsys_ldlt_ok = ldlt.factor_aat(J);
+                    state.augsys_ldlt_x.update(x);
+                }
+                if(!state.augsys_ldlt_ok)
+                    return false;
+
+                // Make sure that we can work with the coordinates of y
+                typedef Coordinates <Real,Y_Vector> YC;
+                Y_Loan loan(state.work_y);
+                auto & dy = loan.vector(bb.second);
+                if(YC::data(dy)==nullptr || YC::size(dy)!=J.m)
+                    throw Exception::t(__LOC__
+                        + ", the direct augmented system solver requires "
+                        + "access to the coordinates of y that match the rows "
+                        + "of the Jacobian");
+
+                // dy <- (g'(x)g'(x)*)^{-1} (g'(x) bb_1 - bb_2)
+                g.p(x,bb.first,dy);
+                Y::axpy(Real(-1.),bb.second,dy);
+                ldlt.solve(YC::data(dy));
+
+                // dx <- bb_1 - g'(x)* dy
+                g.ps(x,dy,xx.first);
+                X::scal(Real(-1.),xx.first);
+                X::axpy(Real(1.),bb.first,xx.first);
+                Y::copy(dy,xx.second);
+                return true;
+            }
+
+            // Solves the augmented system at x.  The arguments match those
+            // of gmres.  When we solve directly, we count each solve with
+            // the factorization as an iteration and report the norm of the
+            // true residual, just like GMRES.  Since we factor g'(x)g'(x)*,
+            // which squares the condition number of g'(x), this residual
+            // may be well above rounding, so when it misses the stopping
+            // tolerance, we take a step of iterative refinement.
+            static std::pair <Real,Natural> augsysSolve(
+                typename Functions::t const & fns,
+                typename State::t const & state,
+                X_Vector const & x,
+                XxY_Vector const & bb,
+                Natural const & augsys_iter_max,
+                Natural const & augsys_rst_freq,
+                Operator <Real,XXxYY,XXxYY> const & PAugSys_l,
+                Operator <Real,XXxYY,XXxYY> const & PAugSys_r,
+                GMRESManipulator <Real,XXxYY> const & gmanip,
+                XxY_Vector & xx
+            ) {
+                // Try to solve the system directly
+                if( state.augsys_solver == AugmentedSystemSolver::Direct &&
+                    augsysDirect(fns,state,x,bb,xx)
+                ) {
+                    // Let the manipulator set the stopping tolerance, so
+                    // that we save the same targets as GMRES
+                    auto eps = Real(1.);
+                    gmanip.eval(1,xx,bb,eps);
+
+                    // Find the residual, rr = bb - A xx
+                    XxY_Loan loan(state.work_xy);
+                    auto & rr = loan.vector(bb);
+                    auto A = AugmentedSystem(state,fns,x);
+                    auto residual = [&]() {
+                        A.eval(xx,rr);
+                        XxY::scal(Real(-1.),rr);
+                        XxY::axpy(Real(1.),bb,rr);
+                        return std::sqrt(XxY::innr(rr,rr));
+                    };
+                    auto norm_rr = residual();
+
+                    // If we missed the tolerance, refine the solution with
+                    // xx <- xx + inv(A) rr
+                    auto iter = Natural(1);
+                    auto & dxx = loan.vector(bb);
+                    if(norm_rr > eps && augsysDirect(fns,state,x,rr,dxx)) {
+                        XxY::axpy(Real(1.),dxx,xx);
+                        norm_rr = residual();
+                        iter++;
+                        gmanip.eval(iter,xx,bb,eps);
+                    }
+                    return std::pair <Real,Natural> (norm_rr,iter);
+                }
+
+                // Otherwise, use GMRES
+                return Optizelle::gmres <Real,XXxYY> (
+                    AugmentedSystem(state,fns,x),
+                    bb,
+                    Real(1.), // This will be overwritten by the manipulator
+                    augsys_iter_max,
+                    augsys_rst_freq,
+                    PAugSys_l,
+                    PAugSys_r,
+                    gmanip,
+                    xx,
+                    state.augsys_recycle_max,
+                    augsysRecycle(state,x),
+                    state.work_xy);
+            }
+
             // Adjusts an augmented system solve stopping tolerance from 
             //
             // || e1 || + || e2 || <= eps
@@ -7960,15 +10029,19 @@ namespace Optizelle{
                 auto const & x=state.x;
                 auto const & y=state.y;
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                Y_Loan loan_y(state.work_y);
+
                 // e1 = xx1 + g'(x)*xx2 - bb1
-                auto e1 = X::init(x);
+                auto & e1 = loan_x.vector(x);
                 g.ps(x,xx.second,e1);
                 X::axpy(Real(1.),xx.first,e1);
                 X::axpy(Real(-1.),bb.first,e1);
                 auto norm_e1 = std::sqrt(X::innr(e1,e1));
 
                 // e2 = g'(x)xx1 - bb2
-                auto e2 = Y::init(y);
+                auto & e2 = loan_y.vector(y);
                 g.p(x,xx.first,e2);
                 Y::axpy(Real(-1.),bb.second,e2);
                 auto norm_e2 = std::sqrt(Y::innr(e2,e2));
@@ -8036,6 +10109,137 @@ namespace Optizelle{
                 }
             };
 
+            // Finds the Cauchy point of the quasinormal problem.  This is
+            // based on solving the problem
+            //
+            // min 0.5 || g'(x)dx + g(x) || ^2
+            //
+            // which has a gradient of
+            //
+            // g'(x)*g'(x) dx + g'(x)*g(x)
+            //
+            // Now, since we start with dx=0, we move in the direction
+            // dx = -g'(x)*g(x), which is the steepest descent direction.
+            // Then, we do the optimal line-search plugging this
+            // dx = -alpha g'(x)*g(x), into the objective above, which gives
+            //
+            // alpha = ||g'(x)*g(x)||^2 / ||g'(x)g'(x)*g(x)||^2.
+            //
+            // Returns false without touching dx_cp when || g'(x)*g(x) || is
+            // small, which means that we're at a local-min of the above
+            // problem.
+            static bool quasinormalCauchyPoint(
+                typename Functions::t const & fns,
+                typename State::t const & state,
+                X_Vector & dx_cp
+            ) {
+                // Create some shortcuts
+                auto const & g=*(fns.g);
+                auto const & absrel = *(fns.absrel);
+                auto const & x=state.x;
+                auto const & g_x=state.g_x;
+                auto const & norm_gpsgxtyp = state.norm_gpsgxtyp;
+                auto const & eps_constr = state.eps_constr;
+
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                Y_Loan loan_y(state.work_y);
+
+                // Find g'(x)*g(x)
+                auto & gps_g = loan_x.vector(x);
+                g.ps(x,g_x,gps_g);
+
+                // Check || g'(x)*g(x) ||.  If this is small, then the
+                // least-square problem is at a local-min.
+                auto norm_gpsgx = std::sqrt(X::innr(gps_g,gps_g));
+                if(norm_gpsgx <= eps_constr * absrel(norm_gpsgxtyp))
+                    return false;
+
+                // Find g'(x)g'(x)*g(x)
+                auto & gp_gps_g = loan_y.vector(g_x);
+                g.p(x,gps_g,gp_gps_g);
+
+                // Find || g'(x)*g(x) ||^2
+                auto norm_gpsg_2 = X::innr(gps_g,gps_g);
+
+                // Find || g'(x)g'(x)*g(x) ||^2
+                auto norm_gpgpsg_2 = Y::innr(gp_gps_g,gp_gps_g);
+
+                // Find the Cauchy point,
+                // -||g'(x)*g(x)||^2 / ||g'(x)g'(x)*g(x)||^2 g'(x)*g(x)
+                X::copy(gps_g,dx_cp);
+                X::scal(-norm_gpsg_2/norm_gpgpsg_2,dx_cp);
+                return true;
+            }
+
+            // Finds the right hand side of the augmented system for the
+            // quasinormal Newton step, b0=(-dx_cp,-g'(x)dx_cp-g(x)), where
+            // dx_cp is the unscaled Cauchy point
+            static void quasinormalNewtonRhs(
+                typename Functions::t const & fns,
+                typename State::t const & state,
+                X_Vector const & dx_cp,
+                XxY_Vector & b0
+            ) {
+                // Create some shortcuts
+                auto const & g=*(fns.g);
+                auto const & x=state.x;
+                auto const & g_x=state.g_x;
+
+                // Find b0
+                X::copy(dx_cp,b0.first);
+                X::scal(Real(-1.),b0.first);
+                g.p(x,dx_cp,b0.second);
+                Y::scal(Real(-1.),b0.second);
+                Y::axpy(Real(-1.),g_x,b0.second);
+            }
+
+            // Determines whether quasinormalStep at the current iterate will
+            // solve an augmented system for the Newton step.  When it will,
+            // we find the right hand side of that system in b0.  This
+            // repeats the tests that quasinormalStep makes before the Newton
+            // step: we're not feasible, we're not at a local-min of the
+            // least-squares problem, and the Cauchy point lies inside the
+            // trust-region and doesn't solve the linearized constraint.
+            // Since b0=(-dx_cp,-g'(x)dx_cp-g(x)), quasinormalStep can reuse
+            // both the Cauchy point and the linearized feasibility from b0.
+            static bool quasinormalNewtonAhead(
+                typename Functions::t const & fns,
+                typename State::t const & state,
+                XxY_Vector & b0
+            ) {
+                // Create some shortcuts
+                auto const & absrel = *(fns.absrel);
+                auto const & x=state.x;
+                auto const & g_x=state.g_x;
+                auto const & delta = state.delta;
+                auto const & zeta = state.zeta;
+                auto const & norm_gxtyp = state.norm_gxtyp;
+                auto const & eps_constr = state.eps_constr;
+
+                // Check || g(x) ||
+                auto tol = eps_constr * absrel(norm_gxtyp);
+                if(std::sqrt(Y::innr(g_x,g_x)) <= tol)
+                    return false;
+
+                // Find the Cauchy point
+                X_Loan loan(state.work_x);
+                auto & dx_cp = loan.vector(x);
+                if(!quasinormalCauchyPoint(fns,state,dx_cp))
+                    return false;
+
+                // Check the Cauchy point against the trust-region 
+                if(std::sqrt(X::innr(dx_cp,dx_cp)) >= zeta*delta)
+                    return false;
+
+                // Find the right hand side and then check
+                // || g'(x)dx_cp + g(x) ||, which is || b0.second ||
+                quasinormalNewtonRhs(fns,state,dx_cp,b0);
+                if(std::sqrt(Y::innr(b0.second,b0.second)) <= tol)
+                    return false;
+                return true;
+            }
+
             // Finds the quasi-normal step
             static void quasinormalStep(
                 typename Functions::t const & fns,
@@ -8052,7 +10256,6 @@ namespace Optizelle{
                 auto const & delta = state.delta;
                 auto const & zeta = state.zeta;
                 auto const & norm_gxtyp = state.norm_gxtyp;
-                auto const & norm_gpsgxtyp = state.norm_gpsgxtyp;
                 auto const & eps_constr = state.eps_constr;
                 auto const & augsys_qn_err_target = state.augsys_qn_err_target;
                 auto & dx_ncp=state.dx_ncp;
@@ -8074,31 +10277,36 @@ namespace Optizelle{
                         std::placeholders::_2,
                         zeta));
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                Y_Loan loan_y(state.work_y);
+                XxY_Loan loan_xy(state.work_xy);
+
                 // Keep track of the safe steps and safeguarding
-                auto dxn_safe = X::init(x);
+                auto & dxn_safe = loan_x.vector(x);
                 X::zero(dxn_safe);
-                auto ddxn_safe = X::init(x);
+                auto & ddxn_safe = loan_x.vector(x);
                 auto safeguard_failed = Natural(0);
 
                 // We build dx_n from ddx_n
-                auto ddx_n = X::init(x);
+                auto & ddx_n = loan_x.vector(x);
 
                 // Zero out our initial directions
                 X::zero(dx_n);
                 X::zero(dx_ncp);
 
                 // Store our trial step, dx_n + ddx_n
-                auto trial = X::init(x);
+                auto & trial = loan_x.vector(x);
 
                 // Create a zero vector
-                auto zero = X::init(x);
+                auto & zero = loan_x.vector(x);
                 X::zero(zero);
 
                 // Initialize our stopping condition to skipped
                 qn_stop = QuasinormalStop::Feasible;
 
                 // Calculates the linearized feasibility || g'(x)dx + g(x) ||
-                auto gpxdxpgx = Y::init(g_x);
+                auto & gpxdxpgx = loan_y.vector(g_x);
                 auto lin_feas = [&](auto const & dx) {
                     g.p(x,dx,gpxdxpgx);
                     Y::axpy(Real(1.),g_x,gpxdxpgx);
@@ -8107,9 +10315,18 @@ namespace Optizelle{
                 };
 
                 // Grab the raw Newton point if we get there
-                auto dx_newton = X::init(x);
+                auto & dx_newton = loan_x.vector(x);
                 X::zero(dx_newton);
 
+                // Determine if we already solved for the Newton step along
+                // with the equality multiplier.  In this case, the saved right
+                // hand side, b0=(-dx_cp,-g'(x)dx_cp-g(x)), gives us the Cauchy
+                // point and its linearized feasibility without applying g'(x)
+                // or g'(x)* again.
+                auto const ahead = !state.augsys_qn_ahead.empty() &&
+                    !state.augsys_qn_ahead_x.stale(x,state.work_x) &&
+                    state.augsys_qn_ahead_xi == state.xi_qn;
+
                 // Make sure our initial safeguard length doesn't restrict
                 // anything.  Mostly, we need this in case we exit early for
                 // stopping conditions like Feasible and LocalMin.
@@ -8118,8 +10335,19 @@ namespace Optizelle{
                 // We only have two points to search in a dogleg method
                 auto iter = Natural(1);
                 for(; iter<=2; iter++) {
-                    // If we ever solve g'(x)dx_n + g(x) = 0, we quit 
-                    auto norm_gpxdxnpgx=lin_feas(dx_n);
+                    // If we ever solve g'(x)dx_n + g(x) = 0, we quit.  When we
+                    // solved ahead, dx_n is either 0 or the Cauchy point, so
+                    // we take these norms from g(x) and the saved b0.
+                    auto norm_gpxdxnpgx = Real(0.);
+                    if(!ahead)
+                        norm_gpxdxnpgx = lin_feas(dx_n);
+                    else if(iter==1)
+                        norm_gpxdxnpgx = std::sqrt(Y::innr(g_x,g_x));
+                    else {
+                        auto const & b0 = state.augsys_qn_ahead.back();
+                        norm_gpxdxnpgx =
+                            std::sqrt(Y::innr(b0.second,b0.second));
+                    }
                     if(norm_gpxdxnpgx <= eps_constr * absrel(norm_gxtyp)) {
                         if(iter==1)
                             qn_stop = QuasinormalStop::Feasible;
@@ -8128,90 +10356,68 @@ namespace Optizelle{
                         break;
                     }
 
-                    // Find the Cauchy point.  This is based on solving the
-                    // problem
-                    //
-                    // min 0.5 || g'(x)dx + g(x) || ^2
-                    //
-                    // which has a gradient of
-                    //
-                    // g'(x)*g'(x) dx + g'(x)*g(x)
-                    //
-                    // Now, since we start with dx=0, we move in the direction
-                    // dx = -g'(x)*g(x), which is the steepest descent
-                    // direction.  Then, we do the optimal line-search plugging
-                    // this dx = -alpha g'(x)*g(x), into the objective above.
-                    // which gives
-                    //
-                    // alpha = ||g'(x)*g(x)||^2 / ||g'(x)g'(x)*g(x)||^2.
+                    // Find the Cauchy point.  If || g'(x)*g(x) || is small,
+                    // then the least-square problem we're about to solve is
+                    // at a local-min.  That's, well, bad, but there's a good
+                    // chance that the tangential step will pull us off of
+                    // this point.
                     if(iter==1) {
-                        // Find g'(x)*g(x)
-                        auto gps_g = X::init(x);
-                        g.ps(x,g_x,gps_g);
-
-                        // Check || g'(x)*g(x) ||.  If this is small, then
-                        // the least-square problem we're about to solve is at
-                        // a local-min.  That's, well, bad, but there's a good
-                        // chance that the tangential step will pull us off
-                        // of this point.
-                        auto norm_gpsgx = std::sqrt(X::innr(gps_g,gps_g));
-                        if(norm_gpsgx <= eps_constr * absrel(norm_gpsgxtyp)) {
+                        if(ahead) {
+                            X::copy(state.augsys_qn_ahead.back().first,ddx_n);
+                            X::scal(Real(-1.),ddx_n);
+                        } else if(!quasinormalCauchyPoint(fns,state,ddx_n)) {
                             qn_stop = QuasinormalStop::LocalMin; 
                             break;
                         }
 
-                        // Find g'(x)g'(x)*g(x)
-                        auto gp_gps_g = Y::init(g_x);
-                        g.p(x,gps_g,gp_gps_g);
-
-                        // Find || g'(x)*g(x) ||^2
-                        auto norm_gpsg_2 = X::innr(gps_g,gps_g);
-
-                        // Find || g'(x)g'(x)*g(x) ||^2
-                        auto norm_gpgpsg_2 = Y::innr(gp_gps_g,gp_gps_g);
-
-                        // Find the Cauchy point,
-                        // -||g'(x)*g(x)||^2 / ||g'(x)g'(x)*g(x)||^2 g'(x)*g(x)
-                        X::copy(gps_g,ddx_n);
-                        X::scal(-norm_gpsg_2/norm_gpgpsg_2,ddx_n);
-
                     // Find the Newton step, dx_newton = dx_cp + ddx_n. 
                     } else {
                         // Create the initial guess, x0=(0,0)
-                        auto x0 = XxY_Vector(X::init(x),Y::init(g_x));
+                        auto & x0 = borrowXxY(loan_xy,x,g_x);
                         XxY::zero(x0);
 
-                        // Create the rhs, b0=(-ddx_n,-g'(x)ddx_n-g(x)).  Note,
-                        // dx_n should contain the unscaled Cauchy point.
-                        auto b0 = XxY_Vector(XxY::init(x0));
-                        X::copy(dx_n,b0.first);
-                        X::scal(Real(-1.),b0.first);
-                        g.p(x,dx_n,b0.second);
-                        Y::scal(Real(-1.),b0.second);
-                        Y::axpy(Real(-1.),g_x,b0.second);
-
-                        // Build Schur style preconditioners
-                        auto I = typename
-                            Unconstrained <Real,XX>::Functions::Identity();
-                        auto PAugSys_l =
-                            BlockDiagonalPreconditioner (I,*(fns.PSchur_left));
-                        auto PAugSys_r =
-                            BlockDiagonalPreconditioner (I,*(fns.PSchur_right));
-
-                        // Solve the augmented system for the Newton step
-                        std::tie(augsys_qn_err,augsys_qn_iter) =
-                            Optizelle::gmres <Real,XXxYY> (
-                                AugmentedSystem(state,fns,x),
-                                b0,
-                                // This will be overwritten by the manipulator
-                                Real(1.),
-                                augsys_iter_max,
-                                augsys_rst_freq,
-                                PAugSys_l,
-                                PAugSys_r,
-                                QNManipulator(state,fns),
-                                x0 
-                            );
+                        // Solve the augmented system for the Newton step.  If
+                        // we already solved this system along with the
+                        // equality multiplier, use that solution instead.
+                        if(ahead) {
+                            XxY::copy(state.augsys_qn_ahead.front(),x0);
+                            augsys_qn_err = state.augsys_qn_ahead_err;
+                            augsys_qn_iter = state.augsys_qn_ahead_iter;
+                            state.augsys_qn_err_target =
+                                state.augsys_qn_ahead_err_target;
+                            while(!state.augsys_qn_ahead.empty())
+                                state.work_xy.recycle(state.augsys_qn_ahead,
+                                    state.augsys_qn_ahead.begin());
+                        } else {
+                            // Create the rhs, b0=(-ddx_n,-g'(x)ddx_n-g(x)).
+                            // Note, dx_n should contain the unscaled Cauchy
+                            // point.
+                            auto & b0 = loan_xy.vector(x0);
+                            quasinormalNewtonRhs(fns,state,dx_n,b0);
+
+                            // Build Schur style preconditioners
+                            auto I = typename
+                                Unconstrained <Real,XX>::Functions::Identity();
+                            auto PAugSys_l = BlockDiagonalPreconditioner
+                                (I,*(fns.PSchur_left));
+                            auto PAugSys_r = BlockDiagonalPreconditioner
+                                (I,*(fns.PSchur_right));
+
+                            // Solve the augmented system
+                            std::tie(augsys_qn_err,augsys_qn_iter) =
+                                augsysSolve(
+                                    fns,
+                                    state,
+                                    x,
+                                    b0,
+                                    augsys_iter_max,
+                                    augsys_rst_freq,
+                                    PAugSys_l,
+                                    PAugSys_r,
+                                    QNManipulator(state,fns),
+                                    x0
+                                );
+                        }
                         augsys_qn_iter_total+=augsys_qn_iter;
                         augsys_iter_total+=augsys_qn_iter;
                         auto augsys_failed = augsys_qn_err>augsys_qn_err_target;
@@ -8429,7 +10635,8 @@ namespace Optizelle{
                 // check whether the direction is zero.  In theory, this
                 // should be detected by the first test, but that can be
                 // hard to discern due to numerical error.
-                auto gp_x_dx = Y::init(y);
+                Y_Loan loan_y(state.work_y);
+                auto & gp_x_dx = loan_y.vector(y);
                 g.p(x,dx,gp_x_dx);
                 auto norm_gp_x_dx = std::sqrt(Y::innr(gp_x_dx,gp_x_dx));
                 auto norm_dx = std::sqrt(X::innr(dx,dx));
@@ -8443,11 +10650,12 @@ namespace Optizelle{
                 }
 
                 // Create the initial guess, x0=(0,0)
-                XxY_Vector x0(X::init(x),Y::init(y));
+                XxY_Loan loan_xy(state.work_xy);
+                auto & x0 = borrowXxY(loan_xy,x,y);
                     XxY::zero(x0);
 
                 // Create the rhs, b0=(dx,0)
-                XxY_Vector b0(XxY::init(x0));
+                auto & b0 = loan_xy.vector(x0);
                     X::copy(dx,b0.first);
                     Y::zero(b0.second);
             
@@ -8461,16 +10669,17 @@ namespace Optizelle{
                 // Solve the augmented system for the nullspace projection 
                 auto iter = Natural(0);
                 std::tie(augsys_null_err,iter) =
-                    Optizelle::gmres <Real,XXxYY> (
-                        AugmentedSystem(state,fns,x),
+                    augsysSolve(
+                        fns,
+                        state,
+                        x,
                         b0,
-                        Real(1.), // Overwritten by the manipulator
                         augsys_iter_max,
                         augsys_rst_freq,
                         PAugSys_l,
                         PAugSys_r,
                         gmanip,
-                        x0 
+                        x0
                     );
                 augsys_null_iter+=iter;
                 augsys_null_iter_total+=iter;
@@ -8572,16 +10781,19 @@ namespace Optizelle{
                 auto & augsys_pg_iter_total = state.augsys_pg_iter_total;
                 auto & augsys_pg_failed = state.augsys_pg_failed;
 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Find the gradient modifications for the step computation
-                auto grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
                
                 // Add the Hessian modifications to H(x)dx_n
-                auto Hdxn_step(X::init(x));
+                auto & Hdxn_step = loan.vector(x);
                     f_mod.hessvec_step(x,dx_n,H_dxn,Hdxn_step);
 
                 // grad_p_Hdxn <- H dxn_step
-                auto grad_p_Hdxn(X::init(x));
+                auto & grad_p_Hdxn = loan.vector(x);
                     X::copy(Hdxn_step,grad_p_Hdxn);
 
                 // grad_p_Hdxn <- grad f(x) + H dx_n
@@ -8743,11 +10955,12 @@ namespace Optizelle{
                 // Setup the Hessian operator and allocate memory for the
                 // Cauchy point.
                 typename Unconstrained <Real,XX>::Algorithms::HessianOperator
-                    H(fns,x);
+                    H(fns,x,state.work_x);
 
                 // Find the quantity - W (g + H dxn).  We use this as the
                 // RHS in the linear system solve.
-                X_Vector minus_W_gradpHdxn(X::init(x));
+                X_Loan loan(state.work_x);
+                auto & minus_W_gradpHdxn = loan.vector(x);
                     X::copy(W_gradpHdxn,minus_W_gradpHdxn);
                     X::scal(Real(-1.),minus_W_gradpHdxn);
 
@@ -8791,7 +11004,8 @@ namespace Optizelle{
                     trunc_iter,
                     trunc_stop,
                     safeguard_failed,
-                    alpha_x);
+                    alpha_x,
+                    state.work_x);
 
                 // Calculate the truncated CG error 
                 trunc_err = residual_err / residual_err0;
@@ -8832,7 +11046,8 @@ namespace Optizelle{
                     Real& augsys_tang_err_target=state.augsys_tang_err_target;
 
                     // dxn_p_dxt <- dx_n + dx_t
-                    X_Vector dxn_p_dxt(X::init(dx_n));
+                    X_Loan loan(state.work_x);
+                    auto & dxn_p_dxt = loan.vector(dx_n);
                     X::copy(dx_n,dxn_p_dxt);
                     X::axpy(Real(1.),xx.first,dxn_p_dxt);
 
@@ -8880,11 +11095,12 @@ namespace Optizelle{
                 auto & augsys_failed_total = state.augsys_failed_total;
 
                 // Create the initial guess, x0=(0,0)
-                XxY_Vector x0(X::init(x),Y::init(y));
+                XxY_Loan loan(state.work_xy);
+                auto & x0 = borrowXxY(loan,x,y);
                     XxY::zero(x0);
 
                 // Create the rhs, b0=(dx_t_uncorrected,0);
-                XxY_Vector b0(XxY::init(x0));
+                auto & b0 = loan.vector(x0);
                     X::copy(dx_t_uncorrected,b0.first);
                     Y::zero(b0.second);
 
@@ -8895,16 +11111,17 @@ namespace Optizelle{
 
                 // Solve the augmented system for the tangential step 
                 std::tie(augsys_tang_err,augsys_tang_iter) =
-                    Optizelle::gmres <Real,XXxYY> (
-                        AugmentedSystem(state,fns,x),
+                    augsysSolve(
+                        fns,
+                        state,
+                        x,
                         b0,
-                        Real(1.), // This will be overwritten by the manipulator
                         augsys_iter_max,
                         augsys_rst_freq,
                         PAugSys_l,
                         PAugSys_r,
                         TangentialStepManipulator(state,fns),
-                        x0 
+                        x0
                     );
                 augsys_tang_iter_total += augsys_tang_iter;
                 augsys_iter_total += augsys_tang_iter;
@@ -8985,17 +11202,21 @@ namespace Optizelle{
                 auto & augsys_iter_total = state.augsys_iter_total;
                 auto & augsys_failed_total = state.augsys_failed_total;
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                XxY_Loan loan(state.work_xy);
+
                 // Find the gradient modifications for the equality multiplier
                 // computation
-                X_Vector grad_mult(X::init(grad));
+                auto & grad_mult = loan_x.vector(grad);
                     f_mod.grad_mult(x,grad,grad_mult);
 
                 // Create the initial guess, x0=(0,0)
-                XxY_Vector x0(X::init(x),Y::init(y));
+                auto & x0 = borrowXxY(loan,x,y);
                     XxY::zero(x0);
 
                 // Create the rhs, b0=(-grad L(x,y),0);
-                XxY_Vector b0(XxY::init(x0));
+                auto & b0 = loan.vector(x0);
                     X::copy(grad_mult,b0.first);
                     X::scal(Real(-1.),b0.first);
                     Y::zero(b0.second);
@@ -9005,20 +11226,75 @@ namespace Optizelle{
                 BlockDiagonalPreconditioner PAugSys_l(I,*(fns.PSchur_left));
                 BlockDiagonalPreconditioner PAugSys_r(I,*(fns.PSchur_right));
 
-                // Solve the augmented system for the initial equality 
-                // multiplier 
-                std::tie(augsys_lmh_err,augsys_lmh_iter) =
-                    Optizelle::gmres <Real,XXxYY> (
+                // Forget any quasinormal Newton step that we solved ahead of
+                // time at a prior iterate
+                while(!state.augsys_qn_ahead.empty())
+                    state.work_xy.recycle(state.augsys_qn_ahead,
+                        state.augsys_qn_ahead.begin());
+
+                // When the quasinormal step at this iterate will solve an
+                // augmented system for its Newton step, solve that system
+                // together with this one.  Then, g sees the directions from
+                // both solves at once through p_many and ps_many.  We only
+                // do this with GMRES when we don't recycle, since the
+                // recycled subspace changes from one solve to the next.
+                auto & qn_b0 = loan.vector(x0);
+                if( state.augsys_solver == AugmentedSystemSolver::GMRES &&
+                    state.augsys_recycle_max == 0 &&
+                    quasinormalNewtonAhead(fns,state,qn_b0)
+                ) {
+                    // Create the initial guess for the Newton step
+                    auto & qn_x0 = loan.vector(x0);
+                    XxY::zero(qn_x0);
+
+                    // The quasinormal manipulator saves its target in the
+                    // state, but that target belongs to the next quasinormal
+                    // step, so we hold onto it separately
+                    auto augsys_qn_err_target = state.augsys_qn_err_target;
+
+                    // Solve both systems
+                    EqualityMultiplierStepManipulator lmhmanip(state,fns);
+                    QNManipulator qnmanip(state,fns);
+                    auto results = gmres_many <Real,XXxYY> (
                         AugmentedSystem(state,fns,x),
-                        b0,
+                        {&b0,&qn_b0},
                         Real(1.), // This will be overwritten by the manipulator
                         augsys_iter_max,
                         augsys_rst_freq,
                         PAugSys_l,
                         PAugSys_r,
-                        EqualityMultiplierStepManipulator(state,fns),
-                        x0 
-                    );
+                        {&lmhmanip,&qnmanip},
+                        {&x0,&qn_x0},
+                        state.work_xy);
+                    std::tie(augsys_lmh_err,augsys_lmh_iter) = results[0];
+
+                    // Save the Newton step for the quasinormal step
+                    std::tie(state.augsys_qn_ahead_err,
+                        state.augsys_qn_ahead_iter) = results[1];
+                    state.augsys_qn_ahead_err_target
+                        = state.augsys_qn_err_target;
+                    state.augsys_qn_err_target = augsys_qn_err_target;
+                    state.augsys_qn_ahead_xi = state.xi_qn;
+                    state.augsys_qn_ahead_x.update(x);
+                    loan.keep(qn_b0,state.augsys_qn_ahead);
+                    loan.keep(qn_x0,state.augsys_qn_ahead);
+
+                // Otherwise, solve the augmented system for the initial
+                // equality multiplier on its own
+                } else
+                    std::tie(augsys_lmh_err,augsys_lmh_iter) =
+                        augsysSolve(
+                            fns,
+                            state,
+                            x,
+                            b0,
+                            augsys_iter_max,
+                            augsys_rst_freq,
+                            PAugSys_l,
+                            PAugSys_r,
+                            EqualityMultiplierStepManipulator(state,fns),
+                            x0
+                        );
                 augsys_lmh_iter_total+=augsys_lmh_iter;
                 augsys_iter_total+=augsys_lmh_iter;
                 auto augsys_failed = augsys_lmh_err>augsys_lmh_err_target;
@@ -9052,26 +11328,30 @@ namespace Optizelle{
                 auto & augsys_iter_total = state.augsys_iter_total;
                 auto & augsys_failed_total = state.augsys_failed_total;
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                XxY_Loan loan_xy(state.work_xy);
+
                 // x_p_dx <- x + dx
-                X_Vector x_p_dx(X::init(x));
+                auto & x_p_dx = loan_x.vector(x);
                     X::copy(x,x_p_dx);
                     X::axpy(Real(1.),dx,x_p_dx);
 
                 // grad_xpdx <- L(x+dx,y) = grad f(x+dx) + g'(x+dx)*y
-                X_Vector grad_xpdx(X::init(x));
+                auto & grad_xpdx = loan_x.vector(x);
                     f.grad(x_p_dx,grad_xpdx);
 
                 // Find the gradient modifications for the equality multiplier
                 // computation
-                X_Vector grad_xpdx_mult(X::init(grad));
+                auto & grad_xpdx_mult = loan_x.vector(grad);
                     f_mod.grad_mult(x_p_dx,grad_xpdx,grad_xpdx_mult);
 
                 // Create the initial guess, x0=(0,0)
-                XxY_Vector x0(X::init(x),Y::init(dy));
+                auto & x0 = borrowXxY(loan_xy,x,dy);
                     XxY::zero(x0);
 
                 // Create the rhs, b0=(-grad L(x+dx,y),0);
-                XxY_Vector b0(XxY::init(x0));
+                auto & b0 = loan_xy.vector(x0);
                     X::copy(grad_xpdx_mult,b0.first);
                     X::scal(Real(-1.),b0.first);
                     Y::zero(b0.second);
@@ -9091,22 +11371,23 @@ namespace Optizelle{
                 // at x+dx, but the preconditioner may and probably is linked
                 // to x.  Hence, we're going to temporarily move where our
                 // current iterate is for this solve and then move back.
-                X_Vector x_save(X::init(x));
+                auto & x_save = loan_x.vector(x);
                     X::copy(x,x_save);
                 X::copy(x_p_dx,x);
 
                 // Solve the augmented system for the equality multiplier step 
                 std::tie(augsys_lmh_err,augsys_lmh_iter) =
-                    Optizelle::gmres <Real,XXxYY> (
-                        AugmentedSystem(state,fns,x),
+                    augsysSolve(
+                        fns,
+                        state,
+                        x,
                         b0,
-                        Real(1.), // This will be overwritten by the manipulator
                         augsys_iter_max,
                         augsys_rst_freq,
                         PAugSys_l,
                         PAugSys_r,
                         EqualityMultiplierStepManipulator(state,fns),
-                        x0 
+                        x0
                     );
                 augsys_lmh_iter_total+=augsys_lmh_iter;
                 augsys_iter_total+=augsys_lmh_iter;
@@ -9146,16 +11427,19 @@ namespace Optizelle{
                 // Find || g(x) ||
                 Real norm_gx = sqrt(Y::innr(g_x,g_x));
                 
+                // Borrow our temporaries from the workspace
+                X_Loan loan(state.work_x);
+
                 // Find the gradient modifications for step computation 
-                X_Vector grad_step(X::init(grad));
+                auto & grad_step = loan.vector(grad);
                     f_mod.grad_step(x,grad,grad_step);
                 
                 // Add the Hessian modifications to H(x)dx_n
-                X_Vector Hdxn_step(X::init(x));
+                auto & Hdxn_step = loan.vector(x);
                     f_mod.hessvec_step(x,dx_n,H_dxn,Hdxn_step);
                 
                 // Add the Hessian modifications to H(x)dx_t_uncorrected
-                X_Vector H_dxtuncorrected_step(X::init(x));
+                auto & H_dxtuncorrected_step = loan.vector(x);
                     f_mod.hessvec_step(x,dx_t_uncorrected,H_dxtuncorrected,
                         H_dxtuncorrected_step);
 
@@ -9270,8 +11554,10 @@ namespace Optizelle{
                 Real & pred=state.pred;
                 Real & f_xpdx=state.f_xpdx;
                 
-                // Allocate memory for temporaries that we need
-                X_Vector x_p_dx(X::init(x));
+                // Borrow memory for temporaries that we need
+                X_Loan loan_x(state.work_x);
+                Y_Loan loan_y(state.work_y);
+                auto & x_p_dx = loan_x.vector(x);
 
                 // Determine the merit function at x
                 auto merit_x = f_mod.merit(x,f_x);
@@ -9285,14 +11571,18 @@ namespace Optizelle{
                 X::axpy(Real(1.),x,x_p_dx);
 
                 // Save the old equality multiplier
-                auto y_old = Y::init(y);
+                auto & y_old = loan_y.vector(y);
                 Y::copy(y,y_old);
 
                 // Determine y + dy
                 Y::axpy(Real(1.),dy,y);
 
-                // Determine the merit function at x+dx and y+dy
-                f_xpdx = f.eval(x_p_dx);
+                // Determine the merit function at x+dx and y+dy.  We
+                // evaluate the constraints while the objective may still be
+                // in progress.
+                auto f_xpdx_done = f.eval_async(x_p_dx);
+                f_mod.prepare_merit(x_p_dx);
+                f_xpdx = f_xpdx_done.get();
                 auto merit_xpdx = f_mod.merit(x_p_dx,f_xpdx);
 
                 // Restore the old equality multiplier
@@ -9389,9 +11679,6 @@ namespace Optizelle{
                 auto & alpha = state.alpha; 
                 auto & alpha0 = state.alpha0; 
 
-                // Create a single temporary vector
-                X_Vector x_tmp1(X::init(x));
-
                 // Continue to look for a step until one comes back as valid
                 for( glob_iter = 1;
                      glob_iter <= glob_iter_max;
@@ -9675,7 +11962,8 @@ namespace Optizelle{
                         norm_gxtyp = sqrt(Y::innr(g_x,g_x));
 
                         // Also cache the value for || g'(x)*g(x) ||
-                        auto gps_g = X::init(x);
+                        X_Loan loan(state.work_x);
+                        auto & gps_g = loan.vector(x);
                         g.ps(x,g_x,gps_g);
                         norm_gpsgxtyp = std::sqrt(X::innr(gps_g,gps_g));
 
@@ -9686,7 +11974,7 @@ namespace Optizelle{
                         // In addition, update the norm of gradient and
                         // typical gradient since we've modified the equality 
                         // multiplier
-                        X_Vector grad_stop(X::init(grad));
+                        auto & grad_stop = loan.vector(grad);
                             f_mod.grad_stop(x,grad,grad_stop);
                         norm_gradtyp=sqrt(X::innr(grad_stop,grad_stop));
 
@@ -9808,6 +12096,8 @@ namespace Optizelle{
         typedef typename X::Vector X_Vector;
         typedef ZZ <Real> Z;
         typedef typename Z::Vector Z_Vector;
+        typedef typename Workspace <Real,XX>::Loan X_Loan;
+        typedef typename Workspace <Real,ZZ>::Loan Z_Loan;
 
         // Routines that manipulate the internal state of the optimization 
         // algorithm.
@@ -9868,6 +12158,12 @@ namespace Optizelle{
                 // Vector space diagnostics on Z
                 VectorSpaceDiagnostics::t z_diag;
 
+                // ---------- Workspace ----------
+
+                // Pool of work vectors shaped like z.  Like work_x, this
+                // isn't part of the restart information.
+                mutable Workspace <Real,ZZ> work_z;
+
                 // Initialization constructors
                 t(X_Vector const & x_user,Z_Vector const & z_user) :
                     Unconstrained <Real,XX>::State::t(x_user),
@@ -9929,7 +12225,8 @@ namespace Optizelle{
                         //---z_diag0---
                         VectorSpaceDiagnostics::NoDiagnostics
                         //---z_diag1---
-                    )
+                    ),
+                    work_z()
                 {
                         Z::copy(z_user,z);
                 }
@@ -10329,15 +12626,17 @@ namespace Optizelle{
                 mutable X_Vector x_tmp1;
                 mutable Z_Vector z_tmp1;
                 mutable Z_Vector z_tmp2;
+                Workspace <Real,XX> & work_x;
+                Workspace <Real,ZZ> & work_z;
                 
-                // Variables used for caching.  The boolean values denote
-                // whether or not we've started caching yet.
-                mutable std::pair <bool,X_Vector> x_merit;
+                // Variables used for caching.  The stamps determine whether
+                // the cached values are stale.
+                mutable CacheStamp <Real,XX> x_merit;
                 mutable Z_Vector hx_merit;
-                mutable std::pair <bool,X_Vector> x_lag;
-                mutable std::pair <bool,Z_Vector> z_lag;
-                mutable std::pair <bool,X_Vector> x_schur;
-                mutable std::pair <bool,Z_Vector> z_schur;
+                mutable CacheStamp <Real,XX> x_lag;
+                mutable CacheStamp <Real,ZZ> z_lag;
+                mutable CacheStamp <Real,XX> x_schur;
+                mutable CacheStamp <Real,ZZ> z_schur;
                 mutable X_Vector hpxsz;
                 mutable X_Vector hpxs_invLhx_e;
 
@@ -10352,19 +12651,13 @@ namespace Optizelle{
                     
                     // If relative error between the current and cached values
                     // is large, compute anew.
-                    if( rel_err_cached <Real,XX> (x,x_lag)
-                            >= std::numeric_limits <Real>::epsilon()*1e1 ||
-                        rel_err_cached <Real,ZZ> (z,z_lag)
-                            >= std::numeric_limits <Real>::epsilon()*1e1 
-                    ) {
+                    if(x_lag.stale(x,work_x) || z_lag.stale(z,work_z)) {
                         // hpxsz <- h'(x)* z 
                         h.ps(x,z,hpxsz);
 
                         // Cache the values
-                        x_lag.first=true;
-                        X::copy(x,x_lag.second);
-                        z_lag.first=true;
-                        Z::copy(z,z_lag.second);
+                        x_lag.update(x);
+                        z_lag.update(z);
                     }
 
                     // grad_lag <- grad f(x) - h'(x)*z
@@ -10382,11 +12675,7 @@ namespace Optizelle{
                     
                     // If relative error between the current and cached values
                     // is large, compute anew.
-                    if( rel_err_cached <Real,XX> (x,x_schur)
-                            >= std::numeric_limits <Real>::epsilon()*1e1 ||
-                        rel_err_cached <Real,ZZ> (z,z_schur)
-                            >= std::numeric_limits <Real>::epsilon()*1e1
-                    ) {
+                    if(x_schur.stale(x,work_x) || z_schur.stale(z,work_z)) {
                         // z_tmp1 <- e
                         Z::id(z_tmp1);
 
@@ -10397,10 +12686,8 @@ namespace Optizelle{
                         h.ps(x,z_tmp2,hpxs_invLhx_e);
                         
                         // Cache the values
-                        x_schur.first=true;
-                        X::copy(x,x_schur.second);
-                        z_schur.first=true;
-                        Z::copy(z,z_schur.second);
+                        x_schur.update(x);
+                        z_schur.update(z);
                     }
 
                     // grad_schur<- grad f(x) - mu h'(x)* (inv(L(h(x))) e)
@@ -10424,33 +12711,41 @@ namespace Optizelle{
                     x_tmp1(X::init(state.x)),
                     z_tmp1(Z::init(state.z)),
                     z_tmp2(Z::init(state.z)),
-                    x_merit(false,X::init(state.x)),
+                    work_x(state.work_x),
+                    work_z(state.work_z),
+                    x_merit(state.x),
                     hx_merit(Z::init(state.z)),
-                    x_lag(false,X::init(state.x)),
-                    z_lag(false,Z::init(state.z)),
-                    x_schur(false,X::init(state.x)),
-                    z_schur(false,Z::init(state.z)),
+                    x_lag(state.x),
+                    z_lag(state.z),
+                    x_schur(state.x),
+                    z_schur(state.z),
                     hpxsz(X::init(state.x)),
                     hpxs_invLhx_e(X::init(state.x))
                 {}
 
-                // Merit function additions to the objective
-                virtual Real merit(X_Vector const & x,Real const & f_x) const {
-                    // Do the underlying modification of the objective
-                    Real merit_x = f_mod->merit(x,f_x);
-                    
+                // Evaluates the constraint at x unless we've cached it
+                virtual void prepare_merit(X_Vector const & x) const {
+                    // Do the underlying preparation
+                    f_mod->prepare_merit(x);
+
                     // If we've not started caching or the relative error
                     // is large, compute anew.
-                    if( rel_err_cached <Real,XX> (x,x_merit)
-                            >= std::numeric_limits <Real>::epsilon()*1e1
-                    ) {
+                    if(x_merit.stale(x,work_x)) {
                         // hx_merit <- h(x)
                         h.eval(x,hx_merit);
                         
                         // Cache the values
-                        x_merit.first=true;
-                        X::copy(x,x_merit.second);
+                        x_merit.update(x);
                     }
+                }
+
+                // Merit function additions to the objective
+                virtual Real merit(X_Vector const & x,Real const & f_x) const {
+                    // Do the underlying modification of the objective
+                    Real merit_x = f_mod->merit(x,f_x);
+
+                    // Make sure that we have h(x)
+                    prepare_merit(x);
 
                     // Return merit(x) - mu barr(h(x))
                     return merit_x - mu * Z::barr(hx_merit); 
@@ -10566,16 +12861,19 @@ namespace Optizelle{
                 auto const & h_x = state.h_x;
                 auto const & gamma = state.gamma;
 
+                // Borrow our temporaries from the workspace
+                Z_Loan loan(state.work_z);
+
                 // hp_dxdir <- h'(x)dx_dir
-                auto hp_dxdir = Z::init(z);
+                auto & hp_dxdir = loan.vector(z);
                 h.p(x,dx_dir,hp_dxdir);
 
                 // hp_dxbase <- h'(x)dx_base
-                auto hp_dxbase = Z::init(z);
+                auto & hp_dxbase = loan.vector(z);
                 h.p(x,dx_base,hp_dxbase);
 
                 // base <- gamma zeta h(x) + h'(x)dx_base
-                auto base = Z::init(z);
+                auto & base = loan.vector(z);
                 Z::copy(hp_dxbase,base); 
                 Z::axpy(gamma*zeta,h_x,base);
 
@@ -10632,7 +12930,8 @@ namespace Optizelle{
                 auto norm_grad_step = std::sqrt(X::innr(grad_step,grad_step));
                        
                 // Find || grad_stop ||
-                auto grad_stop = X::init(x);
+                X_Loan loan(state.work_x);
+                auto & grad_stop = loan.vector(x);
                 f_mod.grad_stop(x,grad,grad_stop);
                 auto norm_grad_stop = std::sqrt(X::innr(grad_stop,grad_stop));
 
@@ -10735,6 +13034,19 @@ namespace Optizelle{
                 // Check that all functions are defined 
                 check(fns);
 
+                // Give the outputs of the inequality constraint new versions
+                // when the vector spaces track them
+                if(has_version <X>::value || has_version <Z>::value)
+                    fns.h.reset(new TouchedVectorValuedFunction <Real,XX,ZZ>(
+                        std::move(fns.h)));
+
+                // Remember the inequality constraint at the last few points
+                if(state.eval_cache_size > 0)
+                    fns.h.reset(new CachedVectorValuedFunction <Real,XX,ZZ> (
+                        std::move(fns.h),
+                        state.eval_cache_size,
+                        state.eval_cache_hits));
+
                 // Modify the objective 
                 fns.f_mod.reset(new InequalityModifications(
                     fns,state,std::move(fns.f_mod)));
@@ -10900,11 +13212,14 @@ namespace Optizelle{
                 X_Vector const & x=state.x;
                 Z_Vector const & z=state.z;
                 FunctionDiagnostics::t const & h_diag = state.h_diag;
+                Natural const & diag_threads=state.diag_threads;
                 
-                // Create some random directions for these tests
-                X_Vector dx(X::init(x));
+                // Borrow some random directions for these tests
+                X_Loan loan_x(state.work_x);
+                Z_Loan loan_z(state.work_z);
+                auto & dx = loan_x.vector(x);
                     X::rand(dx); 
-                Z_Vector dz(Z::init(z));
+                auto & dz = loan_z.vector(z);
                     Z::rand(dz);
 
                 // Run the diagnostics
@@ -10912,7 +13227,7 @@ namespace Optizelle{
                     case FunctionDiagnostics::FirstOrder:
                         msg("Diagnostics on the function h");
                         Optizelle::Diagnostics::derivativeCheck(
-                            msg,h,x,dx,dz,"h");
+                            msg,h,x,dx,dz,"h",diag_threads);
                         Optizelle::Diagnostics::derivativeAdjointCheck(
                             msg,h,x,dx,dz,"h");
                         msg("");
@@ -10920,11 +13235,11 @@ namespace Optizelle{
                     case FunctionDiagnostics::SecondOrder:
                         msg("Diagnostics on the function h");
                         Optizelle::Diagnostics::derivativeCheck(
-                            msg,h,x,dx,dz,"h");
+                            msg,h,x,dx,dz,"h",diag_threads);
                         Optizelle::Diagnostics::derivativeAdjointCheck(
                             msg,h,x,dx,dz,"h");
                         Optizelle::Diagnostics::secondDerivativeCheck(
-                            msg,h,x,dx,dz,"h");
+                            msg,h,x,dx,dz,"h",diag_threads);
                         msg("");
                         break;
                     case FunctionDiagnostics::NoDiagnostics:
@@ -10956,6 +13271,10 @@ namespace Optizelle{
                 // Inequality modifications 
                 typename Functions::InequalityModifications h_mod;
 
+                // Borrow memory for the zero vector
+                X_Loan loan;
+                X_Vector & zero;
+
             public:
                 // Remove some constructors
                 NO_COPY_ASSIGNMENT(InequalityHessianOperator);
@@ -10973,7 +13292,9 @@ namespace Optizelle{
                         std::unique_ptr <
                             ScalarValuedFunctionModifications <Real,XX>
                         > (new ScalarValuedFunctionModifications <Real,XX> ())
-                    )
+                    ),
+                    loan(state.work_x),
+                    zero(loan.vector(state.x))
                 {}
 
                 // Basic application
@@ -10981,7 +13302,6 @@ namespace Optizelle{
                     const
                 {
                     // Grab the zero vector in the X space
-                    X_Vector zero(X::init(x));
                     X::zero(zero);
 
                     // Add the equality constraint's contribution to the
@@ -11000,10 +13320,11 @@ namespace Optizelle{
                 X_Vector const & x=state.x;
                 FunctionDiagnostics::t const & L_diag=state.L_diag;
                 
-                // Create some random directions for these tests
-                X_Vector dx(X::init(x));
+                // Borrow some random directions for these tests
+                X_Loan loan(state.work_x);
+                auto & dx = loan.vector(x);
                     X::rand(dx); 
-                X_Vector dxx(X::init(x));
+                auto & dxx = loan.vector(x);
                     X::rand(dxx); 
 
                 // Create the inequality Hessian operator
@@ -11048,14 +13369,15 @@ namespace Optizelle{
                 X_Vector const & x=state.x;
                 Z_Vector const & z=state.z;
                
-                // Create some random directions for these tests
-                Z_Vector dz(Z::init(z));
+                // Borrow some random directions for these tests
+                Z_Loan loan(state.work_z);
+                auto & dz = loan.vector(z);
                     Z::rand(dz); 
-                Z_Vector dzz(Z::init(z));
+                auto & dzz = loan.vector(z);
                     Z::rand(dzz); 
-                Z_Vector dzzz(Z::init(z));
+                auto & dzzz = loan.vector(z);
                     Z::rand(dzzz); 
-                Z_Vector dzzzz(Z::init(z));
+                auto & dzzzz = loan.vector(z);
                     Z::rand(dzzzz);
 
                 // Run the diagnostics
@@ -11074,7 +13396,7 @@ namespace Optizelle{
                     case VectorSpaceDiagnostics::EuclideanJordan: {
 
                         // Evaluate h_x
-                        Z_Vector h_x(Z::init(z));
+                        auto & h_x = loan.vector(z);
                         h.eval(x,h_x);
 
                         // Run the diagnostics
@@ -11133,12 +13455,15 @@ namespace Optizelle{
                 VectorValuedFunction <Real,XX,ZZ> const & h=*(fns.h);
                 Z_Vector & dz=state.dz;
 
+                // Borrow our temporaries from the workspace
+                Z_Loan loan(state.work_z);
+
                 // z_tmp1 <- h'(x)dx
-                Z_Vector z_tmp1(Z::init(z));
+                auto & z_tmp1 = loan.vector(z);
                 h.p(x,dx,z_tmp1);
 
                 // z_tmp2 <- h'(x)dx o z
-                Z_Vector z_tmp2(Z::init(z));
+                auto & z_tmp2 = loan.vector(z);
                 Z::prod(z_tmp1,z,z_tmp2);
 
                 // z_tmp2 <- -h'(x)dx o z
@@ -11180,7 +13505,8 @@ namespace Optizelle{
                 Z_Vector & z=state.z;
 
                 // z_tmp1 <- e
-                auto e = Z::init(z);
+                Z_Loan loan(state.work_z);
+                auto & e = loan.vector(z);
                 Z::id(e);
 
                 // z <- inv(L(h(x))) e
@@ -11210,7 +13536,8 @@ namespace Optizelle{
                 auto & alpha_z=state.alpha_z;
 
                 // Find gamma z
-                auto gamma_z = Z::init(z);
+                Z_Loan loan(state.work_z);
+                auto & gamma_z = loan.vector(z);
                 Z::copy(z,gamma_z);
                 Z::scal(gamma,gamma_z);
 
@@ -11235,7 +13562,8 @@ namespace Optizelle{
 
                 // Determine the scaling factor for the interior-
                 // point parameter estimate
-                Z_Vector z_tmp(Z::init(z));
+                Z_Loan loan(state.work_z);
+                auto & z_tmp = loan.vector(z);
                 Z::id(z_tmp);
                 Real m = Z::innr(z_tmp,z_tmp);
 
@@ -11303,11 +13631,15 @@ namespace Optizelle{
                 Real & alpha_x=state.alpha_x;
                 Real & alpha_z=state.alpha_z;
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                Z_Loan loan_z(state.work_z);
+
                 // Create a fake step.  In the case of a trust-region
                 // method this is just the step.  In the case of
                 // a line-search method this is alpha0 dx.  This represents
                 // the farthest either method will attempt to step.
-                X_Vector dx_(X::init(x));
+                auto & dx_ = loan_x.vector(x);
                 X::copy(dx,dx_);
                 if(algorithm_class==AlgorithmClass::LineSearch)
                     X::scal(state.alpha0,dx_);
@@ -11315,12 +13647,12 @@ namespace Optizelle{
                 // Determine how far we can go in the primal variable
                 
                 // x_tmp1=x+dx
-                X_Vector x_tmp1(X::init(x));
+                auto & x_tmp1 = loan_x.vector(x);
                     X::copy(x,x_tmp1);
                     X::axpy(Real(1.),dx_,x_tmp1);
 
                 // z_tmp1=h(x+dx)
-                Z_Vector z_tmp1(Z::init(z));
+                auto & z_tmp1 = loan_z.vector(z);
                     h.eval(x_tmp1,z_tmp1);
 
                 // z_tmp1=h(x+dx)-h(x)
@@ -11423,11 +13755,15 @@ namespace Optizelle{
                 // not going to reference it
                 Real alpha_z(std::numeric_limits<Real>::quiet_NaN());
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                Z_Loan loan_z(state.work_z);
+
                 // Create a fake step.  In the case of a trust-region
                 // method this is just the step.  In the case of
                 // a line-search method this is alpha0 dx.  This represents
                 // the farthest either method will attempt to step.
-                X_Vector dx_(X::init(x));
+                auto & dx_ = loan_x.vector(x);
                 X::copy(dx,dx_);
                 if(algorithm_class==AlgorithmClass::LineSearch)
                     X::scal(state.alpha0,dx_);
@@ -11435,12 +13771,12 @@ namespace Optizelle{
                 // Determine how far we can go in the primal variable
                 
                 // x_tmp1=x+dx
-                X_Vector x_tmp1(X::init(x));
+                auto & x_tmp1 = loan_x.vector(x);
                     X::copy(x,x_tmp1);
                     X::axpy(Real(1.),dx_,x_tmp1);
 
                 // z_tmp1=h(x+dx)
-                Z_Vector z_tmp1(Z::init(z));
+                auto & z_tmp1 = loan_z.vector(z);
                 h.eval(x_tmp1,z_tmp1);
 
                 // z_tmp2=h(x+dx)-h(x)
@@ -11456,7 +13792,7 @@ namespace Optizelle{
                 h.p(x,dx_,z_tmp1);
                 
                 // z_tmp2 = h'(x)dx o z
-                Z_Vector z_tmp2(Z::init(z));
+                auto & z_tmp2 = loan_z.vector(z);
                     Z::prod(z_tmp1,z,z_tmp2);
 
                 // z_tmp2 = -h'(x)dx o z
@@ -11534,11 +13870,15 @@ namespace Optizelle{
                 X_Vector & dx=state.dx;
                 Real & alpha_x=state.alpha_x;
 
+                // Borrow our temporaries from the workspaces
+                X_Loan loan_x(state.work_x);
+                Z_Loan loan_z(state.work_z);
+
                 // Create a fake step.  In the case of a trust-region
                 // method this is just the step.  In the case of
                 // a line-search method this is alpha0 dx.  This represents
                 // the farthest either method will attempt to step.
-                X_Vector dx_(X::init(x));
+                auto & dx_ = loan_x.vector(x);
                 X::copy(dx,dx_);
                 if(algorithm_class==AlgorithmClass::LineSearch)
                     X::scal(state.alpha0,dx_);
@@ -11546,12 +13886,12 @@ namespace Optizelle{
                 // Determine how far we can go in the primal variable
                 
                 // x_tmp1=x+dx
-                X_Vector x_tmp1(X::init(x));
+                auto & x_tmp1 = loan_x.vector(x);
                     X::copy(x,x_tmp1);
                     X::axpy(Real(1.),dx_,x_tmp1);
 
                 // z_tmp1=h(x+dx)
-                Z_Vector z_tmp1(Z::init(z));
+                auto & z_tmp1 = loan_z.vector(z);
                     h.eval(x_tmp1,z_tmp1);
 
                 // z_tmp1=h(x+dx)-h(x)
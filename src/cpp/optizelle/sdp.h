@@ -0,0 +1,494 @@
+#pragma once
+
+#include <vector>
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+
+namespace Optizelle {
+    // Different kinds of blocks in the data matrices of a linear SDP
+    namespace SDPBlock {
+        enum t {
+            Sparse,             // Symmetric matrix stored as triplets
+            RankOne             // Scaled outer product c v v'
+        };
+    }
+
+    // A linear SDP constraint
+    //
+    // h(x) = A1 x1 + ... + Am xm - A0 >= 0
+    //
+    // where each A has the block structure of a SQL vector made up of linear
+    // and semidefinite cones.  We store the data matrices sparsely, block by
+    // block.  This lets us evaluate h and its derivatives without touching
+    // the zeros and, more importantly, form the Schur complement
+    //
+    // S dx = h'(x)* inv(L(h(x))) (h'(x)dx o z)
+    //
+    // directly rather than one Hessian-vector product at a time.
+    template <typename Real>
+    struct LinearSDP : public VectorValuedFunction <Real,Rm,SQL> {
+        // Create some type shortcuts
+        typedef Rm <Real> X;
+        typedef typename X::Vector X_Vector;
+        typedef SQL <Real> Z;
+        typedef typename Z::Vector Z_Vector;
+
+        // A block of one of the data matrices.  Sparse blocks list each
+        // nonzero, (is[k],js[k],data[k]), of a symmetric matrix once, so an
+        // off-diagonal entry also defines its transpose.  Since the blocks
+        // for linear cones are diagonal, they only use is.  Rank-one blocks
+        // store scale v v' where v is sparse with entries data[k] at is[k].
+        // All indices start at 1.
+        struct Block {
+            SDPBlock::t type;
+            std::vector <Natural> is;
+            std::vector <Natural> js;
+            std::vector <Real> data;
+            Real scale;
+        };
+
+    private:
+        // Type of cones in the codomain
+        std::vector <Cone::t> types;
+
+        // Size of the cones in the codomain
+        std::vector <Natural> sizes;
+
+        // Data matrices A0, A1, ..., Am.  Each has one block per cone.
+        std::vector <std::vector <Block> > A;
+
+        // blk_z <- blk_z + alpha blk_Ai where blk_z points to the block
+        void axpy_block(
+            Real const & alpha,
+            Natural const & i,
+            Natural const & blk,
+            Real * const z
+        ) const {
+            auto const & Ai = A[i][itok(blk)];
+            Natural const n = sizes[itok(blk)];
+            switch(types[itok(blk)]) {
+            case Cone::Linear:
+                for(Natural k=0;k<Ai.is.size();k++)
+                    z[itok(Ai.is[k])] += alpha*Ai.data[k];
+                break;
+            case Cone::Semidefinite:
+                if(Ai.type==SDPBlock::Sparse)
+                    for(Natural k=0;k<Ai.is.size();k++) {
+                        z[ijtok(Ai.is[k],Ai.js[k],n)] += alpha*Ai.data[k];
+                        if(Ai.is[k]!=Ai.js[k])
+                            z[ijtok(Ai.js[k],Ai.is[k],n)] += alpha*Ai.data[k];
+                    }
+                else
+                    for(Natural l=0;l<Ai.is.size();l++)
+                        for(Natural k=0;k<Ai.is.size();k++)
+                            z[ijtok(Ai.is[k],Ai.is[l],n)] +=
+                                alpha*Ai.scale*Ai.data[k]*Ai.data[l];
+                break;
+            case Cone::Quadratic:
+                break;
+            }
+        }
+
+        // <blk_Ai,blk_dz> where blk_dz points to the block
+        Real innr_block(
+            Natural const & i,
+            Natural const & blk,
+            Real const * const dz
+        ) const {
+            auto const & Ai = A[i][itok(blk)];
+            Natural const n = sizes[itok(blk)];
+            Real innr(0.);
+            switch(types[itok(blk)]) {
+            case Cone::Linear:
+                for(Natural k=0;k<Ai.is.size();k++)
+                    innr += Ai.data[k]*dz[itok(Ai.is[k])];
+                break;
+            case Cone::Semidefinite:
+                if(Ai.type==SDPBlock::Sparse)
+                    for(Natural k=0;k<Ai.is.size();k++) {
+                        innr += Ai.data[k]*dz[ijtok(Ai.is[k],Ai.js[k],n)];
+                        if(Ai.is[k]!=Ai.js[k])
+                            innr += Ai.data[k]*dz[ijtok(Ai.js[k],Ai.is[k],n)];
+                    }
+                else {
+                    for(Natural l=0;l<Ai.is.size();l++)
+                        for(Natural k=0;k<Ai.is.size();k++)
+                            innr += Ai.scale*Ai.data[k]*Ai.data[l]
+                                *dz[ijtok(Ai.is[k],Ai.is[l],n)];
+                }
+                break;
+            case Cone::Quadratic:
+                break;
+            }
+            return innr;
+        }
+
+        // z <- sum_{i>=start} alpha_i A_i where alpha_0 = -1 and alpha_i = x_i
+        // otherwise.  Since the blocks are independent, we compute them in
+        // parallel.
+        void eval_from(
+            Natural const & start,
+            X_Vector const & x,
+            Z_Vector & z
+        ) const {
+            Z::zero(z);
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic)
+            #endif
+            for(Natural blk=1;blk<=types.size();blk++) {
+                Real * const zk = &(z.data[z.offsets[itok(blk)]]);
+                for(Natural i=start;i<A.size();i++)
+                    axpy_block(i==0 ? Real(-1.) : x[itok(i)],i,blk,zk);
+            }
+            z.touch();
+        }
+
+        // Adds the contribution of a linear cone to the Schur complement
+        //
+        // S_ki += sum_l A_k(l) A_i(l) z(l) / h(l)
+        void schur_linear(
+            Natural const & blk,
+            Real const * const h_x,
+            Real const * const z,
+            Real * const S
+        ) const {
+            Natural const m = A.size()-1;
+            Natural const n = sizes[itok(blk)];
+
+            #ifdef _OPENMP
+            #pragma omp parallel
+            #endif
+            {
+                // Dense version of A_i z / h
+                std::vector <Real> t(n,Real(0.));
+
+                #ifdef _OPENMP
+                #pragma omp for schedule(dynamic)
+                #endif
+                for(Natural i=1;i<=m;i++) {
+                    auto const & Ai = A[i][itok(blk)];
+                    for(Natural l=0;l<Ai.is.size();l++) {
+                        Natural const ll = itok(Ai.is[l]);
+                        t[ll] += Ai.data[l]*z[ll]/h_x[ll];
+                    }
+                    for(Natural k=1;k<=m;k++) {
+                        auto const & Ak = A[k][itok(blk)];
+                        Real s(0.);
+                        for(Natural l=0;l<Ak.is.size();l++)
+                            s += Ak.data[l]*t[itok(Ak.is[l])];
+                        S[ijtok(k,i,m)] += s;
+                    }
+                    for(Natural l=0;l<Ai.is.size();l++)
+                        t[itok(Ai.is[l])] = Real(0.);
+                }
+            }
+        }
+
+        // Adds the contribution of a semidefinite cone to the Schur
+        // complement
+        //
+        // S_ki += <A_k, inv(H) A_i Z>
+        //
+        // For each column, we choose between two formulas based on the
+        // number of nonzeros.  Either we form G = inv(H) A_i Z densely and
+        // then take the inner product with each A_k or we sum over the pairs
+        // of nonzeros in A_i and A_k directly.  Rank-one blocks reduce to
+        // vectors: with c v v', inv(H) A_i Z = c (inv(H) v) (Z' v)'.
+        void schur_sdp(
+            Natural const & blk,
+            Real const * const Hinv,
+            Real const * const Zk,
+            Real * const S
+        ) const {
+            Natural const m = A.size()-1;
+            Natural const n = sizes[itok(blk)];
+            Natural const b = itok(blk);
+
+            // For the rank-one blocks, find inv(H) v, Z v, and Z' v.  Also,
+            // find the total number of nonzeros in the sparse blocks.
+            std::vector <Natural> r1(m+1,0);
+            std::vector <Real> Hinv_v;
+            std::vector <Real> Z_v;
+            std::vector <Real> Zt_v;
+            Natural nnz(0);
+            Natural nnz_r1(0);
+            for(Natural k=1;k<=m;k++) {
+                auto const & Ak = A[k][b];
+                if(Ak.type==SDPBlock::Sparse) {
+                    nnz += Ak.is.size();
+                    continue;
+                }
+                nnz_r1 += Ak.is.size()*Ak.is.size();
+                r1[k] = Hinv_v.size();
+                Hinv_v.resize(Hinv_v.size()+n,Real(0.));
+                Z_v.resize(Z_v.size()+n,Real(0.));
+                Zt_v.resize(Zt_v.size()+n,Real(0.));
+                for(Natural l=0;l<Ak.is.size();l++) {
+                    Optizelle::axpy <Real> (n,Ak.data[l],
+                        &(Hinv[ijtok(1,Ak.is[l],n)]),1,&(Hinv_v[r1[k]]),1);
+                    Optizelle::axpy <Real> (n,Ak.data[l],
+                        &(Zk[ijtok(1,Ak.is[l],n)]),1,&(Z_v[r1[k]]),1);
+                    Optizelle::axpy <Real> (n,Ak.data[l],
+                        &(Zk[ijtok(Ak.is[l],1,n)]),n,&(Zt_v[r1[k]]),1);
+                }
+            }
+
+            #ifdef _OPENMP
+            #pragma omp parallel
+            #endif
+            {
+                // Dense storage for inv(H) A_i and inv(H) A_i Z
+                std::vector <Real> T;
+                std::vector <Real> G;
+
+                #ifdef _OPENMP
+                #pragma omp for schedule(dynamic)
+                #endif
+                for(Natural i=1;i<=m;i++) {
+                    auto const & Ai = A[i][b];
+                    Natural const nnz_i = Ai.is.size();
+                    if(nnz_i==0)
+                        continue;
+
+                    // Rank-one column, G = c u w' where u = inv(H) v and
+                    // w = Z' v.
+                    if(Ai.type==SDPBlock::RankOne) {
+                        Real const * const u = &(Hinv_v[r1[i]]);
+                        Real const * const w = &(Zt_v[r1[i]]);
+                        for(Natural k=1;k<=m;k++) {
+                            auto const & Ak = A[k][b];
+                            Real s(0.);
+                            if(Ak.type==SDPBlock::Sparse)
+                                for(Natural l=0;l<Ak.is.size();l++) {
+                                    Natural const r = itok(Ak.is[l]);
+                                    Natural const c = itok(Ak.js[l]);
+                                    s += Ak.data[l]*(u[r]*w[c]
+                                        + (r!=c ? u[c]*w[r] : Real(0.)));
+                                }
+                            else {
+                                Real yu(0.);
+                                Real yw(0.);
+                                for(Natural l=0;l<Ak.is.size();l++) {
+                                    yu += Ak.data[l]*u[itok(Ak.is[l])];
+                                    yw += Ak.data[l]*w[itok(Ak.is[l])];
+                                }
+                                s = Ak.scale*yu*yw;
+                            }
+                            S[ijtok(k,i,m)] += Ai.scale*s;
+                        }
+                        continue;
+                    }
+
+                    // Determine which formula is cheaper for a sparse column
+                    Natural const cost_dense = 2*nnz_i*n + 2*n*n*n
+                        + nnz + nnz_r1;
+                    Natural const cost_sparse = 4*nnz_i*nnz
+                        + 2*nnz_i*(Hinv_v.size()/(n>0 ? n : 1));
+
+                    // Sum over the pairs of nonzeros where
+                    //
+                    // G(r,s) = sum_(p,q) a (inv(H)(r,p) Z(q,s)
+                    //                       + inv(H)(r,q) Z(p,s))
+                    //
+                    // and the second term only appears off the diagonal.
+                    if(cost_sparse < cost_dense) {
+                        auto G_rs = [&](Natural const & r,Natural const & s) {
+                            Real g(0.);
+                            for(Natural l=0;l<nnz_i;l++) {
+                                Natural const p = Ai.is[l];
+                                Natural const q = Ai.js[l];
+                                g += Ai.data[l]*(Hinv[ijtok(r,p,n)]
+                                    *Zk[ijtok(q,s,n)] + (p!=q ?
+                                    Hinv[ijtok(r,q,n)]*Zk[ijtok(p,s,n)] :
+                                    Real(0.)));
+                            }
+                            return g;
+                        };
+                        for(Natural k=1;k<=m;k++) {
+                            auto const & Ak = A[k][b];
+                            Real s(0.);
+                            if(Ak.type==SDPBlock::Sparse)
+                                for(Natural l=0;l<Ak.is.size();l++) {
+                                    Natural const r = Ak.is[l];
+                                    Natural const c = Ak.js[l];
+                                    s += Ak.data[l]*(G_rs(r,c)
+                                        + (r!=c ? G_rs(c,r) : Real(0.)));
+                                }
+
+                            // For a rank-one A_k, we have
+                            // <d y y', inv(H) A_i Z> = d (inv(H) y)' A_i (Z y)
+                            else {
+                                Real const * const xi = &(Hinv_v[r1[k]]);
+                                Real const * const zeta = &(Z_v[r1[k]]);
+                                for(Natural l=0;l<nnz_i;l++) {
+                                    Natural const p = itok(Ai.is[l]);
+                                    Natural const q = itok(Ai.js[l]);
+                                    s += Ai.data[l]*(xi[p]*zeta[q]
+                                        + (p!=q ? xi[q]*zeta[p] : Real(0.)));
+                                }
+                                s *= Ak.scale;
+                            }
+                            S[ijtok(k,i,m)] += s;
+                        }
+
+                    // Form G densely
+                    } else {
+                        // T <- inv(H) A_i
+                        T.assign(n*n,Real(0.));
+                        for(Natural l=0;l<nnz_i;l++) {
+                            Natural const p = Ai.is[l];
+                            Natural const q = Ai.js[l];
+                            Optizelle::axpy <Real> (n,Ai.data[l],
+                                &(Hinv[ijtok(1,p,n)]),1,&(T[ijtok(1,q,n)]),1);
+                            if(p!=q)
+                                Optizelle::axpy <Real> (n,Ai.data[l],
+                                    &(Hinv[ijtok(1,q,n)]),1,
+                                    &(T[ijtok(1,p,n)]),1);
+                        }
+
+                        // G <- inv(H) A_i Z
+                        G.resize(n*n);
+                        Optizelle::gemm <Real> ('N','N',n,n,n,Real(1.),
+                            &(T.front()),n,Zk,n,Real(0.),&(G.front()),n);
+
+                        // S_ki += <A_k,G>
+                        for(Natural k=1;k<=m;k++) {
+                            auto const & Ak = A[k][b];
+                            Real s(0.);
+                            if(Ak.type==SDPBlock::Sparse)
+                                for(Natural l=0;l<Ak.is.size();l++) {
+                                    Natural const r = Ak.is[l];
+                                    Natural const c = Ak.js[l];
+                                    s += Ak.data[l]*(G[ijtok(r,c,n)]
+                                        + (r!=c ? G[ijtok(c,r,n)] : Real(0.)));
+                                }
+                            else {
+                                for(Natural l=0;l<Ak.is.size();l++)
+                                    for(Natural j=0;j<Ak.is.size();j++)
+                                        s += Ak.data[j]*Ak.data[l]
+                                            *G[ijtok(Ak.is[j],Ak.is[l],n)];
+                                s *= Ak.scale;
+                            }
+                            S[ijtok(k,i,m)] += s;
+                        }
+                    }
+                }
+            }
+        }
+
+    public:
+        // We require the structure of the codomain and the data matrices
+        // A0, A1, ..., Am.
+        LinearSDP(
+            std::vector <Cone::t> const & types_,
+            std::vector <Natural> const & sizes_,
+            std::vector <std::vector <Block> > const & A_
+        ) : types(types_), sizes(sizes_), A(A_) {
+            // Check the structure of the data
+            if(types.size()!=sizes.size())
+                throw Exception::t(__LOC__
+                    + ", the vector containing the type of cones must "
+                    "be the same size as the vector with the cone sizes");
+            if(A.size()==0)
+                throw Exception::t(__LOC__
+                    + ", a linear SDP requires at least the data matrix A0");
+            for(Natural i=0;i<A.size();i++) {
+                if(A[i].size()!=types.size())
+                    throw Exception::t(__LOC__
+                        + ", each data matrix requires one block per cone");
+                for(Natural blk=1;blk<=types.size();blk++) {
+                    auto const & Ai = A[i][itok(blk)];
+                    if(types[itok(blk)]==Cone::Quadratic)
+                        throw Exception::t(__LOC__
+                            + ", a linear SDP only supports linear and "
+                            "semidefinite cones");
+                    if(types[itok(blk)]==Cone::Linear &&
+                        Ai.type==SDPBlock::RankOne
+                    )
+                        throw Exception::t(__LOC__
+                            + ", the blocks for linear cones must be sparse");
+                    if(Ai.is.size()!=Ai.data.size() ||
+                        (types[itok(blk)]==Cone::Semidefinite &&
+                            Ai.type==SDPBlock::Sparse &&
+                            Ai.js.size()!=Ai.is.size())
+                    )
+                        throw Exception::t(__LOC__
+                            + ", the indices and data of a block must have "
+                            "the same size");
+                }
+            }
+        }
+
+        // z=h(x)
+        void eval(X_Vector const & x,Z_Vector & z) const {
+            eval_from(0,x,z);
+        }
+
+        // z=h'(x)dx
+        void p(
+            X_Vector const & /*x*/,
+            X_Vector const & dx,
+            Z_Vector & z
+        ) const {
+            eval_from(1,dx,z);
+        }
+
+        // xhat=h'(x)*dz
+        void ps(
+            X_Vector const & /*x*/,
+            Z_Vector const & dz,
+            X_Vector & xhat
+        ) const {
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic)
+            #endif
+            for(Natural i=1;i<A.size();i++) {
+                Real innr(0.);
+                for(Natural blk=1;blk<=types.size();blk++)
+                    innr+=innr_block(i,blk,&(dz.data[dz.offsets[itok(blk)]]));
+                xhat[itok(i)]=innr;
+            }
+        }
+
+        // xhat=(h''(x)dx)*dz
+        void pps(
+            X_Vector const & /*x*/,
+            X_Vector const & /*dx*/,
+            Z_Vector const & /*dz*/,
+            X_Vector & xhat
+        ) const {
+            X::zero(xhat);
+        }
+
+        // Forms the Schur complement, which is the m x m matrix
+        //
+        // S = h'(x)* inv(L(h(x))) (h'(x) . o z)
+        //
+        // and stores it in column-major order.  This is the interior point
+        // piece of the Hessian used by the inequality constrained
+        // algorithms.  We get the inverses of the semidefinite blocks of
+        // h(x) from the cache in h_x.
+        void schur(
+            Z_Vector const & h_x,
+            Z_Vector const & z,
+            std::vector <Real> & S
+        ) const {
+            Natural const m = A.size()-1;
+            S.assign(m*m,Real(0.));
+            for(Natural blk=1;blk<=types.size();blk++) {
+                Real const * const zk = &(z.data[z.offsets[itok(blk)]]);
+                switch(types[itok(blk)]) {
+                case Cone::Linear:
+                    schur_linear(blk,&(h_x.data[h_x.offsets[itok(blk)]]),zk,
+                        &(S.front()));
+                    break;
+                case Cone::Semidefinite:
+                    schur_sdp(blk,Z::get_inverse(h_x,blk),zk,&(S.front()));
+                    break;
+                case Cone::Quadratic:
+                    break;
+                }
+            }
+        }
+    };
+}
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 #include <random>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "optizelle/linalg.h"
 #include "optizelle/optizelle.h"
 #include "optizelle/json.h"
@@ -47,6 +52,108 @@ namespace Optizelle {
             return Optizelle::dot<Real>(x.size(),&(x.front()),1,&(y.front()),1);
         }
 
+        // y <- alpha * x + beta * y.
+        static void axpby(
+            Real const & alpha,
+            Vector const & x,
+            Real const & beta,
+            Vector & y
+        ) {
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for(Natural i=0;i<x.size();i++) 
+                y[i]=alpha*x[i]+beta*y[i];
+        }
+
+        // y <- alpha * x + y and then axpy_innr <- <y,z>.
+        static Real axpy_innr(
+            Real const & alpha,
+            Vector const & x,
+            Vector & y,
+            Vector const & z
+        ) {
+            Real innr=Real(0.);
+            #ifdef _OPENMP
+            #pragma omp parallel for reduction(+:innr) schedule(static)
+            #endif
+            for(Natural i=0;i<x.size();i++) {
+                y[i]+=alpha*x[i];
+                innr+=y[i]*z[i];
+            }
+            return innr;
+        }
+
+        // y <- alpha * x.
+        static void copy_scal(
+            Real const & alpha,
+            Vector const & x,
+            Vector & y
+        ) {
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for(Natural i=0;i<x.size();i++) 
+                y[i]=alpha*x[i];
+        }
+
+        // Store several vectors contiguously in column-major order
+        typedef std::vector <Real> MultiVector;
+
+        // Resize xs to hold n vectors shaped like x
+        static void resize_many(
+            Vector const & x,
+            Natural const & n,
+            MultiVector & xs
+        ) {
+            xs.resize(n*x.size());
+        }
+
+        // xs_j <- x
+        static void copy_many(
+            Vector const & x,
+            Natural const & j,
+            MultiVector & xs
+        ) {
+            Optizelle::copy <Real> (x.size(),&(x.front()),1,
+                &(xs[j*x.size()]),1);
+        }
+
+        // z_j <- <xs_j,y> for j < k.  For a single vector, we use dot, so
+        // that we round exactly as innr does.  Otherwise, the Krylov methods
+        // would change their results even when they store a single vector.
+        static void innr_many(
+            Natural const & k,
+            MultiVector const & xs,
+            Vector const & y,
+            Real * z
+        ) {
+            if(k==0) return;
+            if(k==1)
+                z[0] = Optizelle::dot <Real> (y.size(),&(xs.front()),1,
+                    &(y.front()),1);
+            else
+                Optizelle::gemv <Real> ('T',y.size(),k,Real(1.),
+                    &(xs.front()),y.size(),&(y.front()),1,Real(0.),z,1);
+        }
+
+        // y <- sum_{j<k} alpha_j xs_j + y.  For a single vector, we use axpy
+        // for the same reason as above.
+        static void axpy_many(
+            Natural const & k,
+            Real const * const alpha,
+            MultiVector const & xs,
+            Vector & y
+        ) {
+            if(k==0) return;
+            if(k==1)
+                Optizelle::axpy <Real> (y.size(),alpha[0],&(xs.front()),1,
+                    &(y.front()),1);
+            else
+                Optizelle::gemv <Real> ('N',y.size(),k,Real(1.),
+                    &(xs.front()),y.size(),alpha,1,Real(1.),&(y.front()),1);
+        }
+
         // x <- 0.
         static void zero(Vector & x) {
             #ifdef _OPENMP
@@ -205,10 +312,22 @@ namespace Optizelle {
         bool is_valid(std::string const & name); 
     }
 
+    // How we schedule the work on the semidefinite blocks of a SQL vector 
+    namespace ConeSchedule {
+        enum t {
+            Automatic,          // Choose based on the sizes of the blocks
+            PerCone,            // One block at a time with threaded BLAS
+            AcrossCones         // All blocks in parallel with serial BLAS
+        };
+    }
+
     // A vector spaces consisting of a finite product of semidefinite,
     // quadratic, and linear cones.  This uses the nonsymmetric product
     // for the SDP blocks where x o y = xy.  This is not a true Euclidean-Jordan
-    // algebra, but is sufficient for our purposes.
+    // algebra, but is sufficient for our purposes.  Since this product isn't
+    // symmetric, we store the SDP blocks in full, column-major storage.  Only
+    // the cached Choleski factors of the blocks use rectangular full packed
+    // storage.
     //---SQL0---
     template <typename Real>
     struct SQL {
@@ -232,18 +351,71 @@ namespace Optizelle {
             // Size of the cones stored in the data.
             std::vector <Natural> sizes;
 
-            // Cached matrix inverses.  Once we have the offset, we store the
-            // matrix.
-            mutable std::vector <Real> inverse;
-
-            // Offsets of the cached matrix inverses 
-            std::vector <Natural> inverse_offsets;
-
-            // Point where we last took the matrix inverse 
-            mutable std::vector <Real> inverse_base;
-
-            // Offsets for the bases stored for the matrix inverses 
-            std::vector <Natural> inverse_base_offsets;
+            // Version of the data.  Anything that modifies the data must
+            // call touch, which invalidates the cached factorizations.
+            // The SQL operations do this automatically and the algorithms
+            // touch the outputs of the objective and constraints.  Writes
+            // through the nonconstant accessors mark the vector as dirty,
+            // so we restamp it the next time someone asks for the version.
+            // Code that writes to data directly must call touch itself
+            // once it's done.  We draw the versions from next_version, so
+            // no two vectors share one.
+            mutable Natural version;
+
+            // Whether someone had nonconstant access to the data since we
+            // last stamped the version
+            mutable bool dirty;
+
+            // Cached factorizations of each block.  We only allocate memory
+            // for these once we factor a block, so most vectors never pay
+            // for them.
+            struct Cache {
+                // Version of the data when we computed the factor
+                Natural factor_version;
+
+                // Version of the data when we computed the inverse
+                Natural inverse_version;
+
+                // Number of times we used and computed a factorization
+                Natural hits;
+                Natural misses;
+
+                // Choleski factor, X = U'U, in rectangular full packed
+                // format, which requires about half the memory of the block
+                std::vector <Real> factor;
+
+                // Matrix inverse.  Since we multiply by this with BLAS, we
+                // store the entire matrix.
+                std::vector <Real> inverse;
+            };
+            mutable std::vector <Cache> cache;
+
+            // Cones that share a type and a size.  The Jordan-algebra kernels
+            // run a single loop over each group rather than one per cone,
+            // which matters when we have many small cones.
+            struct Group {
+                // Type of the cones in the group
+                Cone::t type;
+
+                // Size of each cone in the group
+                Natural size;
+
+                // Cones in the group
+                std::vector <Natural> blks;
+
+                // Offsets of each cone in the group stored in the data
+                std::vector <Natural> offsets;
+            };
+            std::vector <Group> groups;
+
+            // How we schedule the work on the semidefinite blocks.  This
+            // is copied by init.
+            ConeSchedule::t schedule;
+
+            // Semidefinite blocks ordered from the most to the least
+            // expensive, which helps balance the work when we process
+            // them in parallel.
+            std::vector <Natural> sdp_blks;
 
             // Eliminate constructors 
             NO_DEFAULT_COPY_ASSIGNMENT(Vector)
@@ -256,8 +428,10 @@ namespace Optizelle {
             )
             //---SQLVector3---
             : data(), offsets(), types(types_), sizes(sizes_),
-                inverse(), inverse_offsets(), inverse_base(),
-                inverse_base_offsets()
+                version(next_version()), dirty(false),
+                cache(types_.size(),Cache{0,0,0,0,{},{}}),
+                groups(),
+                schedule(ConeSchedule::Automatic), sdp_blks()
             {
 
                 // Insure that the type of cones and their sizes lines up.
@@ -285,43 +459,75 @@ namespace Optizelle {
                 // Create the data.
                 data.resize(offsets.back());
 
-                // Calculate offsets for the matrix inverses.  Basically,
-                // the way it works is that we calculate offsets for every cone
-                // even though we're not ever going to use them.  In the case
-                // we don't have an SDP block, we simply use the last offset.
-                // This makes it easy to index to the correct place where the
-                // cached information is stored.
-                inverse_offsets.resize(sizes.size()+1);
-                inverse_offsets.front()=0;
-                inverse_base_offsets.resize(sizes.size()+1);
-                inverse_base_offsets.front()=0;
-                for(Natural i=1;i<types.size()+1;i++) {
-                    inverse_offsets[i] =
-                        types[itok(i)]==Cone::Linear ||
-                        types[itok(i)]==Cone::Quadratic
-                            ? inverse_offsets[itok(i)]
-                            : inverse_offsets[itok(i)]
-                                +sizes[itok(i)]*sizes[itok(i)];
-                    inverse_base_offsets[i] =
-                        types[itok(i)]==Cone::Linear ||
-                        types[itok(i)]==Cone::Quadratic
-                            ? inverse_base_offsets[itok(i)]
-                            : inverse_base_offsets[itok(i)]
-                                +sizes[itok(i)]*sizes[itok(i)];
+                // Group the cones by type and size.  The groups are ordered
+                // by the first appearance of each type and size.
+                std::map <std::pair <Cone::t,Natural>,Natural> group_ids;
+                for(Natural blk=1;blk<=types.size();blk++) {
+                    auto key = std::make_pair(
+                        types[itok(blk)],sizes[itok(blk)]);
+                    auto id = group_ids.find(key);
+                    if(id == group_ids.end()) {
+                        id = group_ids.emplace(key,groups.size()).first;
+                        groups.emplace_back(
+                            Group{key.first,key.second,{},{}});
+                    }
+                    groups[id->second].blks.emplace_back(blk);
+                    groups[id->second].offsets.emplace_back(
+                        offsets[itok(blk)]);
                 }
 
-                // Create the memory required for the cached Schur
-                // decompositions.
-                inverse.resize(inverse_offsets.back());
-                inverse_base.resize(inverse_base_offsets.back());
+                // Order the semidefinite blocks by their cost.  The work
+                // for each is dominated by factorizations, which cost m^3.
+                for(Natural blk=1;blk<=types.size();blk++)
+                    if(types[itok(blk)]==Cone::Semidefinite)
+                        sdp_blks.emplace_back(blk);
+                std::stable_sort(sdp_blks.begin(),sdp_blks.end(),
+                    [&](Natural const & i,Natural const & j) {
+                        return sizes[itok(i)] > sizes[itok(j)];
+                    });
             }
             
             // Move semantics 
             Vector (Vector && x) = default; 
             Vector & operator = (Vector && x) = default;
 
-            // Simple indexing.
+            // Invalidates the cached factorizations after we modify the data
+            void touch() {
+                version=next_version();
+                dirty=false;
+            }
+
+            // Gets the version of the data and restamps it first when we
+            // may have written through the accessors
+            Natural stamp() const {
+                if(dirty) {
+                    version=next_version();
+                    dirty=false;
+                }
+                return version;
+            }
+
+            // Number of times we used a cached factorization
+            Natural cache_hits() const {
+                Natural hits(0);
+                for(auto const & c : cache)
+                    hits+=c.hits;
+                return hits;
+            }
+
+            // Number of times we computed a factorization
+            Natural cache_misses() const {
+                Natural misses(0);
+                for(auto const & c : cache)
+                    misses+=c.misses;
+                return misses;
+            }
+
+            // Simple indexing.  The nonconstant accessors mark the vector as
+            // dirty, which invalidates the cached factorizations.  Access
+            // through a constant reference when only reading the data.
             Real & operator () (Natural const & i) {
+                dirty=true;
                 return data[itok(i)];
             }
             Real const & operator () (Natural const & i) const {
@@ -330,6 +536,7 @@ namespace Optizelle {
 
             // Indexing with multiple cones.
             Real & operator () (Natural const & k,Natural const & i) {
+                dirty=true;
                 return data[offsets[itok(k)]+itok(i)];
             }
             Real const & operator () (Natural const & k,Natural const & i)const{
@@ -340,6 +547,7 @@ namespace Optizelle {
             Real & operator () (
                 Natural const & k,Natural const & i,Natural const & j
             ) {
+                dirty=true;
                 return data[offsets[itok(k)]+ijtok(i,j,sizes[itok(k)])];
             }
             Real const & operator ()(
@@ -391,96 +599,115 @@ namespace Optizelle {
         };
         //---SQLVector5---
 
-        // Gets the matrix inverse of a block of the SQL vector.
-        static void get_inverse(
+        // Gets a read-only view of the Choleski factor, X = U'U, of a block
+        // of the SQL vector in rectangular full packed format.  We only
+        // refactor when the vector has changed since the last time we
+        // factored the block.
+        static Real const * get_factor(
             Vector const & X,
-            Natural const & blk,
-            std::vector <Real> & Xinv 
+            Natural const & blk
         ) {
-            // Get the size of the block
-            const Natural m=X.sizes[itok(blk)];
-
-            // Next, check if we've already calculated the matrix inverse.
-
-            // Copy out the the base of the last inverse 
-            std::vector <Real> tmp(m*m);
-            Optizelle::copy <Real>
-                (m*m,&(X.inverse_base[X.inverse_base_offsets[itok(blk)]]),
-                1,&(tmp.front()),1);
-
-            // tmp <- Base_k - X_k
-            Optizelle::axpy <Real>
-                (m*m,Real(-1.),&(X.data[X.offsets[itok(blk)]]),
-                1,&(tmp.front()),1);
-
-            // Find the relative error between the current iterate
-            // and the base
-            Real norm_xk = sqrt(dot <Real>
-                (m*m,&(X.data[X.offsets[itok(blk)]]),1,
-                &(X.data[X.offsets[itok(blk)]]),1));
-            Real rel_err = sqrt(dot<Real> (m,&(tmp.front()),1,&(tmp.front()),1))
-                / (std::numeric_limits <Real>::epsilon()+norm_xk);
-
-            // If the relative error is large, refresh the cached decomposition.
-            // To be sure, I'm not really sure what this tolerance should be
-            // given that we have both floats and doubles.  In reality,
-            // the iterates will probably change rapidly, so I don't think
-            // we have to worry too much, but be careful.
-            if(rel_err > std::numeric_limits <Real>::epsilon()*1e2) {
-
-                // Store X_k as the new base
-                Optizelle::copy<Real> (m*m,&(X.data[X.offsets[itok(blk)]]),1,
-                    &(X.inverse_base[X.inverse_base_offsets[itok(blk)]]),1);
-
-                // Find the matrix inverse of X_k 
-
-                // Find the matrix inverse.  This assumes the input is
-                // symmetric positive definite.
-                Integer info(0);
-                Optizelle::copy<Real> (m*m,&(X.data[X.offsets[itok(blk)]]),1,
-                    &(X.inverse[X.inverse_offsets[itok(blk)]]),1);
-                Optizelle::potrf <Real> ('U',m,
-                    &(X.inverse[X.inverse_offsets[itok(blk)]]),m,info);
-                Optizelle::potri <Real> ('U',m,
-                    &(X.inverse[X.inverse_offsets[itok(blk)]]),m,info);
-               
-                // Copy the upper triangular portion to the lower.
-                for(Natural i=1;i<=m;i++)
-                    Optizelle::copy <Real> (m-i,
-                        &(X.inverse[X.inverse_offsets[itok(blk)]
-                            +ijtok(i,i+1,m)]),m,
-                        &(X.inverse[X.inverse_offsets[itok(blk)]
-                            +ijtok(i+1,i,m)]),1);
+            // Get the size of the block and its cached information
+            Natural const m=X.sizes[itok(blk)];
+            auto & cache = X.cache[itok(blk)];
+
+            // If the data hasn't changed, use the cached factor
+            Natural const version = X.stamp();
+            if(cache.factor_version == version) {
+                cache.hits++;
+                return &(cache.factor.front());
+            }
+
+            // Otherwise, find the Choleski factorization
+            Integer info(0);
+            cache.factor.resize(m*(m+1)/2);
+            Optizelle::trttf <Real> ('N','U',m,&(X.data[X.offsets[itok(blk)]]),
+                m,&(cache.factor.front()),info);
+            Optizelle::pftrf <Real> ('N','U',m,&(cache.factor.front()),info);
+
+            // If the block isn't positive definite, the partial factor
+            // means nothing.  Fill it with NaNs, so that the barrier and
+            // anything else that we build from the factor come back as NaN
+            // rather than as something that looks valid.
+            if(info!=0)
+                std::fill(cache.factor.begin(),cache.factor.end(),
+                    std::numeric_limits <Real>::quiet_NaN());
+            cache.factor_version = version;
+            cache.misses++;
+            return &(cache.factor.front());
+        }
 
+        // Gets a read-only view of the matrix inverse of a block of the
+        // SQL vector.  This reuses the cached Choleski factor when we can.
+        static Real const * get_inverse(
+            Vector const & X,
+            Natural const & blk
+        ) {
+            // Get the size of the block and its cached information
+            Natural const m=X.sizes[itok(blk)];
+            auto & cache = X.cache[itok(blk)];
+
+            // If the data hasn't changed, use the cached inverse
+            Natural const version = X.stamp();
+            if(cache.inverse_version == version) {
+                cache.hits++;
+                return &(cache.inverse.front());
             }
 
-            // Copy out the inverse from the cached copy
-            Xinv.resize(m*m);
-            Optizelle::copy <Real>
-                (m*m,&(X.inverse[X.inverse_offsets[itok(blk)]]),1,
-                &(Xinv.front()),1);
+            // Otherwise, unpack the Choleski factor and find the inverse 
+            Integer info(0);
+            Real const * const U = get_factor(X,blk);
+            cache.inverse.resize(m*m);
+            Real * const Xinv = &(cache.inverse.front());
+            Optizelle::tfttr <Real> ('N','U',m,U,Xinv,m,info);
+            Optizelle::potri <Real> ('U',m,Xinv,m,info);
+           
+            // Copy the upper triangular portion to the lower.
+            for(Natural i=1;i<=m;i++)
+                Optizelle::copy <Real> (m-i,&(Xinv[ijtok(i,i+1,m)]),m,
+                    &(Xinv[ijtok(i+1,i,m)]),1);
+            cache.inverse_version = version;
+            cache.misses++;
+            return Xinv;
         }
         
+        // Version of the data, which lets the algorithms check their caches
+        // without comparing the data itself
+        static Natural version(Vector const & x) {
+            return x.stamp();
+        }
+
+        // Gives x a new version after someone wrote to it outside of the
+        // SQL operations
+        static void touch(Vector & x) {
+            x.touch();
+        }
+
         // Memory allocation and size setting
         static Vector init(Vector const & x) {
-            return std::move(Vector(x.types,x.sizes));
+            auto y = Vector(x.types,x.sizes);
+            y.schedule = x.schedule;
+            return y;
         }
         
         // y <- x (Shallow.  No memory allocation.)
         static void copy(Vector const & x, Vector & y) {
             Optizelle::copy <Real> (x.data.size(),&(x.data.front()),1,
                 &(y.data.front()),1);
+            y.touch();
         }
 
         // x <- alpha * x
         static void scal(Real const & alpha, Vector & x) {
             Optizelle::scal <Real> (x.data.size(),alpha,&(x.data.front()),1);
+            x.touch();
         }
 
         // y <- alpha * x + y
         static void axpy(Real const & alpha, Vector const & x, Vector & y) {
             Optizelle::axpy <Real> (x.data.size(),alpha,&(x.data.front()),1,
                 &(y.data.front()),1);
+            y.touch();
         }
 
         // innr <- <x,y>
@@ -489,6 +716,113 @@ namespace Optizelle {
                 &(y.data.front()),1);
         }
 
+        // y <- alpha * x + beta * y
+        static void axpby(
+            Real const & alpha,
+            Vector const & x,
+            Real const & beta,
+            Vector & y
+        ) {
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for(Natural i=0;i<x.data.size();i++) 
+                y.data[i]=alpha*x.data[i]+beta*y.data[i];
+            y.touch();
+        }
+
+        // y <- alpha * x + y and then axpy_innr <- <y,z>
+        static Real axpy_innr(
+            Real const & alpha,
+            Vector const & x,
+            Vector & y,
+            Vector const & z
+        ) {
+            Real innr=Real(0.);
+            #ifdef _OPENMP
+            #pragma omp parallel for reduction(+:innr) schedule(static)
+            #endif
+            for(Natural i=0;i<x.data.size();i++) {
+                y.data[i]+=alpha*x.data[i];
+                innr+=y.data[i]*z.data[i];
+            }
+            y.touch();
+            return innr;
+        }
+
+        // y <- alpha * x
+        static void copy_scal(
+            Real const & alpha,
+            Vector const & x,
+            Vector & y
+        ) {
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for(Natural i=0;i<x.data.size();i++) 
+                y.data[i]=alpha*x.data[i];
+            y.touch();
+        }
+
+        // Store several vectors contiguously in column-major order
+        typedef std::vector <Real> MultiVector;
+
+        // Resize xs to hold n vectors shaped like x
+        static void resize_many(
+            Vector const & x,
+            Natural const & n,
+            MultiVector & xs
+        ) {
+            xs.resize(n*x.data.size());
+        }
+
+        // xs_j <- x
+        static void copy_many(
+            Vector const & x,
+            Natural const & j,
+            MultiVector & xs
+        ) {
+            Optizelle::copy <Real> (x.data.size(),&(x.data.front()),1,
+                &(xs[j*x.data.size()]),1);
+        }
+
+        // z_j <- <xs_j,y> for j < k.  As with Rm, we use dot for a single
+        // vector.
+        static void innr_many(
+            Natural const & k,
+            MultiVector const & xs,
+            Vector const & y,
+            Real * z
+        ) {
+            if(k==0) return;
+            if(k==1)
+                z[0] = Optizelle::dot <Real> (y.data.size(),&(xs.front()),1,
+                    &(y.data.front()),1);
+            else
+                Optizelle::gemv <Real> ('T',y.data.size(),k,Real(1.),
+                    &(xs.front()),y.data.size(),&(y.data.front()),1,
+                    Real(0.),z,1);
+        }
+
+        // y <- sum_{j<k} alpha_j xs_j + y.  As with Rm, we use axpy for a
+        // single vector.
+        static void axpy_many(
+            Natural const & k,
+            Real const * const alpha,
+            MultiVector const & xs,
+            Vector & y
+        ) {
+            if(k==0) return;
+            if(k==1)
+                Optizelle::axpy <Real> (y.data.size(),alpha[0],&(xs.front()),
+                    1,&(y.data.front()),1);
+            else
+                Optizelle::gemv <Real> ('N',y.data.size(),k,Real(1.),
+                    &(xs.front()),y.data.size(),alpha,1,Real(1.),
+                    &(y.data.front()),1);
+            y.touch();
+        }
+
         // x <- 0 
         static void zero(Vector & x) {
             #ifdef _OPENMP
@@ -496,6 +830,7 @@ namespace Optizelle {
             #endif
             for(Natural i=0;i<x.data.size();i++) 
                 x.data[i]=Real(0.);
+            x.touch();
         }
 
         // x <- random
@@ -508,6 +843,50 @@ namespace Optizelle {
             // works properly when parallel.
             for(Natural i=0;i<x.data.size();i++) 
                 x.data[i]=Real(dis(gen));
+            x.touch();
+        }
+
+        // Determines whether we process the semidefinite blocks in parallel
+        // with serial BLAS or one after another with threaded BLAS.  When
+        // we choose automatically, we use m^3 as the cost of each block.  We
+        // go across the cones when the most expensive block is no more than
+        // a thread's fair share of the work, so that the load balances, or
+        // when every block is small enough that BLAS wouldn't thread it
+        // anyway.
+        static bool across_cones(Vector const & x) {
+            switch(x.schedule) {
+            case ConeSchedule::PerCone:
+                return false;
+            case ConeSchedule::AcrossCones:
+                return true;
+            case ConeSchedule::Automatic:
+                break;
+            }
+
+            // Determine how many threads we have
+            #ifdef _OPENMP
+            Natural const nthreads = omp_get_max_threads();
+            #else
+            Natural const nthreads = 1;
+            #endif
+
+            // If there's nothing to do in parallel, don't bother
+            if(nthreads < 2 || x.sdp_blks.size() < 2)
+                return false;
+
+            // Find the total cost and the cost of the largest block
+            auto cost = [&](Natural const & blk) {
+                Real const m = Real(x.blkSize(blk));
+                return m*m*m;
+            };
+            Real total(0.);
+            for(auto const & blk : x.sdp_blks)
+                total += cost(blk);
+            Natural const m_max = x.blkSize(x.sdp_blks.front());
+
+            // Decide based on our cost model
+            return cost(x.sdp_blks.front())*Real(nthreads) <= total
+                || m_max <= 64;
         }
 
         // Jordan product, z <- x o y
@@ -517,62 +896,80 @@ namespace Optizelle {
                the cones, but if the cones are large and few, it helps
                to parallelize the computation.  The hardest case to determine
                is if the cones are radically different in size.  At this point
-               we use a simple strategy.  Basically, as far as I can tell,
-               ATLAS BLAS won't allow us to change the number of threads
-               being used by its routines.  Since I don't really want to
-               recode these routines, we're stuck making sure that BLAS
-               controls the parallelism, which means doing parallel
-               computation on each cone one after another. 
+               we use a simple strategy.  The linear and quadratic cones are
+               handled a group at a time, so we parallelize across the cones
+               in the group.  For the semidefinite blocks, as far as I can
+               tell, ATLAS BLAS won't allow us to change the number of threads
+               being used by its routines.  Hence, either we let BLAS control
+               the parallelism and work on each cone one after another or we
+               work on the cones in parallel, in which case threaded BLAS
+               libraries run serially inside of our parallel region.  The
+               routine across_cones decides which.
             */
-            // Loop over all the blocks.
-            for(Natural blk=1;blk<=x.numBlocks();blk++) {
+            // Loop over all the groups of cones
+            for(auto const & grp : x.groups) {
 
-                // Get the size of the block.
-                Natural m=x.blkSize(blk);
+                // Get the size of the cones and where they start
+                Natural const m=grp.size;
+                Natural const n=grp.offsets.size();
+                Natural const * const offsets=grp.offsets.data();
 
-                // Depending on the block, compute a different jordan product.
-                switch(x.blkType(blk)) {
+                // Depending on the cones, compute a different jordan product.
+                switch(grp.type) {
 
-                // z = diag(x) y.
+                // z = diag(x) y.  We treat the group as one long vector.
                 case Cone::Linear:
                     #ifdef _OPENMP
                     #pragma omp parallel for schedule(static)
                     #endif
-                    for(Natural i=1;i<=m;i++)
-                        z(blk,i)=x(blk,i)*y(blk,i);
+                    for(Natural ik=0;ik<n*m;ik++) {
+                        Natural const i=offsets[ik/m]+ik%m;
+                        z.data[i]=x.data[i]*y.data[i];
+                    }
                     break;
 
                 // z = [x'y ; x0 ybar + y0 xbar].
-                case Cone::Quadratic: {
-                    // Get the size of the bar section.
-                    Natural mbar=m-1;
-
-                    // Find the first element
-                    z.naught(blk)=
-                        Optizelle::dot<Real>(
-                            m,&(x.front(blk)),1,&(y.front(blk)),1);
-
-                    // zbar = ybar
-                    Optizelle::copy <Real> (
-                        mbar,&(y.bar(blk)),1,&(z.bar(blk)),1);
-                        
-                    // zbar = x0 ybar
-                    Optizelle::scal <Real> (mbar,x.naught(blk),&(z.bar(blk)),1);
-
-                    // zbar = x0 ybar + y0 xbar
-                    Optizelle::axpy <Real> (mbar,y.naught(blk),&(x.bar(blk)),1,
-                        &(z.bar(blk)),1);
+                case Cone::Quadratic:
+                    #ifdef _OPENMP
+                    #pragma omp parallel for schedule(static)
+                    #endif
+                    for(Natural k=0;k<n;k++) {
+                        Real const * const xk=&(x.data[offsets[k]]);
+                        Real const * const yk=&(y.data[offsets[k]]);
+                        Real * const zk=&(z.data[offsets[k]]);
+                        Real const x0=xk[0];
+                        Real const y0=yk[0];
+
+                        // z0 = x'y
+                        Real z0(0.);
+                        for(Natural i=0;i<m;i++)
+                            z0+=xk[i]*yk[i];
+
+                        // zbar = x0 ybar + y0 xbar
+                        for(Natural i=1;i<m;i++)
+                            zk[i]=x0*yk[i]+y0*xk[i];
+                        zk[0]=z0;
+                    }
                     break;
-                }
 
-                // z = xy 
+                // We handle the semidefinite blocks below
                 case Cone::Semidefinite:
-                    Optizelle::symm <Real> ('L','U',m,m,Real(1.),
-                        &(x.front(blk)),m,&(y.front(blk)),m,Real(0.),
-                        &(z.front(blk)),m);
                     break;
                 }
             }
+
+            // z = xy on the semidefinite blocks
+            auto const & blks = x.sdp_blks;
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) if(across_cones(x))
+            #endif
+            for(Natural k=0;k<blks.size();k++) {
+                Natural const m=x.blkSize(blks[k]);
+                Optizelle::symm <Real> ('L','U',m,m,Real(1.),
+                    &(x.front(blks[k])),m,&(y.front(blks[k])),m,Real(0.),
+                    &(z.data[z.offsets[itok(blks[k])]]),m);
+            }
+            z.touch();
         }
 
         // Identity element, x <- e such that x o e = x
@@ -581,8 +978,9 @@ namespace Optizelle {
             // Loop over all the blocks
             for(Natural blk=1;blk<=x.numBlocks();blk++) {
 
-                // Get the size of the block
+                // Get the size of the block and where it starts
                 Natural m=x.blkSize(blk);
+                Real * const xk=&(x.data[x.offsets[itok(blk)]]);
 
                 // Depending on the block, compute a different identity element
                 switch(x.blkType(blk)) {
@@ -593,16 +991,16 @@ namespace Optizelle {
                     #pragma omp parallel for schedule(static)
                     #endif
                     for(Natural i=1;i<=m;i++) 
-                        x(blk,i)=Real(1.);
+                        xk[itok(i)]=Real(1.);
                     break;
                 // x = (1,0,...,0)
                 case Cone::Quadratic:
-                    x(blk,1)=Real(1.);
+                    xk[0]=Real(1.);
                     #ifdef _OPENMP
                     #pragma omp parallel for schedule(static)
                     #endif
                     for(Natural i=2;i<=m;i++)
-                        x(blk,i)=Real(0.);
+                        xk[itok(i)]=Real(0.);
                     break;
                 // x = I
                 case Cone::Semidefinite:
@@ -613,112 +1011,116 @@ namespace Optizelle {
                     #endif
                     for(Natural j=1;j<=m;j++) 
                         for(Natural i=1;i<=m;i++) 
-                            x(blk,i,j)=Real(0.);
+                            xk[ijtok(i,j,m)]=Real(0.);
 
                     #ifdef _OPENMP
                     #pragma omp parallel for schedule(static)
                     #endif
                     for(Natural i=1;i<=m;i++) 
-                        x(blk,i,i)=Real(1.);
+                        xk[ijtok(i,i,m)]=Real(1.);
                     break;
                 }
             }
+            x.touch();
         }
 
-        // This applies the inverse of the Schur complement of the Arw
-        // operator to a vector.  Note, y has size one less than x.
-        // Hence, m is the length of y and m+1 is the length of x.
-        static void invSchur(Natural const & m,Real const * const x,Real * y) {
-
-            // innr_xbar_y <- <xbar,y>
-            Real innr_xbar_y = dot <Real> (m,&(x[1]),1,&(y[0]),1);
-
-            // denom <- x0 ( x0^2 - <xbar,xbar> )
-            Real denom = x[0]*( x[0]*x[0] - dot <Real> (m,&(x[1]),1,&(x[1]),1));
-
-            // y <- 1/x0 y
-            Optizelle::scal <Real> (m,Real(1.)/x[0],&(y[0]),1);
-
-            // y <- 1/x0 y + <xbar,y> / (x0 ( x0^2 - <xbar,xbar> )) xbar
-            Optizelle::axpy <Real> (m,innr_xbar_y/denom,&(x[1]),1,&(y[0]),1);
-        }
-        
         // Jordan product inverse, z <- inv(L(x)) y where L(x) y = x o y
         static void linv(Vector const & x,Vector const & y,Vector & z) {
-            // We have this vector in case we have a SDP block
-            std::vector <Real> Xinv;
+            // Loop over all the groups of cones
+            for(auto const & grp : x.groups) {
 
-            // Loop over all the blocks
-            for(Natural blk=1;blk<=x.numBlocks();blk++) {
-
-                // Get the size of the block
-                Natural m=x.blkSize(blk);
+                // Get the size of the cones and where they start
+                Natural const m=grp.size;
+                Natural const n=grp.offsets.size();
+                Natural const * const offsets=grp.offsets.data();
 
-                // Depending on the block, compute a different operator
-                switch(x.blkType(blk)) {
+                // Depending on the cones, compute a different operator
+                switch(grp.type) {
 
-                // z = inv(Diag(x)) y
+                // z = inv(Diag(x)) y.  We treat the group as one long vector.
                 case Cone::Linear:
                     #ifdef _OPENMP
                     #pragma omp parallel for schedule(static)
                     #endif
-                    for(Natural i=1;i<=m;i++) 
-                        z(blk,i)=y(blk,i)/x(blk,i);
+                    for(Natural ik=0;ik<n*m;ik++) {
+                        Natural const i=offsets[ik/m]+ik%m;
+                        z.data[i]=y.data[i]/x.data[i];
+                    }
                     break;
 
-                // z = inv(Arw(x)) y
-                case Cone::Quadratic: {
-                    // Get the size of the bar piece
-                    Natural mbar=m-1;
-
-                    // invSchur_ybar <- invSchur(x)(y_bar) 
-                    std::vector <Real> invSchur_ybar(mbar);
-                    Optizelle::copy <Real>(mbar,&(y.bar(blk)),1,
-                        &(invSchur_ybar.front()),1);
-                    invSchur(mbar,&(x.front(blk)),&(invSchur_ybar[0]));
-
-                    // a <- 1 / (x0 - (1/x0) <x_bar,x_bar>) * y0
-                    Real a = y.naught(blk) / (
-                        x.naught(blk) - (Real(1.)/x.naught(blk)) *
-                        Optizelle::dot<Real>(
-                            mbar,&(x.bar(blk)),1,&(x.bar(blk)),1));
-
-                    // b <- - (1/x0) <xbar,invSchur(x)(y_bar)>
-                    Real b = -Optizelle::dot <Real> (mbar,
-                            &(x.bar(blk)),1,&(invSchur_ybar.front()),1)
-                        / x.naught(blk);
-                    
-                    // z0 <- 1 / (x0 - (1/x0) <x_bar,x_bar>) y0
-                    //       - (1/x0) <x_bar,invSchur(x)(y_bar)> 
-                    z(blk,1) = a + b;
-                    
-                    // z_bar <- invSchur(x)(x_bar)
-                    Optizelle::copy <Real> (
-                        mbar,&(x.bar(blk)),1,&(z.bar(blk)),1);
-                    invSchur(mbar,&(x.front(blk)),&(z.bar(blk)));
-
-                    // zbar <- (-y0/x0) invSchur(x)(x_bar)
-                    Optizelle::scal <Real> (mbar,
-                        -y.naught(blk)/x.naught(blk),&(z.bar(blk)),1);
-
-                    // z_bar <- (-y0/x0) invSchur(x)(x_bar) + invSchur(x)(y_bar)
-                    Optizelle::axpy <Real> (mbar,Real(1.),
-                        &(invSchur_ybar.front()),1,&(z.bar(blk)),1);
+                // z = inv(Arw(x)) y.  Using the Schur complement of Arw(x),
+                //
+                // z0 = 1 / (x0 - (1/x0) <xbar,xbar>) y0
+                //      - (1/x0) <xbar,invSchur(x)(ybar)>
+                // zbar = (-y0/x0) invSchur(x)(xbar) + invSchur(x)(ybar)
+                //
+                // where
+                //
+                // invSchur(x)(v) = (1/x0) v + <xbar,v> / d xbar
+                // d = x0 (x0^2 - <xbar,xbar>)
+                case Cone::Quadratic:
+                    #ifdef _OPENMP
+                    #pragma omp parallel for schedule(static)
+                    #endif
+                    for(Natural k=0;k<n;k++) {
+                        Real const * const xk=&(x.data[offsets[k]]);
+                        Real const * const yk=&(y.data[offsets[k]]);
+                        Real * const zk=&(z.data[offsets[k]]);
+                        Real const x0=xk[0];
+                        Real const y0=yk[0];
+
+                        // Find <xbar,xbar> and <xbar,ybar>
+                        Real nb(0.);
+                        Real xy(0.);
+                        for(Natural i=1;i<m;i++) {
+                            nb+=xk[i]*xk[i];
+                            xy+=xk[i]*yk[i];
+                        }
+                        Real const d=x0*(x0*x0-nb);
+
+                        // Find <xbar,invSchur(x)(ybar)>
+                        Real xbar_isy(0.);
+                        for(Natural i=1;i<m;i++)
+                            xbar_isy+=xk[i]*(yk[i]*(Real(1.)/x0)+xy/d*xk[i]);
+
+                        // Find z0
+                        Real const z0 = y0 / (x0 - (Real(1.)/x0) * nb)
+                            - xbar_isy / x0;
+
+                        // Find zbar.  Since we only ever read the i-th
+                        // element of y before writing the i-th element of z,
+                        // z may alias y.
+                        for(Natural i=1;i<m;i++)
+                            zk[i] = -y0/x0*(xk[i]*(Real(1.)/x0)+nb/d*xk[i])
+                                + (yk[i]*(Real(1.)/x0)+xy/d*xk[i]);
+                        zk[0]=z0;
+                    }
                     break;
 
-                // Z=inv(X) Y
-                } case Cone::Semidefinite: {
-                    // Get the Schur complement of the block.  With any luck
-                    // these are cached.
-                    Optizelle::SQL <Real>::get_inverse(x,blk,Xinv);
-
-                    // Multiply out the result
-                    Optizelle::symm <Real> ('L','U',m,m,Real(1.),
-                        &(Xinv.front()),m,&(y.front(blk)),m,Real(0.),
-                        &(z.front(blk)),m);
+                // We handle the semidefinite blocks below
+                case Cone::Semidefinite:
                     break;
-                }}
+                }
+            }
+
+            // Z=inv(X) Y on the semidefinite blocks
+            auto const & blks = x.sdp_blks;
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) if(across_cones(x))
+            #endif
+            for(Natural k=0;k<blks.size();k++) {
+                Natural const m=x.blkSize(blks[k]);
+
+                // Get the inverse of the block.  With any luck this is
+                // cached.
+                Real const * const Xinv = get_inverse(x,blks[k]);
+
+                // Multiply out the result
+                Optizelle::symm <Real> ('L','U',m,m,Real(1.),
+                    Xinv,m,&(y.front(blks[k])),m,Real(0.),
+                    &(z.data[z.offsets[itok(blks[k])]]),m);
             }
+            z.touch();
         }
 
         // Barrier function, barr <- barr(x) where x o grad barr(x) = e
@@ -726,91 +1128,204 @@ namespace Optizelle {
             // This accumulates the barrier's value
             Real z(0.);
 
-            // Loop over all the blocks
-            for(Natural blk=1;blk<=x.numBlocks();blk++) {
-
-                // Get the size of the block
-                Natural m=x.blkSize(blk);
+            // Loop over all the groups of cones
+            for(auto const & grp : x.groups) {
 
-                // In case we need to take a Choleski factorization for the
-                // SDP blocks
-                std::vector <Real> U;
+                // Get the size of the cones and where they start
+                Natural const m=grp.size;
+                Natural const n=grp.offsets.size();
+                Natural const * const offsets=grp.offsets.data();
 
-                // Depending on the block, compute a different barrier
-                switch(x.blkType(blk)) {
+                // Depending on the cones, compute a different barrier
+                switch(grp.type) {
 
-                // z += sum_i log(x_i)
+                // z += sum_i log(x_i).  We treat the group as one long vector.
                 case Cone::Linear:
                     #ifdef _OPENMP
                     #pragma omp parallel for reduction(+:z) schedule(static)
                     #endif
-                    for(Natural i=1;i<=m;i++)
-                        z+=log(x(blk,i));
+                    for(Natural ik=0;ik<n*m;ik++)
+                        z+=log(x.data[offsets[ik/m]+ik%m]);
                     break;
 
                 // z += 0.5 * log(x0^2-<xbar,xbar>)
-                case Cone::Quadratic: {
-                    // Get the size of the bar part.
-                    Natural mbar=m-1;
+                case Cone::Quadratic:
+                    #ifdef _OPENMP
+                    #pragma omp parallel for reduction(+:z) schedule(static)
+                    #endif
+                    for(Natural k=0;k<n;k++) {
+                        Real const * const xk=&(x.data[offsets[k]]);
+                        Real nb(0.);
+                        for(Natural i=1;i<m;i++)
+                            nb+=xk[i]*xk[i];
+                        z+=Real(0.5) * log(xk[0]*xk[0]-nb);
+                    }
+                    break;
 
-                    z+=Real(0.5) * log(x.naught(blk)*x.naught(blk)
-                        -dot <Real> (mbar,&(x.bar(blk)),1,&(x.bar(blk)),1));
+                // We handle the semidefinite blocks below
+                case Cone::Semidefinite:
                     break;
                 }
+            }
 
-                // z += log(det(x)).  We compute this by noting that
-                // log(det(x)) = log(det(u'u)) = log(det(u')det(u))
-                //             = log(det(u)^2) = 2 log(det(u))
-                case Cone::Semidefinite: {
+            // z += log(det(x)) on the semidefinite blocks.  We compute this
+            // by noting that
+            //
+            // log(det(x)) = log(det(u'u)) = log(det(u')det(u))
+            //             = log(det(u)^2) = 2 log(det(u))
+            auto const & blks = x.sdp_blks;
+            #ifdef _OPENMP
+            #pragma omp parallel for reduction(+:z) schedule(dynamic) \
+                if(across_cones(x))
+            #endif
+            for(Natural k=0;k<blks.size();k++) {
+                Natural const m=x.blkSize(blks[k]);
 
-                    // Find the Choleski factorization of X
-                    U.resize(m*m);
-                    Integer info;
-                    Optizelle::copy <Real> (
-                        m*m,&(x.front(blk)),1,&(U.front()),1);
-                    Optizelle::potrf <Real> (
-                        'U',m,&(U.front()),m,info);
+                // Get the Choleski factorization of X.  With any luck this
+                // is cached.
+                Real const * const U = get_factor(x,blks[k]);
 
-                    Real log_det(0.);
-                    #ifdef _OPENMP
-                    #pragma omp parallel for reduction(+:log_det) schedule(static)
-                    #endif
-                    for(Natural i=1;i<=m;i++)
-                        log_det += log(U[Optizelle::ijtok(i,i,m)]);
-                    
-                    // Complete the barrier computation by taking the log
-                    z+= Real(2.) * log_det;
-                    break;
-                } }
+                Real log_det(0.);
+                for(Natural i=1;i<=m;i++)
+                    log_det += log(U[Optizelle::ijtokrf(i,i,m)]);
+                
+                // Complete the barrier computation by taking the log
+                z+= Real(2.) * log_det;
             }
 
             // Return the accumulated barrier value
             return z;
         }
 
+        // Line search on a single semidefinite block.  This returns how far
+        // we can move in the block.
+        //
+        // We need to find the solution of the generalized eigenvalue
+        // problem alpha X v + Y v = 0.  Since Y is positive definite,
+        // we want to divide by alpha to get a standard form
+        // generalized eigenvalue problem X v = (-1/alpha) Y v.  This
+        // means that we solve the problem X v = lambda Y v and then
+        // set alpha = -1/lambda as long as lambda is negative.  Note,
+        // our Krylov method will converge to lambda from the right,
+        // which is going to give an upper bound on alpha.  This is
+        // not good for our line search, since we want a lower bound.
+        // However, since we get an absolute estimate of the error
+        // in lambda, we can just back off of it by a small amount.
+        static Real srch_sdp(
+            Vector const & x,
+            Vector const & y,
+            Natural const & blk
+        ) {
+            // Get the size of the block
+            Natural const m=x.blkSize(blk);
+
+            // Variables required for the linesearch
+            Integer info(0);
+            std::vector <Real> Xrf;
+            std::vector <Real> Yrf;
+            std::vector <Real> Zrf;
+            std::vector <Real> Up;
+
+            // Convert X and Y to rectangular packed storage
+            Xrf.resize(m*(m+1)/2);
+            Optizelle::trttf <Real>('N','U',m,&(x(blk,1,1)),m,&(Xrf[0]),
+                info);
+
+            Yrf.resize(m*(m+1)/2);
+            Optizelle::trttf <Real>('N','U',m,&(y(blk,1,1)),m,&(Yrf[0]),
+                info);
+
+            // Get the Choleski factor of Y in packed storage.  Since Y is
+            // generally the current iterate, this is typically cached.
+            Up.resize(m*(m+1)/2);
+            Optizelle::tfttp <Real>('N','U',m,get_factor(y,blk),&(Up[0]),info);
+
+            // Solve the generalized eigenvalue problem X v = lambda Y v
+            Real abs_tol=1e-2;
+            std::pair <Real,Real> lambda_err=
+                Optizelle::gsyiram_factored <Real> (
+                    m,&(Xrf[0]),&(Up[0]),20,20,abs_tol);
+
+            // IRAM converges from the right, but we really need a lower
+            // bound on the eigenvalue.  Hence, modify the result
+            // so that we have a lower bound
+            Real lambda=lambda_err.first-abs_tol;
+
+            // Now, find the line-search parameter
+            Real alpha0=-Real(1.)/lambda;
+
+            // Do a safeguard step because sometimes the eigenvalue
+            // solver converges to the wrong eigenvalue.  Now, if
+            // alpha0 is negative, ostensibly we can take as big
+            // as step as we want.  However, if we converged to
+            // the wrong eigenvalue, this may not be true.  Hence, 
+            // if alpha0 is negative, we do the line-search with
+            // alpha0 = 2.  If this value doesn't move, we assume
+            // that our eigenvalue estimate was fine and this
+            // direction is feasible for all alpha.
+            //
+            // Also, note that the Choleski check is not full-proof.
+            // It's possible that the Choleski check passes and yet
+            // we have an indefinite matrix.  This is sort of hard
+            // to check.  Basically, that means that the next iteration
+            // will have an infeasible solution, which is going to
+            // cause issues with this routine.  In theory, we should
+            // continue to cut alpha0 until it becomes a hard 0 and
+            // then this routine will exit.  Hopefully, the other
+            // pieces in the code will pick up on the interior point
+            // instability and exit.
+            bool completely_feasible_dir= alpha0<=Real(0.);
+            alpha0= alpha0>0 ? alpha0 : Real(2.);
+            Zrf.resize(m*(m+1)/2);
+            do {
+                // Basically, we find X+alpha0 Y and try to take
+                // the Choleski factorization.  If that fails, we're
+                // infeasible and we do a backtracking line search.
+                Optizelle::copy <Real> (
+                    m*(m+1)/2,&(Yrf[0]),1,&(Zrf[0]),1);
+                Optizelle::axpy <Real> (m*(m+1)/2,alpha0,&(Xrf[0]),1,
+                    &(Zrf[0]),1);
+                pftrf('N','U',m,&(Zrf[0]),info);
+
+                // Check if the Choleski failed
+                if(info!=0) {
+                    alpha0 /= Real(2.); 
+                    completely_feasible_dir=false;
+                }
+                    
+            // If alpha0 ever becomes 0, then something wrong has
+            // gone on and we really ought to exit.
+            } while(info!=0 && alpha0>Real(0.));
+
+            // If we still have a completely feasible direction,
+            // fix alpha0 so that we don't update our line search.
+            alpha0 = completely_feasible_dir ?
+                std::numeric_limits <Real>::infinity(): alpha0;
+
+            // Return the restriction on the line search
+            return alpha0;
+        }
+
         // Line search, srch <- argmax {alpha \in Real >= 0 : alpha x + y >= 0}
         // where y > 0.
         static Real srch(Vector const & x,Vector const & y) {
             // Line search parameter
             Real alpha=std::numeric_limits <Real>::infinity();
-                   
-            // Variables required for the linesearch on SDP blocks 
-            Integer info(0);
-            std::vector <Real> Xrf;
-            std::vector <Real> Yrf;
-            std::vector <Real> Zrf;
 
-            // Loop over all the blocks
-            for(Natural blk=1;blk<=x.numBlocks();blk++) {
+            // Loop over all the groups of cones
+            for(auto const & grp : x.groups) {
 
-                // Get the size of the block
-                Natural m=x.blkSize(blk);
+                // Get the size of the cones and where they start
+                Natural const m=grp.size;
+                Natural const n=grp.offsets.size();
+                Natural const * const offsets=grp.offsets.data();
 
-                // Depending on the block, do a different line search 
-                switch(x.blkType(blk)) {
+                // Depending on the cones, do a different line search 
+                switch(grp.type) {
 
                 // Pointwise, alpha_i = -y_i / x_i.  If this number is positive,
-                // then we need to restrict how far we travel.
+                // then we need to restrict how far we travel.  We treat the
+                // group as one long vector.
                 case Cone::Linear:
 
                     #ifdef _OPENMP
@@ -822,11 +1337,12 @@ namespace Optizelle {
 
                         // Search for the optimal linesearch parameter
                         #ifdef _OPENMP
-                        #pragma omp parallel for schedule(static)
+                        #pragma omp for schedule(static)
                         #endif
-                        for(Natural i=1;i<=m;i++) {
-                            if(x(blk,i) < Real(0.)) {
-                                Real alpha0 = -y(blk,i)/x(blk,i);
+                        for(Natural ik=0;ik<n*m;ik++) {
+                            Natural const i=offsets[ik/m]+ik%m;
+                            if(x.data[i] < Real(0.)) {
+                                Real alpha0 = -y.data[i]/x.data[i];
                                 alpha_loc = alpha0 < alpha_loc ?
                                     alpha0 : alpha_loc;
                             }
@@ -856,144 +1372,102 @@ namespace Optizelle {
                 // Technically, if a is zero, the quadratic formula doesn't
                 // apply and we use -c/b instead of the roots.  If b is zero
                 // and a is zero, then there's no limit to the line search
-                case Cone::Quadratic: {
-
-                    // Get the size of the bar block.
-                    Natural mbar=m-1;
-
-                    // Now, first we have to insure that the leading coefficient
-                    // of the second order cone problem remains nonnegative.
-                    // This number tells us how far we can step before this
-                    // is not true.
-                    Real alpha0 = -y.naught(blk)/x.naught(blk);
-
-                    // Next, assuming that the leading coefficient is fine,
-                    // figure out how far we can step before we violate the
-                    // rest of the SOCP constraint.  This involves solving
-                    // the quadratic equation from above.
-                    Real a = x.naught(blk)*x.naught(blk)
-                        - dot <Real> (mbar,&(x.bar(blk)),1,&(x.bar(blk)),1);
-                    Real b = Real(2.)*(x.naught(blk)*y.naught(blk)
-                        - dot <Real> (mbar,&(x.bar(blk)),1,&(y.bar(blk)),1));
-                    Real c = y.naught(blk)*y.naught(blk)
-                        - dot <Real> (mbar,&(y.bar(blk)),1,&(y.bar(blk)),1);
-                    auto roots = quad_equation(a,b,c);
-
-                    // Now, determine the step length.
-
-                    // If we have a restriction on alpha based on the leading
-                    // coefficient.
-                    alpha = x.naught(blk) < Real(0.) && alpha0<alpha ?
-                        alpha0 : alpha;
-
-                    // Next, if we have two roots, determine the restriction 
-                    if(roots.size()==2) { 
-                        auto alpha1 = roots[0];
-                        auto alpha2 = roots[1];
-                        alpha = alpha1>=Real(0.)&&alpha1<alpha ? alpha1 : alpha;
-                        alpha = alpha2>=Real(0.)&&alpha2<alpha ? alpha2 : alpha;
-
-                    // If we have a single root 
-                    } else if(roots.size()==1) {
-                        auto alpha1 = roots[0];
-                        alpha = alpha1>=Real(0.)&&alpha1<alpha ? alpha1 : alpha;
-                    }
+                case Cone::Quadratic:
 
-                    // If we no roots, there's no additional restriction.
-                    // This can't happen since we assume that y is strictly
-                    // feasible.
-                }
-                break;
+                    #ifdef _OPENMP
+                    #pragma omp parallel
+                    #endif
+                    {
+                        // Create a local version of alpha
+                        Real alpha_loc=std::numeric_limits <Real>::infinity();
 
-                // We need to find the solution of the generalized eigenvalue
-                // problem alpha X v + Y v = 0.  Since Y is positive definite,
-                // we want to divide by alpha to get a standard form
-                // generalized eigenvalue problem X v = (-1/alpha) Y v.  This
-                // means that we solve the problem X v = lambda Y v and then
-                // set alpha = -1/lambda as long as lambda is negative.  Note,
-                // our Krylov method will converge to lambda from the right,
-                // which is going to give an upper bound on alpha.  This is
-                // not good for our line search, since we want a lower bound.
-                // However, since we get an absolute estimate of the error
-                // in lambda, we can just back off of it by a small amount.
-                case Cone::Semidefinite: {
+                        // Search for the optimal linesearch parameter
+                        #ifdef _OPENMP
+                        #pragma omp for schedule(static)
+                        #endif
+                        for(Natural k=0;k<n;k++) {
+                            Real const * const xk=&(x.data[offsets[k]]);
+                            Real const * const yk=&(y.data[offsets[k]]);
+
+                            // First, we have to insure that the leading
+                            // coefficient of the second order cone problem
+                            // remains nonnegative.  This number tells us how
+                            // far we can step before this is not true.
+                            Real const alpha0 = -yk[0]/xk[0];
+                            alpha_loc = xk[0] < Real(0.) && alpha0<alpha_loc ?
+                                alpha0 : alpha_loc;
+
+                            // Next, figure out how far we can step before we
+                            // violate the rest of the SOCP constraint.  This
+                            // involves solving the quadratic equation from
+                            // above.  If we have no roots, there's no
+                            // additional restriction.  This can't happen since
+                            // we assume that y is strictly feasible.
+                            Real xx(0.);
+                            Real xy(0.);
+                            Real yy(0.);
+                            for(Natural i=1;i<m;i++) {
+                                xx+=xk[i]*xk[i];
+                                xy+=xk[i]*yk[i];
+                                yy+=yk[i]*yk[i];
+                            }
+                            Real const a = xk[0]*xk[0] - xx;
+                            Real const b = Real(2.)*(xk[0]*yk[0] - xy);
+                            Real const c = yk[0]*yk[0] - yy;
+                            Real roots[2];
+                            auto nroots = quad_equation(a,b,c,roots);
+                            for(Natural i=0;i<nroots;i++)
+                                alpha_loc = roots[i]>=Real(0.) &&
+                                    roots[i]<alpha_loc ? roots[i] : alpha_loc;
+                        }
 
-                    // Convert X and Y to rectangular packed storage
-                    Xrf.resize(m*(m+1)/2);
-                    Optizelle::trttf <Real>('N','U',m,&(x(blk,1,1)),m,&(Xrf[0]),
-                        info);
-
-                    Yrf.resize(m*(m+1)/2);
-                    Optizelle::trttf <Real>('N','U',m,&(y(blk,1,1)),m,&(Yrf[0]),
-                        info);
-
-                    // Solve the generalized eigenvalue problem X v = lambda Y v
-                    Real abs_tol=1e-2;
-                    std::pair <Real,Real> lambda_err=Optizelle::gsyiram <Real> (
-                        m,&(Xrf[0]),&(Yrf[0]),20,20,abs_tol);
-
-                    // IRAM converges from the right, but we really need a lower
-                    // bound on the eigenvalue.  Hence, modify the result
-                    // so that we have a lower bound
-                    Real lambda=lambda_err.first-abs_tol;
-
-                    // Now, find the line-search parameter
-                    Real alpha0=-Real(1.)/lambda;
-
-                    // Do a safeguard step because sometimes the eigenvalue
-                    // solver converges to the wrong eigenvalue.  Now, if
-                    // alpha0 is negative, ostensibly we can take as big
-                    // as step as we want.  However, if we converged to
-                    // the wrong eigenvalue, this may not be true.  Hence, 
-                    // if alpha0 is negative, we do the line-search with
-                    // alpha0 = 2.  If this value doesn't move, we assume
-                    // that our eigenvalue estimate was fine and this
-                    // direction is feasible for all alpha.
-                    //
-                    // Also, note that the Choleski check is not full-proof.
-                    // It's possible that the Choleski check passes and yet
-                    // we have an indefinite matrix.  This is sort of hard
-                    // to check.  Basically, that means that the next iteration
-                    // will have an infeasible solution, which is going to
-                    // cause issues with this routine.  In theory, we should
-                    // continue to cut alpha0 until it becomes a hard 0 and
-                    // then this routine will exit.  Hopefully, the other
-                    // pieces in the code will pick up on the interior point
-                    // instability and exit.
-                    bool completely_feasible_dir= alpha0<=Real(0.);
-                    alpha0= alpha0>0 ? alpha0 : Real(2.);
-                    Zrf.resize(m*(m+1)/2);
-                    do {
-                        // Basically, we find X+alpha0 Y and try to take
-                        // the Choleski factorization.  If that fails, we're
-                        // infeasible and we do a backtracking line search.
-                        Optizelle::copy <Real> (
-                            m*(m+1)/2,&(Yrf[0]),1,&(Zrf[0]),1);
-                        Optizelle::axpy <Real> (m*(m+1)/2,alpha0,&(Xrf[0]),1,
-                            &(Zrf[0]),1);
-                        pftrf('N','U',m,&(Zrf[0]),info);
-
-                        // Check if the Choleski failed
-                        if(info!=0) {
-                            alpha0 /= Real(2.); 
-                            completely_feasible_dir=false;
+                        // After we're through with the local search,
+                        // accumulate the result
+                        #ifdef _OPENMP
+                        #pragma omp critical
+                        #endif
+                        {
+                            alpha = alpha_loc < alpha ? alpha_loc : alpha;
                         }
-                    
-                    // If alpha0 ever becomes 0, then something wrong has
-                    // gone on and we really ought to exit.
-                    } while(info!=0 && alpha0>Real(0.));
+                    }
 
-                    // If we still have a completely feasible direction,
-                    // fix alpha0 so that we don't update our line search.
-                    alpha0 = completely_feasible_dir ?
-                        std::numeric_limits <Real>::infinity(): alpha0;
+                    break;
 
-                    // Adjust the line search step if necessary
-                    alpha = alpha0<alpha ? alpha0 : alpha;
-                } }
+                // We handle the semidefinite blocks below
+                case Cone::Semidefinite:
+                    break;
+                }
+            }
+
+            // Search each semidefinite block separately
+            auto const & blks = x.sdp_blks;
+            #ifdef _OPENMP
+            #pragma omp parallel if(across_cones(x))
+            #endif
+            {
+                // Create a local version of alpha
+                Real alpha_loc=std::numeric_limits <Real>::infinity();
+
+                #ifdef _OPENMP
+                #pragma omp for schedule(dynamic)
+                #endif
+                for(Natural k=0;k<blks.size();k++) {
+                    Real const alpha0 = srch_sdp(x,y,blks[k]);
+                    alpha_loc = alpha0<alpha_loc ? alpha0 : alpha_loc;
+                }
+
+                // After we're through with the local search, accumulate the
+                // result
+                #ifdef _OPENMP
+                #pragma omp critical
+                #endif
+                {
+                    alpha = alpha_loc < alpha ? alpha_loc : alpha;
+                }
             }
             return alpha;
         }
+
         // Symmetrization, x <- symm(x) such that L(symm(x)) is a symmetric
         // operator.
         static void symm(Vector & x) { 
@@ -1048,6 +1522,7 @@ namespace Optizelle {
                     break;
                 } }
             }
+            x.touch();
         }
     //---SQL2---
     };
@@ -1081,21 +1556,10 @@ namespace Optizelle {
                     x_json["sizes"][Json::ArrayIndex(i)]
                         =Json::Value::UInt64(x.sizes[i]);
 
-                for(Natural i=0;i<x.inverse.size();i++)
-                    x_json["inverse"][Json::ArrayIndex(i)]=x.inverse[i];
-
-                for(Natural i=0;i<x.inverse_offsets.size();i++)
-                    x_json["inverse_offsets"][Json::ArrayIndex(i)]
-                        =Json::Value::UInt64(x.inverse_offsets[i]);
+                // We don't write the cached factorizations since they're
+                // keyed on the version of the data, which doesn't survive
+                // a restart.  We recompute them as needed.
 
-                for(Natural i=0;i<x.inverse_base.size();i++)
-                    x_json["inverse_base"][Json::ArrayIndex(i)]
-                        =x.inverse_base[i];
-
-                for(Natural i=0;i<x.inverse_base_offsets.size();i++)
-                    x_json["inverse_base_offsets"][Json::ArrayIndex(i)]
-                        =Json::Value::UInt64(x.inverse_base_offsets[i]);
-                
                 // Return a string of the result
                 Json::StyledWriter writer;
                 return writer.write(x_json);
@@ -1134,22 +1598,7 @@ namespace Optizelle {
                 for(Natural i=0;i<x.offsets.size();i++)
                     x.offsets[i]=x_json["offsets"][Json::ArrayIndex(i)]
                         .asUInt64();
-
-                for(Natural i=0;i<x.inverse.size();i++)
-                    x.inverse[i]=Real(x_json["inverse"]
-                        [Json::ArrayIndex(i)].asDouble());
-                
-                for(Natural i=0;i<x.inverse_offsets.size();i++)
-                    x.inverse_offsets[i]=x_json["inverse_offsets"]
-                        [Json::ArrayIndex(i)].asUInt64();
-                
-                for(Natural i=0;i<x.inverse_base.size();i++)
-                    x.inverse_base[i]=Real(x_json["inverse_base"]
-                        [Json::ArrayIndex(i)].asDouble());
-                
-                for(Natural i=0;i<x.inverse_base_offsets.size();i++)
-                    x.inverse_base_offsets[i]=x_json["inverse_base_offsets"]
-                        [Json::ArrayIndex(i)].asUInt64();
+                x.touch();
 
                 // Return the newly constructed vector
                 return std::move(x);
@@ -10,6 +10,7 @@
 #include <random>
 #include "optizelle/optizelle.h"
 #include "optizelle/vspaces.h"
+#include "optizelle/sdp.h"
 #include "optizelle/json.h"
 
 // Grab the Optizelle Natural and Integer types
@@ -359,145 +360,6 @@ public:
 };
 
 
-// Define the SDP inequality where 
-//
-// h(x) = A1*x1 + ... + Am*xm - A0 >= 0
-//
-template <typename Real>
-struct SDPIneq :
-    public Optizelle::VectorValuedFunction <Real,Optizelle::Rm,Optizelle::SQL>
-{
-public:
-    typedef Optizelle::Rm <Real> X;
-    typedef Optizelle::SQL <Real> Z;
-    typedef typename X::Vector X_Vector;
-    typedef typename Z::Vector Z_Vector;
-
-private:
-    SparseSDP <Real> const & prob;
-
-    // z=h(x), except that we de start with A_start.  Mostly, this is
-    // to toggle whether we start from A0 or A1.
-    template <Natural start>
-    void eval_from(
-        X_Vector const & x,
-        Z_Vector & z
-    ) const {
-        // Zero out the solution
-        Z::zero(z);
-
-        // Loop over the constraints
-        for(Natural i=start;i<prob.A.size();i++) {
-            // Loop over the blocks
-            for(Natural j=0;j<prob.blk_sizes.size();j++) {
-                // Diagonal blocks
-                if(prob.blk_sizes[j]<0) {
-                    // Loop over the indices
-                    for(Natural k=0;k<prob.A[i][j].is.size();k++) {
-                        // Constant block
-                        if(i==0)
-                            z(j+1,prob.A[i][j].is[k]) -= prob.A[i][j].data[k];
-                        // Variable block
-                        else 
-                            z(j+1,prob.A[i][j].is[k])
-                                += prob.A[i][j].data[k]*x[itok(i)];
-                    }
-
-                // Sparse blocks
-                } else {
-                    // Loop over the indices
-                    for(Natural k=0;k<prob.A[i][j].is.size();k++) {
-                        // Constant block
-                        if(i==0) {
-                            z(j+1,prob.A[i][j].is[k],prob.A[i][j].js[k])
-                                -= prob.A[i][j].data[k];
-                            if(prob.A[i][j].is[k] != prob.A[i][j].js[k])
-                                z(j+1,prob.A[i][j].js[k],prob.A[i][j].is[k])
-                                    -= prob.A[i][j].data[k];
-                        // Variable block
-                        } else {
-                            z(j+1,prob.A[i][j].is[k],prob.A[i][j].js[k])
-                                += prob.A[i][j].data[k]*x[itok(i)];
-                            if(prob.A[i][j].is[k] != prob.A[i][j].js[k])
-                                z(j+1,prob.A[i][j].js[k],prob.A[i][j].is[k])
-                                    += prob.A[i][j].data[k]*x[itok(i)];
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-public:
-    // Grab a reference to the underlying SDP problem
-    SDPIneq(SparseSDP <Real> const & prob_) : prob(prob_) {}
-
-    // z=h(x) 
-    void eval(
-        X_Vector const & x,
-        Z_Vector & z
-    ) const {
-        eval_from <0> (x,z);
-    }
-
-    // z=h'(x)dx
-    void p(
-        X_Vector const & x,
-        X_Vector const & dx,
-        Z_Vector & z
-    ) const {
-        eval_from <1> (dx,z);
-    }
-
-    // xhat=h'(x)*dz
-    void ps(
-        X_Vector const & x,
-        Z_Vector const & dz,
-        X_Vector & xhat 
-    ) const {
-        // Zero out the solution
-        X::zero(xhat);
-
-        // Loop over the constraints
-        for(Natural i=1;i<prob.A.size();i++) {
-            // Loop over the blocks
-            for(Natural j=0;j<prob.blk_sizes.size();j++) {
-                // Diagonal blocks
-                if(prob.blk_sizes[j]<0) {
-                    // Loop over the indices
-                    for(Natural k=0;k<prob.A[i][j].is.size();k++) {
-                        xhat[itok(i)]+=
-                            dz(j+1,prob.A[i][j].is[k]) * prob.A[i][j].data[k];
-                    }
-
-                // Sparse blocks
-                } else {
-                    // Loop over the indices
-                    for(Natural k=0;k<prob.A[i][j].is.size();k++) {
-                        xhat[itok(i)]+=
-                            dz(j+1,prob.A[i][j].is[k],prob.A[i][j].js[k])
-                            * prob.A[i][j].data[k];
-                        if(prob.A[i][j].is[k] != prob.A[i][j].js[k])
-                            xhat[itok(i)]+=
-                                dz(j+1,prob.A[i][j].js[k],prob.A[i][j].is[k])
-                                * prob.A[i][j].data[k];
-                    }
-                }
-            }
-        }
-    }
-
-    // xhat=(h''(x)dx)*dz
-    void pps(
-        X_Vector const & x,
-        X_Vector const & dx,
-        Z_Vector const & dz,
-        X_Vector & xhat 
-    ) const {
-        X::zero(xhat);
-    }
-};
-
 // Initializes an SQL vector 
 template <typename Real>
 typename Optizelle::SQL <Real>::Vector initSQL(
@@ -573,243 +435,144 @@ struct Phase1Obj : public Optizelle::ScalarValuedFunction <Real,Optizelle::Rm> {
     }
 };
 
-// Define a combination of the SDP inequality as well as a piece that
-// helps with feasibility
+// Converts the SDP inequality
+//
+// h(x) = A1*x1 + ... + Am*xm - A0 >= 0
+//
+// into a linear SDP constraint.  In phase-1, we add a piece that helps with
+// feasibility
 //
 // hh(x,y) = [ h(x) >= y e ]
 //           [ y2 >= y1 - epsilon ]
 //           [ y2 >= -y1 + epsilon ]
 //
+// which is linear in (x,y1,y2).  Basically, y1 has a data matrix of -e on
+// the original blocks and we add an extra linear cone of size 2.
 template <typename Real>
-struct Phase1Ineq
-    : public Optizelle::VectorValuedFunction <Real,Optizelle::Rm,Optizelle::SQL>
-{
-public:
-    typedef Optizelle::Rm <Real> Rm;
-    typedef Optizelle::SQL <Real> SQL;
-    
-    typedef typename Rm::Vector X_Vector;
-    typedef Optizelle::SQL <Real> Z;
-    typedef typename Z::Vector Z_Vector;
-
-private:
-    // SDP inequality constraint
-    const SDPIneq <Real> h;
-
-    // Identity vector
-    mutable typename Optizelle::SQL <Real>::Vector e;
-    
-    // Extent to which we push for positive definiteness 
-    Real const & epsilon;
-
-public:
-    // Grab a reference to the SDP inequality, the identity element, and
-    // the amount of infeasibility we want to allow
-    Phase1Ineq(
-        SparseSDP <Real> const & prob,
-        Real const & epsilon_
-    ) : h(prob),
-        e(initSQL(prob)),
-        epsilon(epsilon_)
-    { 
-        // Set the identity element 
-        SQL::id(e);
-    }
-
-    // z=hh(x,y) 
-    void eval(
-        X_Vector const & x,
-        Z_Vector & z
-    ) const {
-        // z <- h(x)
-        h.eval(x,z);
-
-        // Get the size of x
-        Natural m = x.size()-2;
-
-        // z <- h(x) - y1 e
-        SQL::axpy(-x[m],e,z);
-        
-        // Get the number of cones
-        Natural ncones = z.types.size();
-
-        // z_2 <- (-y1 + y2 + epsilon,y1 + y2 - epsilon)
-        z(ncones,1) = -x[m] + x[m+1] + epsilon; 
-        z(ncones,2) = x[m] + x[m+1] - epsilon; 
-    }
-
-    // z=hh'(x,y)(dx,dy)
-    void p(
-        X_Vector const & x,
-        X_Vector const & dx,
-        Z_Vector & z
-    ) const {
-        // z <- h'(x)dx
-        h.p(x,dx,z);
-
-        // Get the size of x
-        Natural m = x.size()-2;
-       
-        // z <- h'(x)dx - dy e 
-        SQL::axpy(-dx[m],e,z);
-        
-        // Get the number of cones
-        Natural ncones = z.types.size();
+Optizelle::LinearSDP <Real> * initLinearSDP(
+    SparseSDP <Real> const & prob,
+    bool const phase1=false,
+    Real const & epsilon=Real(0.)
+) {
+    // Create some type shortcuts
+    typedef Optizelle::LinearSDP <Real> LinearSDP;
+    typedef typename LinearSDP::Block Block;
 
-        // z_2 <- (-dy1 + dy2, dy1 + dy2)
-        z(ncones,1) = -dx[m] + dx[m+1];
-        z(ncones,2) = dx[m] + dx[m+1];
-    }
+    // Grab the structure of the codomain
+    auto xx = initSQL <Real> (prob,phase1);
 
-    // xhat=hh'(x,y)*dz
-    void ps(
-        X_Vector const & x,
-        Z_Vector const & dz,
-        X_Vector & xhat 
-    ) const {
-        // xhat_1 <- h'(x)*dx
-        h.ps(x,dz,xhat);
-        
-        // Get the size of x
-        Natural m = x.size()-2;
-        
-        // Get the number of cones
-        Natural ncones = dz.types.size();
+    // Copy over the data matrices
+    std::vector <std::vector <Block> > A(prob.A.size());
+    for(Natural i=0;i<prob.A.size();i++)
+        for(Natural j=0;j<prob.blk_sizes.size();j++)
+            A[i].emplace_back(Block{Optizelle::SDPBlock::Sparse,
+                prob.A[i][j].is,prob.A[i][j].js,prob.A[i][j].data,Real(1.)});
 
-        // xhat_2 <- -<e,dz>.  We need to do e first to make sure we don't
-        // take the inner product with the last cone in dz.
-        xhat[m] = -SQL::innr(e,dz)-dz(ncones,1)+dz(ncones,2);
-        xhat[m+1] = dz(ncones,1)+dz(ncones,2);
-    }
+    // Add the phase-1 pieces
+    if(phase1) {
+        // Everything so far is empty on the extra cone except A0, which
+        // contains (-epsilon,epsilon)
+        for(Natural i=0;i<A.size();i++)
+            A[i].emplace_back(Block{Optizelle::SDPBlock::Sparse,
+                i==0 ? std::vector <Natural> {1,2} : std::vector <Natural>(),
+                {},
+                i==0 ? std::vector <Real> {-epsilon,epsilon}
+                    : std::vector <Real> (),
+                Real(1.)});
+
+        // y1 contributes -e on the original blocks and (-1,1) on the extra
+        // cone
+        A.emplace_back();
+        for(Natural j=0;j<prob.blk_sizes.size();j++) {
+            Natural n = labs(prob.blk_sizes[j]);
+            std::vector <Natural> is(n);
+            for(Natural k=0;k<n;k++)
+                is[k]=k+1;
+            A.back().emplace_back(Block{Optizelle::SDPBlock::Sparse,
+                is,
+                prob.blk_sizes[j]<0 ? std::vector <Natural> () : is,
+                std::vector <Real> (n,Real(-1.)),
+                Real(1.)});
+        }
+        A.back().emplace_back(Block{Optizelle::SDPBlock::Sparse,
+            {1,2},{},{Real(-1.),Real(1.)},Real(1.)});
 
-    // xhat=(hh''(x,y)(dx,dy)*dz
-    void pps(
-        X_Vector const & x,
-        X_Vector const & dx,
-        Z_Vector const & dz,
-        X_Vector & xhat 
-    ) const {
-        Rm::zero(xhat);
+        // y2 only contributes (1,1) on the extra cone
+        A.emplace_back(std::vector <Block> (prob.blk_sizes.size(),
+            Block{Optizelle::SDPBlock::Sparse,{},{},{},Real(1.)}));
+        A.back().emplace_back(Block{Optizelle::SDPBlock::Sparse,
+            {1,2},{},{Real(1.),Real(1.)},Real(1.)});
     }
-};
 
-// Creates the ith cannonical vector
-template <typename Real>
-void create_ei(Natural const & i,std::vector <Real> & ei) {
-    for(Natural j=0;j<ei.size();j++) {
-        ei[j] = Real(i==j);
-    }
+    // Create the constraint
+    return new LinearSDP(xx.types,xx.sizes,A);
 }
 
-// Projects X to Rm
-template <typename Real,template <typename> class XX>
-struct ProjectX {
-    virtual typename Optizelle::Rm <Real>::Vector * operator () (
-        typename XX <Real>::Vector & x
-    ) const = 0;
-    virtual ~ProjectX() {}
-};
-
-// Projects Rm to Rm
+// Preconditions the Hessian of the interior point problem with the inverse
+// of the Schur complement
+//
+// S = h'(x)* inv(L(h(x))) (h'(x) . o z)
+//
+// which we form directly from the sparse data of h.
 template <typename Real>
-struct ProjectRm : public ProjectX <Real,Optizelle::Rm> {
-    typename Optizelle::Rm <Real>::Vector * operator () (
-        typename Optizelle::Rm <Real>::Vector & x
-    ) const {
-        return &x;
-    }
-};
-
-template <typename Real,template <typename> class XX>
-struct SDPPreconditioner : public Optizelle::Operator <Real,XX,XX> {
+struct SDPPreconditioner
+    : public Optizelle::Operator <Real,Optizelle::Rm,Optizelle::Rm>
+{
 private:
     // Create some type shortcuts
-    typedef Optizelle::Rm <Real> Rm;
-    typedef XX <Real> X;
+    typedef Optizelle::Rm <Real> X;
     typedef typename X::Vector X_Vector;
-    typedef typename Rm::Vector Rm_Vector;
-
-    // Projection from X to Rm
-    const std::unique_ptr <ProjectX <Real,XX> > proj;
+    typedef Optizelle::SQL <Real> Z;
+    typedef typename Z::Vector Z_Vector;
 
-    // Function modifications used by the inequality constrained problem.  This
-    // needs to be a reference to the unique_ptr since the actual function is
-    // not initialized yet when we grab the reference.
-    const std::unique_ptr
-        <Optizelle::ScalarValuedFunctionModifications <Real,XX> >& f_mod;
+    // Inequality constraint
+    Optizelle::LinearSDP <Real> const & h;
 
-    // Current iterate
+    // Current iterate, inequality constraint, and inequality multiplier
     X_Vector const & x;
+    Z_Vector const & h_x;
+    Z_Vector const & z;
 
-    // Workspace 
-    mutable X_Vector x_tmp1;
-    mutable X_Vector x_tmp2;
-
-    // Variables used for caching.  The boolean values denote whether or not
-    // we've started caching yet.
-    mutable std::pair <bool,X_Vector> x_last;
+    // Variables used for caching
+    mutable Optizelle::CacheStamp <Real,Optizelle::Rm> x_last;
+    mutable Optizelle::CacheStamp <Real,Optizelle::SQL> z_last;
 
     // Dense matrix that stores the interior point piece of the Hessian and
     // then its Choleski factorization
     mutable std::vector <Real> H;
 
-    // Cannonical vector
-    mutable X_Vector ei;
-
     // Inverse of the condition number of H
     mutable Real invCondH;
  
 public:
     SDPPreconditioner(
-        ProjectX <Real,XX>* proj_,
-        const std::unique_ptr<
-            Optizelle::ScalarValuedFunctionModifications<Real,XX> >& f_mod_,
-        X_Vector const & x_
-    ) : proj(proj_),
-        f_mod(f_mod_),
+        Optizelle::LinearSDP <Real> const & h_,
+        X_Vector const & x_,
+        Z_Vector const & h_x_,
+        Z_Vector const & z_
+    ) : h(h_),
         x(x_),
-        x_tmp1(X::init(x_)),
-        x_tmp2(X::init(x_)),
-        x_last(false,X::init(x_)),
+        h_x(h_x_),
+        z(z_),
+        x_last(x_),
+        z_last(z_),
         H(),
-        ei(X::init(x_)),
         invCondH(1.)
-    { 
-        Rm_Vector const * const P_x=(*proj)(const_cast <X_Vector &>(x));
-        H.resize(P_x->size()*P_x->size());
-    }
+    { }
 
     // Basic application
     void eval(X_Vector const & dx,X_Vector & PH_dx) const {
-        // Determine the size of the projected vector
-        Natural m = (*proj)(ei)->size();
+        // Determine the size of the problem
+        Natural m = x.size();
 
         // See if we need to recalculate the preconditioner
-        if( Optizelle::rel_err_cached <Real,XX> (x,x_last) >=
-            std::numeric_limits <Real>::epsilon()*1e1
-        ){
+        if(x_last.stale(x) || z_last.stale(z)) {
             // Cache the values
-            x_last.first=true;
-            X::copy(x,x_last.second);
-
-            // Zero out H and our temp vector
-            Rm::zero(H);
-            X::zero(x_tmp1);
+            x_last.update(x);
+            z_last.update(z);
 
             // Form H
-            for(Natural i=0;i<m;i++) {
-                // Create the cannonical vector
-                create_ei <Real> (i,*((*proj)(ei))); 
-
-                // Grab the ith column of H
-                f_mod->hessvec_step(x,ei,x_tmp1,x_tmp2);
-
-                // Project out the bits in Rm
-                Rm_Vector* const P_x_tmp2=(*proj)(x_tmp2);
-
-                // Copy in the column into the correct place
-                Optizelle::copy <Real> (m,&((*P_x_tmp2)[0]),1,&(H[i*m]),1);
-            }
+            h.schur(h_x,z,H);
 
             // Find the condition number of H
             Integer info(0);
@@ -828,10 +591,8 @@ public:
         // If the matrix is well enough conditioned, do a triangular solve
         // for y
         if(invCondH >= std::numeric_limits <Real>::epsilon()*1e3) {
-            // Do the triangular solve for y
-            Rm_Vector* P_PHdx=(*proj)(PH_dx);
-            Optizelle::trsv <Real> ('U','T','N',m,&(H[0]),m,&((*P_PHdx)[0]),1);
-            Optizelle::trsv <Real> ('U','N','N',m,&(H[0]),m,&((*P_PHdx)[0]),1);
+            Optizelle::trsv <Real> ('U','T','N',m,&(H[0]),m,&(PH_dx[0]),1);
+            Optizelle::trsv <Real> ('U','N','N',m,&(H[0]),m,&(PH_dx[0]),1);
         }
     }
 };
@@ -867,7 +628,7 @@ bool initPhase1X(
     // we can simply set y=-2/delta then we're strictly feasible.  Third,
     // if delta < 0, we're strictly feasible and we can set y=0.  Finally,
     // if delta=infinity, we're also feasible.
-    SDPIneq <Real> h(prob);
+    std::unique_ptr <Optizelle::LinearSDP <Real> > h(initLinearSDP(prob));
 
     // xx <- x_1
     typename Rm::Vector xx(Rm::init(x));
@@ -877,7 +638,7 @@ bool initPhase1X(
 
     // h_xx <- h(xx)
     typename SQL::Vector h_xx(SQL::init(e));
-        h.eval(xx,h_xx);
+        h->eval(xx,h_xx);
 
     // Figure out the extent of our infeasibility.  Use the formula above
     // to transform delta into this value.
@@ -994,9 +755,10 @@ int main(int argc,char* argv[]) {
     Optizelle::InequalityConstrained <Real,Optizelle::Rm,Optizelle::SQL>
         ::Functions::t phase1_fns;
     phase1_fns.f.reset(new Phase1Obj <Real> ()); 
-    phase1_fns.h.reset(new Phase1Ineq <Real> (prob,epsilon));
-    phase1_fns.PH.reset(new SDPPreconditioner <Real,Optizelle::Rm> (
-        new ProjectRm <Real> (),phase1_fns.f_mod,phase1_state.x));
+    auto phase1_h = initLinearSDP <Real> (prob,true,epsilon);
+    phase1_fns.h.reset(phase1_h);
+    phase1_fns.PH.reset(new SDPPreconditioner <Real> (*phase1_h,
+        phase1_state.x,phase1_state.h_x,phase1_state.z));
 
     // Solve the phase-1 problem if we're infeasible.
     if(!feasible) {
@@ -1045,9 +807,10 @@ int main(int argc,char* argv[]) {
     Optizelle::InequalityConstrained <Real,Optizelle::Rm,Optizelle::SQL>
         ::Functions::t fns;
     fns.f.reset(new SDPObj <Real> (prob));
-    fns.h.reset(new SDPIneq <Real> (prob));
-    fns.PH.reset(new SDPPreconditioner <Real,Optizelle::Rm> (
-        new ProjectRm <Real> (),fns.f_mod,state.x));
+    auto h = initLinearSDP <Real> (prob);
+    fns.h.reset(h);
+    fns.PH.reset(new SDPPreconditioner <Real> (*h,state.x,state.h_x,
+        state.z));
     
     // Keep our user informed
     std::cout << std::endl << "Solving the SDP probem: " << fname << std::endl;
@@ -34,6 +34,7 @@ function checkEqualityConstrainedStateT(name,value)
         'PSchur_right_type', ...
         'augsys_iter_max', ...
         'augsys_rst_freq', ...
+        'augsys_recycle_max', ...
         'augsys_qn_iter', ...
         'augsys_pg_iter', ...
         'augsys_proj_iter', ...
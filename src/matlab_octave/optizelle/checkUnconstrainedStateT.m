@@ -17,6 +17,7 @@ function checkUnconstrainedStateT(name,value)
         'trunc_iter_total', ...
         'trunc_orthog_storage_max', ...
         'trunc_orthog_iter_max', ...
+        'trunc_solver', ...
         'trunc_stop', ...
         'trunc_err', ...
         'eps_trunc', ...
@@ -55,6 +56,8 @@ function checkUnconstrainedStateT(name,value)
         'eps_ls', ...
         'dir', ...
         'kind', ...
+        'eval_cache_size', ...
+        'eval_cache_hits', ...
         'f_diag', ...
         'L_diag', ...
         'x_diag', ...
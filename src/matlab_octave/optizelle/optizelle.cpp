@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include "optizelle.h"
 
 // Catch and handle MATLAB/Octave and Optizelle errors.  In theory, we should
@@ -244,6 +247,9 @@ namespace Optizelle {
             case ObjectiveIncrease:
                 return Matlab::capi::enumToMxArray(
                     "TruncatedStop","ObjectiveIncrease");
+            case ConvergedOnBoundary:
+                return Matlab::capi::enumToMxArray(
+                    "TruncatedStop","ConvergedOnBoundary");
             }
         }
 
@@ -310,6 +316,10 @@ namespace Optizelle {
                 "TruncatedStop","ObjectiveIncrease")
             )
                 return ObjectiveIncrease;
+            else if(m==Matlab::capi::enumToNatural(
+                "TruncatedStop","ConvergedOnBoundary")
+            )
+                return ConvergedOnBoundary;
             else
                 throw Optizelle::Exception::t( __LOC__
                     + ", unknown TruncatedStop");
@@ -372,6 +382,9 @@ namespace Optizelle {
                 return Matlab::capi::enumToMxArray("Operators","InvSR1");
             case UserDefined:
                 return Matlab::capi::enumToMxArray("Operators","UserDefined");
+            case CompactBFGS:
+                return Matlab::capi::enumToMxArray(
+                    "Operators","CompactBFGS");
             }
         }
 
@@ -398,6 +411,10 @@ namespace Optizelle {
                 return InvSR1;
             else if(m==Matlab::capi::enumToNatural("Operators","UserDefined"))
                 return UserDefined;
+            else if(m==Matlab::capi::enumToNatural(
+                "Operators","CompactBFGS")
+            )
+                return CompactBFGS;
             else
                 throw Optizelle::Exception::t( __LOC__
                     + ", unknown Operators");
@@ -482,6 +499,12 @@ namespace Optizelle {
             case TwoPointB:
                 return Matlab::capi::enumToMxArray(
                     "LineSearchKind","TwoPointB");
+            // MATLAB/Octave functions can't be called from several threads,
+            // so we don't offer the parallel line-search
+            case ParallelBackTracking:
+                throw Optizelle::Exception::t( __LOC__
+                    + ", the ParallelBackTracking line-search is not "
+                    "available from MATLAB/Octave");
             }
         }
 
@@ -799,6 +822,39 @@ namespace Optizelle {
         }
     }
 
+    namespace TruncatedSolver { 
+        // Converts t to a Matlab enumerated type
+        Matlab::mxArrayPtr toMatlab(t const & trunc_solver) {
+            // Do the conversion
+            switch(trunc_solver){
+            case ConjugateGradient:
+                return Matlab::capi::enumToMxArray(
+                    "TruncatedSolver","ConjugateGradient");
+            case Lanczos:
+                return Matlab::capi::enumToMxArray(
+                    "TruncatedSolver","Lanczos");
+            }
+        }
+
+        // Converts a Matlab enumerated type to t 
+        t fromMatlab(Matlab::mxArrayPtr const & member) {
+            // Convert the member to a Natural 
+            auto m = Matlab::capi::mxArrayToNatural(member);
+
+            if(m==Matlab::capi::enumToNatural(
+                "TruncatedSolver","ConjugateGradient")
+            )
+                return ConjugateGradient;
+            else if(m==Matlab::capi::enumToNatural(
+                "TruncatedSolver","Lanczos")
+            )
+                return Lanczos;
+            else
+                throw Optizelle::Exception::t( __LOC__
+                    + ", unknown TruncatedSolver");
+        }
+    }
+
     namespace QuasinormalStop{ 
         // Converts t to a Matlab enumerated type
         Matlab::mxArrayPtr toMatlab(t const & qn_stop) {
@@ -911,7 +967,7 @@ namespace Optizelle {
                 // Call the serialize routine on the vector
                 auto x_json = Matlab::capi::mexCallMATLAB3(
                     std::string("serialize"),
-                    x.data,
+                    x.share(),
                     name,
                     iter,
                     __LOC__
@@ -933,12 +989,12 @@ namespace Optizelle {
 
                 // Call the deserialize routine on the reference vector and the
                 // json vector
-                x.data = Matlab::capi::mexCallMATLAB2(
+                x.assign(Matlab::capi::mexCallMATLAB2(
                     std::string("deserialize"),
-                    x_.data,
+                    x_.share(),
                     x_json,
                     __LOC__
-                        + ", evaluation of the deserialize function failed");
+                        + ", evaluation of the deserialize function failed"));
 
                 // Move out the new vector
                 return x;
@@ -1278,14 +1334,78 @@ namespace Optizelle {
             }
         }
 
+        // Determines whether the vector space is Optizelle.Rm.  Since users
+        // pass us a copy of the structure, we compare the functions with
+        // those in the global module.
+        static bool isRm(mxArrayPtr const & vs) {
+            auto rm = capi::mxGetField(optizelle.back(),0,"Rm");
+            auto ret = capi::mexCallMATLAB2(
+                std::string("isequal"),
+                vs,
+                rm,
+                __LOC__ + ", comparison with the vector space Rm failed");
+            return ::mxIsLogicalScalarTrue(ret.get());
+        }
+
+        // Determines whether an array holds real, dense doubles
+        static bool isDense(mxArrayPtr const & x) {
+            return ::mxIsDouble(x.get()) && !::mxIsComplex(x.get())
+                && !::mxIsSparse(x.get());
+        }
+
         // Grab the vector space and data 
         Vector::Vector(mxArrayPtr const & vs_, mxArrayPtr const & data_) :
+            Vector(vs_,data_,isRm(vs_))
+        {}
+
+        // Grab the vector space and data when we already know whether the
+        // vector space is Optizelle.Rm
+        Vector::Vector(
+            mxArrayPtr const & vs_,
+            mxArrayPtr const & data_,
+            bool const & rm_
+        ) :
+            vs(vs_),
+            rm(rm_),
+            data(data_),
+            buffer(nullptr),
+            size(0)
+        {
+            // When we can work on the memory directly, make our own copy of
+            // the data since MATLAB/Octave may share it with other arrays
+            if(rm && isDense(data)) {
+                data = capi::mxDuplicateArray(data);
+                buffer = ::mxGetPr(data.get());
+                size = ::mxGetNumberOfElements(data.get());
+            }
+        }
+
+        // Grab the vector space and data along with the memory of a native
+        // vector
+        Vector::Vector(
+            mxArrayPtr const & vs_,
+            mxArrayPtr const & data_,
+            double * const & buffer_,
+            Natural const & size_
+        ) :
             vs(vs_),
-            data(data_)
+            rm(true),
+            data(data_),
+            buffer(buffer_),
+            size(size_)
         {}
 
         // Memory allocation and size setting 
         Vector Vector::init() const {
+            // Allocate the memory directly when we can
+            if(buffer) {
+                auto ret = mxArrayPtr(::mxCreateDoubleMatrix(
+                    ::mxGetM(data.get()),
+                    ::mxGetN(data.get()),
+                    mxREAL));
+                return Vector(vs,ret,::mxGetPr(ret.get()),size);
+            }
+
             // Call the init function on the internal and store in y 
             auto init = capi::mxGetField(vs,0,"init");
             auto ret = capi::mexCallMATLAB1(
@@ -1295,22 +1415,65 @@ namespace Optizelle {
                     + ", evaluation of the vector space function init failed");
 
             // Return the vector
-            return Vector(vs,ret);
+            return Vector(vs,ret,rm);
+        }
+
+        // Determines whether we can operate on the memory of this vector
+        // and x directly
+        bool Vector::native(Vector const & x) const {
+            return buffer && x.buffer && size==x.size;
+        }
+
+        // Grabs the data to pass into a MATLAB/Octave function
+        mxArrayPtr Vector::share() const {
+            return buffer ? capi::mxDuplicateArray(data) : data;
+        }
+
+        // Stores data returned from a MATLAB/Octave function
+        void Vector::assign(mxArrayPtr const & ptr) {
+            // Copy the memory directly when we can
+            if(buffer) {
+                if(isDense(ptr) && ::mxGetNumberOfElements(ptr.get())==size) {
+                    Optizelle::copy <double> (size,::mxGetPr(ptr.get()),1,
+                        buffer,1);
+                    return;
+                }
+
+                // Otherwise, we no longer own the data, so stop working on
+                // it directly
+                buffer = nullptr;
+                size = 0;
+            }
+
+            // Hold onto the new data
+            data = ptr;
         }
         
         // y <- x (Shallow.  No memory allocation.)  Internal is y.
         void Vector::copy(Vector const & x) { 
+            // Copy the memory directly when we can
+            if(native(x)) {
+                Optizelle::copy <double> (size,x.buffer,1,buffer,1);
+                return;
+            }
+
             // Call the copy function on x and the internal 
             auto copy = capi::mxGetField(vs,0,"copy");
-            data = capi::mexCallMATLAB1(
+            assign(capi::mexCallMATLAB1(
                 copy,
-                x.data,
+                x.share(),
                  __LOC__
-                    + ", evaluation of the vector space function copy failed");
+                    + ", evaluation of the vector space function copy failed"));
         }
 
         // x <- alpha * x.  Internal is x.
         void Vector::scal(double const & alpha_) { 
+            // Scale the memory directly when we can
+            if(buffer) {
+                Optizelle::scal <double> (size,alpha_,buffer,1);
+                return;
+            }
+
             // Call the scal function on alpha and the internal storage 
             auto scal = capi::mxGetField(vs,0,"scal");
             auto alpha = capi::mxArrayFromDouble(alpha_);
@@ -1324,6 +1487,12 @@ namespace Optizelle {
 
         // x <- 0.  Internal is x. 
         void Vector::zero() { 
+            // Zero the memory directly when we can
+            if(buffer) {
+                std::fill(buffer,buffer+size,0.);
+                return;
+            }
+
             // Call the zero function on this vector.
             auto zero = capi::mxGetField(vs,0,"zero");
             data = capi::mexCallMATLAB1(
@@ -1335,25 +1504,35 @@ namespace Optizelle {
 
         // y <- alpha * x + y.   Internal is y.
         void Vector::axpy(double const & alpha_,Vector const & x) { 
+            // Work on the memory directly when we can
+            if(native(x)) {
+                Optizelle::axpy <double> (size,alpha_,x.buffer,1,buffer,1);
+                return;
+            }
+
             // Call the axpy function on alpha, x, and the internal storage.
             auto axpy = capi::mxGetField(vs,0,"axpy");
             auto alpha = capi::mxArrayFromDouble(alpha_);
-            data = capi::mexCallMATLAB3(
+            assign(capi::mexCallMATLAB3(
                 axpy,
                 alpha,
-                x.data,
+                x.share(),
                 data,
                 __LOC__
-                    + ", evaluation of the vector space function axpy failed");
+                    + ", evaluation of the vector space function axpy failed"));
         } 
 
         // innr <- <x,y>.  Internal is y.
         double Vector::innr(Vector const & x) const {
+            // Work on the memory directly when we can
+            if(native(x))
+                return Optizelle::dot <double> (size,x.buffer,1,buffer,1);
+
             // Call the innr function on x and the internal.  Store in z. 
             auto innr = capi::mxGetField(vs,0,"innr");
             return capi::mxArrayToDouble(capi::mexCallMATLAB2(
                 innr,
-                x.data,
+                x.share(),
                 data,
                 __LOC__
                     + ", evaluation of the vector space function innr failed"));
@@ -1361,6 +1540,16 @@ namespace Optizelle {
 
         // x <- random.  Internal is x. 
         void Vector::rand() { 
+            // Work on the memory directly when we can
+            if(buffer) {
+                std::random_device rd;
+                std::mt19937 gen(rd());
+                std::normal_distribution <double> dis(0.,1.);
+                for(Natural i=0;i<size;i++)
+                    buffer[i]=dis(gen);
+                return;
+            }
+
             // Call the rand function on this vector.
             auto rand = capi::mxGetField(vs,0,"rand");
             data = capi::mexCallMATLAB1(
@@ -1372,18 +1561,31 @@ namespace Optizelle {
 
         // Jordan product, z <- x o y.  Internal is z.
         void Vector::prod(Vector const & x,Vector const & y) { 
+            // Work on the memory directly when we can
+            if(native(x) && native(y)) {
+                for(Natural i=0;i<size;i++)
+                    buffer[i]=x.buffer[i]*y.buffer[i];
+                return;
+            }
+
             // Call the prod function on x, y, and the internal 
             auto prod = capi::mxGetField(vs,0,"prod");
-            data = capi::mexCallMATLAB2(
+            assign(capi::mexCallMATLAB2(
                 prod,
-                x.data,
-                y.data,
+                x.share(),
+                y.share(),
                 __LOC__
-                    + ", evaluation of the vector space function prod failed");
+                    + ", evaluation of the vector space function prod failed"));
         } 
 
         // Identity element, x <- e such that x o e = x .  Internal is x.
         void Vector::id() { 
+            // Work on the memory directly when we can
+            if(buffer) {
+                std::fill(buffer,buffer+size,1.);
+                return;
+            }
+
             // Call the id function on the internal.
             auto id = capi::mxGetField(vs,0,"id");
             data = capi::mexCallMATLAB1(
@@ -1396,19 +1598,34 @@ namespace Optizelle {
         // Jordan product inverse, z <- inv(L(x)) y where L(x) y = x o y.
         // Internal is z.
         void Vector::linv(Vector const & x, Vector const & y) { 
+            // Work on the memory directly when we can
+            if(native(x) && native(y)) {
+                for(Natural i=0;i<size;i++)
+                    buffer[i]=y.buffer[i]/x.buffer[i];
+                return;
+            }
+
             // Call the linv function on x, y, and the internal
             auto linv = capi::mxGetField(vs,0,"linv");
-            data = capi::mexCallMATLAB2(
+            assign(capi::mexCallMATLAB2(
                 linv,
-                x.data,
-                y.data,
+                x.share(),
+                y.share(),
                 __LOC__
-                    + ", evaluation of the vector space function linv failed");
+                    + ", evaluation of the vector space function linv failed"));
         } 
 
         // Barrier function, barr <- barr(x) where x o grad barr(x) = e.
         // Internal is x.
         double Vector::barr() const {
+            // Work on the memory directly when we can
+            if(buffer) {
+                auto z = 0.;
+                for(Natural i=0;i<size;i++)
+                    z+=std::log(buffer[i]);
+                return z;
+            }
+
             // Call the barr function on the internal.  Store in z.
             auto barr = capi::mxGetField(vs,0,"barr");
             return capi::mxArrayToDouble(capi::mexCallMATLAB1(
@@ -1421,11 +1638,22 @@ namespace Optizelle {
         // Line search, srch <- argmax {alpha in Real >= 0 : alpha x + y >= 0} 
         // where y > 0.  Internal is y.
         double Vector::srch(Vector const & x) const {
+            // Work on the memory directly when we can
+            if(native(x)) {
+                auto alpha = std::numeric_limits <double>::infinity();
+                for(Natural i=0;i<size;i++)
+                    if(x.buffer[i] < 0.) {
+                        auto alpha0 = -buffer[i]/x.buffer[i];
+                        alpha = alpha0 < alpha ? alpha0 : alpha;
+                    }
+                return alpha;
+            }
+
             // Call the srch function on x and the internal.  Store in z.
             auto srch = capi::mxGetField(vs,0,"srch");
             return capi::mxArrayToDouble(capi::mexCallMATLAB2(
                 srch,
-                x.data,
+                x.share(),
                 data,
                 __LOC__
                     + ", evaluation of the vector space function srch failed"));
@@ -1434,6 +1662,10 @@ namespace Optizelle {
         // Symmetrization, x <- symm(x) such that L(symm(x)) is a symmetric
         // operator.  Internal is x.
         void Vector::symm() { 
+            // Symmetrization doesn't do anything in Rm
+            if(buffer)
+                return;
+
             // Call the symm function on the internal.
             auto symm = capi::mxGetField(vs,0,"symm");
             data = capi::mexCallMATLAB1(
@@ -1445,6 +1677,10 @@ namespace Optizelle {
         
         // Converts (copies) a value into Matlab.  
         mxArrayPtr Vector::toMatlab() const {
+            // Copy the memory directly when we can
+            if(buffer)
+                return capi::mxDuplicateArray(data);
+
             // Call the copy function on the internal and x
             auto copy = capi::mxGetField(vs,0,"copy");
             return capi::mexCallMATLAB1(
@@ -1457,13 +1693,19 @@ namespace Optizelle {
         // Converts (copies) a value from Matlab.  This assumes that the
         // vector space functions have already been properly assigned.
         void Vector::fromMatlab(mxArrayPtr const & ptr) {
+            // Copy the memory directly when we can
+            if(buffer) {
+                assign(ptr);
+                return;
+            }
+
             // Call the copy function on ptr and the internal 
             auto copy = capi::mxGetField(vs,0,"copy");
-            data = capi::mexCallMATLAB1(
+            assign(capi::mexCallMATLAB1(
                 copy,
                 ptr,
                 __LOC__
-                    + ", evaluation of the vector space function copy failed");
+                    + ", evaluation of the vector space function copy failed"));
         } 
 
         // Grab the pointer to the function information 
@@ -1476,7 +1718,7 @@ namespace Optizelle {
             auto eval = capi::mxGetField(data,0,"eval");
             return capi::mxArrayToDouble(capi::mexCallMATLAB1(
                 eval,
-                x.data,
+                x.share(),
                 __LOC__
                     + ", evaluation of the objective f failed"));
         }
@@ -1488,11 +1730,11 @@ namespace Optizelle {
         ) const { 
             // Call the gradient function on x
             auto mxgrad = capi::mxGetField(data,0,"grad");
-            grad.data = capi::mexCallMATLAB1(
+            grad.assign(capi::mexCallMATLAB1(
                 mxgrad,
-                x.data,
+                x.share(),
                 __LOC__
-                    + ", evaluation of the gradient of f failed.");
+                    + ", evaluation of the gradient of f failed."));
         }
 
         // H_dx = hess f(x) dx 
@@ -1503,12 +1745,13 @@ namespace Optizelle {
         ) const {
             // Call the hessvec function on x and dx,
             auto hessvec = capi::mxGetField(data,0,"hessvec");
-            H_dx.data = capi::mexCallMATLAB2(
+            H_dx.assign(capi::mexCallMATLAB2(
                 hessvec,
-                x.data,
-                dx.data,
+                x.share(),
+                dx.share(),
                 __LOC__
-                    + ", evaluation of the Hessian-vector product of f failed");
+                    + ", evaluation of the Hessian-vector product of f "
+                    + "failed"));
         }
 
         // Grab the function's name and a pointer to the underlying data 
@@ -1526,11 +1769,11 @@ namespace Optizelle {
         ) const {
             // Call the objective function on x.
             auto eval = capi::mxGetField(data,0,"eval");
-            y.data = capi::mexCallMATLAB1(
+            y.assign(capi::mexCallMATLAB1(
                 eval,
-                x.data,
+                x.share(),
                 __LOC__
-                    + ", evaluation of the constraint " + name + " failed");
+                    + ", evaluation of the constraint " + name + " failed"));
         }
 
         // y=f'(x)dx 
@@ -1541,13 +1784,13 @@ namespace Optizelle {
         ) const {
             // Call the prime function on x and dx
             auto p = capi::mxGetField(data,0,"p");
-            y.data = capi::mexCallMATLAB2(
+            y.assign(capi::mexCallMATLAB2(
                 p,
-                x.data,
-                dx.data,
+                x.share(),
+                dx.share(),
                 __LOC__
                     + ", evaluation of the derivative of the constraint "
-                    + name + " failed");
+                    + name + " failed"));
         }
 
         // xhat=f'(x)*dy
@@ -1558,13 +1801,13 @@ namespace Optizelle {
         ) const {
             // Call the prime-adjoint function on x and dy
             auto ps = capi::mxGetField(data,0,"ps");
-            xhat.data = capi::mexCallMATLAB2(
+            xhat.assign(capi::mexCallMATLAB2(
                 ps,
-                x.data,
-                dy.data,
+                x.share(),
+                dy.share(),
                 __LOC__
                     +", evaluation of the derivative-adjoint of the constraint "
-                    + name + " failed");
+                    + name + " failed"));
         }
              
         // xhat=(f''(x)dx)*dy
@@ -1576,14 +1819,14 @@ namespace Optizelle {
         ) const { 
             // Call the prime-adjoint function on x, dx, and dy
             auto pps = capi::mxGetField(data,0,"pps");
-            xhat.data = capi::mexCallMATLAB3(
+            xhat.assign(capi::mexCallMATLAB3(
                 pps,
-                x.data,
-                dx.data,
-                dy.data,
+                x.share(),
+                dx.share(),
+                dy.share(),
                 __LOC__
                     + ", evaluation of the second derivative-adjoint of the "
-                    + "constraint " + name + " failed");
+                    + "constraint " + name + " failed"));
         }
 
         // Converts elements from C++ to Matlab 
@@ -1997,6 +2240,7 @@ namespace Optizelle {
                         "trunc_iter_total",
                         "trunc_orthog_storage_max",
                         "trunc_orthog_iter_max",
+                        "trunc_solver",
                         "trunc_stop",
                         "trunc_err",
                         "eps_trunc",
@@ -2035,6 +2279,8 @@ namespace Optizelle {
                         "eps_ls",
                         "dir",
                         "kind",
+                        "eval_cache_size",
+                        "eval_cache_hits",
                         "f_diag",
                         "L_diag",
                         "x_diag",
@@ -2085,6 +2331,11 @@ namespace Optizelle {
                         state.trunc_orthog_storage_max,mxstate);
                     toMatlab::Natural("trunc_orthog_iter_max",
                         state.trunc_orthog_iter_max,mxstate);
+                    toMatlab::Param <TruncatedSolver::t> (
+                        "trunc_solver",
+                        TruncatedSolver::toMatlab,
+                        state.trunc_solver,
+                        mxstate);
                     toMatlab::Param <TruncatedStop::t> (
                         "trunc_stop",
                         TruncatedStop::toMatlab,
@@ -2154,6 +2405,10 @@ namespace Optizelle {
                         LineSearchKind::toMatlab,
                         state.kind,
                         mxstate);
+                    toMatlab::Natural("eval_cache_size",
+                        state.eval_cache_size,mxstate);
+                    toMatlab::Natural("eval_cache_hits",
+                        state.eval_cache_hits,mxstate);
                     toMatlab::Param <FunctionDiagnostics::t> (
                         "f_diag",
                         FunctionDiagnostics::toMatlab,
@@ -2220,6 +2475,11 @@ namespace Optizelle {
                         mxstate,state.trunc_orthog_storage_max);
                     fromMatlab::Natural("trunc_orthog_iter_max",
                         mxstate,state.trunc_orthog_iter_max);
+                    fromMatlab::Param <TruncatedSolver::t> (
+                        "trunc_solver",
+                        TruncatedSolver::fromMatlab,
+                        mxstate,
+                        state.trunc_solver);
                     fromMatlab::Param <TruncatedStop::t> (
                         "trunc_stop",
                         TruncatedStop::fromMatlab,
@@ -2254,6 +2514,8 @@ namespace Optizelle {
                     fromMatlab::Vector("dx_old",mxstate,state.dx_old);
                     fromMatlab::VectorList("oldY",mxstate,state.x,state.oldY);
                     fromMatlab::VectorList("oldS",mxstate,state.x,state.oldS);
+                    state.innr_oldS_oldS.clear();
+                    state.innr_oldS_oldY.clear();
                     fromMatlab::Real("f_x",mxstate,state.f_x);
                     fromMatlab::Real("f_xpdx",mxstate,state.f_xpdx);
                     fromMatlab::Natural("msg_level",mxstate,state.msg_level);
@@ -2290,6 +2552,10 @@ namespace Optizelle {
                         LineSearchKind::fromMatlab,
                         mxstate,
                         state.kind);
+                    fromMatlab::Natural("eval_cache_size",mxstate,
+                        state.eval_cache_size);
+                    fromMatlab::Natural("eval_cache_hits",mxstate,
+                        state.eval_cache_hits);
                     fromMatlab::Param <FunctionDiagnostics::t> (
                         "f_diag",
                         FunctionDiagnostics::fromMatlab,
@@ -2649,6 +2915,7 @@ namespace Optizelle {
                         "PSchur_right_type",
                         "augsys_iter_max",
                         "augsys_rst_freq",
+                        "augsys_recycle_max",
                         "augsys_qn_iter",
                         "augsys_pg_iter",
                         "augsys_proj_iter",
@@ -2748,6 +3015,8 @@ namespace Optizelle {
                         state.augsys_iter_max,mxstate);
                     toMatlab::Natural("augsys_rst_freq",
                         state.augsys_rst_freq,mxstate);
+                    toMatlab::Natural("augsys_recycle_max",
+                        state.augsys_recycle_max,mxstate);
                     toMatlab::Natural("augsys_qn_iter",
                         state.augsys_qn_iter,mxstate);
                     toMatlab::Natural("augsys_pg_iter",
@@ -2879,6 +3148,8 @@ namespace Optizelle {
                         mxstate,state.augsys_iter_max);
                     fromMatlab::Natural("augsys_rst_freq",
                         mxstate,state.augsys_rst_freq);
+                    fromMatlab::Natural("augsys_recycle_max",
+                        mxstate,state.augsys_recycle_max);
                     fromMatlab::Natural("augsys_qn_iter",
                         mxstate,state.augsys_qn_iter);
                     fromMatlab::Natural("augsys_pg_iter",
@@ -252,10 +252,42 @@ namespace Optizelle {
             // Vector space
             mxArrayPtr vs;
 
+            // Whether the vector space is Optizelle.Rm.  Checking this calls
+            // back into MATLAB/Octave, so we check once when we're handed a
+            // vector space and then pass the answer to every vector that we
+            // create from this one.
+            bool rm;
+
+            // Grab the vector space and data when we already know whether
+            // the vector space is Optizelle.Rm
+            Vector(
+                mxArrayPtr const & vs_,
+                mxArrayPtr const & data_,
+                bool const & rm_);
+
+            // Grab the vector space and data along with the memory of a
+            // native vector
+            Vector(
+                mxArrayPtr const & vs_,
+                mxArrayPtr const & data_,
+                double * const & buffer_,
+                Natural const & size_);
+
         public:
             // Data
             mxArrayPtr data;
 
+            // When the vector space is Optizelle.Rm and the data is a real,
+            // dense array of doubles, we run the vector space operations on
+            // the memory of the array directly rather than calling back into
+            // MATLAB/Octave.  In this case, buffer points to this memory and
+            // size holds the number of elements.  Otherwise, buffer is null.
+            // Since we modify this memory in place, a native vector always
+            // owns its array and never hands it to MATLAB/Octave directly.
+            // Use share and assign to pass data back and forth.
+            double * buffer;
+            Natural size;
+
             // Disallow constructors
             NO_DEFAULT_COPY_ASSIGNMENT(Vector)
 
@@ -268,6 +300,18 @@ namespace Optizelle {
 
             // Memory allocation and size setting 
             Vector init() const;
+
+            // Determines whether we can operate on the memory of this vector
+            // and x directly
+            bool native(Vector const & x) const;
+
+            // Grabs the data to pass into a MATLAB/Octave function.  Native
+            // vectors hand out a copy, which MATLAB/Octave may keep.
+            mxArrayPtr share() const;
+
+            // Stores data returned from a MATLAB/Octave function.  Native
+            // vectors copy it into their own memory.
+            void assign(mxArrayPtr const & ptr);
             
             // y <- x (Shallow.  No memory allocation.)  Internal is y.
             void copy(Vector const & x);
@@ -663,13 +707,13 @@ namespace Optizelle {
 
                 // Apply the operator to the state, x, and y
                 auto eval = capi::mxGetField(data,0,"eval");
-                y.data = capi::mexCallMATLAB2(
+                y.assign(capi::mexCallMATLAB2(
                     eval,
                     mxstate.data,
-                    x.data,
+                    x.share(),
                     __LOC__
                         + ", evaluation of the eval function in the operator "
-                        + name + " failed");
+                        + name + " failed"));
             }
         };
         
@@ -45,7 +45,8 @@ Optizelle.TruncatedStop = createEnum( { ...
     'OffsetViolatesTrustRegion', ...
     'OffsetViolatesSafeguard', ...
     'TooManyFailedSafeguard', ...
-    'ObjectiveIncrease'} );
+    'ObjectiveIncrease', ...
+    'ConvergedOnBoundary'} );
 
 % Which algorithm Optizelle.do we use
 Optizelle.AlgorithmClass = createEnum( { ...
@@ -72,7 +73,8 @@ Optizelle.Operators = createEnum( { ...
     'InvBFGS', ...
     'SR1', ...
     'InvSR1', ...
-    'UserDefined' } );
+    'UserDefined', ...
+    'CompactBFGS' } );
     
 % Different kinds of search directions
 Optizelle.LineSearchDirection = createEnum( { ...
@@ -149,6 +151,11 @@ Optizelle.ToleranceKind = createEnum( { ...
     'Absolute', ...
     'Relative'});
 
+% Different methods for solving the trust-region subproblem
+Optizelle.TruncatedSolver = createEnum( { ...
+    'ConjugateGradient', ...
+    'Lanczos'});
+
 % Reasons why the quasinormal problem exited
 Optizelle.QuasinormalStop = createEnum( { ...
     'Newton', ...
@@ -210,6 +217,8 @@ Optizelle.StateManipulator = struct('eval',@(fns,state,loc)state);
 %---StateManipulator1---
 
 % Vector space for the nonnegative orthant.  For basic vectors in R^m, use this.
+% When the vectors are real, dense arrays of doubles, the optimization
+% routines run these operations natively rather than calling these functions.
 Optizelle.Rm = struct( ...
     'init',@(x)x, ...
     'copy',@(x)x, ...
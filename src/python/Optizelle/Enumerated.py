@@ -24,8 +24,9 @@ class TruncatedStop(EnumeratedType):
     OffsetViolatesTrustRegion, \
     OffsetViolatesSafeguard, \
     TooManyFailedSafeguard, \
-    ObjectiveIncrease \
-    = range(15)
+    ObjectiveIncrease, \
+    ConvergedOnBoundary \
+    = range(16)
 
 class AlgorithmClass(EnumeratedType):
     """Which algorithm class do we use"""
@@ -54,8 +55,9 @@ class Operators(EnumeratedType):
     InvBFGS, \
     SR1, \
     InvSR1, \
-    UserDefined \
-    = range(8)
+    UserDefined, \
+    CompactBFGS \
+    = range(9)
     
 class LineSearchDirection(EnumeratedType):
     """Different kinds of search directions"""
@@ -72,8 +74,9 @@ class LineSearchKind(EnumeratedType):
     GoldenSection, \
     BackTracking, \
     TwoPointA, \
-    TwoPointB \
-    = range(4)
+    TwoPointB, \
+    ParallelBackTracking \
+    = range(5)
     
 class OptimizationLocation(EnumeratedType):
     """Different points in the optimization algorithm"""
@@ -134,6 +137,12 @@ class ToleranceKind(EnumeratedType):
     Absolute \
     = range(2)
 
+class TruncatedSolver(EnumeratedType):
+    """Which truncated Krylov method solves the trust-region subproblem"""
+    ConjugateGradient, \
+    Lanczos \
+    = range(2)
+
 class QuasinormalStop(EnumeratedType):
     """Reasons why the quasinormal problem exited"""
     Newton, \
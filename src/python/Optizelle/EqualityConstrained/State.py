@@ -112,6 +112,10 @@ class t(Optizelle.Unconstrained.State.t):
     augsys_rst_freq = createNatProperty(
         "augsys_rst_freq",
         ("How often we restart the augmented system solve"))
+    augsys_recycle_max = createNatProperty(
+        "augsys_recycle_max",
+        ("Maximum number of directions recycled between augmented system "
+        "solves"))
     augsys_qn_iter = createNatProperty(
         "augsys_qn_iter",
         ("Number of augmented system solve iterations used on the quasi-normal "
@@ -20,6 +20,12 @@ class ScalarValuedFunction(object):
     def hessvec(self,x,dx,H_dx):
         """<- hess f(x) dx"""
         _err(self,"grad")
+
+    def hessvec_many(self,x,dxs,H_dxs):
+        """H_dxs[j] <- hess f(x) dxs[j] for each j.  Override this to share
+        work between the directions."""
+        for (dx,H_dx) in zip(dxs,H_dxs):
+            self.hessvec(x,dx,H_dx)
 #---ScalarValuedFunction1---
 
 #---VectorValuedFunction0---
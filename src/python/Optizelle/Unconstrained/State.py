@@ -78,6 +78,10 @@ class t(object):
     trunc_orthog_iter_max = createNatProperty(
         "trunc_orthog_iter_max",
         "Maximum number of orthogonalization iterations in truncated CG")
+    trunc_solver = createEnumProperty(
+        "trunc_solver",
+        TruncatedSolver,
+        "Truncated Krylov method for the trust-region subproblem")
     trunc_stop = createEnumProperty(
         "trunc_stop",
         TruncatedStop,
@@ -169,6 +173,9 @@ class t(object):
         "eta2",
         ("Trust-region parameter for checking whether we enlarge the "
         "trust-region radius"))
+    trial_radii = createNatProperty(
+        "trial_radii",
+        "Number of trust-region radii that we try at once")
     ared = createFloatProperty(
         "ared",
         "Actual reduction")
@@ -204,6 +211,16 @@ class t(object):
         "kind",
         LineSearchKind,
         "Type of line-search")
+    ls_points = createNatProperty(
+        "ls_points",
+        ("Number of step lengths that the parallel line-search evaluates "
+        "at once"))
+    eval_cache_size = createNatProperty(
+        "eval_cache_size",
+        "Number of points where we remember function evaluations")
+    eval_cache_hits = createNatProperty(
+        "eval_cache_hits",
+        "Total number of function evaluations avoided by the cache")
     f_diag = createEnumProperty(
         "f_diag",
         FunctionDiagnostics,
@@ -220,6 +237,9 @@ class t(object):
         "dscheme",
         DiagnosticScheme,
         "Diagnostic scheme")
+    diag_threads = createNatProperty(
+        "diag_threads",
+        "Number of function evaluations the diagnostics run concurrently")
     eps_kind = createEnumProperty(
         "eps_kind",
         ToleranceKind,
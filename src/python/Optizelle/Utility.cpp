@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
 #include <Utility.h>
 
 // Handle Python and Optizelle errors
@@ -297,6 +300,9 @@ namespace Optizelle {
             case ObjectiveIncrease:
                 return Python::capi::enumToPyObject(
                     "TruncatedStop","ObjectiveIncrease");
+            case ConvergedOnBoundary:
+                return Python::capi::enumToPyObject(
+                    "TruncatedStop","ConvergedOnBoundary");
             }
         }
 
@@ -363,6 +369,10 @@ namespace Optizelle {
                 "TruncatedStop","ObjectiveIncrease")
             )
                 return ObjectiveIncrease;
+            else if(m==Python::capi::enumToNatural(
+                "TruncatedStop","ConvergedOnBoundary")
+            )
+                return ConvergedOnBoundary;
             else
                 throw Optizelle::Exception::t( __LOC__
                     + ", unknown TruncatedStop");
@@ -431,6 +441,9 @@ namespace Optizelle {
                 return Python::capi::enumToPyObject("Operators","InvSR1");
             case UserDefined:
                 return Python::capi::enumToPyObject("Operators","UserDefined");
+            case CompactBFGS:
+                return Python::capi::enumToPyObject(
+                    "Operators","CompactBFGS");
             }
         }
 
@@ -457,6 +470,10 @@ namespace Optizelle {
                 return InvSR1;
             else if(m==Python::capi::enumToNatural("Operators","UserDefined"))
                 return UserDefined;
+            else if(m==Python::capi::enumToNatural(
+                    "Operators","CompactBFGS")
+            )
+                return CompactBFGS;
             else
                 throw Optizelle::Exception::t( __LOC__
                     + ", unknown Operators");
@@ -541,6 +558,9 @@ namespace Optizelle {
             case TwoPointB:
                 return Python::capi::enumToPyObject(
                     "LineSearchKind","TwoPointB");
+            case ParallelBackTracking:
+                return Python::capi::enumToPyObject(
+                    "LineSearchKind","ParallelBackTracking");
             }
         }
 
@@ -565,6 +585,10 @@ namespace Optizelle {
                 "LineSearchKind","TwoPointB")
             )
                 return TwoPointB;
+            else if(m==Python::capi::enumToNatural(
+                "LineSearchKind","ParallelBackTracking")
+            )
+                return ParallelBackTracking;
             else
                 throw Optizelle::Exception::t( __LOC__
                     + ", unknown LineSearchKind");
@@ -860,6 +884,39 @@ namespace Optizelle {
         }
     }
 
+    namespace TruncatedSolver { 
+        // Converts t to a Python enumerated type
+        Python::PyObjectPtr toPython(t const & trunc_solver) {
+            // Do the conversion
+            switch(trunc_solver){
+            case ConjugateGradient:
+                return Python::capi::enumToPyObject("TruncatedSolver",
+                    "ConjugateGradient");
+            case Lanczos:
+                return Python::capi::enumToPyObject("TruncatedSolver",
+                    "Lanczos");
+            }
+        }
+
+        // Converts a Python enumerated type to t 
+        t fromPython(Python::PyObjectPtr const & member) {
+            // Convert the member to a Natural 
+            auto m=Python::capi::PyInt_AsNatural(member);
+
+            if(m==Python::capi::enumToNatural("TruncatedSolver",
+                "ConjugateGradient")
+            )
+                return ConjugateGradient;
+            else if(m==Python::capi::enumToNatural("TruncatedSolver",
+                "Lanczos")
+            )
+                return Lanczos;
+            else
+                throw Optizelle::Exception::t( __LOC__
+                    + ", unknown TruncatedSolver");
+        }
+    }
+
     namespace QuasinormalStop{ 
         // Converts t to a Python enumerated type
         Python::PyObjectPtr toPython(t const & qn_stop) {
@@ -1027,15 +1084,23 @@ namespace Optizelle {
             PyObjectPtr::Mode const & mode
         ) : ptr(ptr_) {
             // If we have a borrowed reference, increase the reference count
-            if(mode==PyObjectPtr::Borrowed)
+            if(mode==PyObjectPtr::Borrowed && ptr) {
+                AcquireGIL gil;
                 Py_XINCREF(ptr);
+            }
         }
 
         // Copy semantics 
         PyObjectPtr::PyObjectPtr(PyObjectPtr const & p) : ptr(p.ptr) {
-            Py_XINCREF(ptr);
+            if(ptr) {
+                AcquireGIL gil;
+                Py_XINCREF(ptr);
+            }
         }
         PyObjectPtr & PyObjectPtr::operator = (PyObjectPtr& p) {
+            // Since we may run with the GIL released, grab it
+            AcquireGIL gil;
+
             // Decrease the reference count on this object first
             if(ptr)
                 Py_XDECREF(ptr);
@@ -1052,8 +1117,10 @@ namespace Optizelle {
         }
         PyObjectPtr & PyObjectPtr::operator = (PyObjectPtr && p) { 
             // Decrease the reference count on this object first
-            if(ptr)
+            if(ptr) {
+                AcquireGIL gil;
                 Py_XDECREF(ptr);
+            }
 
             // Then, grab the new pointer
             ptr=p.ptr;
@@ -1068,8 +1135,10 @@ namespace Optizelle {
 
         // On destruction, decrement the reference count 
         PyObjectPtr::~PyObjectPtr() {
-            if(ptr)
+            if(ptr) {
+                AcquireGIL gil;
                 Py_XDECREF(ptr);
+            }
         }
         namespace capi {
             PyObjectPtr PyImport_ImportModule(const char *name) {
@@ -1312,6 +1381,36 @@ namespace Optizelle {
                     __LOC__ + ", failed to deep copy an object");
             }
 
+            // Grabs the memory of an object that exposes a contiguous,
+            // writable buffer of doubles, such as a NumPy array of float64.
+            // We return the number of elements in n.  If the object doesn't
+            // have such a buffer, we return null.
+            double * PyBuffer_AsDoubles(PyObjectPtr const & o,Natural & n) {
+                // Objects without a buffer are fine, so clear the error
+                Py_buffer view;
+                if(!PyObject_CheckBuffer(o.get()) ||
+                    ::PyObject_GetBuffer(o.get(),&view,
+                        PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE)==-1
+                ) {
+                    ::PyErr_Clear();
+                    n = 0;
+                    return nullptr;
+                }
+
+                // Make sure we have doubles in the native byte order
+                auto format = std::string(view.format ? view.format : "B");
+                auto doubles = view.itemsize==sizeof(double) &&
+                    (format=="d" || format=="@d" || format=="=d");
+                auto buffer = doubles ? static_cast <double *> (view.buf)
+                    : nullptr;
+                n = doubles ? Natural(view.len/view.itemsize) : 0;
+
+                // We hold a reference to the object, which keeps the memory
+                // alive, so we don't need to hold onto the view
+                ::PyBuffer_Release(&view);
+                return buffer;
+            }
+
             // Converts an Optizelle enumerated type to a PyObject * 
             PyObjectPtr enumToPyObject(
                 std::string const & type,
@@ -1346,6 +1445,7 @@ namespace Optizelle {
             Optizelle::Messaging::t python(PyObjectPtr const & print) {
                 return [print](std::string const & msg_) {
                     // Call the print function
+                    AcquireGIL gil;
                     auto msg = capi::PyString_FromString(msg_.c_str());
                     auto ret = capi::PyObject_CallObject1(
                         print,
@@ -1356,13 +1456,37 @@ namespace Optizelle {
             }
         }
 
+        // Determines whether the vector space is Optizelle.Rm.  We hold onto
+        // Rm for the life of the interpreter, so we never release it.
+        static bool isRm(PyObjectPtr const & vs) {
+            static PyObject * const rm = []() {
+                auto module = capi::PyImport_ImportModule("Optizelle");
+                auto rm = capi::PyObject_GetAttrString(module,"Rm");
+                Py_INCREF(rm.get());
+                return rm.get();
+            }();
+            return vs.get()==rm;
+        }
+
         // Create a vector with the appropriate vector space 
         Vector::Vector(PyObjectPtr const & vs_,PyObjectPtr const & vec_) :
-            vs(vs_), data(vec_) {}
+            vs(vs_), data(vec_), buffer(nullptr), size(0)
+        {
+            AcquireGIL gil;
+            if(isRm(vs))
+                buffer = capi::PyBuffer_AsDoubles(data,size);
+        }
+
+        // Determines whether we can operate on the memory of this vector
+        // and x directly
+        bool Vector::native(Vector const & x) const {
+            return buffer && x.buffer && size==x.size;
+        }
             
         // Memory allocation and size setting 
         Vector Vector::init() const {
             // Call the init function on the internal and store in y 
+            AcquireGIL gil;
             auto init = capi::PyObject_GetAttrString(vs,"init");
             auto y = capi::PyObject_CallObject1(
                 init,
@@ -1376,7 +1500,14 @@ namespace Optizelle {
         
         // y <- x (Shallow.  No memory allocation.)  Internal is y.
         void Vector::copy(Vector const & x) { 
+            // Copy the memory directly when we can
+            if(native(x)) {
+                Optizelle::copy <double> (size,x.buffer,1,buffer,1);
+                return;
+            }
+
             // Call the copy function on x and the internal 
+            AcquireGIL gil;
             auto copy = capi::PyObject_GetAttrString(vs,"copy");
             capi::PyObject_CallObject2(
                 copy,
@@ -1388,7 +1519,14 @@ namespace Optizelle {
 
         // x <- alpha * x.  Internal is x.
         void Vector::scal(double const & alpha_) { 
+            // Scale the memory directly when we can
+            if(buffer) {
+                Optizelle::scal <double> (size,alpha_,buffer,1);
+                return;
+            }
+
             // Call the scal function on alpha and the internal storage 
+            AcquireGIL gil;
             auto scal = capi::PyObject_GetAttrString(vs,"scal");
             auto alpha = capi::PyFloat_FromDouble(alpha_);
             capi::PyObject_CallObject2(
@@ -1401,7 +1539,14 @@ namespace Optizelle {
 
         // x <- 0.  Internal is x. 
         void Vector::zero() { 
+            // Zero the memory directly when we can
+            if(buffer) {
+                std::fill(buffer,buffer+size,0.);
+                return;
+            }
+
             // Call the zero function on this vector.
+            AcquireGIL gil;
             auto zero = capi::PyObject_GetAttrString(vs,"zero");
             capi::PyObject_CallObject1(
                 zero,
@@ -1412,7 +1557,14 @@ namespace Optizelle {
 
         // y <- alpha * x + y.   Internal is y.
         void Vector::axpy(double const & alpha_,Vector const & x) { 
+            // Work on the memory directly when we can
+            if(native(x)) {
+                Optizelle::axpy <double> (size,alpha_,x.buffer,1,buffer,1);
+                return;
+            }
+
             // Call the axpy function on alpha, x, and the internal storage.
+            AcquireGIL gil;
             auto axpy = capi::PyObject_GetAttrString(vs,"axpy");
             auto alpha = capi::PyFloat_FromDouble(alpha_);
             capi::PyObject_CallObject3(
@@ -1426,7 +1578,12 @@ namespace Optizelle {
 
         // innr <- <x,y>.  Internal is y.
         double Vector::innr(Vector const & x) const {
+            // Work on the memory directly when we can
+            if(native(x))
+                return Optizelle::dot <double> (size,x.buffer,1,buffer,1);
+
             // Call the innr function on x and the internal.  Store in z. 
+            AcquireGIL gil;
             auto innr = capi::PyObject_GetAttrString(vs,"innr");
             auto z = capi::PyObject_CallObject2(
                 innr,
@@ -1441,7 +1598,18 @@ namespace Optizelle {
 
         // x <- random.  Internal is x. 
         void Vector::rand() { 
+            // Work on the memory directly when we can
+            if(buffer) {
+                std::random_device rd;
+                std::mt19937 gen(rd());
+                std::normal_distribution <double> dis(0.,1.);
+                for(Natural i=0;i<size;i++)
+                    buffer[i]=dis(gen);
+                return;
+            }
+
             // Call the rand function on this vector.
+            AcquireGIL gil;
             auto rand = capi::PyObject_GetAttrString(vs,"rand");
             capi::PyObject_CallObject1(
                 rand,
@@ -1452,7 +1620,15 @@ namespace Optizelle {
 
         // Jordan product, z <- x o y.  Internal is z.
         void Vector::prod(Vector const & x,Vector const & y) { 
+            // Work on the memory directly when we can
+            if(native(x) && native(y)) {
+                for(Natural i=0;i<size;i++)
+                    buffer[i]=x.buffer[i]*y.buffer[i];
+                return;
+            }
+
             // Call the prod function on x, y, and the internal 
+            AcquireGIL gil;
             auto prod = capi::PyObject_GetAttrString(vs,"prod");
             capi::PyObject_CallObject3(
                 prod,
@@ -1465,7 +1641,14 @@ namespace Optizelle {
 
         // Identity element, x <- e such that x o e = x .  Internal is x.
         void Vector::id() {
+            // Work on the memory directly when we can
+            if(buffer) {
+                std::fill(buffer,buffer+size,1.);
+                return;
+            }
+
             // Call the id function on the internal.
+            AcquireGIL gil;
             auto id = capi::PyObject_GetAttrString(vs,"id");
             capi::PyObject_CallObject1(
                 id,
@@ -1477,7 +1660,15 @@ namespace Optizelle {
         // Jordan product inverse, z <- inv(L(x)) y where L(x) y = x o y.
         // Internal is z.
         void Vector::linv(Vector const & x, Vector const & y) { 
+            // Work on the memory directly when we can
+            if(native(x) && native(y)) {
+                for(Natural i=0;i<size;i++)
+                    buffer[i]=y.buffer[i]/x.buffer[i];
+                return;
+            }
+
             // Call the linv function on x, y, and the internal
+            AcquireGIL gil;
             auto linv = capi::PyObject_GetAttrString(vs,"linv");
             capi::PyObject_CallObject3(
                 linv,
@@ -1491,7 +1682,20 @@ namespace Optizelle {
         // Barrier function, barr <- barr(x) where x o grad barr(x) = e.
         // Internal is x.
         double Vector::barr() const {
+            // Work on the memory directly when we can.  Like Optizelle.Rm,
+            // we return nan when we're outside of the cone.
+            if(buffer) {
+                auto z = 0.;
+                for(Natural i=0;i<size;i++) {
+                    if(buffer[i] <= 0.)
+                        return std::numeric_limits <double>::quiet_NaN();
+                    z+=std::log(buffer[i]);
+                }
+                return z;
+            }
+
             // Call the barr function on the internal.  Store in z.
+            AcquireGIL gil;
             auto barr = capi::PyObject_GetAttrString(vs,"barr");
             auto z = capi::PyObject_CallObject1(
                 barr,
@@ -1506,7 +1710,19 @@ namespace Optizelle {
         // Line search, srch <- argmax {alpha in Real >= 0 : alpha x + y >= 0} 
         // where y > 0.  Internal is y.
         double Vector::srch(Vector const & x) const {
+            // Work on the memory directly when we can
+            if(native(x)) {
+                auto alpha = std::numeric_limits <double>::infinity();
+                for(Natural i=0;i<size;i++)
+                    if(x.buffer[i] < 0.) {
+                        auto alpha0 = -buffer[i]/x.buffer[i];
+                        alpha = alpha0 < alpha ? alpha0 : alpha;
+                    }
+                return alpha;
+            }
+
             // Call the srch function on x and the internal.  Store in z.
+            AcquireGIL gil;
             auto srch = capi::PyObject_GetAttrString(vs,"srch");
             auto z = capi::PyObject_CallObject2(
                 srch,
@@ -1522,7 +1738,12 @@ namespace Optizelle {
         // Symmetrization, x <- symm(x) such that L(symm(x)) is a symmetric
         // operator.  Internal is x.
         void Vector::symm() { 
+            // Symmetrization doesn't do anything in Rm
+            if(buffer)
+                return;
+
             // Call the symm function on the internal.
+            AcquireGIL gil;
             auto symm = capi::PyObject_GetAttrString(vs,"symm");
             capi::PyObject_CallObject1(
                 symm,
@@ -1534,7 +1755,19 @@ namespace Optizelle {
         // Converts (copies) a value into Python.  This assumes memory
         // has been allocated both in the vector as well as Python.
         void Vector::toPython(PyObjectPtr const & ptr) const {
+            // Copy the memory directly when we can
+            if(buffer) {
+                AcquireGIL gil;
+                auto n = Natural(0);
+                auto ptr_buffer = capi::PyBuffer_AsDoubles(ptr,n);
+                if(ptr_buffer && n==size) {
+                    Optizelle::copy <double> (size,buffer,1,ptr_buffer,1);
+                    return;
+                }
+            }
+
             // Call the copy function on the internal and x
+            AcquireGIL gil;
             auto copy = capi::PyObject_GetAttrString(vs,"copy");
             capi::PyObject_CallObject2(
                 copy,
@@ -1547,7 +1780,19 @@ namespace Optizelle {
         // Converts (copies) a value from Python.  This assumes memory
         // has been allocated both in the vector as well as Python.
         void Vector::fromPython(PyObjectPtr const & ptr) {
+            // Copy the memory directly when we can
+            if(buffer) {
+                AcquireGIL gil;
+                auto n = Natural(0);
+                auto ptr_buffer = capi::PyBuffer_AsDoubles(ptr,n);
+                if(ptr_buffer && n==size) {
+                    Optizelle::copy <double> (size,ptr_buffer,1,buffer,1);
+                    return;
+                }
+            }
+
             // Call the copy function on ptr and the internal 
+            AcquireGIL gil;
             auto copy = capi::PyObject_GetAttrString(vs,"copy");
             capi::PyObject_CallObject2(
                 copy,
@@ -1646,6 +1891,7 @@ namespace Optizelle {
         // <- f(x) 
         double ScalarValuedFunction::eval(Vector const & x) const { 
             // Call the objective function on x.  Store in z.
+            AcquireGIL gil;
             auto eval = capi::PyObject_GetAttrString(data,"eval");
             auto ret = capi::PyObject_CallObject1(
                 eval,
@@ -1663,6 +1909,7 @@ namespace Optizelle {
             Vector & grad
         ) const { 
             // Call the gradient function on x and grad. 
+            AcquireGIL gil;
             auto pygrad = capi::PyObject_GetAttrString(data,"grad");
             capi::PyObject_CallObject2(
                 pygrad,
@@ -1679,6 +1926,7 @@ namespace Optizelle {
             Vector & H_dx
         ) const {
             // Call the hessvec function on x, dx, and H_dx.
+            AcquireGIL gil;
             auto hessvec = capi::PyObject_GetAttrString(data,"hessvec");
             capi::PyObject_CallObject3(
                 hessvec,
@@ -1689,6 +1937,41 @@ namespace Optizelle {
                     + ", evaluation of the Hessian-vector product of f failed");
         }
 
+        // H_dxs[j] = hess f(x) dxs[j] for each j.  If the Python function
+        // provides hessvec_many, we pass it all of the directions at once,
+        // which saves trips through the interpreter.
+        void ScalarValuedFunction::hessvec_many(
+            Vector const & x,
+            std::vector <Vector const *> const & dxs,
+            std::vector <Vector *> const & H_dxs
+        ) const {
+            AcquireGIL gil;
+            if(!::PyObject_HasAttrString(data.get(),"hessvec_many")) {
+                Optizelle::ScalarValuedFunction <double,PythonVS>
+                    ::hessvec_many(x,dxs,H_dxs);
+                return;
+            }
+
+            // Pack the directions into lists
+            auto pydxs = capi::PyList_New(0);
+            auto pyH_dxs = capi::PyList_New(0);
+            for(Natural j=0;j<dxs.size();j++) {
+                capi::PyList_Append(pydxs,dxs[j]->data);
+                capi::PyList_Append(pyH_dxs,H_dxs[j]->data);
+            }
+
+            // Call the hessvec_many function on x, dxs, and H_dxs.
+            auto hessvec_many=capi::PyObject_GetAttrString(data,"hessvec_many");
+            capi::PyObject_CallObject3(
+                hessvec_many,
+                x.data,
+                pydxs,
+                pyH_dxs,
+                __LOC__
+                    + ", evaluation of the batched Hessian-vector product of "
+                    "f failed");
+        }
+
         // Create a function 
         VectorValuedFunction::VectorValuedFunction(
             std::string const & name_,
@@ -1704,6 +1987,7 @@ namespace Optizelle {
             VectorValuedFunction::Y_Vector& y
         ) const {
             // Call the evaluate function on x and y.
+            AcquireGIL gil;
             auto eval = capi::PyObject_GetAttrString(data,"eval");
             capi::PyObject_CallObject2(
                 eval,
@@ -1720,6 +2004,7 @@ namespace Optizelle {
             Y_Vector & y
         ) const {
             // Call the prime function on x, dx, and y
+            AcquireGIL gil;
             auto p = capi::PyObject_GetAttrString(data,"p");
             capi::PyObject_CallObject3(
                 p,
@@ -1738,6 +2023,7 @@ namespace Optizelle {
             X_Vector & xhat 
         ) const {
             // Call the prime-adjoint function on x, dy, and z
+            AcquireGIL gil;
             auto ps = capi::PyObject_GetAttrString(data,"ps");
             capi::PyObject_CallObject3(
                 ps,
@@ -1757,6 +2043,7 @@ namespace Optizelle {
             X_Vector & xhat 
         ) const { 
             // Call the prime-adjoint function on x, dx, dy, and z
+            AcquireGIL gil;
             auto pps = capi::PyObject_GetAttrString(data,"pps");
             capi::PyObject_CallObject4(
                 pps,
@@ -2143,6 +2430,11 @@ namespace Optizelle {
                         state.trunc_orthog_storage_max,pystate);
                     toPython::Natural("trunc_orthog_iter_max",
                         state.trunc_orthog_iter_max,pystate);
+                    toPython::Param <TruncatedSolver::t> (
+                        "trunc_solver",
+                        TruncatedSolver::toPython,
+                        state.trunc_solver,
+                        pystate);
                     toPython::Param <TruncatedStop::t> (
                         "trunc_stop",
                         TruncatedStop::toPython,
@@ -2190,6 +2482,8 @@ namespace Optizelle {
                     toPython::Real("delta",state.delta,pystate);
                     toPython::Real("eta1",state.eta1,pystate);
                     toPython::Real("eta2",state.eta2,pystate);
+                    toPython::Natural("trial_radii",
+                        state.trial_radii,pystate);
                     toPython::Real("ared",state.ared,pystate);
                     toPython::Real("pred",state.pred,pystate);
                     toPython::Real("alpha0",state.alpha0,pystate);
@@ -2212,6 +2506,12 @@ namespace Optizelle {
                         LineSearchKind::toPython,
                         state.kind,
                         pystate);
+                    toPython::Natural("ls_points",
+                        state.ls_points,pystate);
+                    toPython::Natural("eval_cache_size",
+                        state.eval_cache_size,pystate);
+                    toPython::Natural("eval_cache_hits",
+                        state.eval_cache_hits,pystate);
                     toPython::Param <FunctionDiagnostics::t> (
                         "f_diag",
                         FunctionDiagnostics::toPython,
@@ -2232,6 +2532,8 @@ namespace Optizelle {
                         DiagnosticScheme::toPython,
                         state.dscheme,
                         pystate);
+                    toPython::Natural("diag_threads",
+                        state.diag_threads,pystate);
                     toPython::Param <ToleranceKind::t> (
                         "eps_kind",
                         ToleranceKind::toPython,
@@ -2278,6 +2580,11 @@ namespace Optizelle {
                         pystate,state.trunc_orthog_storage_max);
                     fromPython::Natural("trunc_orthog_iter_max",
                         pystate,state.trunc_orthog_iter_max);
+                    fromPython::Param <TruncatedSolver::t> (
+                        "trunc_solver",
+                        TruncatedSolver::fromPython,
+                        pystate,
+                        state.trunc_solver);
                     fromPython::Param <TruncatedStop::t> (
                         "trunc_stop",
                         TruncatedStop::fromPython,
@@ -2312,6 +2619,8 @@ namespace Optizelle {
                     fromPython::Vector("dx_old",pystate,state.dx_old);
                     fromPython::VectorList("oldY",pystate,state.x,state.oldY);
                     fromPython::VectorList("oldS",pystate,state.x,state.oldS);
+                    state.innr_oldS_oldS.clear();
+                    state.innr_oldS_oldY.clear();
                     fromPython::Real("f_x",pystate,state.f_x);
                     fromPython::Real("f_xpdx",pystate,state.f_xpdx);
                     fromPython::Natural("msg_level",pystate,state.msg_level);
@@ -2326,6 +2635,8 @@ namespace Optizelle {
                     fromPython::Real("delta",pystate,state.delta);
                     fromPython::Real("eta1",pystate,state.eta1);
                     fromPython::Real("eta2",pystate,state.eta2);
+                    fromPython::Natural("trial_radii",
+                        pystate,state.trial_radii);
                     fromPython::Real("ared",pystate,state.ared);
                     fromPython::Real("pred",pystate,state.pred);
                     fromPython::Real("alpha0",pystate,state.alpha0);
@@ -2348,6 +2659,12 @@ namespace Optizelle {
                         LineSearchKind::fromPython,
                         pystate,
                         state.kind);
+                    fromPython::Natural("ls_points",
+                        pystate,state.ls_points);
+                    fromPython::Natural("eval_cache_size",pystate,
+                        state.eval_cache_size);
+                    fromPython::Natural("eval_cache_hits",pystate,
+                        state.eval_cache_hits);
                     fromPython::Param <FunctionDiagnostics::t> (
                         "f_diag",
                         FunctionDiagnostics::fromPython,
@@ -2368,6 +2685,8 @@ namespace Optizelle {
                         DiagnosticScheme::fromPython,
                         pystate,
                         state.dscheme);
+                    fromPython::Natural("diag_threads",pystate,
+                        state.diag_threads);
                     fromPython::Param <ToleranceKind::t> (
                         "eps_kind",
                         ToleranceKind::fromPython,
@@ -2502,9 +2821,14 @@ namespace Optizelle {
                         pyfns,
                         smanip_);
                    
-                    // Minimize
-                    PyUnconstrained::Algorithms::getMin(
-                        msg,fns,state,smanip);
+                    // Minimize.  We release the GIL while we run the
+                    // algorithm, so other Python threads may run.  Anything
+                    // that calls back into Python reacquires it.
+                    {
+                        ReleaseGIL nogil;
+                        PyUnconstrained::Algorithms::getMin(
+                            msg,fns,state,smanip);
+                    }
                     
                     // Convert the C++ state to a Python state
                     pystate.toPython(state);
@@ -2713,6 +3037,8 @@ namespace Optizelle {
                         state.augsys_iter_max,pystate);
                     toPython::Natural("augsys_rst_freq",
                         state.augsys_rst_freq,pystate);
+                    toPython::Natural("augsys_recycle_max",
+                        state.augsys_recycle_max,pystate);
                     toPython::Natural("augsys_qn_iter",
                         state.augsys_qn_iter,pystate);
                     toPython::Natural("augsys_pg_iter",
@@ -2844,6 +3170,8 @@ namespace Optizelle {
                         pystate,state.augsys_iter_max);
                     fromPython::Natural("augsys_rst_freq",
                         pystate,state.augsys_rst_freq);
+                    fromPython::Natural("augsys_recycle_max",
+                        pystate,state.augsys_recycle_max);
                     fromPython::Natural("augsys_qn_iter",
                         pystate,state.augsys_qn_iter);
                     fromPython::Natural("augsys_pg_iter",
@@ -3073,9 +3401,14 @@ namespace Optizelle {
                         pyfns,
                         smanip_);
                    
-                    // Minimize
-                    PyEqualityConstrained::Algorithms::getMin(
-                        msg,fns,state,smanip);
+                    // Minimize.  We release the GIL while we run the
+                    // algorithm, so other Python threads may run.  Anything
+                    // that calls back into Python reacquires it.
+                    {
+                        ReleaseGIL nogil;
+                        PyEqualityConstrained::Algorithms::getMin(
+                            msg,fns,state,smanip);
+                    }
                     
                     // Convert the C++ state to a Python state
                     pystate.toPython(state);
@@ -3465,9 +3798,14 @@ namespace Optizelle {
                         pyfns,
                         smanip_);
                    
-                    // Minimize
-                    PyInequalityConstrained::Algorithms::getMin(
-                        msg,fns,state,smanip);
+                    // Minimize.  We release the GIL while we run the
+                    // algorithm, so other Python threads may run.  Anything
+                    // that calls back into Python reacquires it.
+                    {
+                        ReleaseGIL nogil;
+                        PyInequalityConstrained::Algorithms::getMin(
+                            msg,fns,state,smanip);
+                    }
                     
                     // Convert the C++ state to a Python state
                     pystate.toPython(state);
@@ -3813,9 +4151,14 @@ namespace Optizelle {
                         pyfns,
                         smanip_);
                    
-                    // Minimize
-                    PyConstrained::Algorithms::getMin(
-                        msg,fns,state,smanip);
+                    // Minimize.  We release the GIL while we run the
+                    // algorithm, so other Python threads may run.  Anything
+                    // that calls back into Python reacquires it.
+                    {
+                        ReleaseGIL nogil;
+                        PyConstrained::Algorithms::getMin(
+                            msg,fns,state,smanip);
+                    }
                     
                     // Convert the C++ state to a Python state
                     pystate.toPython(state);
@@ -4176,6 +4519,10 @@ PyMethodDef methods[] = {
 PyMODINIT_FUNC initUtility() {
     PyObject * m;
 
+    // We release the GIL during the optimization, so make sure that Python
+    // is ready for threads
+    PyEval_InitThreads();
+
     // Initilize the module
     m = Py_InitModule3(
         "Utility",
@@ -106,7 +106,39 @@ namespace Optizelle {
             };
         }
 
-        // Manage the memory and reference counts for raw PyObject pointers 
+        // Holds the global interpreter lock for the life of the object.  We
+        // release the lock while the optimization algorithms run, so anything
+        // that calls into Python must create one of these first.  These nest,
+        // so it's fine to create one when we already hold the lock.
+        struct AcquireGIL {
+        private:
+            PyGILState_STATE state;
+
+        public:
+            NO_COPY_ASSIGNMENT(AcquireGIL)
+            AcquireGIL() : state(PyGILState_Ensure()) {}
+            ~AcquireGIL() {
+                PyGILState_Release(state);
+            }
+        };
+
+        // Releases the global interpreter lock for the life of the object.
+        // This must be created by a thread that holds the lock.
+        struct ReleaseGIL {
+        private:
+            PyThreadState * save;
+
+        public:
+            NO_COPY_ASSIGNMENT(ReleaseGIL)
+            ReleaseGIL() : save(PyEval_SaveThread()) {}
+            ~ReleaseGIL() {
+                PyEval_RestoreThread(save);
+            }
+        };
+
+        // Manage the memory and reference counts for raw PyObject pointers.
+        // Since we may destroy these while the GIL is released, we acquire
+        // it whenever we change a reference count.
         struct PyObjectPtr {
         protected:
             // Internal storage of the pointer
@@ -209,6 +241,12 @@ namespace Optizelle {
 
             // Deep copy of a Python object and return the result
             PyObjectPtr deepcopy(PyObjectPtr const & in);
+
+            // Grabs the memory of an object that exposes a contiguous,
+            // writable buffer of doubles, such as a NumPy array of float64.
+            // We return the number of elements in n.  If the object doesn't
+            // have such a buffer, we return null.
+            double * PyBuffer_AsDoubles(PyObjectPtr const & o,Natural & n);
         
             // Converts an Optizelle enumerated type to a PyObject
             PyObjectPtr enumToPyObject(
@@ -242,6 +280,16 @@ namespace Optizelle {
             // Vector data
             PyObjectPtr data;
 
+            // When the vector space is Optizelle.Rm and the data is a
+            // contiguous array of doubles, we run the vector space operations
+            // on the memory of the array directly rather than calling back
+            // into Python.  In this case, buffer points to this memory and
+            // size holds the number of elements.  Otherwise, buffer is null.
+            // Since we hold a reference to the array, its memory stays put
+            // unless someone resizes it with refcheck=False.
+            double * buffer;
+            Natural size;
+
             // Prevent constructors 
             NO_DEFAULT_COPY_ASSIGNMENT(Vector)
 
@@ -254,6 +302,10 @@ namespace Optizelle {
 
             // Memory allocation and size setting 
             Vector init() const;
+
+            // Determines whether we can operate on the memory of this vector
+            // and x directly
+            bool native(Vector const & x) const;
             
             // y <- x (Shallow.  No memory allocation.)  Internal is y.
             void copy(Vector const & x);
@@ -411,6 +463,7 @@ namespace Optizelle {
                 OptimizationLocation::t const & loc_
             ) const {
                 // Convert the C++ state to a Python state
+                AcquireGIL gil;
                 pystate.toPython(state);
 
                 // Convert the lcoation to Python
@@ -564,6 +617,12 @@ namespace Optizelle {
 
             // H_dx = hess f(x) dx 
             void hessvec(Vector const & x,Vector const & dx,Vector & H_dx)const;
+
+            // H_dxs[j] = hess f(x) dxs[j] for each j
+            void hessvec_many(
+                Vector const & x,
+                std::vector <Vector const *> const & dxs,
+                std::vector <Vector *> const & H_dxs) const;
         };
 
         // A simple vector valued function interface, f : X -> Y
@@ -658,6 +717,7 @@ namespace Optizelle {
             // y = A(x)
             void eval(X_Vector const & x,Y_Vector & y) const {
                 // Convert the state to a Python state
+                AcquireGIL gil;
                 pystate.toPython(state);
 
                 // Apply the operator to the state, x, and y
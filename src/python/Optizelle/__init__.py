@@ -72,7 +72,11 @@ __all__ = [
 __doc__ = "Optizelle optimization library"
 
 class Rm(object):
-    """Vector space for the nonnegative orthant.  For basic vectors in R^m, use this."""
+    """Vector space for the nonnegative orthant.  For basic vectors in R^m, use this.
+
+    When the vectors are contiguous, writable NumPy arrays of float64, the
+    optimization algorithms work on the memory of the arrays directly and
+    don't call the functions below.  Other vectors still use them."""
 
     @staticmethod
     def init(x):
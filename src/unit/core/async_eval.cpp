@@ -0,0 +1,95 @@
+// Solve an equality constrained Rosenbrock problem where the objective
+// evaluates in the background and verify that we follow the same iterates as
+// when it evaluates synchronously.  In addition, verify that we actually
+// evaluate the objective and the constraint at the same time, both with and
+// without the evaluation cache.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include "parallel.h"
+#include "unit.h"
+
+// Define the unit circle
+//
+// g(x,y)= x^2 + y^2 - 1
+//
+struct Circle : public Optizelle::VectorValuedFunction <Real,XX,YY> {
+    typedef YY <Real> Y;
+    typedef typename Y::Vector Y_Vector;
+
+    Tracker const & tracker;
+    Circle(Tracker const & tracker_) : tracker(tracker_) {}
+
+    void eval(X_Vector const & x,Y_Vector & y) const {
+        tracker.enter();
+        y[0]=sq(x[0])+sq(x[1])-1.;
+        tracker.leave();
+    }
+    void p(X_Vector const & x,X_Vector const & dx,Y_Vector & y) const {
+        y[0]=2.*x[0]*dx[0]+2.*x[1]*dx[1];
+    }
+    void ps(X_Vector const & x,Y_Vector const & dy,X_Vector & z) const {
+        z[0]=2.*x[0]*dy[0];
+        z[1]=2.*x[1]*dy[0];
+    }
+    void pps(
+        X_Vector const & x,
+        X_Vector const & dx,
+        Y_Vector const & dy,
+        X_Vector & z
+    ) const {
+        z[0]=2.*dx[0]*dy[0];
+        z[1]=2.*dx[1]*dy[0];
+    }
+};
+
+// Solves the problem and returns the most evaluations that ran at once
+Optizelle::Natural solve(
+    bool const & async,
+    Optizelle::Natural const & eval_cache_size,
+    Optizelle::EqualityConstrained <Real,XX,YY>::State::t & state
+) {
+    Tracker tracker;
+    state.eval_cache_size = eval_cache_size;
+    state.H_type = Optizelle::Operators::UserDefined;
+    state.iter_max = 100;
+    state.msg_level = 0;
+    Optizelle::EqualityConstrained <Real,XX,YY>::Functions::t fns;
+    fns.f.reset(new Rosenbrock(tracker,async));
+    fns.g.reset(new Circle(tracker));
+    Optizelle::EqualityConstrained <Real,XX,YY>::Algorithms::getMin(
+        Optizelle::Messaging::stdout,fns,state);
+    return tracker.peak;
+}
+
+int main(int argc,char* argv[]){
+    // Solve the problem synchronously
+    auto x = X_Vector {0.5, 0.5};
+    auto y = X_Vector {1.};
+    Optizelle::EqualityConstrained <Real,XX,YY>::State::t state0(x,y);
+    CHECK(solve(false,0,state0) == 1);
+    CHECK(state0.opt_stop == Optizelle::OptimizationStop::GradientSmall);
+
+    // Solve the problem while evaluating the objective in the background.
+    // Then, do the same with the evaluation cache.
+    Optizelle::EqualityConstrained <Real,XX,YY>::State::t state1(x,y);
+    auto peak1 = solve(true,0,state1);
+    Optizelle::EqualityConstrained <Real,XX,YY>::State::t state2(x,y);
+    auto peak2 = solve(true,2,state2);
+
+    // We should take the same path to the solution
+    for(auto const & state : {&state1,&state2}) {
+        CHECK(state->opt_stop == state0.opt_stop);
+        CHECK(state->iter == state0.iter);
+        CHECK(state->x == state0.x);
+        CHECK(state->y == state0.y);
+    }
+
+    // The objective should overlap with the constraint
+    CHECK(peak1 > 1);
+    CHECK(peak2 > 1);
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
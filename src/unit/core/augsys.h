@@ -107,6 +107,17 @@ struct Unit {
                 x_hat[1]=dy[0];
             }
 
+            // Sparse Jacobian
+            bool jacobian(
+                X_Vector const & x,
+                Optizelle::SparseMatrix <Real> & J
+            ) const {
+                J.reset(1,2);
+                J.add(0,0,Real(1.));
+                J.add(0,1,Real(1.));
+                return true;
+            }
+
             // x_hat=(g''(x)dx)*dy
             void pps(
                 X_Vector const & x,
@@ -224,6 +235,19 @@ struct Unit {
                 x_hat[1] = Real(2.)*(x[1]-b)*dy[0] + Real(2.)*(x[1]-d)*dy[1];
             }
 
+            // Sparse Jacobian
+            bool jacobian(
+                X_Vector const & x,
+                Optizelle::SparseMatrix <Real> & J
+            ) const {
+                J.reset(2,2);
+                J.add(0,0,Real(2.)*(x[0]-a));
+                J.add(0,1,Real(2.)*(x[1]-b));
+                J.add(1,0,Real(2.)*(x[0]-c));
+                J.add(1,1,Real(2.)*(x[1]-d));
+                return true;
+            }
+
             // x_hat=(g''(x)dx)*dy
             void pps(
                 X_Vector const & x,
@@ -417,6 +441,9 @@ struct Unit {
 
         // Check that we exited the augmented system solve early
         bool check_augsys_exit;
+
+        // Method for solving the augmented systems
+        Optizelle::AugmentedSystemSolver::t augsys_solver;
         
         // Setup some simple parameters
         Augsys(X_Vector const & x_,Y_Vector const & y_) :
@@ -430,7 +457,8 @@ struct Unit {
             delta(1e16),
             do_diagnostics(false),
             check_augsys(false),
-            check_augsys_exit(false)
+            check_augsys_exit(false),
+            augsys_solver(Optizelle::AugmentedSystemSolver::GMRES)
         {
             X::copy(x_,x); 
             Y::copy(y_,y);
@@ -526,6 +554,7 @@ struct Unit {
 
         // Set some appropriate state information
         state.delta = setup.delta;
+        state.augsys_solver = setup.augsys_solver;
 
         // Create a bundle of functions
         typename Optizelle::Constrained <Real,XX,YY,ZZ>::Functions::t fns;
@@ -696,6 +725,7 @@ struct Unit {
         // Create an optimization state
         typename Optizelle::EqualityConstrained <Real,XX,YY>::State::t
             state(setup.x,setup.y);
+        state.augsys_solver = setup.augsys_solver;
 
         // Create a bundle of functions
         typename Optizelle::Constrained <Real,XX,YY,ZZ>::Functions::t fns;
@@ -0,0 +1,108 @@
+// Run the finite difference diagnostics with several threads and verify that
+// we obtain the same table of errors as running them with a single thread.
+// When we have OpenMP, we also verify that the function evaluations overlap.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include "parallel.h"
+#include "unit.h"
+
+// Define a simple equality
+//
+// g(x,y)= [ x^2 + y ; x y^3 ]
+//
+struct Equality : public Optizelle::VectorValuedFunction <Real,XX,YY> {
+    typedef YY <Real> Y;
+    typedef typename Y::Vector Y_Vector;
+
+    Tracker const & tracker;
+    Equality(Tracker const & tracker_) : tracker(tracker_) {}
+
+    void eval(X_Vector const & x,Y_Vector & y) const {
+        tracker.enter();
+        y[0]=sq(x[0])+x[1];
+        y[1]=x[0]*x[1]*sq(x[1]);
+        tracker.leave();
+    }
+    void p(X_Vector const & x,X_Vector const & dx,Y_Vector & y) const {
+        y[0]=2.*x[0]*dx[0]+dx[1];
+        y[1]=x[1]*sq(x[1])*dx[0]+3.*x[0]*sq(x[1])*dx[1];
+    }
+    void ps(X_Vector const & x,Y_Vector const & dy,X_Vector & z) const {
+        tracker.enter();
+        z[0]=2.*x[0]*dy[0]+x[1]*sq(x[1])*dy[1];
+        z[1]=dy[0]+3.*x[0]*sq(x[1])*dy[1];
+        tracker.leave();
+    }
+    void pps(
+        X_Vector const & x,
+        X_Vector const & dx,
+        Y_Vector const & dy,
+        X_Vector & z
+    ) const {
+        z[0]=2.*dx[0]*dy[0]+3.*sq(x[1])*dx[1]*dy[1];
+        z[1]=3.*sq(x[1])*dx[0]*dy[1]+6.*x[0]*x[1]*dx[1]*dy[1];
+    }
+};
+
+// Checks that two tables hold the same errors
+void same(
+    Optizelle::Diagnostics::FiniteDifferenceTable <Real> const & a,
+    Optizelle::Diagnostics::FiniteDifferenceTable <Real> const & b
+) {
+    CHECK(a.title == b.title);
+    CHECK(a.rel_errs.size() == a.epsilons.size());
+    CHECK(a.rel_errs == b.rel_errs);
+    CHECK(a.min_rel_err == b.min_rel_err);
+    CHECK(a.min_rel_err < Real(1e-6));
+}
+
+int main() {
+    // Setup the problem
+    auto x = X_Vector {1.2,2.3};
+    auto dx = X_Vector {0.3,-0.7};
+    auto dy = X_Vector {-0.5,0.9};
+    Tracker f_tracker;
+    Rosenbrock f(f_tracker);
+    Tracker g_tracker;
+    Equality g(g_tracker);
+    auto threads = Optizelle::Natural(4);
+
+    // Check f with one and then several threads
+    auto grad1 = Optizelle::Diagnostics::gradientCheck <Real,XX> (
+        f,x,dx,"f");
+    auto hess1 = Optizelle::Diagnostics::hessianCheck <Real,XX> (
+        f,x,dx,"f");
+    CHECK(f_tracker.peak == 1);
+    f_tracker.evals = 0;
+    auto grad = Optizelle::Diagnostics::gradientCheck <Real,XX> (
+        f,x,dx,"f",threads);
+    auto hess = Optizelle::Diagnostics::hessianCheck <Real,XX> (
+        f,x,dx,"f",threads);
+    same(grad,grad1);
+    same(hess,hess1);
+    CHECK(f_tracker.evals == 8*grad.epsilons.size()+1);
+
+    // Check g with one and then several threads
+    auto deriv1 = Optizelle::Diagnostics::derivativeCheck <Real,XX,YY> (
+        g,x,dx,dy,"g");
+    auto second1 = Optizelle::Diagnostics::secondDerivativeCheck<Real,XX,YY>(
+        g,x,dx,dy,"g");
+    CHECK(g_tracker.peak == 1);
+    auto deriv = Optizelle::Diagnostics::derivativeCheck <Real,XX,YY> (
+        g,x,dx,dy,"g",threads);
+    auto second = Optizelle::Diagnostics::secondDerivativeCheck<Real,XX,YY>(
+        g,x,dx,dy,"g",threads);
+    same(deriv,deriv1);
+    same(second,second1);
+
+    // Make sure that we actually ran the evaluations together
+    #ifdef _OPENMP
+    CHECK(f_tracker.peak > 1);
+    CHECK(g_tracker.peak > 1);
+    #endif
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
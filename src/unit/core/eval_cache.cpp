@@ -0,0 +1,150 @@
+// Solve the Rosenbrock function with and without the evaluation cache and
+// verify that we follow the same iterates, but that the cache avoids calling
+// the objective and that it counts each avoided evaluation.  The diagnostics
+// at the start of each iteration ask again for the gradient at the iterate,
+// so these are the evaluations that we expect to avoid.  We also verify
+// that the cache for the constraints recognizes points that it remembers and
+// forgets the least recently used one.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include "unit.h"
+
+// Squares its input
+template <typename Real>
+Real sq(Real x){
+    return x*x; 
+}
+
+// Define the Rosenbrock function where
+// 
+// f(x,y)=(1-x)^2+100(y-x^2)^2
+//
+struct Rosenbrock : public Optizelle::ScalarValuedFunction <Real,XX> {
+    Optizelle::Natural & evals;
+    Rosenbrock(Optizelle::Natural & evals_) : evals(evals_) {}
+
+    Real eval(X_Vector const & x) const {
+        evals++;
+        return sq(1.-x[0])+100.*sq(x[1]-sq(x[0]));
+    }
+    void grad(X_Vector const & x,X_Vector & grad) const {
+        evals++;
+        grad[0]=-400.*x[0]*(x[1]-sq(x[0]))-2.*(1.-x[0]);
+        grad[1]=200.*(x[1]-sq(x[0]));
+    }
+    void hessvec(X_Vector const & x,X_Vector const & dx,X_Vector & H_dx)
+        const
+    {
+        H_dx[0]=(1200.*sq(x[0])-400.*x[1]+2)*dx[0]-400.*x[0]*dx[1];
+        H_dx[1]=-400.*x[0]*dx[0]+200.*dx[1];
+    }
+};
+
+// Define a simple equality
+//
+// g(x,y)= [ x^2 + y ; x y^3 ]
+//
+struct Equality : public Optizelle::VectorValuedFunction <Real,XX,YY> {
+    typedef YY <Real> Y;
+    typedef typename Y::Vector Y_Vector;
+
+    Optizelle::Natural & evals;
+    Equality(Optizelle::Natural & evals_) : evals(evals_) {}
+
+    void eval(X_Vector const & x,Y_Vector & y) const {
+        evals++;
+        y[0]=sq(x[0])+x[1];
+        y[1]=x[0]*x[1]*sq(x[1]);
+    }
+    void p(X_Vector const & x,X_Vector const & dx,Y_Vector & y) const {
+        y[0]=2.*x[0]*dx[0]+dx[1];
+        y[1]=x[1]*sq(x[1])*dx[0]+3.*x[0]*sq(x[1])*dx[1];
+    }
+    void ps(X_Vector const & x,Y_Vector const & dy,X_Vector & z) const {
+        z[0]=2.*x[0]*dy[0]+x[1]*sq(x[1])*dy[1];
+        z[1]=dy[0]+3.*x[0]*sq(x[1])*dy[1];
+    }
+    void pps(
+        X_Vector const & x,
+        X_Vector const & dx,
+        Y_Vector const & dy,
+        X_Vector & z
+    ) const {
+        z[0]=2.*dx[0]*dy[0]+3.*sq(x[1])*dx[1]*dy[1];
+        z[1]=3.*sq(x[1])*dx[0]*dy[1]+6.*x[0]*x[1]*dx[1]*dy[1];
+    }
+};
+
+// Solves the Rosenbrock problem with a cache of the given size and returns
+// the number of evaluations of the objective and its gradient
+Optizelle::Natural solve(
+    Optizelle::Natural const & eval_cache_size,
+    Optizelle::Unconstrained <Real,XX>::State::t & state
+) {
+    auto evals = Optizelle::Natural(0);
+    state.eval_cache_size = eval_cache_size;
+    state.H_type = Optizelle::Operators::UserDefined;
+    state.iter_max = 50;
+    state.msg_level = 0;
+    state.f_diag = Optizelle::FunctionDiagnostics::FirstOrder;
+    state.dscheme = Optizelle::DiagnosticScheme::EveryIteration;
+    Optizelle::Unconstrained <Real,XX>::Functions::t fns;
+    fns.f.reset(new Rosenbrock(evals));
+    Optizelle::Unconstrained <Real,XX>::Algorithms::getMin(
+        Optizelle::Messaging::stdout,fns,state);
+    return evals;
+}
+
+int main(int argc,char* argv[]){
+    // Solve the problem with and without the cache
+    auto x = X_Vector {-1.2, 1.};
+    Optizelle::Unconstrained <Real,XX>::State::t state0(x);
+    auto evals0 = solve(0,state0);
+    Optizelle::Unconstrained <Real,XX>::State::t state(x);
+    auto evals = solve(2,state);
+
+    // We should take the same path to the solution
+    CHECK(state.opt_stop == state0.opt_stop);
+    CHECK(state.iter == state0.iter);
+    CHECK(state.x == state0.x);
+    CHECK(state0.eval_cache_hits == 0);
+
+    // Each call that the cache answered is one fewer call to the objective
+    CHECK(state.eval_cache_hits > 0);
+    CHECK(evals + state.eval_cache_hits == evals0);
+
+    // Remember the equality constraint at two points
+    auto g_evals = Optizelle::Natural(0);
+    auto hits = Optizelle::Natural(0);
+    Optizelle::CachedVectorValuedFunction <Real,XX,YY> g(
+        std::make_unique <Equality> (g_evals),2,hits);
+    auto x1 = X_Vector {1.2, 2.3};
+    auto x2 = X_Vector {-0.5, 0.9};
+    auto x3 = X_Vector {0.1, 0.2};
+    auto y = X_Vector(2);
+    auto y1 = X_Vector(2);
+    Equality(g_evals).eval(x1,y1);
+    g_evals = 0;
+
+    // Evaluate at x1, x2, and then x1 again, which we remember
+    g.eval(x1,y);
+    g.eval(x2,y);
+    g.eval(x1,y);
+    CHECK(y == y1);
+    CHECK(g_evals == 2);
+    CHECK(hits == 1);
+
+    // Evaluating at x3 forgets x2, but not x1 since we used it more recently
+    g.eval(x3,y);
+    g.eval(x1,y);
+    CHECK(g_evals == 3);
+    CHECK(hits == 2);
+    g.eval(x2,y);
+    CHECK(g_evals == 4);
+    CHECK(hits == 2);
+
+    // Declare success 
+    return EXIT_SUCCESS;
+}
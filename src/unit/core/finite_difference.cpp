@@ -0,0 +1,202 @@
+// Approximate second derivatives with the finite difference adapters and
+// verify them against the exact derivatives.  For the sparse adapters, we
+// also verify that a whole Hessian or Jacobian costs one evaluation per color
+// of its sparsity pattern plus one at the base point, and that we reuse it
+// while x stays the same.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "optizelle/finite_difference.h"
+#include "spaces.h"
+#include "unit.h"
+
+// Size of the problem
+auto const n = Optizelle::Natural(10);
+
+// Define the chained function
+//
+// f(x) = sum_i x_i^4 + sum_i x_i x_{i+1}
+//
+// whose Hessian is tridiagonal
+template <typename Base>
+struct Chained : public Base {
+    mutable Optizelle::Natural grads;
+    template <typename... Args>
+    Chained(Args &&... args) : Base(std::forward <Args> (args)...), grads(0)
+    {}
+
+    Real eval(X_Vector const & x) const {
+        auto f = Real(0.);
+        for(Optizelle::Natural i=0;i<n;i++)
+            f += x[i]*x[i]*x[i]*x[i];
+        for(Optizelle::Natural i=0;i+1<n;i++)
+            f += x[i]*x[i+1];
+        return f;
+    }
+    void grad(X_Vector const & x,X_Vector & grad) const {
+        grads++;
+        for(Optizelle::Natural i=0;i<n;i++)
+            grad[i] = 4.*x[i]*x[i]*x[i];
+        for(Optizelle::Natural i=0;i+1<n;i++) {
+            grad[i] += x[i+1];
+            grad[i+1] += x[i];
+        }
+    }
+};
+
+// Exact Hessian-vector product of the chained function
+void hessvec(X_Vector const & x,X_Vector const & dx,X_Vector & H_dx) {
+    for(Optizelle::Natural i=0;i<n;i++)
+        H_dx[i] = 12.*x[i]*x[i]*dx[i];
+    for(Optizelle::Natural i=0;i+1<n;i++) {
+        H_dx[i] += dx[i+1];
+        H_dx[i+1] += dx[i];
+    }
+}
+
+// Define the constraint g : R^n -> R^(n-1) where
+//
+// g_i(x) = x_i^2 x_{i+1} - 1
+//
+// whose Jacobian is upper bidiagonal
+template <typename Base>
+struct Bidiagonal : public Base {
+    mutable Optizelle::Natural evals;
+    template <typename... Args>
+    Bidiagonal(Args &&... args) : Base(std::forward <Args> (args)...), evals(0)
+    {}
+
+    void eval(X_Vector const & x,X_Vector & y) const {
+        evals++;
+        for(Optizelle::Natural i=0;i+1<n;i++)
+            y[i] = x[i]*x[i]*x[i+1]-1.;
+    }
+    void ps(X_Vector const & x,X_Vector const & dy,X_Vector & z) const {
+        X::zero(z);
+        for(Optizelle::Natural i=0;i+1<n;i++) {
+            z[i] += 2.*x[i]*x[i+1]*dy[i];
+            z[i+1] += x[i]*x[i]*dy[i];
+        }
+    }
+};
+
+// Exact derivatives of the constraint
+void p(X_Vector const & x,X_Vector const & dx,X_Vector & y) {
+    for(Optizelle::Natural i=0;i+1<n;i++)
+        y[i] = 2.*x[i]*x[i+1]*dx[i]+x[i]*x[i]*dx[i+1];
+}
+void pps(
+    X_Vector const & x,
+    X_Vector const & dx,
+    X_Vector const & dy,
+    X_Vector & z
+) {
+    X::zero(z);
+    for(Optizelle::Natural i=0;i+1<n;i++) {
+        z[i] += (2.*x[i+1]*dx[i]+2.*x[i]*dx[i+1])*dy[i];
+        z[i+1] += 2.*x[i]*dx[i]*dy[i];
+    }
+}
+
+// Relative error between two vectors
+Real rel_err(X_Vector const & x,X_Vector const & y) {
+    auto r = X::init(x);
+    X::copy(x,r);
+    X::axpy(Real(-1.),y,r);
+    return std::sqrt(X::innr(r,r)/X::innr(y,y));
+}
+
+int main() {
+    // Setup the point and directions
+    auto x = X_Vector(n);
+    auto dx = X_Vector(n);
+    auto dy = X_Vector(n-1);
+    for(Optizelle::Natural i=0;i<n;i++) {
+        x[i] = 1.+0.1*i;
+        dx[i] = i%3 ? 0.5 : -1.;
+    }
+    for(Optizelle::Natural i=0;i+1<n;i++)
+        dy[i] = i%2 ? 1. : -0.25;
+    auto tol = Real(1e-5);
+
+    // Exact derivatives
+    auto H_dx = X_Vector(n);
+    hessvec(x,dx,H_dx);
+    auto p_dx = X_Vector(n-1);
+    p(x,dx,p_dx);
+    auto pps_dx_dy = X_Vector(n);
+    pps(x,dx,dy,pps_dx_dy);
+
+    // Hessian-vector products from a finite difference on the gradient.
+    // After the first product, we reuse the gradient at x.
+    Chained <Optizelle::FiniteDifferenceHessian <Real,XX> > fd;
+    auto fd_H_dx = X_Vector(n);
+    fd.hessvec(x,dx,fd_H_dx);
+    CHECK(rel_err(fd_H_dx,H_dx) < tol);
+    CHECK(fd.grads == 2);
+    fd.hessvec(x,dx,fd_H_dx);
+    CHECK(fd.grads == 3);
+
+    // Sparse Hessian from a tridiagonal pattern where we only give the
+    // diagonal and the superdiagonal
+    auto is = std::vector <Optizelle::Natural> ();
+    auto js = std::vector <Optizelle::Natural> ();
+    for(Optizelle::Natural i=0;i<n;i++) {
+        is.emplace_back(i);
+        js.emplace_back(i);
+        if(i+1<n) {
+            is.emplace_back(i);
+            js.emplace_back(i+1);
+        }
+    }
+    Chained <Optizelle::SparseFiniteDifferenceHessian <Real> > sfd(n,is,js);
+    CHECK(sfd.ncolors() == 3);
+    sfd.hessvec(x,dx,fd_H_dx);
+    CHECK(rel_err(fd_H_dx,H_dx) < tol);
+    CHECK(sfd.grads == sfd.ncolors()+1);
+    sfd.hessvec(x,x,fd_H_dx);
+    CHECK(sfd.grads == sfd.ncolors()+1);
+
+    // Derivative and second derivative adjoint from finite differences of
+    // the function and its adjoint derivative
+    Bidiagonal <Optizelle::FiniteDifferenceDerivative <Real,XX,YY> > gfd;
+    auto fd_p_dx = X_Vector(n-1);
+    gfd.p(x,dx,fd_p_dx);
+    CHECK(rel_err(fd_p_dx,p_dx) < tol);
+    CHECK(gfd.evals == 2);
+    auto fd_pps_dx_dy = X_Vector(n);
+    gfd.pps(x,dx,dy,fd_pps_dx_dy);
+    CHECK(rel_err(fd_pps_dx_dy,pps_dx_dy) < tol);
+
+    // Sparse Jacobian from a bidiagonal pattern
+    is.clear();
+    js.clear();
+    for(Optizelle::Natural i=0;i+1<n;i++) {
+        is.emplace_back(i);
+        js.emplace_back(i);
+        is.emplace_back(i);
+        js.emplace_back(i+1);
+    }
+    Bidiagonal <Optizelle::SparseFiniteDifferenceJacobian <Real> > sgfd(
+        n-1,n,is,js);
+    CHECK(sgfd.ncolors() == 2);
+    sgfd.p(x,dx,fd_p_dx);
+    CHECK(rel_err(fd_p_dx,p_dx) < tol);
+    CHECK(sgfd.evals == sgfd.ncolors()+1);
+    auto fd_ps_dy = X_Vector(n);
+    sgfd.ps(x,dy,fd_ps_dy);
+    auto ps_dy = X_Vector(n);
+    gfd.ps(x,dy,ps_dy);
+    CHECK(rel_err(fd_ps_dy,ps_dy) < tol);
+    CHECK(sgfd.evals == sgfd.ncolors()+1);
+    sgfd.pps(x,dx,dy,fd_pps_dx_dy);
+    CHECK(rel_err(fd_pps_dx_dy,pps_dx_dy) < Real(1e-4));
+
+    // The Jacobian also feeds the direct augmented system solver
+    auto J = Optizelle::SparseMatrix <Real> ();
+    CHECK(sgfd.jacobian(x,J));
+    CHECK(J.m == n-1 && J.n == n && J.vals.size() == is.size());
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
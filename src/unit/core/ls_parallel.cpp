@@ -0,0 +1,118 @@
+// Solve the Rosenbrock function with a backtracking line-search that
+// evaluates several step lengths at once and verify that we take the same
+// steps as the usual backtracking line-search.  We also change the base
+// step length or the direction after each rejection from a state manipulator,
+// which should discard the objective values that we computed ahead of time.
+// When we have OpenMP, we also verify that the objective evaluations overlap.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include "parallel.h"
+#include "unit.h"
+
+// Shrinks the base step length after each rejected step
+struct Shrink : public Optizelle::StateManipulator <
+    Optizelle::Unconstrained <Real,XX> >
+{
+    void eval(
+        Optizelle::Unconstrained <Real,XX>::Functions::t const & fns,
+        Optizelle::Unconstrained <Real,XX>::State::t & state,
+        Optizelle::OptimizationLocation::t const & loc
+    ) const {
+        if(loc==Optizelle::OptimizationLocation::AfterRejectedLineSearch)
+            state.alpha0 *= Real(0.75);
+    }
+};
+
+// Bends the direction after each rejected step
+struct Bend : public Optizelle::StateManipulator <
+    Optizelle::Unconstrained <Real,XX> >
+{
+    void eval(
+        Optizelle::Unconstrained <Real,XX>::Functions::t const & fns,
+        Optizelle::Unconstrained <Real,XX>::State::t & state,
+        Optizelle::OptimizationLocation::t const & loc
+    ) const {
+        if(loc==Optizelle::OptimizationLocation::AfterRejectedLineSearch)
+            state.dx[1] *= Real(0.75);
+    }
+};
+
+// Solves the problem with the given line-search
+void solve(
+    Optizelle::LineSearchKind::t const & kind,
+    Optizelle::StateManipulator <Optizelle::Unconstrained <Real,XX> > const &
+        smanip,
+    Optizelle::Unconstrained <Real,XX>::State::t & state,
+    Tracker & tracker
+) {
+    state.algorithm_class = Optizelle::AlgorithmClass::LineSearch;
+    state.dir = Optizelle::LineSearchDirection::NewtonCG;
+    state.H_type = Optizelle::Operators::UserDefined;
+    state.kind = kind;
+    state.ls_points = 4;
+    state.iter_max = 200;
+    state.msg_level = 0;
+    Tracker grads;
+    Optizelle::Unconstrained <Real,XX>::Functions::t fns;
+    fns.f.reset(new Rosenbrock(tracker,grads));
+    Optizelle::Unconstrained <Real,XX>::Algorithms::getMin(
+        Optizelle::Messaging::stdout,fns,state,smanip);
+}
+
+int main(int argc,char* argv[]){
+    // Solve the problem with both line-searches
+    auto x = X_Vector {-1.2, 1.};
+    Optizelle::EmptyManipulator <Optizelle::Unconstrained <Real,XX> > empty;
+    Tracker f1;
+    Optizelle::Unconstrained <Real,XX>::State::t state1(x);
+    solve(Optizelle::LineSearchKind::BackTracking,empty,state1,f1);
+    Tracker f;
+    Optizelle::Unconstrained <Real,XX>::State::t state(x);
+    solve(Optizelle::LineSearchKind::ParallelBackTracking,empty,state,f);
+
+    // Make sure that we backtracked
+    CHECK(state1.opt_stop == Optizelle::OptimizationStop::GradientSmall);
+    CHECK(state1.glob_iter_total > state1.iter);
+    CHECK(f1.peak == 1);
+
+    // We should take exactly the same steps
+    CHECK(state.opt_stop == state1.opt_stop);
+    CHECK(state.iter == state1.iter);
+    CHECK(state.glob_iter_total == state1.glob_iter_total);
+    CHECK(state.x == state1.x);
+
+    // We evaluate the objective at extra step lengths
+    CHECK(f.evals > f1.evals);
+    CHECK(state.ls_iter_total == f.evals-1);
+
+    // Make sure that we actually ran the evaluations together
+    #ifdef _OPENMP
+    CHECK(f.peak > 1);
+    #endif
+
+    // Change the base step length or the direction after each rejection and
+    // make sure that we still take the same steps
+    Shrink shrink;
+    Bend bend;
+    for(auto smanip : std::vector <Optizelle::StateManipulator <
+        Optizelle::Unconstrained <Real,XX> > const *> {&shrink,&bend}
+    ) {
+        Tracker g1;
+        Optizelle::Unconstrained <Real,XX>::State::t state2(x);
+        solve(Optizelle::LineSearchKind::BackTracking,*smanip,state2,g1);
+        Tracker g;
+        Optizelle::Unconstrained <Real,XX>::State::t state3(x);
+        solve(Optizelle::LineSearchKind::ParallelBackTracking,*smanip,state3,
+            g);
+        CHECK(state2.glob_iter_total > state2.iter);
+        CHECK(state3.opt_stop == state2.opt_stop);
+        CHECK(state3.iter == state2.iter);
+        CHECK(state3.glob_iter_total == state2.glob_iter_total);
+        CHECK(state3.x == state2.x);
+    }
+
+    // Declare success 
+    return EXIT_SUCCESS;
+}
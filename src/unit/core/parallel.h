@@ -0,0 +1,87 @@
+#pragma once
+// Supporting functions for testing the evaluations that we run at the same
+// time
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+// Grab the squaring function
+using Optizelle::sq;
+
+// Tracks the number of evaluations and how many run at once
+struct Tracker {
+    mutable std::atomic <Optizelle::Natural> active;
+    mutable std::atomic <Optizelle::Natural> peak;
+    mutable std::atomic <Optizelle::Natural> evals;
+    Tracker() : active(0), peak(0), evals(0) {}
+
+    // Marks the start of an evaluation and gives other threads a chance to
+    // start theirs
+    void enter() const {
+        auto now = ++active;
+        auto old = peak.load();
+        while(old < now && !peak.compare_exchange_weak(old,now));
+        evals++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Marks the end of an evaluation
+    void leave() const {
+        active--;
+    }
+};
+
+// Define the Rosenbrock function where
+//
+// f(x,y)=(1-x)^2+100(y-x^2)^2
+//
+// We track the evaluations of the function and its gradient separately, when
+// asked.  When async is true, we evaluate both in the background.
+struct Rosenbrock : public Optizelle::ScalarValuedFunction <Real,XX> {
+    Tracker const & f_tracker;
+    Tracker const & grad_tracker;
+    bool async;
+    Rosenbrock(
+        Tracker const & f_tracker_,
+        Tracker const & grad_tracker_,
+        bool const & async_=false
+    ) : f_tracker(f_tracker_), grad_tracker(grad_tracker_), async(async_) {}
+    Rosenbrock(Tracker const & tracker_,bool const & async_=false) :
+        Rosenbrock(tracker_,tracker_,async_) {}
+
+    Real eval(X_Vector const & x) const {
+        f_tracker.enter();
+        auto f = sq(1.-x[0])+100.*sq(x[1]-sq(x[0]));
+        f_tracker.leave();
+        return f;
+    }
+    void grad(X_Vector const & x,X_Vector & grad) const {
+        grad_tracker.enter();
+        grad[0]=-400.*x[0]*(x[1]-sq(x[0]))-2.*(1.-x[0]);
+        grad[1]=200.*(x[1]-sq(x[0]));
+        grad_tracker.leave();
+    }
+    void hessvec(X_Vector const & x,X_Vector const & dx,X_Vector & H_dx)
+        const
+    {
+        H_dx[0]=(1200.*sq(x[0])-400.*x[1]+2)*dx[0]-400.*x[0]*dx[1];
+        H_dx[1]=-400.*x[0]*dx[0]+200.*dx[1];
+    }
+    std::future <Real> eval_async(X_Vector const & x) const {
+        if(!async)
+            return ScalarValuedFunction::eval_async(x);
+        return std::async(std::launch::async,
+            [this,&x]() { return eval(x); });
+    }
+    std::future <void> grad_async(X_Vector const & x,X_Vector & grad) const {
+        if(!async)
+            return ScalarValuedFunction::grad_async(x,grad);
+        return std::async(std::launch::async,
+            [this,&x,&grad]() { this->grad(x,grad); });
+    }
+};
@@ -0,0 +1,124 @@
+// Test that when we solve for the equality multiplier, we solve the augmented
+// system for the quasinormal Newton step at the same time and that the
+// quasinormal step then uses this solution.  Here, we find the intersection of
+// two circles where the first has the center at (1,0) and the second has the
+// center at (1,1).  The intersection occurs at (1+-sqrt(3)/2,1/2).
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "augsys.h"
+#include "spaces.h"
+
+// Counts the number of times that we apply the derivative of the constraint to
+// more than one direction at once as well as to a single direction
+struct Counted : public Unit <Real>::Constraint::CircleIntersection {
+    typedef Unit <Real>::Y_Vector Y_Vector;
+    mutable Optizelle::Natural batches;
+    mutable Optizelle::Natural applications;
+    Counted() :
+        CircleIntersection(1.,0.,1.,1.), batches(0), applications(0)
+    {}
+    void p(
+        X_Vector const & x,
+        X_Vector const & dx,
+        Y_Vector & y
+    ) const {
+        applications++;
+        CircleIntersection::p(x,dx,y);
+    }
+    void ps(
+        X_Vector const & x,
+        Y_Vector const & dy,
+        X_Vector & z
+    ) const {
+        applications++;
+        CircleIntersection::ps(x,dy,z);
+    }
+    void p_many(
+        X_Vector const & x,
+        std::vector <X_Vector const *> const & dxs,
+        std::vector <Y_Vector *> const & ys
+    ) const {
+        batches += dxs.size() > 1;
+        CircleIntersection::p_many(x,dxs,ys);
+    }
+    void ps_many(
+        X_Vector const & x,
+        std::vector <Y_Vector const *> const & dys,
+        std::vector <X_Vector *> const & zs
+    ) const {
+        batches += dys.size() > 1;
+        CircleIntersection::ps_many(x,dys,zs);
+    }
+};
+
+// Sets up the problem and caches information about the constraint
+void setup(
+    Optizelle::Constrained <Real,XX,YY,XX>::State::t & state,
+    Optizelle::Constrained <Real,XX,YY,XX>::Functions::t & fns,
+    Counted * & g
+) {
+    g = new Counted;
+    fns.f.reset(new Unit <Real>::Objective::Quadratic);
+    fns.g.reset(g);
+    auto lb = X_Vector {-1e6,-1e6};
+    auto ub = X_Vector {1e6,1e6};
+    fns.h.reset(new Unit <Real>::Constraint::Box(lb,ub));
+    Optizelle::Constrained <Real,XX,YY,XX>::Functions::init(state,fns);
+    state.delta = 1e16;
+    fns.f->grad(state.x,state.grad);
+    fns.g->eval(state.x,state.g_x);
+    state.norm_gxtyp = std::sqrt(X::innr(state.g_x,state.g_x));
+    auto gps_g = X::init(state.x);
+    fns.g->ps(state.x,state.g_x,gps_g);
+    state.norm_gpsgxtyp = std::sqrt(X::innr(gps_g,gps_g));
+    fns.h->eval(state.x,state.h_x);
+}
+
+int main(int argc,char* argv[]){
+    // Generate an initial guess
+    auto x = X_Vector { 0., 0. };
+    auto y = X_Vector { 0., 0. };
+    auto z = X_Vector { 1., 1., 1., 1. };
+
+    // Find the quasinormal step on its own
+    Optizelle::Constrained <Real,XX,YY,XX>::State::t state1(x,y,z);
+    Optizelle::Constrained <Real,XX,YY,XX>::Functions::t fns1;
+    Counted * g1;
+    setup(state1,fns1,g1);
+    Optizelle::EqualityConstrained<Real,XX,YY>::Algorithms::quasinormalStep(
+        fns1,state1);
+    CHECK(state1.qn_stop == Optizelle::QuasinormalStop::Newton);
+    CHECK(g1->batches == 0);
+
+    // Find the equality multiplier and then the quasinormal step
+    Optizelle::Constrained <Real,XX,YY,XX>::State::t state(x,y,z);
+    Optizelle::Constrained <Real,XX,YY,XX>::Functions::t fns;
+    Counted * g;
+    setup(state,fns,g);
+    Optizelle::EqualityConstrained<Real,XX,YY>::Algorithms
+        ::findEqualityMultiplier(fns,state);
+    CHECK(g->batches > 0);
+    CHECK(state.augsys_qn_ahead.size() == 2);
+    auto batches = g->batches;
+    auto applications = g->applications;
+    Optizelle::EqualityConstrained<Real,XX,YY>::Algorithms::quasinormalStep(
+        fns,state);
+
+    // We should have used the solution that we found ahead of time and found
+    // the same step.  Since we saved the Cauchy point and right hand side, we
+    // shouldn't apply the derivative of the constraint again.
+    CHECK(g->batches == batches);
+    CHECK(g->applications == applications);
+    CHECK(state.augsys_qn_ahead.size() == 0);
+    CHECK(state.qn_stop == state1.qn_stop);
+    CHECK(state.augsys_qn_iter == state1.augsys_qn_iter);
+    CHECK(state.augsys_qn_err_target == state1.augsys_qn_err_target);
+    auto err = Real(0.);
+    auto norm_dxn = Real(0.);
+    std::tie(err,norm_dxn) = Unit <Real>::error(state.dx_n,state1.dx_n);
+    CHECK(err <= Real(1e-12)*norm_dxn);
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+// Solve the Rosenbrock function while trying several trust-region radii at
+// once and verify that we take the same steps as trying one radius at a
+// time.  We start with a large trust-region, so that we reject steps, and we
+// try this with both the dogleg and GLTR subproblem solves.  We also shrink
+// the trust-region further after each rejection from a state manipulator,
+// which should discard the trial steps that we computed ahead of time.  When
+// we have OpenMP, we also verify that the objective evaluations overlap.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include "parallel.h"
+#include "unit.h"
+
+// Shrinks the trust-region radius after each rejected step
+struct Shrink : public Optizelle::StateManipulator <
+    Optizelle::Unconstrained <Real,XX> >
+{
+    void eval(
+        Optizelle::Unconstrained <Real,XX>::Functions::t const & fns,
+        Optizelle::Unconstrained <Real,XX>::State::t & state,
+        Optizelle::OptimizationLocation::t const & loc
+    ) const {
+        if(loc==Optizelle::OptimizationLocation::AfterRejectedTrustRegion)
+            state.delta *= Real(0.75);
+    }
+};
+
+// Solves the problem with the given subproblem solver and number of radii
+void solve(
+    Optizelle::TruncatedSolver::t const & trunc_solver,
+    Optizelle::Natural const & trial_radii,
+    Optizelle::StateManipulator <Optizelle::Unconstrained <Real,XX> > const &
+        smanip,
+    Optizelle::Unconstrained <Real,XX>::State::t & state,
+    Tracker & tracker
+) {
+    state.H_type = Optizelle::Operators::UserDefined;
+    state.trunc_solver = trunc_solver;
+    state.trial_radii = trial_radii;
+    state.delta = 100.;
+    state.iter_max = 100;
+    state.msg_level = 0;
+    Tracker grads;
+    Optizelle::Unconstrained <Real,XX>::Functions::t fns;
+    fns.f.reset(new Rosenbrock(tracker,grads));
+    Optizelle::Unconstrained <Real,XX>::Algorithms::getMin(
+        Optizelle::Messaging::stdout,fns,state,smanip);
+}
+
+int main(int argc,char* argv[]){
+    auto x = X_Vector {-1.2, 1.};
+    for(auto trunc_solver : {
+        Optizelle::TruncatedSolver::ConjugateGradient,
+        Optizelle::TruncatedSolver::Lanczos
+    }) {
+        // Solve the problem trying one radius and then four radii at once
+        Optizelle::EmptyManipulator <Optizelle::Unconstrained <Real,XX> >
+            empty;
+        Tracker f1;
+        Optizelle::Unconstrained <Real,XX>::State::t state1(x);
+        solve(trunc_solver,1,empty,state1,f1);
+        Tracker f;
+        Optizelle::Unconstrained <Real,XX>::State::t state(x);
+        solve(trunc_solver,4,empty,state,f);
+
+        // Make sure that we rejected some steps
+        CHECK(state1.opt_stop == Optizelle::OptimizationStop::GradientSmall);
+        CHECK(state1.glob_iter_total > state1.iter);
+        CHECK(f1.peak == 1);
+
+        // We should take exactly the same steps
+        CHECK(state.opt_stop == state1.opt_stop);
+        CHECK(state.iter == state1.iter);
+        CHECK(state.glob_iter_total == state1.glob_iter_total);
+        CHECK(state.x == state1.x);
+        CHECK(state.delta == state1.delta);
+        CHECK(state.safeguard_failed_total == state1.safeguard_failed_total);
+
+        // We evaluate the objective at extra radii
+        CHECK(f.evals > f1.evals);
+
+        // Make sure that we actually ran the evaluations together
+        #ifdef _OPENMP
+        CHECK(f.peak > 1);
+        #endif
+
+        // Shrink the trust-region after each rejection and make sure that
+        // we still take the same steps
+        Shrink shrink;
+        Tracker g1;
+        Optizelle::Unconstrained <Real,XX>::State::t state2(x);
+        solve(trunc_solver,1,shrink,state2,g1);
+        Tracker g;
+        Optizelle::Unconstrained <Real,XX>::State::t state3(x);
+        solve(trunc_solver,4,shrink,state3,g);
+        CHECK(state2.glob_iter_total > state2.iter);
+        CHECK(state3.opt_stop == state2.opt_stop);
+        CHECK(state3.iter == state2.iter);
+        CHECK(state3.glob_iter_total == state2.glob_iter_total);
+        CHECK(state3.x == state2.x);
+        CHECK(state3.delta == state2.delta);
+    }
+
+    // Declare success 
+    return EXIT_SUCCESS;
+}
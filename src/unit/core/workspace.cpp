@@ -0,0 +1,168 @@
+// Verify that once the algorithms warm up, they take all of their temporaries
+// from the workspaces in the state rather than creating new vectors.  We
+// count every vector that the vector spaces create and check this on the
+// Rosenbrock function with a trust-region method using BFGS, so that the
+// quasi-Newton history wraps around, and then with an equality constraint and
+// with inequality constraints.
+
+#include "optizelle/optizelle.h"
+#include "optizelle/vspaces.h"
+#include "spaces.h"
+#include "parallel.h"
+#include "augsys.h"
+#include "unit.h"
+
+// Rm, but we count the number of vectors that we create
+template <typename Real>
+struct CountedRm : public Optizelle::Rm <Real> {
+    typedef typename Optizelle::Rm <Real>::Vector Vector;
+    static Optizelle::Natural inits;
+    static Vector init(Vector const & x) {
+        inits++;
+        return Optizelle::Rm <Real>::init(x);
+    }
+};
+template <typename Real>
+Optizelle::Natural CountedRm <Real>::inits = 0;
+
+// Runs a scalar valued function on Rm in the counted space
+struct CountedScalar
+    : public Optizelle::ScalarValuedFunction <Real,CountedRm>
+{
+    std::unique_ptr <Optizelle::ScalarValuedFunction <Real,XX> > f;
+    explicit CountedScalar(Optizelle::ScalarValuedFunction <Real,XX> * f_) :
+        f(f_) {}
+
+    Real eval(X_Vector const & x) const {
+        return f->eval(x);
+    }
+    void grad(X_Vector const & x,X_Vector & grad) const {
+        f->grad(x,grad);
+    }
+    void hessvec(X_Vector const & x,X_Vector const & dx,X_Vector & H_dx)
+        const
+    {
+        f->hessvec(x,dx,H_dx);
+    }
+};
+
+// Runs a vector valued function on Rm in the counted space
+struct CountedVector
+    : public Optizelle::VectorValuedFunction <Real,CountedRm,CountedRm>
+{
+    std::unique_ptr <Optizelle::VectorValuedFunction <Real,XX,XX> > f;
+    explicit CountedVector(
+        Optizelle::VectorValuedFunction <Real,XX,XX> * f_
+    ) : f(f_) {}
+
+    void eval(X_Vector const & x,X_Vector & y) const {
+        f->eval(x,y);
+    }
+    void p(X_Vector const & x,X_Vector const & dx,X_Vector & y) const {
+        f->p(x,dx,y);
+    }
+    void ps(X_Vector const & x,X_Vector const & dy,X_Vector & z) const {
+        f->ps(x,dy,z);
+    }
+    void pps(
+        X_Vector const & x,
+        X_Vector const & dx,
+        X_Vector const & dy,
+        X_Vector & z
+    ) const {
+        f->pps(x,dx,dy,z);
+    }
+};
+
+// Records the number of vectors that we've created at the end of each
+// iteration
+template <typename ProblemClass>
+struct RecordInits : public Optizelle::StateManipulator <ProblemClass> {
+    mutable std::vector <Optizelle::Natural> inits;
+    void eval(
+        typename ProblemClass::Functions::t const & fns,
+        typename ProblemClass::State::t & state,
+        Optizelle::OptimizationLocation::t const & loc
+    ) const {
+        if(loc==Optizelle::OptimizationLocation::EndOfOptimizationIteration)
+            inits.emplace_back(CountedRm <Real>::inits);
+    }
+};
+
+// Checks that we ran at least warm+2 iterations and that we stopped creating
+// vectors after the iteration warm
+void check_inits(
+    std::vector <Optizelle::Natural> const & inits,
+    Optizelle::Natural const & warm
+) {
+    CHECK(inits.size() > warm+2);
+    CHECK(inits[warm] > 0);
+    for(auto i=warm;i<inits.size();i++)
+        CHECK(inits[i] == inits[warm]);
+}
+
+int main(int argc,char* argv[]){
+    // Setup the problems
+    typedef Optizelle::Unconstrained <Real,CountedRm> Unconstrained;
+    typedef Optizelle::EqualityConstrained <Real,CountedRm,CountedRm>
+        EqualityConstrained;
+    typedef Optizelle::InequalityConstrained <Real,CountedRm,CountedRm>
+        InequalityConstrained;
+    auto x = X_Vector {-1.2, 1.};
+    auto y = X_Vector {0.};
+    auto z = X_Vector {1., 1., 1., 1.};
+    auto lb = X_Vector {-2., -2.};
+    auto ub = X_Vector {0.5, 2.};
+    Tracker tracker;
+
+    // Solve the unconstrained problem.  We should stop creating vectors once
+    // the quasi-Newton history fills.
+    {
+        Unconstrained::State::t state(x);
+        state.H_type = Optizelle::Operators::BFGS;
+        state.stored_history = 2;
+        state.iter_max = 20;
+        state.msg_level = 0;
+        Unconstrained::Functions::t fns;
+        fns.f.reset(new CountedScalar(new Rosenbrock(tracker)));
+        RecordInits <Unconstrained> smanip;
+        Unconstrained::Algorithms::getMin(
+            Optizelle::Messaging::stdout,fns,state,smanip);
+        check_inits(smanip.inits,state.stored_history);
+    }
+
+    // Solve the problem on the unit circle
+    {
+        EqualityConstrained::State::t state(x,y);
+        state.H_type = Optizelle::Operators::UserDefined;
+        state.iter_max = 20;
+        state.msg_level = 0;
+        EqualityConstrained::Functions::t fns;
+        fns.f.reset(new CountedScalar(new Rosenbrock(tracker)));
+        fns.g.reset(new CountedVector(
+            new Unit <Real>::Constraint::Quadratic(1.,1.)));
+        RecordInits <EqualityConstrained> smanip;
+        EqualityConstrained::Algorithms::getMin(
+            Optizelle::Messaging::stdout,fns,state,smanip);
+        check_inits(smanip.inits,2);
+    }
+
+    // Solve the problem on a box
+    {
+        InequalityConstrained::State::t state(x,z);
+        state.H_type = Optizelle::Operators::UserDefined;
+        state.iter_max = 20;
+        state.msg_level = 0;
+        InequalityConstrained::Functions::t fns;
+        fns.f.reset(new CountedScalar(new Rosenbrock(tracker)));
+        fns.h.reset(new CountedVector(
+            new Unit <Real>::Constraint::Box(lb,ub)));
+        RecordInits <InequalityConstrained> smanip;
+        InequalityConstrained::Algorithms::getMin(
+            Optizelle::Messaging::stdout,fns,state,smanip);
+        check_inits(smanip.inits,2);
+    }
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+// Verify that the fused operations from a vector space match those built
+// from the basic operations.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+int main() {
+    // Create some type shortcuts
+    typedef Optizelle::FusedOps <Real,Rm> XF;
+    typedef Optizelle::FusedOps <Real,RmBasic> XF_basic;
+
+    // Make sure we're actually testing the fused operations
+    CHECK(Optizelle::has_axpby <Rm <Real> >::value);
+    CHECK(!Optizelle::has_axpby <RmBasic <Real> >::value);
+
+    // Generate a couple of vectors
+    auto m = Unit::Natural(7);
+    auto x = Unit::Vector <Real>::basic(m);
+    auto y = x;
+    for(auto i=Unit::Natural(0);i<m;i++) {
+        x[i] = cos(Real(i+3));
+        y[i] = sin(Real(2*i+1));
+    }
+
+    // Check y <- alpha x + beta y
+    auto z = y;
+    auto z_basic = y;
+    XF::axpby(Real(1.5),x,Real(-0.5),z);
+    XF_basic::axpby(Real(1.5),x,Real(-0.5),z_basic);
+    for(auto i=Unit::Natural(0);i<m;i++)
+        CHECK(std::fabs(z[i]-z_basic[i]) <= 1e-14*(1.+std::fabs(z[i])));
+
+    // Check y <- alpha x + y along with <y,y> when the last argument aliases
+    // the updated vector 
+    z = y;
+    z_basic = y;
+    auto innr = XF::axpy_innr(Real(-2.),x,z,z);
+    auto innr_basic = XF_basic::axpy_innr(Real(-2.),x,z_basic,z_basic);
+    CHECK(std::fabs(innr-innr_basic) <= 1e-14*(1.+std::fabs(innr)));
+    for(auto i=Unit::Natural(0);i<m;i++)
+        CHECK(std::fabs(z[i]-z_basic[i]) <= 1e-14*(1.+std::fabs(z[i])));
+
+    // Check y <- alpha x
+    XF::copy_scal(Real(0.25),x,z);
+    XF_basic::copy_scal(Real(0.25),x,z_basic);
+    for(auto i=Unit::Natural(0);i<m;i++)
+        CHECK(std::fabs(z[i]-z_basic[i]) <= 1e-14*(1.+std::fabs(z[i])));
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
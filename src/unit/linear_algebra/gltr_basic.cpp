@@ -0,0 +1,130 @@
+// Run the generalized Lanczos trust-region method on a positive definite
+// system, where it should match the solution of the linear system, and on an
+// indefinite system, where it should find a step on the trust-region boundary
+// that does at least as well as truncated CG.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Finds the value of the model 0.5 <Ax,x> - <b,x>
+Real model(Matrix const & A,Vector const & b,Vector const & x) {
+    auto Ax = X::init(x);
+    A.eval(x,Ax);
+    return Real(0.5)*X::innr(Ax,x) - X::innr(b,x);
+}
+
+// Solves the trust-region subproblem with GLTR
+void run_gltr(
+    Matrix const & A,
+    Vector const & b,
+    Real const & delta,
+    Unit::Natural const & iter_max,
+    Vector & x,
+    Unit::Natural & iter,
+    Optizelle::TruncatedStop::t & stop
+) {
+    auto x_cp = X::init(b);
+    auto norm_Br0 = Real(0.);
+    auto norm_Br = Real(0.);
+    auto failed = Unit::Natural(0);
+    auto alpha = Real(0.);
+    Optizelle::gltr <Real,Rm> (
+        A,
+        b,
+        Unit::Operator <Real,Rm>::Identity(),
+        Real(1e-12),
+        iter_max,
+        delta,
+        Optizelle::SafeguardSimplified <Real,Rm> (
+            Unit::Safeguard <Real,Rm>::none),
+        x,
+        x_cp,
+        norm_Br0,
+        norm_Br,
+        iter,
+        stop,
+        failed,
+        alpha);
+    CHECK(failed == 0);
+    CHECK(alpha == Real(1.));
+}
+
+int main() {
+    auto m = Unit::Natural(5);
+    auto x = Vector(m);
+    auto iter = Unit::Natural(0);
+    auto stop = Optizelle::TruncatedStop::NotConverged;
+
+    // On a positive definite system with a large trust-region, we should
+    // solve the linear system
+    {
+        auto A = Unit::Matrix <Real>::symmetric(m,2);
+        auto b = Unit::Vector <Real>::basic(m);
+        run_gltr(A,b,Real(1e5),m+5,x,iter,stop);
+        CHECK(stop == Optizelle::TruncatedStop::RelativeErrorSmall);
+        CHECK(iter <= m);
+        auto norm_r = Real(0.);
+        auto norm_b = Real(0.);
+        std::tie(norm_r,norm_b) = Unit::residual <Real,Rm>(A,x,b);
+        CHECK(norm_r <= Real(1e-10)*norm_b);
+    }
+
+    // On an indefinite system, we should end up on the trust-region boundary
+    // with a model value at least as good as truncated CG
+    {
+        auto A = Unit::Matrix <Real>::mostly_dd_indef(m);
+        auto b = Unit::Vector <Real>::basic(m);
+        auto delta = Real(2.);
+        run_gltr(A,b,delta,m+5,x,iter,stop);
+        CHECK(stop == Optizelle::TruncatedStop::ConvergedOnBoundary);
+        CHECK(std::fabs(std::sqrt(X::innr(x,x))-delta) <= Real(1e-10)*delta);
+
+        // Compare against truncated CG
+        auto x_tcg = X::init(b);
+        auto x_offset = X::init(b);
+        X::zero(x_offset);
+        auto x_cp = X::init(b);
+        auto norm_Br0 = Real(0.);
+        auto norm_Br = Real(0.);
+        auto iter_tcg = Unit::Natural(0);
+        auto stop_tcg = Optizelle::TruncatedStop::NotConverged;
+        auto failed = Unit::Natural(0);
+        auto alpha = Real(0.);
+        Optizelle::truncated_cg <Real,Rm> (
+            A,
+            b,
+            Unit::Operator <Real,Rm>::Identity(),
+            Real(1e-12),
+            m+5,
+            m+5,
+            1,
+            delta,
+            x_offset,
+            0,
+            Optizelle::SafeguardSimplified <Real,Rm> (
+                Unit::Safeguard <Real,Rm>::none),
+            false,
+            false,
+            false,
+            x_tcg,
+            x_cp,
+            norm_Br0,
+            norm_Br,
+            iter_tcg,
+            stop_tcg,
+            failed,
+            alpha);
+        CHECK(model(A,b,x) <= model(A,b,x_tcg) + Real(1e-12));
+    }
+
+    // Without a trust-region, we stop when we detect negative curvature
+    {
+        auto A = Unit::Matrix <Real>::mostly_dd_indef(m);
+        auto b = Unit::Vector <Real>::elast(m);
+        run_gltr(A,b,std::numeric_limits <Real>::infinity(),m+5,x,iter,stop);
+        CHECK(stop == Optizelle::TruncatedStop::NegativeCurvature);
+    }
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
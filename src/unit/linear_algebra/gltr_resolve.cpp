@@ -0,0 +1,72 @@
+// Run GLTR on an indefinite system and then resolve the trust-region
+// subproblem with a smaller radius using the saved Krylov space.  The resolve
+// should match a fresh solve and should not apply the operator.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Counts the number of times we apply a matrix
+struct Counted : public Optizelle::Operator <Real,Rm,Rm> {
+    Matrix A;
+    mutable Unit::Natural calls;
+    Counted(Matrix const & A_) : A(A_), calls(0) {}
+    void eval(Vector const & x,Vector & y) const {
+        A.eval(x,y);
+        calls++;
+    }
+};
+
+int main() {
+    // Setup the problem
+    auto m = Unit::Natural(5);
+    auto A = Counted(Unit::Matrix <Real>::mostly_dd_indef(m));
+    auto b = Unit::Vector <Real>::basic(m);
+    auto B = Unit::Operator <Real,Rm>::Identity();
+    auto safeguard = Optizelle::SafeguardSimplified <Real,Rm> (
+        Unit::Safeguard <Real,Rm>::none);
+    auto eps = Real(1e-12);
+    auto iter_max = m+5;
+
+    // Solve with a large trust-region and keep the Krylov space
+    auto x = X::init(b);
+    auto x_cp = X::init(b);
+    auto norm_Br0 = Real(0.);
+    auto norm_Br = Real(0.);
+    auto iter = Unit::Natural(0);
+    auto stop = Optizelle::TruncatedStop::NotConverged;
+    auto failed = Unit::Natural(0);
+    auto alpha = Real(0.);
+    auto qs = Optizelle::MultiVectors <Real,Rm>::t();
+    auto D = std::vector <Real> ();
+    auto E = std::vector <Real> ();
+    Optizelle::Workspace <Real,Rm> work;
+    Optizelle::gltr <Real,Rm> (A,b,B,eps,iter_max,Real(100.),safeguard,x,
+        x_cp,norm_Br0,norm_Br,iter,stop,failed,alpha,qs,D,E,work);
+    CHECK(D.size() == iter);
+    CHECK(E.size() == iter-1);
+
+    // Rm stores the Lanczos vectors contiguously
+    CHECK(qs.size() == iter*m);
+
+    // Resolve with a smaller trust-region
+    auto delta = Real(0.5);
+    auto calls = A.calls;
+    Optizelle::gltr_resolve <Real,Rm> (qs,D,E,norm_Br0,delta,safeguard,x,
+        stop,failed,alpha,work);
+    CHECK(A.calls == calls);
+    CHECK(stop == Optizelle::TruncatedStop::ConvergedOnBoundary);
+    CHECK(std::fabs(std::sqrt(X::innr(x,x))-delta) <= Real(1e-10)*delta);
+
+    // Compare against a fresh solve with the smaller trust-region
+    auto x_star = X::init(b);
+    Optizelle::gltr <Real,Rm> (A,b,B,eps,iter_max,delta,safeguard,x_star,
+        x_cp,norm_Br0,norm_Br,iter,stop,failed,alpha);
+    CHECK(stop == Optizelle::TruncatedStop::ConvergedOnBoundary);
+    auto norm_r = Real(0.);
+    auto norm_xstar = Real(0.);
+    std::tie(norm_r,norm_xstar) = Unit::error <Real,Rm> (x,x_star);
+    CHECK(norm_r <= Real(1e-8)*norm_xstar);
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+// Run GMRES on several right hand sides at once and verify that we get the
+// same solutions and iteration counts as running GMRES on each right hand side
+// separately, but that we apply the operator to all of the systems together.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Counts the number of times we apply a matrix to a group of vectors
+struct Counted : public Optizelle::Operator <Real,Rm,Rm> {
+    Matrix A;
+    mutable Unit::Natural calls;
+    Counted(Matrix const & A_) : A(A_), calls(0) {}
+    void eval(Vector const & x,Vector & y) const {
+        A.eval(x,y);
+        calls++;
+    }
+    void eval_many(
+        std::vector <Vector const *> const & xs,
+        std::vector <Vector *> const & ys
+    ) const {
+        for(auto j=Unit::Natural(0);j<xs.size();j++)
+            A.eval(*(xs[j]),*(ys[j]));
+        calls++;
+    }
+};
+
+int main() {
+    // Setup the problem
+    auto m = Unit::Natural(20);
+    auto A = Counted(Unit::Matrix <Real>::symmetric(m,0));
+    auto b1 = Unit::Vector <Real>::basic(m);
+    auto b2 = Unit::Vector <Real>::alternate(m);
+    auto eps = Real(1e-12);
+    auto iter_max = Unit::Natural(100);
+    auto rst_freq = Unit::Natural(7);
+    auto I = Unit::Operator <Real,Rm>::Identity();
+    Optizelle::EmptyGMRESManipulator <Real,Rm> gmanip;
+    Optizelle::Workspace <Real,Rm> work;
+
+    // Solve each system on its own
+    auto x1 = X::init(b1);
+    X::zero(x1);
+    auto x2 = X::init(b2);
+    X::zero(x2);
+    auto res1 = Optizelle::gmres <Real,Rm> (A,b1,eps,iter_max,rst_freq,I,I,
+        gmanip,x1,work);
+    auto res2 = Optizelle::gmres <Real,Rm> (A,b2,eps,iter_max,rst_freq,I,I,
+        gmanip,x2,work);
+    auto calls = A.calls;
+
+    // Solve both systems together
+    auto y1 = X::init(b1);
+    X::zero(y1);
+    auto y2 = X::init(b2);
+    X::zero(y2);
+    A.calls = 0;
+    auto res = Optizelle::gmres_many <Real,Rm> (A,{&b1,&b2},eps,iter_max,
+        rst_freq,I,I,{&gmanip,&gmanip},{&y1,&y2},work);
+    CHECK(res.size() == 2);
+
+    // The iterations and solutions should match
+    CHECK(res[0].second == res1.second);
+    CHECK(res[1].second == res2.second);
+    CHECK(res[0].first <= eps);
+    CHECK(res[1].first <= eps);
+    auto err = Real(0.);
+    auto norm_x = Real(0.);
+    std::tie(err,norm_x) = Unit::error <Real,Rm> (x1,y1);
+    CHECK(err <= Real(1e-10)*norm_x);
+    std::tie(err,norm_x) = Unit::error <Real,Rm> (x2,y2);
+    CHECK(err <= Real(1e-10)*norm_x);
+
+    // We should apply the operator as many times as the longer solve
+    CHECK(A.calls < calls);
+    CHECK(A.calls <= 2*std::max(res1.second,res2.second)+1);
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+// Run restarted GMRES on a sequence of systems while recycling a subspace
+// between the solves.  The second solve should require fewer iterations than
+// it would from scratch and, once the operator changes, we should recompute
+// the images of the recycled directions and still converge.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Solves A x = b from a zero initial guess and checks the residual
+Unit::Natural solve(
+    Matrix const & A,
+    Vector const & b,
+    Unit::Natural const & recycle_max,
+    Optizelle::GMRESRecycle <Real,Rm> & recycle,
+    Optizelle::Workspace <Real,Rm> & work
+) {
+    auto x = X::init(b);
+    X::zero(x);
+    auto eps = Real(1e-10);
+    auto err = Real(0.);
+    auto iter = Unit::Natural(0);
+    std::tie(err,iter) = Optizelle::gmres <Real,Rm> (
+        A,
+        b,
+        eps,
+        500,
+        5,
+        Unit::Operator <Real,Rm>::Identity(),
+        Unit::Operator <Real,Rm>::Identity(),
+        Optizelle::EmptyGMRESManipulator <Real,Rm> (),
+        x,
+        recycle_max,
+        recycle,
+        work);
+    CHECK(err <= eps);
+    auto norm_r = Real(0.);
+    auto norm_b = Real(0.);
+    std::tie(norm_r,norm_b) = Unit::residual <Real,Rm>(A,x,b);
+    CHECK(norm_r <= eps);
+    return iter;
+}
+
+int main() {
+    // Setup the problem
+    auto m = Unit::Natural(30);
+    auto A = Unit::Matrix <Real>::symmetric(m,0);
+    auto b = Unit::Vector <Real>::basic(m);
+    auto b2 = Unit::Vector <Real>::alternate(m);
+    Optizelle::Workspace <Real,Rm> work;
+
+    // Find the number of iterations without recycling
+    Optizelle::GMRESRecycle <Real,Rm> none;
+    solve(A,b,0,none,work);
+    auto iter_b2 = solve(A,b2,0,none,work);
+    CHECK(none.size == 0);
+
+    // Recycling on the first solve fills the subspace and then the second
+    // solve benefits from it
+    auto recycle_max = Unit::Natural(10);
+    Optizelle::GMRESRecycle <Real,Rm> recycle;
+    solve(A,b,recycle_max,recycle,work);
+    CHECK(recycle.size > 0);
+    CHECK(recycle.size <= recycle_max);
+    auto iter_b2_recycled = solve(A,b2,recycle_max,recycle,work);
+    CHECK(iter_b2_recycled < iter_b2);
+    CHECK(recycle.refreshes == 0);
+
+    // When the operator changes, we recompute the images once
+    auto A2 = Unit::Matrix <Real>::symmetric(m,1);
+    auto size = recycle.size;
+    recycle.touch();
+    solve(A2,b,recycle_max,recycle,work);
+    CHECK(recycle.refreshes == size);
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
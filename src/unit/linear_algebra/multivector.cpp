@@ -0,0 +1,54 @@
+// Verify that the batched inner products and axpys from a vector space's
+// multivector match those from the fallback that stores individual vectors.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+int main() {
+    // Create some type shortcuts
+    typedef Optizelle::MultiVectors <Real,Rm> Vs;
+    typedef Optizelle::MultiVectors <Real,RmBasic> Vs_basic;
+
+    // Generate a handful of vectors and store them both ways 
+    auto m = Unit::Natural(7);
+    auto n = Unit::Natural(4);
+    auto x = Unit::Vector <Real>::basic(m);
+    auto vs = Vs::t();
+    auto vs_basic = Vs_basic::t();
+    Vs::resize(x,n,vs);
+    Vs_basic::resize(x,n,vs_basic);
+    for(auto j=Unit::Natural(0);j<n;j++) {
+        auto v = x;
+        for(auto i=Unit::Natural(0);i<m;i++)
+            v[i] = cos(Real(i*(j+1)+3));
+        Vs::copy(v,j,vs);
+        Vs_basic::copy(v,j,vs_basic);
+    }
+
+    // Check the inner products
+    auto z = std::vector <Real> (n);
+    auto z_basic = std::vector <Real> (n);
+    Vs::innr(n-1,vs,x,z.data());
+    Vs_basic::innr(n-1,vs_basic,x,z_basic.data());
+    for(auto j=Unit::Natural(0);j<n-1;j++)
+        CHECK(std::fabs(z[j]-z_basic[j]) <= 1e-14*(1.+std::fabs(z[j])));
+
+    // Check the linear combinations
+    auto alpha = std::vector <Real> {1.5,-2.,0.25,3.};
+    auto y = x;
+    auto y_basic = x;
+    Vs::axpy(n,alpha.data(),vs,y);
+    Vs_basic::axpy(n,alpha.data(),vs_basic,y_basic);
+    for(auto i=Unit::Natural(0);i<m;i++)
+        CHECK(std::fabs(y[i]-y_basic[i]) <= 1e-14*(1.+std::fabs(y[i])));
+
+    // Make sure growing the storage keeps the existing vectors
+    Vs::resize(x,n+2,vs);
+    Vs::innr(n,vs,x,z.data());
+    Vs_basic::innr(n,vs_basic,x,z_basic.data());
+    for(auto j=Unit::Natural(0);j<n;j++)
+        CHECK(std::fabs(z[j]-z_basic[j]) <= 1e-14*(1.+std::fabs(z[j])));
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
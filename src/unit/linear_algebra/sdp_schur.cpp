@@ -0,0 +1,122 @@
+// Verify that the Schur complement of a linear SDP constraint, which we form
+// directly from the sparse data, matches the one formed one Hessian-vector
+// product at a time.  In addition, verify that h'(x) and h'(x)* are adjoint.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+#include "optizelle/sdp.h"
+
+// Create some type shortcuts
+typedef Optizelle::Rm <Real> X;
+typedef X::Vector X_Vector;
+typedef Optizelle::SQL <Real> Z;
+typedef Z::Vector Z_Vector;
+typedef Optizelle::Cone::t Cone;
+typedef Optizelle::LinearSDP <Real> LinearSDP;
+typedef LinearSDP::Block Block;
+auto const Sparse = Optizelle::SDPBlock::Sparse;
+auto const RankOne = Optizelle::SDPBlock::RankOne;
+
+int main() {
+    // Create a constraint with a semidefinite block, a linear block, and
+    // a second semidefinite block large enough that some columns form
+    // inv(H) A_i Z densely while others sum over the nonzeros.
+    auto types = std::vector <Cone> {
+        Cone::Semidefinite,Cone::Linear,Cone::Semidefinite};
+    auto sizes = std::vector <Unit::Natural> {3,4,2};
+    auto n = Unit::Natural(6);
+    auto A = std::vector <std::vector <Block> > (n+1);
+
+    // A0 is the identity
+    A[0] = {
+        Block{Sparse,{1,2,3},{1,2,3},{Real(-1.),Real(-1.),Real(-1.)},1.},
+        Block{Sparse,{1,2,3,4},{},{Real(-1.),Real(-1.),Real(-1.),Real(-1.)},
+            1.},
+        Block{Sparse,{1,2},{1,2},{Real(-1.),Real(-1.)},1.}};
+
+    // Mix sparse and rank-one blocks
+    A[1] = {
+        Block{Sparse,{1,1},{1,3},{Real(1.),Real(0.5)},1.},
+        Block{Sparse,{2},{},{Real(1.)},1.},
+        Block{RankOne,{1,2},{},{Real(1.),Real(-1.)},Real(0.5)}};
+    A[2] = {
+        Block{RankOne,{1,3},{},{Real(2.),Real(1.)},Real(0.3)},
+        Block{Sparse,{1,4},{},{Real(0.5),Real(-1.)},1.},
+        Block{Sparse,{2},{2},{Real(2.)},1.}};
+    A[3] = {
+        Block{Sparse,{1,1,1,2,2,3},{1,2,3,2,3,3},
+            {Real(1.),Real(0.2),Real(-0.3),Real(2.),Real(0.4),Real(1.5)},1.},
+        Block{Sparse,{},{},{},1.},
+        Block{Sparse,{1},{2},{Real(0.7)},1.}};
+    A[4] = {
+        Block{RankOne,{2},{},{Real(1.)},Real(-1.)},
+        Block{Sparse,{3},{},{Real(3.)},1.},
+        Block{Sparse,{},{},{},1.}};
+    A[5] = {
+        Block{Sparse,{2},{3},{Real(-1.)},1.},
+        Block{Sparse,{},{},{},1.},
+        Block{RankOne,{2},{},{Real(1.)},Real(2.)}};
+    A[6] = {
+        Block{Sparse,{},{},{},1.},
+        Block{Sparse,{1,2,3,4},{},{Real(1.),Real(1.),Real(1.),Real(1.)},1.},
+        Block{Sparse,{},{},{},1.}};
+    auto h = LinearSDP(types,sizes,A);
+
+    // Pick a point where h(x) is strictly feasible
+    auto x = X_Vector(n,Real(0.05));
+    auto h_x = Z_Vector(types,sizes);
+    h.eval(x,h_x);
+    CHECK(Z::srch(h_x,h_x) > Real(0.));
+
+    // Pick a nonsymmetric multiplier
+    auto z = Z::init(h_x);
+    for(auto i=Unit::Natural(0);i<z.data.size();i++)
+        z.data[i] = Real(1.)+Real(0.1)*sin(Real(i+1));
+    z.touch();
+
+    // Form the Schur complement directly
+    auto S = std::vector <Real> ();
+    h.schur(h_x,z,S);
+    CHECK(S.size() == n*n);
+
+    // Form it a column at a time from h'(x)* inv(L(h(x))) (h'(x) e_i o z)
+    auto ei = X::init(x);
+    auto Si = X::init(x);
+    auto z_tmp1 = Z::init(h_x);
+    auto z_tmp2 = Z::init(h_x);
+    for(auto i=Unit::Natural(1);i<=n;i++) {
+        X::zero(ei);
+        ei[i-1] = Real(1.);
+        h.p(x,ei,z_tmp1);
+        Z::prod(z_tmp1,z,z_tmp2);
+        Z::linv(h_x,z_tmp2,z_tmp1);
+        h.ps(x,z_tmp1,Si);
+        for(auto k=Unit::Natural(1);k<=n;k++)
+            CHECK(std::fabs(S[(k-1)+(i-1)*n]-Si[k-1]) <= Real(1e-12)
+                *(Real(1.)+std::fabs(Si[k-1])));
+    }
+
+    // Check that <h'(x)dx,dz> = <dx,h'(x)*dz>
+    auto dx = X::init(x);
+    for(auto i=Unit::Natural(0);i<n;i++)
+        dx[i] = cos(Real(i+1));
+    auto dz = Z::init(h_x);
+    for(auto i=Unit::Natural(0);i<dz.data.size();i++)
+        dz.data[i] = sin(Real(2*i+1));
+    Z::symm(dz);
+    h.p(x,dx,z_tmp1);
+    h.ps(x,dz,Si);
+    auto lhs = Z::innr(z_tmp1,dz);
+    auto rhs = X::innr(dx,Si);
+    CHECK(std::fabs(lhs-rhs) <= Real(1e-12)*(Real(1.)+std::fabs(lhs)));
+
+    // Make sure that we reject quadratic cones
+    auto caught = false;
+    try {
+        LinearSDP({Cone::Quadratic},{3},
+            {{Block{Sparse,{},{},{},1.}}});
+    } catch(Optizelle::Exception::t const & e) {
+        caught = true;
+    }
+    CHECK(caught);
+}
@@ -8,3 +8,22 @@ typedef XX <Real> X;
 typedef typename X::Vector Vector;
 typedef Unit::Matrix <Real>::t Matrix;
 using Optizelle::Rm;
+
+// Rm without any of the optional vector space extensions, such as fused
+// operations or multivectors.  This lets us check the extensions against the
+// fallbacks built from the basic operations.
+template <typename Real>
+struct RmBasic {
+    typedef Optizelle::Rm <Real> X;
+    typedef typename X::Vector Vector;
+    static Vector init(Vector const & x) { return X::init(x); }
+    static void copy(Vector const & x, Vector & y) { X::copy(x,y); }
+    static void scal(Real const & alpha, Vector & x) { X::scal(alpha,x); }
+    static void zero(Vector & x) { X::zero(x); }
+    static void axpy(Real const & alpha, Vector const & x, Vector & y) {
+        X::axpy(alpha,x,y);
+    }
+    static Real innr(Vector const & x,Vector const & y) {
+        return X::innr(x,y);
+    }
+};
@@ -0,0 +1,60 @@
+// Factor A A' for a sparse matrix A with a sparse LDL' factorization and
+// verify that we solve linear systems with it.  In addition, verify that we
+// detect when A doesn't have full row rank.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+int main() {
+    // Setup a 4 x 6 matrix.  We split one of the entries in two to verify
+    // that we sum repeated entries.
+    auto A = Optizelle::SparseMatrix <Real> ();
+    A.reset(4,6);
+    A.add(0,0,Real(2.));
+    A.add(0,3,Real(-1.));
+    A.add(1,1,Real(1.));
+    A.add(1,4,Real(3.));
+    A.add(2,0,Real(1.));
+    A.add(2,2,Real(4.));
+    A.add(2,5,Real(-2.));
+    A.add(3,3,Real(1.));
+    A.add(3,5,Real(0.5));
+    A.add(3,5,Real(0.5));
+
+    // Form A A' densely
+    auto m = A.m;
+    auto Ad = std::vector <Real> (A.m*A.n,Real(0.));
+    for(auto p=Unit::Natural(0);p<A.vals.size();p++)
+        Ad[A.rows[p]+A.cols[p]*m] += A.vals[p];
+    auto AAt = std::vector <Real> (m*m,Real(0.));
+    for(auto i=Unit::Natural(0);i<m;i++)
+        for(auto k=Unit::Natural(0);k<m;k++)
+            for(auto j=Unit::Natural(0);j<A.n;j++)
+                AAt[i+k*m] += Ad[i+j*m]*Ad[k+j*m];
+
+    // Factor and then solve A A' x = b
+    auto ldlt = Optizelle::SparseLDLT <Real> ();
+    CHECK(ldlt.factor_aat(A));
+    auto b = Unit::Vector <Real>::basic(m);
+    auto x = b;
+    ldlt.solve(x.data());
+
+    // Check the residual
+    auto r = b;
+    for(auto i=Unit::Natural(0);i<m;i++)
+        for(auto k=Unit::Natural(0);k<m;k++)
+            r[i] -= AAt[i+k*m]*x[k];
+    CHECK(std::sqrt(X::innr(r,r)) <= Real(1e-12)*std::sqrt(X::innr(b,b)));
+
+    // When a row repeats, A A' is singular
+    A.reset(3,2);
+    A.add(0,0,Real(1.));
+    A.add(0,1,Real(2.));
+    A.add(1,0,Real(2.));
+    A.add(1,1,Real(4.));
+    A.add(2,1,Real(1.));
+    CHECK(!ldlt.factor_aat(A));
+
+    // Declare success
+    return EXIT_SUCCESS;
+}
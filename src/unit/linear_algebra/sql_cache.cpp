@@ -0,0 +1,165 @@
+// Verify that the SQL kernels share the cached factorizations of the
+// semidefinite blocks and that modifying a vector invalidates them.  In
+// addition, verify that the version stamps let the algorithms check their
+// caches.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Create some type shortcuts
+typedef Optizelle::SQL <Real> SQL;
+typedef SQL::Vector SQL_Vector;
+typedef Optizelle::Cone::t Cone;
+
+// Checks that x o z = y
+void check_linv(SQL_Vector const & x,SQL_Vector const & y) {
+    auto z = SQL::init(x);
+    auto w = SQL::init(x);
+    SQL::linv(x,y,z);
+    SQL::prod(x,z,w);
+    for(auto i=Unit::Natural(0);i<w.data.size();i++)
+        CHECK(std::fabs(w.data[i]-y.data[i]) <= Real(1e-12)
+            *(Real(1.)+std::fabs(y.data[i])));
+}
+
+int main() {
+    // Create a vector with a single semidefinite block and a linear cone
+    auto x = SQL_Vector({Cone::Semidefinite,Cone::Linear},{4,2});
+    SQL::id(x);
+    for(auto j=Unit::Natural(1);j<=4;j++)
+        for(auto i=Unit::Natural(1);i<=4;i++)
+            x(1,i,j) += Real(0.1)*cos(Real(i+j));
+    x(2,1) = Real(2.);
+    x(2,2) = Real(3.);
+    auto y = SQL::init(x);
+    SQL::id(y);
+    auto d = SQL::init(x);
+    SQL::rand(d);
+    SQL::symm(d);
+    CHECK(x.cache_hits() == 0);
+    CHECK(x.cache_misses() == 0);
+
+    // We don't allocate memory for the cache until we need it
+    CHECK(x.cache[0].factor.size() == 0);
+    CHECK(x.cache[0].inverse.size() == 0);
+
+    // The first barrier evaluation factors the block and the second reuses
+    // the factor
+    auto barr = SQL::barr(x);
+    CHECK(x.cache_misses() == 1);
+    CHECK(SQL::barr(x) == barr);
+    CHECK(x.cache_hits() == 1);
+    CHECK(x.cache[0].factor.size() == 10);
+    CHECK(x.cache[0].inverse.size() == 0);
+
+    // The inverse is built from the cached factor
+    check_linv(x,y);
+    CHECK(x.cache_misses() == 2);
+    CHECK(x.cache_hits() == 2);
+
+    // The line search reuses the factor of the iterate
+    SQL::srch(d,x);
+    CHECK(x.cache_misses() == 2);
+    CHECK(x.cache_hits() == 3);
+
+    // Check the barrier on a diagonal block, which has a known answer.  We
+    // use an even size since the indexing into the packed factor differs
+    // between even and odd sizes.
+    auto w = SQL_Vector({Cone::Semidefinite},{4});
+    SQL::zero(w);
+    for(auto i=Unit::Natural(1);i<=4;i++)
+        w(1,i,i) = Real(i);
+    CHECK(std::fabs(SQL::barr(w)-std::log(Real(24.))) <= Real(1e-14));
+
+    // Updating the vector invalidates the cache
+    SQL::axpy(Real(0.1),y,x);
+    auto misses = x.cache_misses();
+    check_linv(x,y);
+    CHECK(x.cache_misses() == misses+2);
+
+    // Reading through the constant accessors keeps the cache
+    auto const & x_const = x;
+    auto x22 = x_const(1,2,2);
+    auto hits = x.cache_hits();
+    misses = x.cache_misses();
+    check_linv(x,y);
+    CHECK(x.cache_misses() == misses);
+    CHECK(x.cache_hits() == hits+1);
+
+    // Writing through the nonconstant accessors invalidates the cache and
+    // the version without a call to touch
+    auto version = SQL::version(x);
+    x(1,2,2) = x22+Real(0.5);
+    x(2,1) += Real(0.5);
+    misses = x.cache_misses();
+    check_linv(x,y);
+    CHECK(x.cache_misses() == misses+2);
+    CHECK(SQL::version(x) != version);
+
+    // Once we restamp the vector, we reuse the new factors
+    version = SQL::version(x);
+    misses = x.cache_misses();
+    check_linv(x,y);
+    CHECK(x.cache_misses() == misses);
+    CHECK(SQL::version(x) == version);
+
+    // The same holds when we write through front
+    x.front(1) += Real(0.5);
+    misses = x.cache_misses();
+    check_linv(x,y);
+    CHECK(x.cache_misses() == misses+2);
+
+    // When we write to the data directly, we touch the vector once we're
+    // done
+    x.data[0] += Real(0.5);
+    x.touch();
+    misses = x.cache_misses();
+    check_linv(x,y);
+    CHECK(x.cache_misses() == misses+2);
+
+    // Overwrite an entire block through a pointer to its raw data.  Once we
+    // touch the vector, like the algorithms do after the user writes to
+    // one, we refactor the block and get the barrier of the new data.
+    auto v = SQL_Vector({Cone::Semidefinite},{4});
+    SQL::id(v);
+    CHECK(std::fabs(SQL::barr(v)) <= Real(1e-14));
+    Real * const v_blk = &(v(1,1,1));
+    for(auto i=Unit::Natural(1);i<=4;i++)
+        v_blk[Optizelle::ijtok(i,i,4)] = Real(i);
+    Optizelle::Touch <Real,Optizelle::SQL>::eval(v);
+    CHECK(std::fabs(SQL::barr(v)-std::log(Real(24.))) <= Real(1e-14));
+    CHECK(v.cache_misses() == 2);
+
+    // When the block is singular, the factor fails and the barrier tells us
+    // so rather than returning the log of the partial factor
+    v_blk[Optizelle::ijtok(2,2,4)] = Real(0.);
+    SQL::touch(v);
+    CHECK(std::isnan(SQL::barr(v)));
+
+    // SQL stamps its vectors with versions, but Rm falls back to checking
+    // the relative error
+    CHECK(Optizelle::has_version <SQL>::value);
+    CHECK(!Optizelle::has_version <Optizelle::Rm <Real> >::value);
+
+    // Different vectors never share a version
+    CHECK(SQL::version(x) != SQL::version(y));
+    CHECK(SQL::version(x) != SQL::version(SQL::init(x)));
+
+    // Stamps go stale when we modify the vector or pass a different one
+    auto stamp = Optizelle::CacheStamp <Real,Optizelle::SQL> (x);
+    CHECK(stamp.stale(x));
+    stamp.update(x);
+    CHECK(!stamp.stale(x));
+    CHECK(stamp.stale(y));
+    SQL::scal(Real(2.),x);
+    CHECK(stamp.stale(x));
+
+    // The fallback only goes stale when the data changes
+    auto r = std::vector <Real> {Real(1.),Real(2.)};
+    auto r_stamp = Optizelle::CacheStamp <Real,Optizelle::Rm> (r);
+    CHECK(r_stamp.stale(r));
+    r_stamp.update(r);
+    CHECK(!r_stamp.stale(r));
+    r[1] = Real(3.);
+    CHECK(r_stamp.stale(r));
+}
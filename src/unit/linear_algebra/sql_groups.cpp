@@ -0,0 +1,169 @@
+// Verify that the SQL kernels, which run over groups of like cones, agree
+// with the same computation done one cone at a time.  In addition, verify that
+// the way we schedule the semidefinite blocks doesn't change the result.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Create some type shortcuts
+typedef Optizelle::SQL <Real> SQL;
+typedef SQL::Vector SQL_Vector;
+typedef Optizelle::Cone::t Cone;
+
+// Fills in a strictly feasible point.  The seed lets us generate different
+// points of the same shape.
+void feasible(Real const & seed,SQL_Vector & x) {
+    for(auto blk=Unit::Natural(1);blk<=x.numBlocks();blk++) {
+        auto m = x.blkSize(blk);
+        switch(x.blkType(blk)) {
+        case Cone::Linear:
+            for(auto i=Unit::Natural(1);i<=m;i++)
+                x(blk,i) = Real(1.5)+sin(seed*Real(blk+i));
+            break;
+        case Cone::Quadratic: {
+            auto norm_xbar = Real(0.);
+            for(auto i=Unit::Natural(2);i<=m;i++) {
+                x(blk,i) = cos(seed*Real(3*blk+i));
+                norm_xbar += x(blk,i)*x(blk,i);
+            }
+            x(blk,1) = std::sqrt(norm_xbar)+Real(0.5)+Real(0.1)*Real(blk);
+            break;
+        } case Cone::Semidefinite:
+            for(auto j=Unit::Natural(1);j<=m;j++)
+                for(auto i=Unit::Natural(1);i<=m;i++)
+                    x(blk,i,j) = Real(0.1)*cos(seed*Real(i+j+blk))
+                        + (i==j ? Real(m) : Real(0.));
+            break;
+        }
+    }
+}
+
+// Fills in a direction
+void direction(Real const & seed,SQL_Vector & x) {
+    for(auto i=Unit::Natural(0);i<x.data.size();i++)
+        x.data[i] = sin(seed*Real(i+1));
+    SQL::symm(x);
+}
+
+// Extracts a single cone into a vector by itself
+SQL_Vector extract(SQL_Vector const & x,Unit::Natural const & blk) {
+    auto y = SQL_Vector({x.blkType(blk)},{x.blkSize(blk)});
+    auto begin = x.data.begin()+x.offsets[blk-1];
+    auto end = x.data.begin()+x.offsets[blk];
+    std::copy(begin,end,y.data.begin());
+    return y;
+}
+
+int main() {
+    // Create a vector with many small cones of a few kinds
+    auto types = std::vector <Cone> ();
+    auto sizes = std::vector <Unit::Natural> ();
+    for(auto k=Unit::Natural(0);k<12;k++) {
+        types.emplace_back(Cone::Quadratic);
+        sizes.emplace_back(k%4==3 ? 4 : 3);
+        if(k%5==0) {
+            types.emplace_back(Cone::Linear);
+            sizes.emplace_back(2);
+        }
+        if(k%6==0) {
+            types.emplace_back(Cone::Semidefinite);
+            sizes.emplace_back(3);
+        }
+    }
+    auto x = SQL_Vector(types,sizes);
+    auto y = SQL::init(x);
+    auto z = SQL::init(x);
+    auto d = SQL::init(x);
+    feasible(Real(1.),x);
+    feasible(Real(2.),y);
+    direction(Real(3.),d);
+
+    // Make sure that we grouped the cones.  We have quadratic cones of size 3
+    // and 4, linear cones of size 2, and semidefinite cones of size 3.
+    CHECK(x.groups.size() == 4);
+    CHECK(x.groups[0].type == Cone::Quadratic);
+    CHECK(x.groups[0].size == 3);
+    CHECK(x.groups[0].blks.size() == 9);
+
+    // Check the Jordan product
+    SQL::prod(x,y,z);
+    for(auto blk=Unit::Natural(1);blk<=x.numBlocks();blk++) {
+        auto xk = extract(x,blk);
+        auto yk = extract(y,blk);
+        auto zk = SQL::init(xk);
+        SQL::prod(xk,yk,zk);
+        auto z_blk = extract(z,blk);
+        for(auto i=Unit::Natural(0);i<zk.data.size();i++)
+            CHECK(std::fabs(zk.data[i]-z_blk.data[i]) <= Real(1e-14)
+                *(Real(1.)+std::fabs(zk.data[i])));
+    }
+
+    // Check the Jordan product inverse by undoing it
+    SQL::linv(x,y,z);
+    auto w = SQL::init(x);
+    SQL::prod(x,z,w);
+    for(auto i=Unit::Natural(0);i<w.data.size();i++)
+        CHECK(std::fabs(w.data[i]-y.data[i]) <= Real(1e-12)
+            *(Real(1.)+std::fabs(y.data[i])));
+
+    // Check the barrier
+    auto barr = SQL::barr(x);
+    auto barr_blk = Real(0.);
+    for(auto blk=Unit::Natural(1);blk<=x.numBlocks();blk++)
+        barr_blk += SQL::barr(extract(x,blk));
+    CHECK(std::fabs(barr-barr_blk) <= Real(1e-12)*(Real(1.)+std::fabs(barr)));
+
+    // Check the line search
+    auto alpha = SQL::srch(d,y);
+    auto alpha_blk = std::numeric_limits <Real>::infinity();
+    for(auto blk=Unit::Natural(1);blk<=x.numBlocks();blk++)
+        alpha_blk = std::min(alpha_blk,
+            SQL::srch(extract(d,blk),extract(y,blk)));
+    CHECK(alpha == alpha_blk);
+    CHECK(alpha < std::numeric_limits <Real>::infinity());
+
+    // Create a vector with several semidefinite blocks of different sizes
+    auto xs = SQL_Vector(
+        {Cone::Semidefinite,Cone::Quadratic,Cone::Semidefinite,
+            Cone::Semidefinite,Cone::Semidefinite},
+        {2,3,5,3,4});
+    feasible(Real(4.),xs);
+
+    // Make sure that we order the semidefinite blocks from the most to the
+    // least expensive and that init carries the schedule
+    CHECK(xs.sdp_blks == std::vector <Unit::Natural> ({3,5,4,1}));
+    xs.schedule = Optizelle::ConeSchedule::AcrossCones;
+    auto ys = SQL::init(xs);
+    CHECK(ys.schedule == Optizelle::ConeSchedule::AcrossCones);
+    feasible(Real(5.),ys);
+    auto ds = SQL::init(xs);
+    direction(Real(6.),ds);
+
+    // Run each kernel going across the cones and then one cone at a time 
+    auto prod_across = SQL::init(xs);
+    auto linv_across = SQL::init(xs);
+    SQL::prod(xs,ys,prod_across);
+    SQL::linv(xs,ys,linv_across);
+    auto barr_across = SQL::barr(xs);
+    auto srch_across = SQL::srch(ds,ys);
+
+    xs.schedule = Optizelle::ConeSchedule::PerCone;
+    ds.schedule = Optizelle::ConeSchedule::PerCone;
+    auto prod_per = SQL::init(xs);
+    auto linv_per = SQL::init(xs);
+    SQL::prod(xs,ys,prod_per);
+    SQL::linv(xs,ys,linv_per);
+    auto barr_per = SQL::barr(xs);
+    auto srch_per = SQL::srch(ds,ys);
+
+    // Check that we get the same thing
+    for(auto i=Unit::Natural(0);i<xs.data.size();i++) {
+        CHECK(std::fabs(prod_across.data[i]-prod_per.data[i]) <= Real(1e-14)
+            *(Real(1.)+std::fabs(prod_per.data[i])));
+        CHECK(std::fabs(linv_across.data[i]-linv_per.data[i]) <= Real(1e-14)
+            *(Real(1.)+std::fabs(linv_per.data[i])));
+    }
+    CHECK(std::fabs(barr_across-barr_per) <= Real(1e-14)
+        *(Real(1.)+std::fabs(barr_per)));
+    CHECK(srch_across == srch_per);
+}
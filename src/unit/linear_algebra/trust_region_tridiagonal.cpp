@@ -0,0 +1,111 @@
+// Solve the tridiagonal trust-region subproblem from GLTR by factoring
+// T + lambda I and verify that it matches the solution that we find by
+// diagonalizing T.  We check an interior solution, a solution on the boundary
+// for both a positive definite and an indefinite T, the hard case, and that
+// the initial guess for the multiplier doesn't change the answer.
+
+#include "linear_algebra.h"
+#include "spaces.h"
+
+// Finds the value of the model 0.5 <T h,h> + gamma0 h_1
+Real model(
+    std::vector <Real> const & D,
+    std::vector <Real> const & E,
+    Real const & gamma0,
+    std::vector <Real> const & h
+) {
+    auto k = D.size();
+    auto z = gamma0*h[0];
+    for(auto i=Unit::Natural(0);i<k;i++) {
+        auto Th_i = D[i]*h[i];
+        if(i > 0)
+            Th_i += E[i-1]*h[i-1];
+        if(i+1 < k)
+            Th_i += E[i]*h[i+1];
+        z += Real(0.5)*Th_i*h[i];
+    }
+    return z;
+}
+
+// Finds the norm of a vector
+Real norm(std::vector <Real> const & h) {
+    auto norm_h_2 = Real(0.);
+    for(auto const & h_i : h)
+        norm_h_2 += h_i*h_i;
+    return std::sqrt(norm_h_2);
+}
+
+// Solves the subproblem both ways and checks that they match.  Then, returns
+// the multiplier.
+Real check(
+    std::vector <Real> const & D,
+    std::vector <Real> const & E,
+    Real const & gamma0,
+    Real const & delta,
+    Real lambda,
+    bool const & indefinite
+) {
+    auto k = D.size();
+    auto h = std::vector <Real> ();
+    CHECK(Optizelle::trust_region_tridiagonal <Real> (
+        k,D,E,gamma0,delta,h,lambda) == indefinite);
+    CHECK(h.size() == k);
+    CHECK(norm(h) <= delta*(Real(1.)+Real(1e-12)));
+
+    auto h_eig = std::vector <Real> ();
+    auto lambda_eig = Real(0.);
+    CHECK(Optizelle::trust_region_tridiagonal_eig <Real> (
+        k,D,E,gamma0,delta,h_eig,lambda_eig));
+    CHECK(std::fabs(lambda-lambda_eig) <= Real(1e-8)*(Real(1.)+lambda_eig));
+    CHECK(std::fabs(model(D,E,gamma0,h)-model(D,E,gamma0,h_eig))
+        <= Real(1e-10)*(Real(1.)+std::fabs(model(D,E,gamma0,h_eig))));
+    return lambda;
+}
+
+int main() {
+    // Setup a positive definite T
+    auto k = Unit::Natural(6);
+    auto D = std::vector <Real> (k);
+    auto E = std::vector <Real> (k-1);
+    for(auto i=Unit::Natural(0);i<k;i++) {
+        D[i] = Real(4.)+Real(i);
+        if(i+1 < k)
+            E[i] = Real(1.)+Real(0.5)*Real(i);
+    }
+    auto gamma0 = Real(2.);
+
+    // With a large trust-region, we find the unconstrained minimizer
+    CHECK(check(D,E,gamma0,Real(1e3),Real(0.),false) == Real(0.));
+
+    // With a small trust-region, we move to the boundary
+    auto lambda = check(D,E,gamma0,Real(0.1),Real(0.),false);
+    CHECK(lambda > Real(0.));
+
+    // The initial guess for the multiplier doesn't change the answer
+    check(D,E,gamma0,Real(0.1),lambda,false);
+    check(D,E,gamma0,Real(0.1),Real(1e6),false);
+    check(D,E,gamma0,Real(0.1),Real(-1e6),false);
+
+    // When T is indefinite, we end up on the boundary even with a large
+    // trust-region
+    D[2] = Real(-3.);
+    lambda = check(D,E,gamma0,Real(10.),Real(0.),true);
+    CHECK(lambda > Real(3.));
+    check(D,E,gamma0,Real(10.),lambda,true);
+
+    // In the hard case, the eigenvector for the smallest eigenvalue is
+    // orthogonal to e_1, so no multiplier to the right of the smallest
+    // eigenvalue reaches the boundary
+    D = std::vector <Real> {Real(1.),Real(-1.),Real(2.)};
+    E = std::vector <Real> {Real(0.),Real(0.)};
+    auto h = std::vector <Real> ();
+    lambda = Real(0.);
+    CHECK(Optizelle::trust_region_tridiagonal <Real> (
+        D.size(),D,E,Real(1.),Real(2.),h,lambda));
+    CHECK(std::fabs(norm(h)-Real(2.)) <= Real(1e-8));
+    CHECK(std::fabs(h[0]+Real(0.5)) <= Real(1e-6));
+    CHECK(std::fabs(h[2]) <= Real(1e-8));
+
+    // Declare success
+    return EXIT_SUCCESS;
+}